@@ -19,7 +19,7 @@
 /**
  * maximum number of heaps (determined by number of bits used for actual heap)
  */
-#define POSAL_HEAP_MGR_MAX_NUM_HEAPS 1
+#define POSAL_HEAP_MGR_MAX_NUM_HEAPS 7
 
 /**
  * Controls buffer pool reserved for queue elements.
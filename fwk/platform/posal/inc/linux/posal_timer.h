@@ -274,6 +274,36 @@ uint64_t posal_timer_get_time(void);
  */
 uint64_t posal_timer_get_time_in_msec(void);
 
+/**
+  Switches the POSAL time source to a simulated clock starting at the given time.
+
+  @param[in] start_time_us  Initial value of the simulated clock, in microseconds.
+
+  @detdesc
+  Once enabled, posal_timer_get_time() returns the simulated time and periodic
+  timers expire only when the clock is advanced. Must be called before any
+  timer is started. Used by host tools to run graphs faster than real time.
+
+  @dependencies
+  None.
+ */
+void posal_timer_sim_clock_enable(uint64_t start_time_us);
+
+/**
+  Advances the simulated clock.
+
+  @param[in] duration_us  Time to advance, in microseconds.
+
+  @detdesc
+  Periodic timers that expire within the advanced duration are signaled in
+  expiry order. Expiries of the same timer within one advance are coalesced
+  into one signal.
+
+  @dependencies
+  posal_timer_sim_clock_enable() must be called first.
+ */
+void posal_timer_sim_clock_advance(uint64_t duration_us);
+
 
 /**
   Restarts the absolute one-shot timer.
@@ -377,7 +407,7 @@ void posal_utimer_expiry_cb(void *data);
 uint64_t posal_timer_get_remaining_duration(posal_timer_t p_obj);
 
 /**
-  Utility function to convert tick to timestamp as per Q-timer with 19.2MHz.
+  Utility function to convert tick to timestamp. On Linux a tick is one nanosecond.
 
   @param[in] tick_count   tick_count Tick Count by DMA..
 
@@ -54,6 +54,7 @@ INCLUDE FILES FOR MODULE
 #include "posal_globalstate.h"
 #include "posal_thread_prio.h"
 #include "posal_thread_profiling.h"
+#include "posal_trace.h"
 
 //DO NOT INCLUDE posal_internal_inline.h here as it shared libs may call inline func and
 // backward compatibility might break in case 'qurt' structs are changed.
@@ -32,6 +32,31 @@ extern "C" {
 
 typedef uint32_t posal_heap_tcm_handle_t;
 
+/** Usage statistics of a heap created with posal_memory_heapmgr_create. */
+typedef struct posal_heapmgr_stats_t
+{
+   uint32_t heap_size;
+   /**< Bytes available for allocations, excluding the heap manager's own state. */
+
+   uint32_t used_bytes;
+   /**< Bytes currently allocated, including block headers. */
+
+   uint32_t peak_used_bytes;
+   /**< Maximum of used_bytes since the heap was created. */
+
+   uint32_t largest_free_block;
+   /**< Largest allocation that can currently succeed. */
+
+   uint32_t num_used_blocks;
+   /**< Number of outstanding allocations. */
+
+   uint32_t num_free_blocks;
+   /**< Number of free blocks, a measure of fragmentation. */
+
+   uint32_t num_failed_mallocs;
+   /**< Number of allocations that failed since the heap was created. */
+} posal_heapmgr_stats_t;
+
 /**
   Initializes the heap manager for a specified heap.
 
@@ -105,6 +130,17 @@ ar_result_t posal_memory_heapmgr_create_v2(POSAL_HEAP_ID *          heap_id_ptr,
 */
 ar_result_t posal_memory_heapmgr_destroy(POSAL_HEAP_ID heap_id);
 
+/**
+  Gets the usage statistics of a heap created with posal_memory_heapmgr_create.
+
+  @param[in]  heap_id    ID of the heap.
+  @param[out] stats_ptr  Statistics of the heap.
+
+  @return
+  AR_EOK, or AR_EBADPARAM if the heap is not managed by SPF.
+*/
+ar_result_t posal_memory_heapmgr_get_stats(POSAL_HEAP_ID heap_id, posal_heapmgr_stats_t *stats_ptr);
+
 /** @} */ /* end_addtogroup posal_memory */
 
 #ifdef __cplusplus
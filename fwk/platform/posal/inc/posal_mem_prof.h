@@ -15,7 +15,6 @@ INCLUDE FILES FOR MODULE
 ========================================================================== */
 #include "ar_error_codes.h"
 #include "posal_types.h"
-#include "spf_hashtable.h"
 #include "posal_memory.h"
 #include "posal_mutex.h"
 
@@ -26,6 +25,23 @@ extern "C" {
 /* -----------------------------------------------------------------------
 ** Macro definitions
 ** ----------------------------------------------------------------------- */
+/** Threads that can count without sharing a cache line, others count in the shared table */
+#define POSAL_MEM_PROF_MAX_THREADS 64
+
+/** Heap IDs per thread, power of 2 */
+#define POSAL_MEM_PROF_IDS_PER_THREAD 64
+
+/** Allocation sites per thread, power of 2 */
+#define POSAL_MEM_PROF_SITES_PER_THREAD 32
+
+/** Heap IDs counted in the shared table, power of 2 */
+#define POSAL_MEM_PROF_SHARED_IDS 256
+
+/** Allocation sites kept for exited threads, power of 2 */
+#define POSAL_MEM_PROF_SHARED_SITES 64
+
+/** Allocation sites reported on stop */
+#define POSAL_MEM_PROF_NUM_TOP_SITES 10
 
 /* -----------------------------------------------------------------------
 ** Structure definitions
@@ -37,38 +53,72 @@ typedef struct posal_mem_prof_marker_t
    /**< Heap ID of the memory allocated */
 
    uint32_t magic_number;
-   /**< Magic number to verify mem tracking */
+   /**< Magic number to verify mem tracking, changes with every profiling start */
 }posal_mem_prof_marker_t;
 
-/**< Hash node structure to hold heap-id to memory count mapping */
-typedef struct posal_mem_prof_node_t
+/**< Memory count of a heap id */
+typedef struct posal_mem_prof_counter_t
 {
-   // Need to be first element
-   spf_hash_node_t hash_node;
-   /**< Hash node */
+   uint32_t heap_id;
+   /**< Key - heap id including the tracking id, 0 if the entry is free */
 
-   POSAL_HEAP_ID heap_id;
-   /**< Key - heap id is used as a key to hashnode */
+   int64_t mem_count;
+   /**< Value - Bytes allocated minus bytes freed. Negative in a thread that frees memory allocated by another. */
+} posal_mem_prof_counter_t;
+
+/**< Allocation count of a call site */
+typedef struct posal_mem_prof_site_t
+{
+   void *site_ptr;
+   /**< Return address of the posal_memory_malloc call, NULL if the entry is free */
 
-   uint32_t mem_count;
-   /**< Value - Count of memory allocations in Bytes */
+   uint32_t num_allocs;
+   /**< Allocations made from the site. Over-estimated by the count of the entry it replaced, if any. */
 
-} posal_mem_prof_node_t;
+   uint64_t num_bytes;
+   /**< Bytes allocated from the site since the entry was taken */
+} posal_mem_prof_site_t;
+
+/**< Counters of one thread. Only the owner thread writes them, so updates need neither lock nor atomic RMW. */
+typedef struct posal_mem_prof_thread_t
+{
+   POSAL_ALIGN(uint32_t in_use, 64);
+   /**< Set when claimed by a thread, cleared when the thread exits. Blocks don't share cache lines. */
+
+   uint32_t generation;
+   /**< Profiling session the counters belong to, the owner resets them when a new session starts */
+
+   posal_mem_prof_counter_t counters[POSAL_MEM_PROF_IDS_PER_THREAD];
+
+   posal_mem_prof_site_t sites[POSAL_MEM_PROF_SITES_PER_THREAD];
+} posal_mem_prof_thread_t;
 
 /**< Enum to indicate whether memory profiling started or not */
 typedef enum posal_mem_prof_state_t { POSAL_MEM_PROF_STOPPED = 0, POSAL_MEM_PROF_STARTED = 1 } posal_mem_prof_state_t;
 
-/**< Posal memory profiling main structure */
+/**< Posal memory profiler main structure */
 typedef struct posal_mem_prof_t
 {
-   spf_hashtable_t mem_ht;
-   /**< Hash table to hold heap id to memory count mapping */
+   posal_mem_prof_thread_t threads[POSAL_MEM_PROF_MAX_THREADS];
+   /**< Per thread counters, aggregated when queried */
+
+   posal_mem_prof_counter_t shared_counters[POSAL_MEM_PROF_SHARED_IDS];
+   /**< Counters of exited threads and threads without their own, updated with atomics */
+
+   posal_mem_prof_site_t shared_sites[POSAL_MEM_PROF_SHARED_SITES];
+   /**< Allocation sites of exited threads, updated under prof_mutex */
+
+   uint32_t num_dropped;
+   /**< Updates lost because the shared table was full */
 
    POSAL_HEAP_ID heap_id;
    /**< Heap id to be used by posal memory profiler */
 
    posal_mutex_t prof_mutex;
-   /**< Mutex to be used by posal memory profiler */
+   /**< Serializes start, stop, queries and thread exits. Never taken on malloc or free. */
+
+   uint32_t generation;
+   /**< Incremented on every start */
 
    posal_mem_prof_state_t mem_prof_status;
    /**< Flag to indicate whether profiling started or not */
@@ -91,8 +141,7 @@ typedef struct posal_mem_prof_t
 ar_result_t posal_mem_prof_init(POSAL_HEAP_ID heap_id);
 
 /**
-  Starts posal memory profiling, creates hashtable needed to store the heapid to
-  mem count mapping.
+  Starts posal memory profiling, resets the counters of the previous session.
 
   @param[in] None
 
@@ -105,8 +154,7 @@ ar_result_t posal_mem_prof_init(POSAL_HEAP_ID heap_id);
 ar_result_t posal_mem_prof_start();
 
 /**
-  Stops posal memory profiling, destroys hashtable needed to store the heapid to
-  memory count mapping.
+  Stops posal memory profiling, prints the allocation sites with the most allocations.
 
   @param[in] None
 
@@ -152,6 +200,7 @@ void posal_mem_prof_pre_process_malloc(POSAL_HEAP_ID orig_heap_id, POSAL_HEAP_ID
   @param[in] ptr              Pointer to the newly allocated memory.
   @param[in] orig_heap_id     Heap id sent by the client.
   @param[in] is_mem_tracked   Boolean to indicate of memory was tracked while allocation.
+  @param[in] site_ptr         Return address of the allocation call, for the allocation site histogram.
 
   @return
   None.
@@ -159,7 +208,7 @@ void posal_mem_prof_pre_process_malloc(POSAL_HEAP_ID orig_heap_id, POSAL_HEAP_ID
   @dependencies
   None
 */
-void posal_mem_prof_post_process_malloc(void *ptr, POSAL_HEAP_ID orig_heap_id, bool_t is_mem_tracked);
+void posal_mem_prof_post_process_malloc(void *ptr, POSAL_HEAP_ID orig_heap_id, bool_t is_mem_tracked, void *site_ptr);
 
 /**
   Extracts heapid and mem size from the ptr, updates statistics.
@@ -175,7 +224,7 @@ void posal_mem_prof_post_process_malloc(void *ptr, POSAL_HEAP_ID orig_heap_id, b
 void posal_mem_prof_process_free(void *ptr);
 
 /**
-  Updates the mem usage query asked by a client if the statistics exists.
+  Updates the mem usage query asked by a client if the statistics exists. Aggregates the counters of all threads.
 
   @param[in] heap_id         Heap id of the query.
   @param[in] mem_usage_ptr   Pointer to which query update needs to be done.
@@ -206,6 +206,50 @@ int64_t posal_thread_get_tid_v2(posal_thread_t thread_obj);
 int32_t posal_thread_get_curr_tid(void);
 int64_t posal_thread_get_curr_tid_v2(void);
 
+/**
+  Changes the core affinity of a running thread.
+
+  @param[in] thread_obj   Thread object.
+  @param[in] affinity     CPU set bit mask, bit n for core n.
+
+  @return
+  AR_EUNSUPPORTED if affinity is not supported on the platform.
+
+  @dependencies
+  Before calling this function, the object must be created and initialized.
+
+  @newpage
+*/
+ar_result_t posal_thread_set_affinity(posal_thread_t thread_obj, uint32_t affinity);
+
+/**
+  Queries the number of cores that threads can run on.
+
+  @return
+  Number of cores, at least 1.
+
+  @dependencies
+  None.
+
+  @newpage
+*/
+uint32_t posal_thread_get_num_cores(void);
+
+/**
+  Queries the cores that share the last level cache with the given core.
+
+  @param[in] core   Core index.
+
+  @return
+  CPU set bit mask of the cores sharing the cache, including the given core.
+
+  @dependencies
+  None.
+
+  @newpage
+*/
+uint32_t posal_thread_get_cache_domain(uint32_t core);
+
 /**
   Get the thread name.
 
@@ -0,0 +1,137 @@
+/**
+ * \file posal_trace.h
+ * \brief
+ *     This file contains PUBLIC utilities for runtime event tracing.
+ *
+ *     Events are written to a per-thread ring without locks. Tracing is enabled at runtime,
+ *     when disabled each trace point costs one load and one branch.
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef _POSAL_TRACE_H_
+#define _POSAL_TRACE_H_
+
+#include "ar_error_codes.h"
+#include "posal_types.h"
+#include "posal_memory.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif //__cplusplus
+
+/* -----------------------------------------------------------------------
+** Macro definitions
+** ----------------------------------------------------------------------- */
+/** Maximum number of threads that can write trace events. Events from further threads are dropped. */
+#define POSAL_TRACE_MAX_THREADS 32
+
+/** Records a trace event if tracing is enabled.
+    ctx identifies the object the event is about, arg is the event argument. */
+#define POSAL_TRACE(type, ctx, arg)                                                                                    \
+   do                                                                                                                  \
+   {                                                                                                                   \
+      if (posal_trace_enabled)                                                                                         \
+      {                                                                                                                \
+         posal_trace_record((type), (uint64_t)(uintptr_t)(ctx), (uint64_t)(uintptr_t)(arg));                          \
+      }                                                                                                                \
+   } while (0)
+
+/* -----------------------------------------------------------------------
+** Structure definitions
+** ----------------------------------------------------------------------- */
+/** Trace event types */
+typedef enum posal_trace_event_type_t
+{
+   POSAL_TRACE_TOPO_PROCESS_BEGIN = 1,
+   /**< ctx: container instance id */
+   POSAL_TRACE_TOPO_PROCESS_END,
+   /**< ctx: container instance id */
+   POSAL_TRACE_MODULE_PROCESS_BEGIN,
+   /**< ctx: module instance id, arg: container instance id */
+   POSAL_TRACE_MODULE_PROCESS_END,
+   /**< ctx: module instance id, arg: container instance id */
+   POSAL_TRACE_QUEUE_PUSH,
+   /**< ctx: queue, arg: message payload */
+   POSAL_TRACE_QUEUE_POP,
+   /**< ctx: queue, arg: message payload */
+   POSAL_TRACE_GPR_RECV,
+   /**< ctx: destination port, arg: opcode << 32 | token */
+   POSAL_TRACE_GPR_SEND,
+   /**< ctx: source port, arg: opcode of the acknowledged command << 32 | token */
+} posal_trace_event_type_t;
+
+/** Trace event */
+typedef struct posal_trace_event_t
+{
+   uint64_t ticks;
+   /**< Time of the event in HW ticks, see posal_convert_tick_to_time */
+
+   uint64_t ctx;
+   /**< Object the event is about */
+
+   uint64_t arg;
+   /**< Event argument */
+
+   uint32_t type;
+   /**< posal_trace_event_type_t */
+
+   uint32_t reserved;
+} posal_trace_event_t;
+
+/** Callback to read out the trace events, called for each event in time order per thread. */
+typedef void (*posal_trace_event_cb_t)(int64_t tid, const posal_trace_event_t *event_ptr, void *cb_ctx_ptr);
+
+/* -----------------------------------------------------------------------
+** Global variables
+** ----------------------------------------------------------------------- */
+/** TRUE when tracing is enabled. Only checked by POSAL_TRACE. */
+extern volatile bool_t posal_trace_enabled;
+
+/* -----------------------------------------------------------------------
+** Function declaration
+** ----------------------------------------------------------------------- */
+/**
+  Allocates the trace rings and enables tracing. Previously recorded events are discarded.
+  The rings are allocated on the first call only, later calls keep their size.
+
+  @param[in] num_events_per_thread   Ring size, rounded up to a power of 2. Once full the oldest
+                                     events are overwritten.
+  @param[in] heap_id                 Heap to allocate the rings from.
+
+  @return
+  Result.
+*/
+ar_result_t posal_trace_enable(uint32_t num_events_per_thread, POSAL_HEAP_ID heap_id);
+
+/**
+  Disables tracing. The recorded events are kept until the next enable or deinit.
+*/
+void posal_trace_disable(void);
+
+/**
+  Records an event in the ring of the calling thread. Use POSAL_TRACE instead of calling this directly.
+*/
+void posal_trace_record(uint32_t type, uint64_t ctx, uint64_t arg);
+
+/**
+  Reads out the recorded events. Should be called after posal_trace_disable, events written
+  while reading may be reported inconsistently.
+
+  @param[in] cb_fn        Called for each event.
+  @param[in] cb_ctx_ptr   Passed to cb_fn.
+*/
+void posal_trace_read_events(posal_trace_event_cb_t cb_fn, void *cb_ctx_ptr);
+
+/**
+  Disables tracing and frees the trace rings.
+*/
+void posal_trace_deinit(void);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
+#endif // _POSAL_TRACE_H_
@@ -124,6 +124,8 @@ ar_result_t posal_queue_push_back(posal_queue_t *q_ptr, posal_queue_element_t *p
    queue_ptr->active_tail_ptr->elem = *payload_ptr;
    queue_ptr->active_nodes++;
 
+   POSAL_TRACE(POSAL_TRACE_QUEUE_PUSH, queue_ptr, payload_ptr->q_payload_ptr);
+
    // if signaling is disabled then don't set the signal
    if (!queue_ptr->disable_signaling)
    {
@@ -161,6 +163,8 @@ ar_result_t posal_queue_pop_front(posal_queue_t *q_ptr, posal_queue_element_t *p
    // point to next entry to read
    queue_ptr->active_nodes--;
 
+   POSAL_TRACE(POSAL_TRACE_QUEUE_POP, queue_ptr, payload_ptr->q_payload_ptr);
+
 #ifdef DEBUG_POSAL_QUEUE
    uint32_t unOpcode = (uint32_t)(*payload_ptr >> 32);
    // filter out POSAL_DATA_BUFFER to avoid the flood.
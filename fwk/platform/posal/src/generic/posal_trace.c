@@ -0,0 +1,189 @@
+/**
+ * \file posal_trace.c
+ * \brief
+ *     This file contains the runtime event tracing utilities.
+ *
+ *     Each thread writing events claims one ring, keyed by its thread id. Only the owner thread
+ *     writes to a ring, so recording needs no locks: the event is written and then the write
+ *     index is published with a release store. Once full, a ring overwrites its oldest events.
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+/* =======================================================================
+INCLUDE FILES FOR MODULE
+========================================================================== */
+#include "posal.h"
+#include "posal_trace.h"
+
+/* -----------------------------------------------------------------------
+** Structure definitions
+** ----------------------------------------------------------------------- */
+typedef struct posal_trace_ring_t
+{
+   int64_t tid;
+   /**< Owner thread, 0 if the ring is free */
+
+   uint32_t write_idx;
+   /**< Number of events written, wraps around */
+
+   posal_trace_event_t *events_ptr;
+} posal_trace_ring_t;
+
+typedef struct posal_trace_t
+{
+   posal_trace_ring_t rings[POSAL_TRACE_MAX_THREADS];
+
+   uint32_t num_events_per_ring;
+   /**< Power of 2 */
+
+   posal_trace_event_t *mem_ptr;
+   /**< Events of all the rings */
+
+   POSAL_HEAP_ID heap_id;
+} posal_trace_t;
+
+/* -----------------------------------------------------------------------
+** Global variables
+** ----------------------------------------------------------------------- */
+volatile bool_t posal_trace_enabled = FALSE;
+
+static posal_trace_t posal_trace;
+
+/* =======================================================================
+**                          Function Definitions
+** ======================================================================= */
+static posal_trace_ring_t *posal_trace_get_ring(int64_t tid)
+{
+   uint64_t key   = (uint64_t)tid;
+   uint32_t start = (uint32_t)((key >> 4) ^ (key >> 16)) % POSAL_TRACE_MAX_THREADS;
+
+   for (uint32_t i = 0; i < POSAL_TRACE_MAX_THREADS; i++)
+   {
+      posal_trace_ring_t *ring_ptr = &posal_trace.rings[(start + i) % POSAL_TRACE_MAX_THREADS];
+      int64_t             owner    = __atomic_load_n(&ring_ptr->tid, __ATOMIC_ACQUIRE);
+
+      if (owner == tid)
+      {
+         return ring_ptr;
+      }
+
+      if (0 == owner)
+      {
+         int64_t expected = 0;
+         if (__atomic_compare_exchange_n(&ring_ptr->tid, &expected, tid, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) ||
+             (expected == tid))
+         {
+            return ring_ptr;
+         }
+      }
+   }
+
+   return NULL;
+}
+
+ar_result_t posal_trace_enable(uint32_t num_events_per_thread, POSAL_HEAP_ID heap_id)
+{
+   if (NULL == posal_trace.mem_ptr)
+   {
+      uint32_t num_events = 1;
+      while (num_events < num_events_per_thread)
+      {
+         num_events <<= 1;
+      }
+
+      posal_trace.mem_ptr = (posal_trace_event_t *)
+         posal_memory_malloc(num_events * POSAL_TRACE_MAX_THREADS * sizeof(posal_trace_event_t), heap_id);
+      if (NULL == posal_trace.mem_ptr)
+      {
+         AR_MSG(DBG_ERROR_PRIO, "posal_trace: failed to allocate %lu events per thread", num_events);
+         return AR_ENOMEMORY;
+      }
+
+      posal_trace.num_events_per_ring = num_events;
+      posal_trace.heap_id             = heap_id;
+      for (uint32_t i = 0; i < POSAL_TRACE_MAX_THREADS; i++)
+      {
+         posal_trace.rings[i].events_ptr = posal_trace.mem_ptr + (i * num_events);
+      }
+   }
+   else if (num_events_per_thread > posal_trace.num_events_per_ring)
+   {
+      // rings may be in use by threads that just saw the enable flag, they are not resized.
+      AR_MSG(DBG_HIGH_PRIO,
+             "posal_trace: keeping %lu events per thread, requested %lu",
+             posal_trace.num_events_per_ring,
+             num_events_per_thread);
+   }
+
+   for (uint32_t i = 0; i < POSAL_TRACE_MAX_THREADS; i++)
+   {
+      __atomic_store_n(&posal_trace.rings[i].write_idx, 0, __ATOMIC_RELAXED);
+   }
+
+   __atomic_store_n(&posal_trace_enabled, TRUE, __ATOMIC_RELEASE);
+   return AR_EOK;
+}
+
+void posal_trace_disable(void)
+{
+   __atomic_store_n(&posal_trace_enabled, FALSE, __ATOMIC_RELEASE);
+}
+
+void posal_trace_record(uint32_t type, uint64_t ctx, uint64_t arg)
+{
+   posal_trace_ring_t *ring_ptr = posal_trace_get_ring(posal_thread_get_curr_tid_v2());
+   if (NULL == ring_ptr)
+   {
+      return;
+   }
+
+   uint32_t             idx       = ring_ptr->write_idx;
+   posal_trace_event_t *event_ptr = &ring_ptr->events_ptr[idx & (posal_trace.num_events_per_ring - 1)];
+
+   event_ptr->ticks = posal_timer_get_hw_ticks();
+   event_ptr->ctx   = ctx;
+   event_ptr->arg   = arg;
+   event_ptr->type  = type;
+
+   __atomic_store_n(&ring_ptr->write_idx, idx + 1, __ATOMIC_RELEASE);
+}
+
+void posal_trace_read_events(posal_trace_event_cb_t cb_fn, void *cb_ctx_ptr)
+{
+   if ((NULL == posal_trace.mem_ptr) || (NULL == cb_fn))
+   {
+      return;
+   }
+
+   for (uint32_t i = 0; i < POSAL_TRACE_MAX_THREADS; i++)
+   {
+      posal_trace_ring_t *ring_ptr = &posal_trace.rings[i];
+      int64_t             tid      = __atomic_load_n(&ring_ptr->tid, __ATOMIC_ACQUIRE);
+      uint32_t            end      = __atomic_load_n(&ring_ptr->write_idx, __ATOMIC_ACQUIRE);
+      uint32_t            start    = (end > posal_trace.num_events_per_ring) ? (end - posal_trace.num_events_per_ring) : 0;
+
+      if (0 == tid)
+      {
+         continue;
+      }
+
+      for (uint32_t idx = start; idx != end; idx++)
+      {
+         cb_fn(tid, &ring_ptr->events_ptr[idx & (posal_trace.num_events_per_ring - 1)], cb_ctx_ptr);
+      }
+   }
+}
+
+void posal_trace_deinit(void)
+{
+   posal_trace_disable();
+
+   if (posal_trace.mem_ptr)
+   {
+      posal_memory_free(posal_trace.mem_ptr);
+   }
+   memset(&posal_trace, 0, sizeof(posal_trace));
+}
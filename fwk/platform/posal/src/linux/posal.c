@@ -18,6 +18,9 @@ INCLUDE FILES FOR MODULE
 #include "posal_globalstate.h"
 #include "posal_mem_prof.h"
 #include "posal_power_mgr.h"
+#if defined(POSAL_DATA_LOG_FILE_SINK)
+#include "posal_data_log_i.h"
+#endif
 
 /*--------------------------------------------------------------*/
 /* Macro definitions                                            */
@@ -86,5 +89,8 @@ void posal_init(void)
 
 void posal_deinit(void)
 {
+#if defined(POSAL_DATA_LOG_FILE_SINK)
+   posal_data_log_file_sink_deinit();
+#endif
 
 }
@@ -16,7 +16,9 @@ INCLUDE FILES FOR MODULE
 #include "posal.h"
 #include "capi_types.h"
 #include "dls_log_pkt_hdr_api.h"
-#if defined(DLS_DATA_LOGGING)
+#if defined(POSAL_DATA_LOG_FILE_SINK)
+// file sink functions are declared in posal_data_log_i.h
+#elif defined(DLS_DATA_LOGGING)
 #include "dls.h"
 #else
 #include "log.h"
@@ -30,8 +32,14 @@ typedef union log_pkt_header_internal_t
    dls_log_pkt_bitstream_data_t bitstream;
 } log_pkt_header_internal_t;
 
+// Enable POSAL_DATA_LOG_FILE_SINK to write the log packets to a local file instead of DIAG/DLS.
+#if defined(POSAL_DATA_LOG_FILE_SINK)
+#define log_alloc posal_data_log_file_sink_acquire
+#define log_commit posal_data_log_file_sink_commit
+#define log_free posal_data_log_file_sink_free
+#define log_status posal_data_log_file_sink_log_code_status
 // Enable DLS_DATA_LOGGING on platforms where DIAG is not supported and Data Logging Service (DLS) is used.
-#if defined(DLS_DATA_LOGGING)
+#elif defined(DLS_DATA_LOGGING)
 #define log_alloc dls_acquire_buffer
 #define log_commit dls_commit_buffer
 #define log_free dls_log_buf_free
@@ -0,0 +1,356 @@
+/**
+ *  \file posal_data_log_file_sink.c
+ * \brief
+ *  	This file contains a local file backend for data logging on Linux.
+ *
+ *  Log packets are acquired in place from a ring shared by all the logging threads, filled and
+ *  committed by the caller. A writer thread drains the committed packets in ring order and appends
+ *  them to a file in batches. Packets are written back to back, each starting with dls_log_hdr_type,
+ *  which is the same framing DLS clients receive.
+ *
+ *  The logging threads never wait for the file IO: if the ring is full the packet is dropped and
+ *  counted, and the data logging caller accounts for it through the sequence number.
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+/* =======================================================================
+INCLUDE FILES FOR MODULE
+========================================================================== */
+#include "posal_data_log_i.h"
+#include "posal.h"
+#include "dls_log_pkt_hdr_api.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*==========================================================================
+  Macro definitions
+  ========================================================================== */
+/* File the log packets are written to, can be overridden with the environment variable. */
+#define FILE_SINK_PATH_ENV "SPF_DATA_LOG_FILE"
+#define FILE_SINK_DEFAULT_PATH "/tmp/spf_data_log.bin"
+
+/* Size of the ring shared by all the taps. */
+#define FILE_SINK_RING_SIZE (1024 * 1024)
+
+/* Writer thread wakes up at least this often, and right away once the ring is half full. */
+#define FILE_SINK_DRAIN_PERIOD_MS 20
+
+/* stdio buffer used to batch the file writes. */
+#define FILE_SINK_IO_BUF_SIZE (64 * 1024)
+
+#define FILE_SINK_ALIGN_8(x) (((x) + 7) & (~7))
+
+/*==========================================================================
+  Structure definitions
+  ========================================================================== */
+typedef enum file_sink_rec_state_t
+{
+   FILE_SINK_REC_ACQUIRED = 1,
+   FILE_SINK_REC_COMMITTED,
+   FILE_SINK_REC_FREED,
+   FILE_SINK_REC_PAD
+} file_sink_rec_state_t;
+
+/* Header of every record in the ring, followed by the log packet. */
+typedef struct file_sink_rec_hdr_t
+{
+   uint32_t size;
+   /**< Record size in bytes including this header, multiple of 8. */
+
+   uint32_t state;
+   /**< file_sink_rec_state_t */
+} file_sink_rec_hdr_t;
+
+typedef struct posal_data_log_file_sink_t
+{
+   pthread_mutex_t lock;
+   pthread_cond_t  cond;
+   pthread_t       writer_thread;
+   FILE *          file_ptr;
+   int8_t *        ring_ptr;
+   uint32_t        head;
+   /**< Offset at which the next record is acquired. */
+   uint32_t        tail;
+   /**< Offset of the oldest record not yet drained. */
+   uint32_t        used_bytes;
+   /**< Bytes between tail and head, including the padding at the end of the ring. */
+   bool_t          is_running;
+   uint32_t        num_pkts_written;
+   uint32_t        num_pkts_dropped;
+   uint64_t        num_bytes_written;
+} posal_data_log_file_sink_t;
+
+static posal_data_log_file_sink_t g_file_sink;
+static pthread_once_t             g_file_sink_once = PTHREAD_ONCE_INIT;
+
+/* ----------------------------------------------------------------------------
+ * Function Definitions
+ * ------------------------------------------------------------------------- */
+static file_sink_rec_hdr_t *file_sink_get_rec(uint32_t offset)
+{
+   return (file_sink_rec_hdr_t *)(g_file_sink.ring_ptr + offset);
+}
+
+static uint32_t file_sink_next_offset(uint32_t offset, uint32_t size)
+{
+   offset += size;
+   return (offset >= FILE_SINK_RING_SIZE) ? 0 : offset;
+}
+
+/* Writes the finalized records in [start, start + num_bytes) to the file. Called without the lock, producers
+ * never touch records behind the head and the drained range is not reused until the tail is advanced. */
+static void file_sink_write_records(uint32_t start, uint32_t num_bytes)
+{
+   uint32_t offset = start;
+   while (num_bytes)
+   {
+      file_sink_rec_hdr_t *rec_ptr = file_sink_get_rec(offset);
+      if (FILE_SINK_REC_COMMITTED == rec_ptr->state)
+      {
+         dls_log_hdr_type *log_hdr_ptr = (dls_log_hdr_type *)(rec_ptr + 1);
+         if (log_hdr_ptr->len == fwrite(log_hdr_ptr, 1, log_hdr_ptr->len, g_file_sink.file_ptr))
+         {
+            g_file_sink.num_pkts_written++;
+            g_file_sink.num_bytes_written += log_hdr_ptr->len;
+         }
+         else
+         {
+            g_file_sink.num_pkts_dropped++;
+         }
+      }
+      num_bytes -= rec_ptr->size;
+      offset = file_sink_next_offset(offset, rec_ptr->size);
+   }
+   fflush(g_file_sink.file_ptr);
+}
+
+static void *file_sink_writer_thread_entry(void *arg_ptr)
+{
+   bool_t is_tail_pending = FALSE;
+
+   pthread_mutex_lock(&g_file_sink.lock);
+   while (1)
+   {
+      // Wait unless the ring is filling up. Also wait if the oldest record is still being filled, else the
+      // writer would spin holding the lock which the producer needs to commit it.
+      if (g_file_sink.is_running && ((g_file_sink.used_bytes < (FILE_SINK_RING_SIZE / 2)) || is_tail_pending))
+      {
+         struct timespec abs_time;
+         clock_gettime(CLOCK_REALTIME, &abs_time);
+         abs_time.tv_nsec += FILE_SINK_DRAIN_PERIOD_MS * 1000000L;
+         if (abs_time.tv_nsec >= 1000000000L)
+         {
+            abs_time.tv_sec++;
+            abs_time.tv_nsec -= 1000000000L;
+         }
+         pthread_cond_timedwait(&g_file_sink.cond, &g_file_sink.lock, &abs_time);
+      }
+
+      // Find the records from the tail which are done, stop at the first one still being filled.
+      uint32_t start     = g_file_sink.tail;
+      uint32_t offset    = start;
+      uint32_t num_bytes = 0;
+      while (num_bytes < g_file_sink.used_bytes)
+      {
+         file_sink_rec_hdr_t *rec_ptr = file_sink_get_rec(offset);
+         if (FILE_SINK_REC_ACQUIRED == rec_ptr->state)
+         {
+            break;
+         }
+         num_bytes += rec_ptr->size;
+         offset = file_sink_next_offset(offset, rec_ptr->size);
+      }
+
+      if (!g_file_sink.is_running && (0 == num_bytes))
+      {
+         break;
+      }
+      is_tail_pending = (0 == num_bytes) ? TRUE : FALSE;
+
+      if (num_bytes)
+      {
+         pthread_mutex_unlock(&g_file_sink.lock);
+         file_sink_write_records(start, num_bytes);
+         pthread_mutex_lock(&g_file_sink.lock);
+
+         g_file_sink.tail = offset;
+         g_file_sink.used_bytes -= num_bytes;
+      }
+   }
+   pthread_mutex_unlock(&g_file_sink.lock);
+
+   return NULL;
+}
+
+static void posal_data_log_file_sink_init(void)
+{
+   const char *path_ptr = getenv(FILE_SINK_PATH_ENV);
+   if (NULL == path_ptr)
+   {
+      path_ptr = FILE_SINK_DEFAULT_PATH;
+   }
+
+   pthread_mutex_init(&g_file_sink.lock, NULL);
+   pthread_cond_init(&g_file_sink.cond, NULL);
+
+   if (NULL == (g_file_sink.file_ptr = fopen(path_ptr, "wb")))
+   {
+      AR_MSG(DBG_ERROR_PRIO, "Data log file sink: Failed to open %s, logging is disabled", path_ptr);
+      return;
+   }
+   setvbuf(g_file_sink.file_ptr, NULL, _IOFBF, FILE_SINK_IO_BUF_SIZE);
+
+   if (NULL == (g_file_sink.ring_ptr = (int8_t *)posal_memory_malloc(FILE_SINK_RING_SIZE, POSAL_HEAP_DEFAULT)))
+   {
+      AR_MSG(DBG_ERROR_PRIO, "Data log file sink: Failed to allocate the ring, logging is disabled");
+      fclose(g_file_sink.file_ptr);
+      g_file_sink.file_ptr = NULL;
+      return;
+   }
+
+   g_file_sink.is_running = TRUE;
+   if (0 != pthread_create(&g_file_sink.writer_thread, NULL, file_sink_writer_thread_entry, NULL))
+   {
+      AR_MSG(DBG_ERROR_PRIO, "Data log file sink: Failed to create the writer thread, logging is disabled");
+      g_file_sink.is_running = FALSE;
+      posal_memory_free(g_file_sink.ring_ptr);
+      g_file_sink.ring_ptr = NULL;
+      fclose(g_file_sink.file_ptr);
+      g_file_sink.file_ptr = NULL;
+      return;
+   }
+
+   AR_MSG(DBG_HIGH_PRIO, "Data log file sink: Logging to %s, ring size %lu", path_ptr, FILE_SINK_RING_SIZE);
+}
+
+void posal_data_log_file_sink_deinit(void)
+{
+   pthread_mutex_lock(&g_file_sink.lock);
+   if (!g_file_sink.is_running)
+   {
+      pthread_mutex_unlock(&g_file_sink.lock);
+      return;
+   }
+   g_file_sink.is_running = FALSE;
+   pthread_cond_signal(&g_file_sink.cond);
+   pthread_mutex_unlock(&g_file_sink.lock);
+
+   // Writer drains the committed packets before exiting.
+   pthread_join(g_file_sink.writer_thread, NULL);
+
+   AR_MSG(DBG_HIGH_PRIO,
+          "Data log file sink: Done, packets written %lu, dropped %lu, bytes written %llu",
+          g_file_sink.num_pkts_written,
+          g_file_sink.num_pkts_dropped,
+          g_file_sink.num_bytes_written);
+
+   fclose(g_file_sink.file_ptr);
+   g_file_sink.file_ptr = NULL;
+   posal_memory_free(g_file_sink.ring_ptr);
+   g_file_sink.ring_ptr = NULL;
+}
+
+bool_t posal_data_log_file_sink_log_code_status(uint32_t log_code)
+{
+   pthread_once(&g_file_sink_once, posal_data_log_file_sink_init);
+   return g_file_sink.is_running;
+}
+
+void *posal_data_log_file_sink_acquire(uint16_t log_code, uint32_t log_pkt_size)
+{
+   pthread_once(&g_file_sink_once, posal_data_log_file_sink_init);
+
+   uint32_t rec_size = FILE_SINK_ALIGN_8(sizeof(file_sink_rec_hdr_t) + log_pkt_size);
+   if ((log_pkt_size > MAX_LOG_PKT_SIZE) || (log_pkt_size < sizeof(dls_log_hdr_type)))
+   {
+      return NULL;
+   }
+
+   pthread_mutex_lock(&g_file_sink.lock);
+   if (!g_file_sink.is_running)
+   {
+      pthread_mutex_unlock(&g_file_sink.lock);
+      return NULL;
+   }
+
+   if (0 == g_file_sink.used_bytes)
+   {
+      g_file_sink.head = 0;
+      g_file_sink.tail = 0;
+   }
+
+   // Records are contiguous, if the record doesn't fit before the end of the ring pad to the end and wrap.
+   bool_t   is_wrapped = (g_file_sink.head < g_file_sink.tail) || (FILE_SINK_RING_SIZE == g_file_sink.used_bytes);
+   uint32_t pad_size   = 0;
+   if (!is_wrapped && ((FILE_SINK_RING_SIZE - g_file_sink.head) < rec_size))
+   {
+      pad_size = FILE_SINK_RING_SIZE - g_file_sink.head;
+   }
+
+   if ((g_file_sink.used_bytes + pad_size + rec_size) > FILE_SINK_RING_SIZE)
+   {
+      g_file_sink.num_pkts_dropped++;
+      pthread_mutex_unlock(&g_file_sink.lock);
+      return NULL;
+   }
+
+   if (pad_size)
+   {
+      file_sink_rec_hdr_t *pad_ptr = file_sink_get_rec(g_file_sink.head);
+      pad_ptr->size                = pad_size;
+      pad_ptr->state               = FILE_SINK_REC_PAD;
+      g_file_sink.head             = 0;
+      g_file_sink.used_bytes += pad_size;
+   }
+
+   file_sink_rec_hdr_t *rec_ptr = file_sink_get_rec(g_file_sink.head);
+   rec_ptr->size                = rec_size;
+   rec_ptr->state               = FILE_SINK_REC_ACQUIRED;
+   g_file_sink.head             = file_sink_next_offset(g_file_sink.head, rec_size);
+   g_file_sink.used_bytes += rec_size;
+   pthread_mutex_unlock(&g_file_sink.lock);
+
+   // populate the log_hdr_type information, same as DLS.
+   dls_log_hdr_type *hdr_ptr = (dls_log_hdr_type *)(rec_ptr + 1);
+   uint64_t          ts      = posal_timer_get_time();
+   hdr_ptr->len              = (uint16_t)log_pkt_size;
+   hdr_ptr->code             = log_code;
+   hdr_ptr->ts_lsw           = (uint32_t)ts;
+   hdr_ptr->ts_msw           = (uint32_t)(ts >> 32);
+
+   return hdr_ptr;
+}
+
+static void file_sink_release(void *log_pkt_ptr, file_sink_rec_state_t state)
+{
+   if (NULL == log_pkt_ptr)
+   {
+      return;
+   }
+
+   file_sink_rec_hdr_t *rec_ptr = ((file_sink_rec_hdr_t *)log_pkt_ptr) - 1;
+
+   pthread_mutex_lock(&g_file_sink.lock);
+   rec_ptr->state = state;
+   if (g_file_sink.used_bytes >= (FILE_SINK_RING_SIZE / 2))
+   {
+      pthread_cond_signal(&g_file_sink.cond);
+   }
+   pthread_mutex_unlock(&g_file_sink.lock);
+}
+
+uint32_t posal_data_log_file_sink_commit(void *log_pkt_ptr)
+{
+   file_sink_release(log_pkt_ptr, FILE_SINK_REC_COMMITTED);
+   return AR_EOK;
+}
+
+void posal_data_log_file_sink_free(void *log_pkt_ptr)
+{
+   file_sink_release(log_pkt_ptr, FILE_SINK_REC_FREED);
+}
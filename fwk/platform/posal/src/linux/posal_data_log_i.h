@@ -23,7 +23,11 @@
  * ------------------------------------------------------------------------- */
 // diag max packet size is 8736 but diag adds their header which is around 104 bytes so we cannot use entire 8736
 // bytes hence we are subtracting 200 bytes from 8736 which gives the max num of bytes available for spf to use .
-#ifdef _DIAG_MAX_TX_PKT_SIZE
+#if defined(POSAL_DATA_LOG_FILE_SINK)
+// packets are not bound by the diag limit when logged to a local file, large enough for 10ms of 48kHz 8ch 32bit.
+// limited by the 16 bit length in dls_log_hdr_type.
+#define MAX_LOG_PKT_SIZE (16 * 1024)
+#elif defined(_DIAG_MAX_TX_PKT_SIZE)
 #define MAX_LOG_PKT_SIZE (_DIAG_MAX_TX_PKT_SIZE - 200)
 #else
 // retaining 3360 for variants which do not diag macro defined
@@ -70,4 +74,13 @@
 //#define POSAL_PINE_VERSION_PCM_V1 0x44
 #define POSAL_PINE_VERSION_PCM_V2 0x59
 
+#if defined(POSAL_DATA_LOG_FILE_SINK)
+/* Local file backend, see posal_data_log_file_sink.c */
+void    *posal_data_log_file_sink_acquire(uint16_t log_code, uint32_t log_pkt_size);
+uint32_t posal_data_log_file_sink_commit(void *log_pkt_ptr);
+void     posal_data_log_file_sink_free(void *log_pkt_ptr);
+bool_t   posal_data_log_file_sink_log_code_status(uint32_t log_code);
+void     posal_data_log_file_sink_deinit(void);
+#endif // POSAL_DATA_LOG_FILE_SINK
+
 #endif // POSAL_DATA_LOG_I_H
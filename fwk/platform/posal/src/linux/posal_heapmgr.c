@@ -0,0 +1,583 @@
+/**
+ * \file posal_heapmgr.c
+ * \brief
+ *     This file contains the heap manager for heaps created on caller provided memory regions.
+ *
+ *     Each heap is a two level segregated fit (TLSF) allocator. Free blocks are kept in lists indexed by
+ *     the power of 2 of their size (first level) and a linear subdivision of that range (second level),
+ *     with a bitmap per level. Malloc and free take constant time: a free list is found with two bit scans,
+ *     and a freed block is merged with its free neighbours right away.
+ *
+ *     The heap manager state is placed at the start of the region and the block headers are in-band.
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+/* ----------------------------------------------------------------------------
+ * Include Files
+ * ------------------------------------------------------------------------- */
+#include "posal.h"
+#include "posal_internal.h"
+#include "posal_globalstate.h"
+#include "posal_heapmgr.h"
+#include "posal_memory_i.h"
+#include <pthread.h>
+
+/* ----------------------------------------------------------------------------
+ * Global Declarations/Definitions
+ * ------------------------------------------------------------------------- */
+#define POSAL_HEAPMGR_ALIGN_LOG2 3
+#define POSAL_HEAPMGR_ALIGN (1u << POSAL_HEAPMGR_ALIGN_LOG2)
+
+/* Second level subdivisions of each power of 2 */
+#define POSAL_HEAPMGR_SL_LOG2 4
+#define POSAL_HEAPMGR_SL_COUNT (1u << POSAL_HEAPMGR_SL_LOG2)
+
+/* Blocks smaller than this are all in the first level list 0, split linearly */
+#define POSAL_HEAPMGR_FL_SHIFT (POSAL_HEAPMGR_SL_LOG2 + POSAL_HEAPMGR_ALIGN_LOG2)
+#define POSAL_HEAPMGR_SMALL_BLOCK_SIZE (1u << POSAL_HEAPMGR_FL_SHIFT)
+
+/* Block sizes are 32 bit */
+#define POSAL_HEAPMGR_FL_COUNT (32 - POSAL_HEAPMGR_FL_SHIFT + 1)
+
+#define POSAL_HEAPMGR_BLOCK_FREE 0x1
+#define POSAL_HEAPMGR_PREV_BLOCK_FREE 0x2
+
+#define POSAL_HEAPMGR_MAX_LEAKS_TO_PRINT 16
+
+#define POSAL_HEAPMGR_ALIGN_UP(x) (((x) + (POSAL_HEAPMGR_ALIGN - 1)) & ~((uint64_t)POSAL_HEAPMGR_ALIGN - 1))
+#define POSAL_HEAPMGR_ALIGN_DOWN(x) ((x) & ~((uint64_t)POSAL_HEAPMGR_ALIGN - 1))
+
+typedef struct posal_heapmgr_block_t posal_heapmgr_block_t;
+
+struct posal_heapmgr_block_t
+{
+   posal_heapmgr_block_t *prev_phys_ptr;
+   /**< Block before this one in memory, valid only if POSAL_HEAPMGR_PREV_BLOCK_FREE is set */
+
+   uint32_t size;
+   /**< Payload size in bytes, multiple of POSAL_HEAPMGR_ALIGN */
+
+   uint32_t flags;
+   /**< POSAL_HEAPMGR_BLOCK_FREE, POSAL_HEAPMGR_PREV_BLOCK_FREE */
+
+   posal_heapmgr_block_t *next_free_ptr;
+   /**< Free list links, valid only for free blocks. They are in the payload of the block. */
+
+   posal_heapmgr_block_t *prev_free_ptr;
+};
+
+#define POSAL_HEAPMGR_BLOCK_HDR_SIZE ((uint32_t)offsetof(posal_heapmgr_block_t, next_free_ptr))
+#define POSAL_HEAPMGR_MIN_BLOCK_SIZE ((uint32_t)sizeof(posal_heapmgr_block_t) - POSAL_HEAPMGR_BLOCK_HDR_SIZE)
+
+typedef struct posal_heapmgr_t
+{
+   pthread_mutex_t lock;
+   /**< Priority inheriting, so that RT threads are not held up by a lower priority allocation */
+
+   uint32_t fl_bitmap;
+   /**< Bit per first level with a non-empty list */
+
+   uint32_t sl_bitmap[POSAL_HEAPMGR_FL_COUNT];
+   /**< Bit per non-empty second level list */
+
+   posal_heapmgr_block_t *free_lists[POSAL_HEAPMGR_FL_COUNT][POSAL_HEAPMGR_SL_COUNT];
+
+   posal_heapmgr_block_t *first_block_ptr;
+
+   posal_heapmgr_block_t *last_block_ptr;
+   /**< Zero size used block at the end of the region, so that every block has a next block */
+
+   POSAL_HEAP_ID heap_id;
+   /**< Actual heap ID */
+
+   posal_heapmgr_stats_t stats;
+} posal_heapmgr_t;
+
+extern posal_heap_table_t posal_heap_table[POSAL_HEAP_MGR_MAX_NUM_HEAPS];
+
+/* Number of heaps managed by SPF, lets free skip the heap table lookup when there are none */
+static uint32_t posal_heapmgr_num_heaps = 0;
+
+/* Serializes heap table updates */
+static pthread_mutex_t posal_heapmgr_table_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* -------------------------------------------------------------------------
+ * Function Definitions
+ * ------------------------------------------------------------------------- */
+static inline uint32_t posal_heapmgr_fls(uint32_t x)
+{
+   return 31 - __builtin_clz(x);
+}
+
+static inline uint32_t posal_heapmgr_ffs(uint32_t x)
+{
+   return __builtin_ctz(x);
+}
+
+static inline uint8_t *posal_heapmgr_block_payload(posal_heapmgr_block_t *block_ptr)
+{
+   return ((uint8_t *)block_ptr) + POSAL_HEAPMGR_BLOCK_HDR_SIZE;
+}
+
+static inline posal_heapmgr_block_t *posal_heapmgr_block_from_payload(void *ptr)
+{
+   return (posal_heapmgr_block_t *)(((uint8_t *)ptr) - POSAL_HEAPMGR_BLOCK_HDR_SIZE);
+}
+
+static inline posal_heapmgr_block_t *posal_heapmgr_next_phys_block(posal_heapmgr_block_t *block_ptr)
+{
+   return (posal_heapmgr_block_t *)(posal_heapmgr_block_payload(block_ptr) + block_ptr->size);
+}
+
+static inline void posal_heapmgr_mapping_insert(uint32_t size, uint32_t *fl_ptr, uint32_t *sl_ptr)
+{
+   if (size < POSAL_HEAPMGR_SMALL_BLOCK_SIZE)
+   {
+      *fl_ptr = 0;
+      *sl_ptr = size / (POSAL_HEAPMGR_SMALL_BLOCK_SIZE / POSAL_HEAPMGR_SL_COUNT);
+   }
+   else
+   {
+      uint32_t fl = posal_heapmgr_fls(size);
+      *sl_ptr     = (size >> (fl - POSAL_HEAPMGR_SL_LOG2)) ^ POSAL_HEAPMGR_SL_COUNT;
+      *fl_ptr     = fl - (POSAL_HEAPMGR_FL_SHIFT - 1);
+   }
+}
+
+/* Rounds the size up to the next list, so that any block of that list fits. Returns FALSE on overflow. */
+static inline bool_t posal_heapmgr_mapping_search(uint32_t size, uint32_t *fl_ptr, uint32_t *sl_ptr)
+{
+   uint64_t rounded_size = size;
+   if (size >= POSAL_HEAPMGR_SMALL_BLOCK_SIZE)
+   {
+      rounded_size += (1u << (posal_heapmgr_fls(size) - POSAL_HEAPMGR_SL_LOG2)) - 1;
+      if (rounded_size > UINT32_MAX)
+      {
+         return FALSE;
+      }
+   }
+   posal_heapmgr_mapping_insert((uint32_t)rounded_size, fl_ptr, sl_ptr);
+   return TRUE;
+}
+
+static inline posal_heapmgr_block_t *posal_heapmgr_find_free_block(posal_heapmgr_t *mgr_ptr,
+                                                                   uint32_t        *fl_ptr,
+                                                                   uint32_t        *sl_ptr)
+{
+   uint32_t fl     = *fl_ptr;
+   uint32_t sl_map = mgr_ptr->sl_bitmap[fl] & (~0u << *sl_ptr);
+   if (0 == sl_map)
+   {
+      uint32_t fl_map = (fl + 1 < POSAL_HEAPMGR_FL_COUNT) ? (mgr_ptr->fl_bitmap & (~0u << (fl + 1))) : 0;
+      if (0 == fl_map)
+      {
+         return NULL;
+      }
+      fl     = posal_heapmgr_ffs(fl_map);
+      sl_map = mgr_ptr->sl_bitmap[fl];
+   }
+
+   *fl_ptr = fl;
+   *sl_ptr = posal_heapmgr_ffs(sl_map);
+   return mgr_ptr->free_lists[fl][*sl_ptr];
+}
+
+static inline void posal_heapmgr_remove_free_block(posal_heapmgr_t *mgr_ptr, posal_heapmgr_block_t *block_ptr)
+{
+   uint32_t fl, sl;
+   posal_heapmgr_mapping_insert(block_ptr->size, &fl, &sl);
+
+   if (block_ptr->next_free_ptr)
+   {
+      block_ptr->next_free_ptr->prev_free_ptr = block_ptr->prev_free_ptr;
+   }
+   if (block_ptr->prev_free_ptr)
+   {
+      block_ptr->prev_free_ptr->next_free_ptr = block_ptr->next_free_ptr;
+   }
+   else
+   {
+      mgr_ptr->free_lists[fl][sl] = block_ptr->next_free_ptr;
+      if (NULL == block_ptr->next_free_ptr)
+      {
+         mgr_ptr->sl_bitmap[fl] &= ~(1u << sl);
+         if (0 == mgr_ptr->sl_bitmap[fl])
+         {
+            mgr_ptr->fl_bitmap &= ~(1u << fl);
+         }
+      }
+   }
+
+   mgr_ptr->stats.num_free_blocks--;
+}
+
+static inline void posal_heapmgr_insert_free_block(posal_heapmgr_t *mgr_ptr, posal_heapmgr_block_t *block_ptr)
+{
+   uint32_t fl, sl;
+   posal_heapmgr_mapping_insert(block_ptr->size, &fl, &sl);
+
+   posal_heapmgr_block_t *head_ptr = mgr_ptr->free_lists[fl][sl];
+   block_ptr->next_free_ptr        = head_ptr;
+   block_ptr->prev_free_ptr        = NULL;
+   if (head_ptr)
+   {
+      head_ptr->prev_free_ptr = block_ptr;
+   }
+   mgr_ptr->free_lists[fl][sl] = block_ptr;
+   mgr_ptr->sl_bitmap[fl] |= (1u << sl);
+   mgr_ptr->fl_bitmap |= (1u << fl);
+
+   mgr_ptr->stats.num_free_blocks++;
+}
+
+static void posal_heapmgr_update_used_bytes(posal_heapmgr_t *mgr_ptr, int64_t delta)
+{
+   mgr_ptr->stats.used_bytes = (uint32_t)((int64_t)mgr_ptr->stats.used_bytes + delta);
+   if (mgr_ptr->stats.used_bytes > mgr_ptr->stats.peak_used_bytes)
+   {
+      mgr_ptr->stats.peak_used_bytes = mgr_ptr->stats.used_bytes;
+   }
+
+   posal_globalstate.avs_stats[mgr_ptr->heap_id].curr_heap = mgr_ptr->stats.used_bytes;
+   posal_globalstate.avs_stats[mgr_ptr->heap_id].peak_heap = mgr_ptr->stats.peak_used_bytes;
+}
+
+static posal_heapmgr_t *posal_heapmgr_init(POSAL_HEAP_ID heap_id, void *heap_start_ptr, uint32_t heap_size)
+{
+   uint64_t start_addr = (uint64_t)(uintptr_t)heap_start_ptr;
+   uint64_t end_addr   = POSAL_HEAPMGR_ALIGN_DOWN(start_addr + heap_size);
+   uint64_t mgr_addr   = POSAL_HEAPMGR_ALIGN_UP(start_addr);
+   uint64_t first_addr = POSAL_HEAPMGR_ALIGN_UP(mgr_addr + sizeof(posal_heapmgr_t));
+
+   // first block, at least one minimum size payload and the last block header
+   if (first_addr + POSAL_HEAPMGR_BLOCK_HDR_SIZE + POSAL_HEAPMGR_MIN_BLOCK_SIZE + POSAL_HEAPMGR_BLOCK_HDR_SIZE >
+       end_addr)
+   {
+      return NULL;
+   }
+
+   posal_heapmgr_t *mgr_ptr = (posal_heapmgr_t *)(uintptr_t)mgr_addr;
+   memset(mgr_ptr, 0, sizeof(*mgr_ptr));
+
+   pthread_mutexattr_t attr;
+   pthread_mutexattr_init(&attr);
+   pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+   pthread_mutex_init(&mgr_ptr->lock, &attr);
+   pthread_mutexattr_destroy(&attr);
+
+   posal_heapmgr_block_t *first_ptr = (posal_heapmgr_block_t *)(uintptr_t)first_addr;
+   posal_heapmgr_block_t *last_ptr  = (posal_heapmgr_block_t *)(uintptr_t)(end_addr - POSAL_HEAPMGR_BLOCK_HDR_SIZE);
+
+   first_ptr->prev_phys_ptr = NULL;
+   first_ptr->size          = (uint32_t)(((uint8_t *)last_ptr) - posal_heapmgr_block_payload(first_ptr));
+   first_ptr->flags         = POSAL_HEAPMGR_BLOCK_FREE;
+
+   last_ptr->prev_phys_ptr = first_ptr;
+   last_ptr->size          = 0;
+   last_ptr->flags         = POSAL_HEAPMGR_PREV_BLOCK_FREE;
+
+   mgr_ptr->first_block_ptr = first_ptr;
+   mgr_ptr->last_block_ptr  = last_ptr;
+   mgr_ptr->heap_id         = heap_id;
+   mgr_ptr->stats.heap_size = first_ptr->size + POSAL_HEAPMGR_BLOCK_HDR_SIZE;
+
+   posal_heapmgr_insert_free_block(mgr_ptr, first_ptr);
+
+   return mgr_ptr;
+}
+
+void *posal_heapmgr_malloc(uint32_t heap_table_idx, uint32_t bytes)
+{
+   posal_heapmgr_t *mgr_ptr = (posal_heapmgr_t *)posal_heap_table[heap_table_idx].heapmgr_ptr;
+   if ((NULL == mgr_ptr) || (0 == bytes) || (bytes > UINT32_MAX - POSAL_HEAPMGR_ALIGN))
+   {
+      return NULL;
+   }
+
+   uint32_t size = (uint32_t)POSAL_HEAPMGR_ALIGN_UP(bytes);
+   size          = MAX(size, POSAL_HEAPMGR_MIN_BLOCK_SIZE);
+
+   pthread_mutex_lock(&mgr_ptr->lock);
+
+   uint32_t               fl = 0, sl = 0;
+   posal_heapmgr_block_t *block_ptr = NULL;
+   if (posal_heapmgr_mapping_search(size, &fl, &sl) && (fl < POSAL_HEAPMGR_FL_COUNT))
+   {
+      block_ptr = posal_heapmgr_find_free_block(mgr_ptr, &fl, &sl);
+   }
+
+   if (NULL == block_ptr)
+   {
+      mgr_ptr->stats.num_failed_mallocs++;
+      pthread_mutex_unlock(&mgr_ptr->lock);
+      return NULL;
+   }
+
+   posal_heapmgr_remove_free_block(mgr_ptr, block_ptr);
+
+   posal_heapmgr_block_t *next_ptr = posal_heapmgr_next_phys_block(block_ptr);
+   if (block_ptr->size >= size + POSAL_HEAPMGR_BLOCK_HDR_SIZE + POSAL_HEAPMGR_MIN_BLOCK_SIZE)
+   {
+      // split, the remainder stays free so the next block keeps its prev free flag
+      posal_heapmgr_block_t *rem_ptr = (posal_heapmgr_block_t *)(posal_heapmgr_block_payload(block_ptr) + size);
+      rem_ptr->size                  = block_ptr->size - size - POSAL_HEAPMGR_BLOCK_HDR_SIZE;
+      rem_ptr->flags                 = POSAL_HEAPMGR_BLOCK_FREE;
+      rem_ptr->prev_phys_ptr         = block_ptr;
+      next_ptr->prev_phys_ptr        = rem_ptr;
+      block_ptr->size                = size;
+
+      posal_heapmgr_insert_free_block(mgr_ptr, rem_ptr);
+   }
+   else
+   {
+      next_ptr->flags &= ~POSAL_HEAPMGR_PREV_BLOCK_FREE;
+   }
+   block_ptr->flags &= ~POSAL_HEAPMGR_BLOCK_FREE;
+
+   mgr_ptr->stats.num_used_blocks++;
+   posal_heapmgr_update_used_bytes(mgr_ptr, block_ptr->size + POSAL_HEAPMGR_BLOCK_HDR_SIZE);
+
+   pthread_mutex_unlock(&mgr_ptr->lock);
+
+   return posal_heapmgr_block_payload(block_ptr);
+}
+
+void posal_heapmgr_free(uint32_t heap_table_idx, void *ptr)
+{
+   posal_heapmgr_t       *mgr_ptr   = (posal_heapmgr_t *)posal_heap_table[heap_table_idx].heapmgr_ptr;
+   posal_heapmgr_block_t *block_ptr = posal_heapmgr_block_from_payload(ptr);
+
+   pthread_mutex_lock(&mgr_ptr->lock);
+
+   if (block_ptr->flags & POSAL_HEAPMGR_BLOCK_FREE)
+   {
+      pthread_mutex_unlock(&mgr_ptr->lock);
+      AR_MSG(DBG_ERROR_PRIO, "posal_heapmgr: heap %lu, double free of 0x%p", mgr_ptr->heap_id, ptr);
+      return;
+   }
+
+   mgr_ptr->stats.num_used_blocks--;
+   posal_heapmgr_update_used_bytes(mgr_ptr, -((int64_t)block_ptr->size + POSAL_HEAPMGR_BLOCK_HDR_SIZE));
+
+   block_ptr->flags |= POSAL_HEAPMGR_BLOCK_FREE;
+
+   if (block_ptr->flags & POSAL_HEAPMGR_PREV_BLOCK_FREE)
+   {
+      posal_heapmgr_block_t *prev_ptr = block_ptr->prev_phys_ptr;
+      posal_heapmgr_remove_free_block(mgr_ptr, prev_ptr);
+      prev_ptr->size += POSAL_HEAPMGR_BLOCK_HDR_SIZE + block_ptr->size;
+      block_ptr = prev_ptr;
+   }
+
+   posal_heapmgr_block_t *next_ptr = posal_heapmgr_next_phys_block(block_ptr);
+   if (next_ptr->flags & POSAL_HEAPMGR_BLOCK_FREE)
+   {
+      posal_heapmgr_remove_free_block(mgr_ptr, next_ptr);
+      block_ptr->size += POSAL_HEAPMGR_BLOCK_HDR_SIZE + next_ptr->size;
+      next_ptr = posal_heapmgr_next_phys_block(block_ptr);
+   }
+
+   next_ptr->prev_phys_ptr = block_ptr;
+   next_ptr->flags |= POSAL_HEAPMGR_PREV_BLOCK_FREE;
+
+   posal_heapmgr_insert_free_block(mgr_ptr, block_ptr);
+
+   pthread_mutex_unlock(&mgr_ptr->lock);
+}
+
+uint32_t posal_heapmgr_get_block_size(uint32_t heap_table_idx, void *ptr)
+{
+   // size of a used block only changes when it is freed, no lock needed
+   return posal_heapmgr_block_from_payload(ptr)->size;
+}
+
+bool_t posal_heapmgr_find_heap_idx(void *ptr, uint32_t *heap_table_idx_ptr)
+{
+   if (0 == __atomic_load_n(&posal_heapmgr_num_heaps, __ATOMIC_ACQUIRE))
+   {
+      return FALSE;
+   }
+
+   for (uint32_t i = 0; i < POSAL_HEAP_MGR_MAX_NUM_HEAPS; i++)
+   {
+      if (posal_heap_table[i].heapmgr_ptr && posal_check_if_addr_within_heap_idx_range(i, ptr))
+      {
+         *heap_table_idx_ptr = i;
+         return TRUE;
+      }
+   }
+   return FALSE;
+}
+
+ar_result_t posal_memory_heapmgr_create(POSAL_HEAP_ID *heap_id_ptr,
+                                        void *         heap_start_ptr,
+                                        uint32_t       heap_size,
+                                        bool_t         is_init_heap_needed)
+{
+   if ((NULL == heap_id_ptr) || (NULL == heap_start_ptr) || (0 == heap_size))
+   {
+      AR_MSG(DBG_ERROR_PRIO, "posal_heapmgr: invalid heap region 0x%p, size %lu", heap_start_ptr, heap_size);
+      return AR_EBADPARAM;
+   }
+
+   pthread_mutex_lock(&posal_heapmgr_table_lock);
+
+   uint32_t idx = 0;
+   while ((idx < POSAL_HEAP_MGR_MAX_NUM_HEAPS) && posal_heap_table[idx].used_flag)
+   {
+      idx++;
+   }
+
+   if (idx >= POSAL_HEAP_MGR_MAX_NUM_HEAPS)
+   {
+      pthread_mutex_unlock(&posal_heapmgr_table_lock);
+      AR_MSG(DBG_ERROR_PRIO, "posal_heapmgr: all %lu heaps are in use", POSAL_HEAP_MGR_MAX_NUM_HEAPS);
+      return AR_ENORESOURCE;
+   }
+
+   POSAL_HEAP_ID actual_heap_id = (POSAL_HEAP_ID)HEAP_ID_FROM_HEAP_TABLE_INDEX(idx);
+   posal_heapmgr_t *mgr_ptr     = NULL;
+
+   // otherwise the heap is managed outside SPF, allocations from it fall back to the default heap
+   if (is_init_heap_needed)
+   {
+      mgr_ptr = posal_heapmgr_init(actual_heap_id, heap_start_ptr, heap_size);
+      if (NULL == mgr_ptr)
+      {
+         pthread_mutex_unlock(&posal_heapmgr_table_lock);
+         AR_MSG(DBG_ERROR_PRIO, "posal_heapmgr: heap region of %lu bytes is too small", heap_size);
+         return AR_ENORESOURCE;
+      }
+   }
+
+   memset(&posal_globalstate.avs_stats[actual_heap_id], 0, sizeof(posal_globalstate.avs_stats[actual_heap_id]));
+
+   posal_heap_table[idx].start_addr         = (uint64_t)(uintptr_t)heap_start_ptr;
+   posal_heap_table[idx].end_addr           = (uint64_t)(uintptr_t)heap_start_ptr + heap_size;
+   posal_heap_table[idx].is_phys_addr_range = FALSE;
+   posal_heap_table[idx].dynamic_heap       = TRUE;
+   posal_heap_table[idx].heapmgr_ptr        = mgr_ptr;
+   posal_heap_table[idx].used_flag          = TRUE;
+
+   if (mgr_ptr)
+   {
+      __atomic_fetch_add(&posal_heapmgr_num_heaps, 1, __ATOMIC_RELEASE);
+   }
+
+   pthread_mutex_unlock(&posal_heapmgr_table_lock);
+
+   *heap_id_ptr = (POSAL_HEAP_ID)MODIFY_HEAP_ID_FOR_MEM_TRACKING(*heap_id_ptr, actual_heap_id);
+
+   AR_MSG(DBG_HIGH_PRIO,
+          "posal_heapmgr: created heap %lu at 0x%p, size %lu, managed %lu",
+          actual_heap_id,
+          heap_start_ptr,
+          heap_size,
+          (NULL != mgr_ptr));
+
+   return AR_EOK;
+}
+
+ar_result_t posal_memory_heapmgr_destroy(POSAL_HEAP_ID origheapId)
+{
+   POSAL_HEAP_ID heap_id = GET_ACTUAL_HEAP_ID(origheapId);
+   if ((POSAL_HEAP_DEFAULT == heap_id) || (heap_id >= POSAL_HEAP_OUT_OF_RANGE))
+   {
+      return AR_EBADPARAM;
+   }
+
+   uint32_t idx = HEAP_TABLE_INDEX_FROM_HEAP_ID(heap_id);
+
+   pthread_mutex_lock(&posal_heapmgr_table_lock);
+
+   if (!posal_heap_table[idx].used_flag)
+   {
+      pthread_mutex_unlock(&posal_heapmgr_table_lock);
+      AR_MSG(DBG_ERROR_PRIO, "posal_heapmgr: heap %lu doesn't exist", heap_id);
+      return AR_EBADPARAM;
+   }
+
+   posal_heapmgr_t *mgr_ptr = (posal_heapmgr_t *)posal_heap_table[idx].heapmgr_ptr;
+   if (mgr_ptr)
+   {
+      // report the leaks, the caller is expected to have freed everything
+      uint32_t num_leaks = 0, leaked_bytes = 0;
+      for (posal_heapmgr_block_t *block_ptr = mgr_ptr->first_block_ptr; block_ptr != mgr_ptr->last_block_ptr;
+           block_ptr                        = posal_heapmgr_next_phys_block(block_ptr))
+      {
+         if (block_ptr->flags & POSAL_HEAPMGR_BLOCK_FREE)
+         {
+            continue;
+         }
+
+         if (num_leaks < POSAL_HEAPMGR_MAX_LEAKS_TO_PRINT)
+         {
+            AR_MSG(DBG_ERROR_PRIO,
+                   "posal_heapmgr: heap %lu leak 0x%p, %lu bytes",
+                   heap_id,
+                   posal_heapmgr_block_payload(block_ptr),
+                   block_ptr->size);
+         }
+         num_leaks++;
+         leaked_bytes += block_ptr->size;
+      }
+
+      AR_MSG((num_leaks ? DBG_ERROR_PRIO : DBG_HIGH_PRIO),
+             "posal_heapmgr: destroying heap %lu, %lu leaks of %lu bytes, peak usage %lu of %lu bytes, "
+             "failed mallocs %lu",
+             heap_id,
+             num_leaks,
+             leaked_bytes,
+             mgr_ptr->stats.peak_used_bytes,
+             mgr_ptr->stats.heap_size,
+             mgr_ptr->stats.num_failed_mallocs);
+
+      pthread_mutex_destroy(&mgr_ptr->lock);
+      __atomic_fetch_sub(&posal_heapmgr_num_heaps, 1, __ATOMIC_RELEASE);
+   }
+
+   memset(&posal_heap_table[idx], 0, sizeof(posal_heap_table[idx]));
+
+   pthread_mutex_unlock(&posal_heapmgr_table_lock);
+
+   return AR_EOK;
+}
+
+ar_result_t posal_memory_heapmgr_get_stats(POSAL_HEAP_ID origheapId, posal_heapmgr_stats_t *stats_ptr)
+{
+   POSAL_HEAP_ID heap_id = GET_ACTUAL_HEAP_ID(origheapId);
+   if ((NULL == stats_ptr) || (POSAL_HEAP_DEFAULT == heap_id) || (heap_id >= POSAL_HEAP_OUT_OF_RANGE))
+   {
+      return AR_EBADPARAM;
+   }
+
+   posal_heapmgr_t *mgr_ptr = (posal_heapmgr_t *)posal_heap_table[HEAP_TABLE_INDEX_FROM_HEAP_ID(heap_id)].heapmgr_ptr;
+   if (NULL == mgr_ptr)
+   {
+      return AR_EBADPARAM;
+   }
+
+   pthread_mutex_lock(&mgr_ptr->lock);
+
+   *stats_ptr                    = mgr_ptr->stats;
+   stats_ptr->largest_free_block = 0;
+
+   // the largest block is in the highest non-empty list
+   if (mgr_ptr->fl_bitmap)
+   {
+      uint32_t fl = posal_heapmgr_fls(mgr_ptr->fl_bitmap);
+      uint32_t sl = posal_heapmgr_fls(mgr_ptr->sl_bitmap[fl]);
+      for (posal_heapmgr_block_t *block_ptr = mgr_ptr->free_lists[fl][sl]; block_ptr;
+           block_ptr                        = block_ptr->next_free_ptr)
+      {
+         stats_ptr->largest_free_block = MAX(stats_ptr->largest_free_block, block_ptr->size);
+      }
+   }
+
+   pthread_mutex_unlock(&mgr_ptr->lock);
+
+   return AR_EOK;
+}
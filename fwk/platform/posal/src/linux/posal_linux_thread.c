@@ -11,11 +11,18 @@
 /* ----------------------------------------------------------------------------
  * Include Files
  * ------------------------------------------------------------------------- */
+#if defined(POSAL_THREAD_AFFINITY) && !defined(_GNU_SOURCE)
+// cpu_set_t and the pthread affinity functions are GNU extensions
+#define _GNU_SOURCE
+#endif
 #include "posal.h"
 #include "posal_thread_profiling.h"
 #include "posal_internal.h"
 #include <ar_osal_thread.h>
 #include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
 
 /* ----------------------------------------------------------------------------
  * Global Declarations/Definitions
@@ -495,3 +502,102 @@ int64_t posal_thread_get_curr_tid_v2(void)
 {
    return (int64_t)pthread_self();
 }
+
+ar_result_t posal_thread_set_affinity(posal_thread_t thread_obj, uint32_t affinity)
+{
+// Thread Affinity is not supported via this api on QNX and Linux Android
+#if defined (POSAL_THREAD_AFFINITY)
+   _thread_args_t *thrd_obj_ptr = (_thread_args_t *)thread_obj;
+   cpu_set_t       cs;
+
+   if ((NULL == thrd_obj_ptr) || (0 == affinity))
+   {
+      return AR_EBADPARAM;
+   }
+
+   CPU_ZERO(&cs);
+   for (uint32_t i = 0; i < sizeof(affinity) * 8; i++)
+   {
+      if (affinity & (1 << i))
+      {
+         CPU_SET(i, &cs);
+      }
+   }
+
+   int unix_result = pthread_setaffinity_np(thrd_obj_ptr->thread_handle, sizeof(cpu_set_t), &cs);
+   if (unix_result)
+   {
+      AR_MSG(DBG_ERROR_PRIO, "Error: pthread_setaffinity_np failed with status 0x%x", unix_result);
+      return AR_EFAILED;
+   }
+
+   return AR_EOK;
+#else
+   return AR_EUNSUPPORTED;
+#endif
+}
+
+uint32_t posal_thread_get_num_cores(void)
+{
+   long num_cores = sysconf(_SC_NPROCESSORS_ONLN);
+
+   // affinity masks are 32 bit
+   return (num_cores < 1) ? 1 : ((num_cores > 32) ? 32 : (uint32_t)num_cores);
+}
+
+uint32_t posal_thread_get_cache_domain(uint32_t core)
+{
+   uint32_t mask = 0;
+   char     path[96];
+   char     list[128];
+   FILE    *fp = NULL;
+
+   if (core >= 32)
+   {
+      return 0;
+   }
+
+   // highest cache level listed in sysfs is the last level cache (index3 = L3, index2 = L2)
+   for (int32_t index = 3; (index >= 2) && (NULL == fp); index--)
+   {
+      snprintf(path,
+               sizeof(path),
+               "/sys/devices/system/cpu/cpu%u/cache/index%d/shared_cpu_list",
+               (unsigned)core,
+               (int)index);
+      fp = fopen(path, "r");
+   }
+
+   if (fp)
+   {
+      if (fgets(list, sizeof(list), fp))
+      {
+         // format is a comma separated list of ranges, for ex. "0-3,8-11"
+         char *str_ptr = list;
+         while (*str_ptr && ('\n' != *str_ptr))
+         {
+            char         *end_ptr = NULL;
+            unsigned long first   = strtoul(str_ptr, &end_ptr, 10);
+            unsigned long last    = first;
+
+            if (end_ptr == str_ptr)
+            {
+               break;
+            }
+            if ('-' == *end_ptr)
+            {
+               str_ptr = end_ptr + 1;
+               last    = strtoul(str_ptr, &end_ptr, 10);
+            }
+            for (unsigned long i = first; (i <= last) && (i < 32); i++)
+            {
+               mask |= (1u << i);
+            }
+            str_ptr = (',' == *end_ptr) ? (end_ptr + 1) : end_ptr;
+         }
+      }
+      fclose(fp);
+   }
+
+   return mask | (1u << core);
+}
@@ -3,6 +3,14 @@
  * \brief
  *  	   This file contains a utility for memory profile.
  *
+ *  	   Malloc and free never lock or allocate. Each thread claims a block of counters the first time it
+ *  	   allocates and is the only writer of it. Queries sum the blocks of all threads. Threads that exit
+ *  	   fold their counters into a shared table, which also serves threads that could not claim a block.
+ *
+ *  	   Allocation sites are kept in a bounded table per thread: when the table is full, a new site replaces
+ *  	   the least counted one and inherits its count (space-saving), so frequent sites stay and their counts
+ *  	   are only over-estimated. The sites with the most allocations are printed on stop.
+ *
  * \copyright
  *       Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
  *       SPDX-License-Identifier: BSD-3-Clause-Clear
@@ -16,14 +24,23 @@
 #include "posal_memory_i.h"
 
 #include "posal.h"
+#include <malloc.h>
+#include <pthread.h>
+#include <stdlib.h>
 
 /* ----------------------------------------------------------------------------
  * Global Declarations/Definitions
  * ------------------------------------------------------------------------- */
-#define POSAL_MEM_PROF_HASH_TABLE_SIZE 16
-#define POSAL_MEM_PROF_HASH_TABLE_RESIZE_FACTOR 2
 #define POSAL_MEM_PROF_MAGIC_NUMBER 0xCAFEC0DE
 
+/* Entries looked at for a heap id before falling back to the shared table */
+#define POSAL_MEM_PROF_MAX_ID_PROBES 8
+
+/* Entries looked at for a site before replacing the least counted one */
+#define POSAL_MEM_PROF_MAX_SITE_PROBES 4
+
+#define POSAL_MEM_PROF_MAX_SHARED_ID_PROBES 16
+
 posal_mem_prof_t          g_posal_mem_prof;
 posal_mem_prof_t *        g_posal_mem_prof_ptr = NULL;
 extern posal_heap_table_t posal_heap_table[POSAL_HEAP_MGR_MAX_NUM_HEAPS];
@@ -32,17 +49,310 @@ extern posal_heap_table_t posal_heap_table[POSAL_HEAP_MGR_MAX_NUM_HEAPS];
 #define ALIGN_4_BYTES(a) ((a + 3) & (0xFFFFFFFC))
 #endif
 
+/* Incremented on every init, so that threads drop blocks claimed before a deinit */
+static uint32_t posal_mem_prof_epoch = 0;
+
+/* Runs posal_mem_prof_thread_exit for threads that claimed a block */
+static pthread_key_t posal_mem_prof_thread_key;
+
+static __thread posal_mem_prof_thread_t *posal_mem_prof_thread_ptr   = NULL;
+static __thread uint32_t                 posal_mem_prof_thread_epoch = 0;
 
 /* -------------------------------------------------------------------------
  * Function Definitions
  * ------------------------------------------------------------------------- */
-static void posal_mem_prof_mem_free(void *free_context_ptr, spf_hash_node_t *node_ptr)
+static inline uint32_t posal_mem_prof_hash(uint64_t key)
+{
+   return (uint32_t)((key * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+/* Shared counters are updated by any thread. Entries are claimed with a CAS and never released during a session. */
+static void posal_mem_prof_shared_update(uint32_t heap_id, int64_t delta)
+{
+   uint32_t hash = posal_mem_prof_hash(heap_id);
+
+   for (uint32_t i = 0; i < POSAL_MEM_PROF_MAX_SHARED_ID_PROBES; i++)
+   {
+      posal_mem_prof_counter_t *counter_ptr =
+         &g_posal_mem_prof_ptr->shared_counters[(hash + i) & (POSAL_MEM_PROF_SHARED_IDS - 1)];
+      uint32_t key = __atomic_load_n(&counter_ptr->heap_id, __ATOMIC_RELAXED);
+      if (0 == key)
+      {
+         // on failure key is updated to the id that won the entry
+         if (__atomic_compare_exchange_n(&counter_ptr->heap_id,
+                                         &key,
+                                         heap_id,
+                                         FALSE,
+                                         __ATOMIC_RELAXED,
+                                         __ATOMIC_RELAXED))
+         {
+            key = heap_id;
+         }
+      }
+      if (key == heap_id)
+      {
+         __atomic_fetch_add(&counter_ptr->mem_count, delta, __ATOMIC_RELAXED);
+         return;
+      }
+   }
+
+   __atomic_fetch_add(&g_posal_mem_prof_ptr->num_dropped, 1, __ATOMIC_RELAXED);
+}
+
+/* Owner thread only. Readers may see a partially replaced entry, that only skews the histogram. */
+static void posal_mem_prof_site_update(posal_mem_prof_site_t *sites_ptr,
+                                       uint32_t               num_sites,
+                                       void *                 site_ptr,
+                                       uint32_t               num_allocs,
+                                       uint64_t               num_bytes)
+{
+   uint32_t               hash      = posal_mem_prof_hash((uint64_t)(uintptr_t)site_ptr);
+   posal_mem_prof_site_t *victim_ptr = NULL;
+
+   for (uint32_t i = 0; i < POSAL_MEM_PROF_MAX_SITE_PROBES; i++)
+   {
+      posal_mem_prof_site_t *entry_ptr = &sites_ptr[(hash + i) & (num_sites - 1)];
+      if (site_ptr == entry_ptr->site_ptr)
+      {
+         __atomic_store_n(&entry_ptr->num_allocs, entry_ptr->num_allocs + num_allocs, __ATOMIC_RELAXED);
+         __atomic_store_n(&entry_ptr->num_bytes, entry_ptr->num_bytes + num_bytes, __ATOMIC_RELAXED);
+         return;
+      }
+      if ((NULL == victim_ptr) || (entry_ptr->num_allocs < victim_ptr->num_allocs))
+      {
+         victim_ptr = entry_ptr;
+      }
+   }
+
+   // free entries have a 0 count, so they are picked first
+   __atomic_store_n(&victim_ptr->site_ptr, site_ptr, __ATOMIC_RELAXED);
+   __atomic_store_n(&victim_ptr->num_allocs, victim_ptr->num_allocs + num_allocs, __ATOMIC_RELAXED);
+   __atomic_store_n(&victim_ptr->num_bytes, num_bytes, __ATOMIC_RELAXED);
+}
+
+static void posal_mem_prof_thread_exit(void *arg_ptr)
+{
+   posal_mem_prof_thread_t *thread_ptr = (posal_mem_prof_thread_t *)arg_ptr;
+
+   // later frees of this thread (e.g. from other key destructors) go to the shared table
+   posal_mem_prof_thread_ptr = NULL;
+
+   if (NULL == g_posal_mem_prof_ptr)
+   {
+      return;
+   }
+
+   posal_mutex_lock(g_posal_mem_prof_ptr->prof_mutex);
+   if ((POSAL_MEM_PROF_STARTED == g_posal_mem_prof_ptr->mem_prof_status) &&
+       (thread_ptr->generation == g_posal_mem_prof_ptr->generation))
+   {
+      for (uint32_t i = 0; i < POSAL_MEM_PROF_IDS_PER_THREAD; i++)
+      {
+         if (thread_ptr->counters[i].heap_id && thread_ptr->counters[i].mem_count)
+         {
+            posal_mem_prof_shared_update(thread_ptr->counters[i].heap_id, thread_ptr->counters[i].mem_count);
+         }
+      }
+      for (uint32_t i = 0; i < POSAL_MEM_PROF_SITES_PER_THREAD; i++)
+      {
+         if (thread_ptr->sites[i].site_ptr)
+         {
+            posal_mem_prof_site_update(g_posal_mem_prof_ptr->shared_sites,
+                                       POSAL_MEM_PROF_SHARED_SITES,
+                                       thread_ptr->sites[i].site_ptr,
+                                       thread_ptr->sites[i].num_allocs,
+                                       thread_ptr->sites[i].num_bytes);
+         }
+      }
+   }
+   thread_ptr->generation = 0;
+   __atomic_store_n(&thread_ptr->in_use, 0, __ATOMIC_RELEASE);
+   posal_mutex_unlock(g_posal_mem_prof_ptr->prof_mutex);
+}
+
+/* Returns the counters of the calling thread, NULL if all blocks are taken */
+static posal_mem_prof_thread_t *posal_mem_prof_get_thread(uint32_t generation)
 {
-   if (NULL != node_ptr)
+   posal_mem_prof_thread_t *thread_ptr = posal_mem_prof_thread_ptr;
+   uint32_t                 epoch      = __atomic_load_n(&posal_mem_prof_epoch, __ATOMIC_RELAXED);
+
+   if (posal_mem_prof_thread_epoch != epoch)
+   {
+      // first allocation of the thread in this init, claim a block. Tried once, the thread uses the shared
+      // table if none is free.
+      thread_ptr                  = NULL;
+      posal_mem_prof_thread_epoch = epoch;
+      for (uint32_t i = 0; i < POSAL_MEM_PROF_MAX_THREADS; i++)
+      {
+         uint32_t expected = 0;
+         if (__atomic_compare_exchange_n(&g_posal_mem_prof_ptr->threads[i].in_use,
+                                         &expected,
+                                         1,
+                                         FALSE,
+                                         __ATOMIC_ACQUIRE,
+                                         __ATOMIC_RELAXED))
+         {
+            thread_ptr = &g_posal_mem_prof_ptr->threads[i];
+            pthread_setspecific(posal_mem_prof_thread_key, thread_ptr);
+            break;
+         }
+      }
+      posal_mem_prof_thread_ptr = thread_ptr;
+   }
+
+   if (thread_ptr && (generation != thread_ptr->generation))
+   {
+      // counters of a previous session. Queries skip the block until the generation is published.
+      memset(thread_ptr->counters, 0, sizeof(thread_ptr->counters));
+      memset(thread_ptr->sites, 0, sizeof(thread_ptr->sites));
+      __atomic_store_n(&thread_ptr->generation, generation, __ATOMIC_RELEASE);
+   }
+
+   return thread_ptr;
+}
+
+static void posal_mem_prof_update_stats(POSAL_HEAP_ID update_heap_id,
+                                        uint32_t      generation,
+                                        int64_t       delta,
+                                        void *        site_ptr)
+{
+   posal_mem_prof_thread_t *thread_ptr = posal_mem_prof_get_thread(generation);
+
+#ifdef DEBUG_POSAL_MEM_PROF
+   AR_MSG(DBG_HIGH_PRIO,
+          "POSAL MEM PROF: update_heap_id = 0x%X, delta = %ld, thread block 0x%p",
+          update_heap_id,
+          (int32_t)delta,
+          thread_ptr);
+#endif
+
+   if (NULL == thread_ptr)
+   {
+      posal_mem_prof_shared_update(update_heap_id, delta);
+      return;
+   }
+
+   if (site_ptr)
    {
-      posal_mem_prof_node_t *mem_prof_node_ptr = (posal_mem_prof_node_t *)(node_ptr);
-      posal_memory_free(mem_prof_node_ptr);
+      posal_mem_prof_site_update(thread_ptr->sites, POSAL_MEM_PROF_SITES_PER_THREAD, site_ptr, 1, (uint64_t)delta);
    }
+
+   uint32_t                  hash       = posal_mem_prof_hash((uint32_t)update_heap_id);
+   posal_mem_prof_counter_t *reuse_ptr  = NULL;
+   for (uint32_t i = 0; i < POSAL_MEM_PROF_MAX_ID_PROBES; i++)
+   {
+      posal_mem_prof_counter_t *counter_ptr = &thread_ptr->counters[(hash + i) & (POSAL_MEM_PROF_IDS_PER_THREAD - 1)];
+      if ((uint32_t)update_heap_id == counter_ptr->heap_id)
+      {
+         __atomic_store_n(&counter_ptr->mem_count, counter_ptr->mem_count + delta, __ATOMIC_RELAXED);
+         return;
+      }
+      // an entry that counts 0 contributes nothing to queries and can be taken by another id
+      if ((NULL == reuse_ptr) && (0 == counter_ptr->mem_count))
+      {
+         reuse_ptr = counter_ptr;
+      }
+   }
+
+   if (reuse_ptr)
+   {
+      __atomic_store_n(&reuse_ptr->heap_id, (uint32_t)update_heap_id, __ATOMIC_RELAXED);
+      __atomic_store_n(&reuse_ptr->mem_count, delta, __ATOMIC_RELAXED);
+      return;
+   }
+
+   posal_mem_prof_shared_update(update_heap_id, delta);
+}
+
+static int posal_mem_prof_cmp_site_ptr(const void *a_ptr, const void *b_ptr)
+{
+   uintptr_t a = (uintptr_t)((const posal_mem_prof_site_t *)a_ptr)->site_ptr;
+   uintptr_t b = (uintptr_t)((const posal_mem_prof_site_t *)b_ptr)->site_ptr;
+   return (a > b) - (a < b);
+}
+
+static int posal_mem_prof_cmp_num_allocs(const void *a_ptr, const void *b_ptr)
+{
+   uint32_t a = ((const posal_mem_prof_site_t *)a_ptr)->num_allocs;
+   uint32_t b = ((const posal_mem_prof_site_t *)b_ptr)->num_allocs;
+   return (a < b) - (a > b);
+}
+
+/* Merges the sites of all threads and prints the most frequent ones. prof_mutex must be held. */
+static void posal_mem_prof_report_top_sites(void)
+{
+   uint32_t               max_sites = POSAL_MEM_PROF_MAX_THREADS * POSAL_MEM_PROF_SITES_PER_THREAD +
+                                      POSAL_MEM_PROF_SHARED_SITES;
+   posal_mem_prof_site_t *all_ptr   = (posal_mem_prof_site_t *)posal_memory_malloc(max_sites *
+                                                                                     sizeof(posal_mem_prof_site_t),
+                                                                                   g_posal_mem_prof_ptr->heap_id);
+   if (NULL == all_ptr)
+   {
+      AR_MSG(DBG_ERROR_PRIO, "POSAL MEM PROF: Failed to allocate memory for the allocation site report.");
+      return;
+   }
+
+   uint32_t num_sites = 0;
+   for (uint32_t i = 0; i < POSAL_MEM_PROF_SHARED_SITES; i++)
+   {
+      if (g_posal_mem_prof_ptr->shared_sites[i].site_ptr)
+      {
+         all_ptr[num_sites++] = g_posal_mem_prof_ptr->shared_sites[i];
+      }
+   }
+   for (uint32_t t = 0; t < POSAL_MEM_PROF_MAX_THREADS; t++)
+   {
+      posal_mem_prof_thread_t *thread_ptr = &g_posal_mem_prof_ptr->threads[t];
+      if (!__atomic_load_n(&thread_ptr->in_use, __ATOMIC_ACQUIRE) ||
+          (g_posal_mem_prof_ptr->generation != __atomic_load_n(&thread_ptr->generation, __ATOMIC_ACQUIRE)))
+      {
+         continue;
+      }
+      for (uint32_t i = 0; i < POSAL_MEM_PROF_SITES_PER_THREAD; i++)
+      {
+         posal_mem_prof_site_t site;
+         site.site_ptr   = __atomic_load_n(&thread_ptr->sites[i].site_ptr, __ATOMIC_RELAXED);
+         site.num_allocs = __atomic_load_n(&thread_ptr->sites[i].num_allocs, __ATOMIC_RELAXED);
+         site.num_bytes  = __atomic_load_n(&thread_ptr->sites[i].num_bytes, __ATOMIC_RELAXED);
+         if (site.site_ptr)
+         {
+            all_ptr[num_sites++] = site;
+         }
+      }
+   }
+
+   // sum the entries of a site across threads
+   qsort(all_ptr, num_sites, sizeof(posal_mem_prof_site_t), posal_mem_prof_cmp_site_ptr);
+   uint32_t num_unique = 0;
+   for (uint32_t i = 0; i < num_sites; i++)
+   {
+      if (num_unique && (all_ptr[num_unique - 1].site_ptr == all_ptr[i].site_ptr))
+      {
+         all_ptr[num_unique - 1].num_allocs += all_ptr[i].num_allocs;
+         all_ptr[num_unique - 1].num_bytes += all_ptr[i].num_bytes;
+      }
+      else
+      {
+         all_ptr[num_unique++] = all_ptr[i];
+      }
+   }
+   qsort(all_ptr, num_unique, sizeof(posal_mem_prof_site_t), posal_mem_prof_cmp_num_allocs);
+
+   AR_MSG(DBG_HIGH_PRIO,
+          "POSAL MEM PROF: %lu allocation sites seen, %lu updates dropped",
+          num_unique,
+          g_posal_mem_prof_ptr->num_dropped);
+   for (uint32_t i = 0; i < MIN(num_unique, POSAL_MEM_PROF_NUM_TOP_SITES); i++)
+   {
+      AR_MSG(DBG_HIGH_PRIO,
+             "POSAL MEM PROF: site %lu: 0x%p, %lu allocs, %lu KB",
+             i,
+             all_ptr[i].site_ptr,
+             all_ptr[i].num_allocs,
+             (uint32_t)(all_ptr[i].num_bytes >> 10));
+   }
+
+   posal_memory_free(all_ptr);
 }
 
 ar_result_t posal_mem_prof_init(POSAL_HEAP_ID heap_id)
@@ -64,10 +374,18 @@ ar_result_t posal_mem_prof_init(POSAL_HEAP_ID heap_id)
       return result;
    }
 
+   if (0 != pthread_key_create(&posal_mem_prof_thread_key, posal_mem_prof_thread_exit))
+   {
+      AR_MSG(DBG_ERROR_PRIO, "POSAL MEM PROF:Failed to create thread key for posal mem prof.");
+      posal_mutex_destroy(&g_posal_mem_prof.prof_mutex);
+      return AR_EFAILED;
+   }
+
    /** Initialize mem prof variables */
    g_posal_mem_prof.heap_id         = heap_id;
    g_posal_mem_prof.mem_prof_status = POSAL_MEM_PROF_STOPPED;
-   g_posal_mem_prof_ptr             = &g_posal_mem_prof;
+   __atomic_add_fetch(&posal_mem_prof_epoch, 1, __ATOMIC_RELAXED);
+   __atomic_store_n(&g_posal_mem_prof_ptr, &g_posal_mem_prof, __ATOMIC_RELEASE);
    AR_MSG(DBG_HIGH_PRIO, "POSAL MEM PROF: Init Done.");
    return result;
 }
@@ -78,28 +396,23 @@ ar_result_t posal_mem_prof_start()
    ar_result_t result = AR_EOK;
    if (NULL == g_posal_mem_prof_ptr)
    {
-      AR_MSG(DBG_ERROR_PRIO, "POSAL MEM PROF:g_posal_mem_prof_ptr is not null during start.");
+      AR_MSG(DBG_ERROR_PRIO, "POSAL MEM PROF:g_posal_mem_prof_ptr is null during start.");
       return AR_EFAILED;
    }
 
    posal_mutex_lock(g_posal_mem_prof_ptr->prof_mutex);
    if (POSAL_MEM_PROF_STARTED != g_posal_mem_prof.mem_prof_status)
    {
-      result = spf_hashtable_init(&g_posal_mem_prof.mem_ht,
-                                  g_posal_mem_prof_ptr->heap_id,
-                                  POSAL_MEM_PROF_HASH_TABLE_SIZE,
-                                  POSAL_MEM_PROF_HASH_TABLE_RESIZE_FACTOR,
-                                  posal_mem_prof_mem_free,
-                                  (void *)g_posal_mem_prof_ptr);
-      if (AR_EOK != result)
-      {
-         posal_mutex_unlock(g_posal_mem_prof_ptr->prof_mutex);
-         AR_MSG(DBG_ERROR_PRIO, "POSAL MEM PROF: Failed to init hashtable during posal mem prof start.");
-         return result;
-      }
+      // thread counters are reset by their owners on their next update
+      memset(g_posal_mem_prof.shared_counters, 0, sizeof(g_posal_mem_prof.shared_counters));
+      memset(g_posal_mem_prof.shared_sites, 0, sizeof(g_posal_mem_prof.shared_sites));
+      g_posal_mem_prof.num_dropped = 0;
+
+      // generation 0 marks free thread blocks
+      uint32_t generation = g_posal_mem_prof.generation + 1;
+      __atomic_store_n(&g_posal_mem_prof.generation, generation ? generation : 1, __ATOMIC_RELAXED);
+      __atomic_store_n(&g_posal_mem_prof.mem_prof_status, POSAL_MEM_PROF_STARTED, __ATOMIC_RELEASE);
    }
-
-   g_posal_mem_prof.mem_prof_status = POSAL_MEM_PROF_STARTED;
    posal_mutex_unlock(g_posal_mem_prof_ptr->prof_mutex);
    AR_MSG(DBG_HIGH_PRIO, "POSAL MEM PROF: Start done.");
    return result;
@@ -111,15 +424,15 @@ ar_result_t posal_mem_prof_stop()
    ar_result_t result = AR_EOK;
    if (NULL == g_posal_mem_prof_ptr)
    {
-      AR_MSG(DBG_ERROR_PRIO, "POSAL MEM PROF:g_posal_mem_prof_ptr is not null during stop.");
+      AR_MSG(DBG_ERROR_PRIO, "POSAL MEM PROF:g_posal_mem_prof_ptr is null during stop.");
       return AR_EFAILED;
    }
 
    posal_mutex_lock(g_posal_mem_prof_ptr->prof_mutex);
    if (POSAL_MEM_PROF_STARTED == g_posal_mem_prof.mem_prof_status)
    {
-      spf_hashtable_deinit(&g_posal_mem_prof.mem_ht);
-      g_posal_mem_prof.mem_prof_status = POSAL_MEM_PROF_STOPPED;
+      __atomic_store_n(&g_posal_mem_prof.mem_prof_status, POSAL_MEM_PROF_STOPPED, __ATOMIC_RELEASE);
+      posal_mem_prof_report_top_sites();
    }
    posal_mutex_unlock(g_posal_mem_prof_ptr->prof_mutex);
 
@@ -135,94 +448,22 @@ void posal_mem_prof_deinit()
       return;
    }
 
-   if (0 != g_posal_mem_prof_ptr->mem_ht.num_nodes)
-   {
-      spf_hashtable_deinit(&g_posal_mem_prof_ptr->mem_ht);
-   }
-   posal_mutex_destroy(&g_posal_mem_prof_ptr->prof_mutex);
+   __atomic_store_n(&g_posal_mem_prof_ptr, NULL, __ATOMIC_RELEASE);
+   pthread_key_delete(posal_mem_prof_thread_key);
+   posal_mutex_destroy(&g_posal_mem_prof.prof_mutex);
    memset(&g_posal_mem_prof, 0, sizeof(posal_mem_prof_t));
-   g_posal_mem_prof_ptr = NULL;
    AR_MSG(DBG_HIGH_PRIO, "POSAL MEM PROF: Deinit done.");
    return;
 }
 
-static void posal_mem_prof_update_stats(void *ptr, POSAL_HEAP_ID update_heap_id, bool_t is_malloc, uint32_t mem_size)
+uint32_t posal_mem_prof_get_mem_size(void *ptr, POSAL_HEAP_ID orig_heap_id)
 {
-   posal_mem_prof_node_t *mem_prof_node_ptr = NULL;
-   uint32_t               actual_size       = (mem_size - sizeof(posal_mem_prof_marker_t));
-
-#ifdef DEBUG_POSAL_MEM_PROF
-   AR_MSG(DBG_HIGH_PRIO,
-          "POSAL MEM PROF: is_malloc = %lu, ptr = 0x%X, update_heap_id = 0x%X, mem_size = %lu",
-          is_malloc,
-          ptr,
-          update_heap_id,
-          mem_size);
-#endif
-
-   /** Acquire the hashnode for given heap id */
-   mem_prof_node_ptr = (posal_mem_prof_node_t *)spf_hashtable_find(&g_posal_mem_prof_ptr->mem_ht,
-                                                                   &update_heap_id,
-                                                                   sizeof(POSAL_HEAP_ID));
-
-   if (is_malloc)
+   uint32_t heap_table_idx;
+   if (posal_heapmgr_find_heap_idx(ptr, &heap_table_idx))
    {
-      /** If No entry is  present for the given heap id, create one */
-      if (NULL == mem_prof_node_ptr)
-      {
-         posal_mem_prof_node_t *new_mem_prof_node_ptr =
-            posal_memory_malloc(sizeof(posal_mem_prof_node_t), g_posal_mem_prof_ptr->heap_id);
-         if (NULL == new_mem_prof_node_ptr)
-         {
-            AR_MSG(DBG_ERROR_PRIO, "POSAL MEM PROF: Failed to allocate memory for hash node.");
-            return;
-         }
-         memset(new_mem_prof_node_ptr, 0, sizeof(posal_mem_prof_node_t));
-         new_mem_prof_node_ptr->hash_node.key_ptr  = &new_mem_prof_node_ptr->heap_id;
-         new_mem_prof_node_ptr->hash_node.key_size = sizeof(POSAL_HEAP_ID);
-         new_mem_prof_node_ptr->hash_node.next_ptr = NULL;
-         new_mem_prof_node_ptr->heap_id            = update_heap_id;
-         new_mem_prof_node_ptr->mem_count          = actual_size;
-         spf_hashtable_insert(&g_posal_mem_prof_ptr->mem_ht, &new_mem_prof_node_ptr->hash_node);
-      }
-      else /** Update the mem count if a hash node is cound for the given heap id */
-      {
-         mem_prof_node_ptr->mem_count += (actual_size);
-      }
-   }
-   else
-   {
-      if (NULL == mem_prof_node_ptr)
-      {
-         AR_MSG(DBG_ERROR_PRIO, "POSAL MEM PROF: WARNING Freeing from node which doesn't exist. Ignoring");
-      }
-      else
-      {
-         if (mem_prof_node_ptr->mem_count < actual_size)
-         {
-            AR_MSG(DBG_ERROR_PRIO, "POSAL MEM PROF: WARNING mem count less than amount being freed");
-            mem_prof_node_ptr->mem_count = 0;
-         }
-         else
-         {
-            mem_prof_node_ptr->mem_count -= actual_size;
-         }
-
-         /** Remove the hash node if the mem count reaches 0 */
-         if (0 == mem_prof_node_ptr->mem_count)
-         {
-            spf_hashtable_remove(&g_posal_mem_prof_ptr->mem_ht,
-                                 &mem_prof_node_ptr->heap_id,
-                                 sizeof(POSAL_HEAP_ID),
-                                 &mem_prof_node_ptr->hash_node);
-         }
-      }
+      return posal_heapmgr_get_block_size(heap_table_idx, ptr);
    }
-}
-
-uint32_t posal_mem_prof_get_mem_size(void *ptr, POSAL_HEAP_ID orig_heap_id)
-{
-   return 0;
+   return (uint32_t)malloc_usable_size(ptr);
 }
 
 inline void posal_mem_prof_pre_process_malloc(POSAL_HEAP_ID  orig_heap_id,
@@ -231,41 +472,42 @@ inline void posal_mem_prof_pre_process_malloc(POSAL_HEAP_ID  orig_heap_id,
 {
    (*heap_id_ptr) = GET_ACTUAL_HEAP_ID(orig_heap_id);
 
-   if ((NULL == g_posal_mem_prof_ptr) || (orig_heap_id < POSAL_HEAP_MGR_MAX_NUM_HEAPS))
+   /** Do not track unmodified heap id since they don't belong to any cntrs or modules */
+   if ((NULL == g_posal_mem_prof_ptr) || (0 == GET_TRACKING_ID_FROM_HEAP_ID(orig_heap_id)))
    {
       return;
    }
 
    /** Modify the bytes required only if profiling is enabled */
-   posal_mutex_lock(g_posal_mem_prof_ptr->prof_mutex);
-   if (POSAL_MEM_PROF_STARTED == g_posal_mem_prof_ptr->mem_prof_status)
+   if (POSAL_MEM_PROF_STARTED == __atomic_load_n(&g_posal_mem_prof_ptr->mem_prof_status, __ATOMIC_ACQUIRE))
    {
 #ifdef DEBUG_POSAL_MEM_PROF
       AR_MSG(DBG_HIGH_PRIO, "POSAL MEM PROF: posal_mem_prof_pre_process_malloc. bytes = %lu", *bytes_ptr);
 #endif
       (*bytes_ptr) = ALIGN_4_BYTES((*bytes_ptr)) + sizeof(posal_mem_prof_marker_t);
    }
-   posal_mutex_unlock(g_posal_mem_prof_ptr->prof_mutex);
    return;
 }
 
-inline void posal_mem_prof_post_process_malloc(void *ptr, POSAL_HEAP_ID orig_heap_id, bool_t is_mem_tracked)
+inline void posal_mem_prof_post_process_malloc(void *        ptr,
+                                               POSAL_HEAP_ID orig_heap_id,
+                                               bool_t        is_mem_tracked,
+                                               void *        site_ptr)
 {
-   bool_t                   IS_MALLOC_TRUE = TRUE;
-   uint32_t                 mem_size       = 0;
-   posal_mem_prof_marker_t *marker_ptr     = NULL;
+   uint32_t                 mem_size   = 0;
+   posal_mem_prof_marker_t *marker_ptr = NULL;
    /** Do not track unmodified heap id since they don't belong to any cntrs or modules */
-   if ((NULL == g_posal_mem_prof_ptr) || (orig_heap_id < POSAL_HEAP_MGR_MAX_NUM_HEAPS) || (!is_mem_tracked))
+   if ((NULL == ptr) || (NULL == g_posal_mem_prof_ptr) || (!is_mem_tracked) ||
+       (0 == GET_TRACKING_ID_FROM_HEAP_ID(orig_heap_id)))
    {
       return;
    }
 
-   posal_mutex_lock(g_posal_mem_prof_ptr->prof_mutex);
-   if ((NULL == ptr) || (POSAL_MEM_PROF_STOPPED == g_posal_mem_prof_ptr->mem_prof_status))
+   if (POSAL_MEM_PROF_STARTED != __atomic_load_n(&g_posal_mem_prof_ptr->mem_prof_status, __ATOMIC_ACQUIRE))
    {
-      posal_mutex_unlock(g_posal_mem_prof_ptr->prof_mutex);
       return;
    }
+   uint32_t generation = __atomic_load_n(&g_posal_mem_prof_ptr->generation, __ATOMIC_RELAXED);
 
    mem_size = posal_mem_prof_get_mem_size(ptr, orig_heap_id);
 #ifdef DEBUG_POSAL_MEM_PROF
@@ -276,7 +518,6 @@ inline void posal_mem_prof_post_process_malloc(void *ptr, POSAL_HEAP_ID orig_hea
 #endif
    if (8 >= mem_size)
    {
-      posal_mutex_unlock(g_posal_mem_prof_ptr->prof_mutex);
       return;
    }
 
@@ -284,40 +525,35 @@ inline void posal_mem_prof_post_process_malloc(void *ptr, POSAL_HEAP_ID orig_hea
    marker_ptr          = (posal_mem_prof_marker_t *)(((uint8_t *)ptr) + mem_size - sizeof(posal_mem_prof_marker_t));
    marker_ptr->heap_id = orig_heap_id;
 
-   /** Update the tail of the memory allocated with with a magic number as well */
-   marker_ptr->magic_number = POSAL_MEM_PROF_MAGIC_NUMBER;
+   /** Update the tail of the memory allocated with a magic number of this session, so that frees of memory
+    *  allocated in an earlier session are not counted */
+   marker_ptr->magic_number = POSAL_MEM_PROF_MAGIC_NUMBER + generation;
 
    /** Update stats */
-   posal_mem_prof_update_stats(ptr, orig_heap_id, IS_MALLOC_TRUE, mem_size);
-   posal_mutex_unlock(g_posal_mem_prof_ptr->prof_mutex);
+   posal_mem_prof_update_stats(orig_heap_id, generation, (mem_size - sizeof(posal_mem_prof_marker_t)), site_ptr);
    return;
 }
 
 inline void posal_mem_prof_process_free(void *ptr)
 {
-   bool_t                   IS_MALLOC_FALSE = FALSE;
-   uint32_t                 mem_size        = 0;
-   POSAL_HEAP_ID            heap_id         = POSAL_HEAP_INVALID;
-   posal_mem_prof_marker_t *marker_ptr      = NULL;
+   uint32_t                 mem_size   = 0;
+   posal_mem_prof_marker_t *marker_ptr = NULL;
 
    if ((NULL == ptr) || (NULL == g_posal_mem_prof_ptr))
    {
       return;
    }
 
-   posal_mutex_lock(g_posal_mem_prof_ptr->prof_mutex);
-   if (POSAL_MEM_PROF_STARTED == g_posal_mem_prof_ptr->mem_prof_status)
+   if (POSAL_MEM_PROF_STARTED == __atomic_load_n(&g_posal_mem_prof_ptr->mem_prof_status, __ATOMIC_ACQUIRE))
    {
-      mem_size = posal_mem_prof_get_mem_size(ptr, heap_id);
+      uint32_t generation = __atomic_load_n(&g_posal_mem_prof_ptr->generation, __ATOMIC_RELAXED);
+
+      mem_size = posal_mem_prof_get_mem_size(ptr, POSAL_HEAP_INVALID);
 #ifdef DEBUG_POSAL_MEM_PROF
-      AR_MSG(DBG_HIGH_PRIO,
-             "POSAL MEM PROF: posal_mem_prof_pre_process_malloc. ptr = 0x%X, mem_size = %lu",
-             ptr,
-             mem_size);
+      AR_MSG(DBG_HIGH_PRIO, "POSAL MEM PROF: posal_mem_prof_process_free. ptr = 0x%X, mem_size = %lu", ptr, mem_size);
 #endif
       if ((8 >= mem_size) || (ALIGN_4_BYTES(mem_size) != mem_size))
       {
-         posal_mutex_unlock(g_posal_mem_prof_ptr->prof_mutex);
          return;
       }
 
@@ -325,19 +561,21 @@ inline void posal_mem_prof_process_free(void *ptr)
       marker_ptr = (posal_mem_prof_marker_t *)(((uint8_t *)ptr) + mem_size - sizeof(posal_mem_prof_marker_t));
 
       /** Get and check for the magic number from tail and reset it and update stats if valid */
-      if (POSAL_MEM_PROF_MAGIC_NUMBER == marker_ptr->magic_number)
+      if ((POSAL_MEM_PROF_MAGIC_NUMBER + generation) == marker_ptr->magic_number)
       {
          marker_ptr->magic_number = 0; // Reset the magic number so it wont come by accident later
-         posal_mem_prof_update_stats(ptr, marker_ptr->heap_id, IS_MALLOC_FALSE, mem_size);
+         posal_mem_prof_update_stats(marker_ptr->heap_id,
+                                     generation,
+                                     -((int64_t)(mem_size - sizeof(posal_mem_prof_marker_t))),
+                                     NULL);
       }
    }
-   posal_mutex_unlock(g_posal_mem_prof_ptr->prof_mutex);
    return;
 }
 
 void posal_mem_prof_query(POSAL_HEAP_ID heap_id, uint32_t *mem_usage_ptr)
 {
-   posal_mem_prof_node_t *mem_prof_node_ptr = NULL;
+   int64_t mem_count = 0;
 
    if ((NULL == g_posal_mem_prof_ptr) || (NULL == mem_usage_ptr))
    {
@@ -350,14 +588,43 @@ void posal_mem_prof_query(POSAL_HEAP_ID heap_id, uint32_t *mem_usage_ptr)
    posal_mutex_lock(g_posal_mem_prof_ptr->prof_mutex);
    if (POSAL_MEM_PROF_STARTED == g_posal_mem_prof_ptr->mem_prof_status)
    {
-      /**  Find the hash node and update mem usage if valid entry is found */
-      mem_prof_node_ptr =
-         (posal_mem_prof_node_t *)spf_hashtable_find(&g_posal_mem_prof_ptr->mem_ht, &heap_id, sizeof(POSAL_HEAP_ID));
+      uint32_t generation = g_posal_mem_prof_ptr->generation;
+      uint32_t hash       = posal_mem_prof_hash((uint32_t)heap_id);
+
+      /** Sum the counts of all threads, an id is in at most one entry of each table */
+      for (uint32_t i = 0; i < POSAL_MEM_PROF_MAX_SHARED_ID_PROBES; i++)
+      {
+         posal_mem_prof_counter_t *counter_ptr =
+            &g_posal_mem_prof_ptr->shared_counters[(hash + i) & (POSAL_MEM_PROF_SHARED_IDS - 1)];
+         if ((uint32_t)heap_id == __atomic_load_n(&counter_ptr->heap_id, __ATOMIC_RELAXED))
+         {
+            mem_count += __atomic_load_n(&counter_ptr->mem_count, __ATOMIC_RELAXED);
+            break;
+         }
+      }
 
-      if (NULL != mem_prof_node_ptr)
+      for (uint32_t t = 0; t < POSAL_MEM_PROF_MAX_THREADS; t++)
       {
-         *mem_usage_ptr = mem_prof_node_ptr->mem_count;
+         posal_mem_prof_thread_t *thread_ptr = &g_posal_mem_prof_ptr->threads[t];
+         if (!__atomic_load_n(&thread_ptr->in_use, __ATOMIC_ACQUIRE) ||
+             (generation != __atomic_load_n(&thread_ptr->generation, __ATOMIC_ACQUIRE)))
+         {
+            continue;
+         }
+         for (uint32_t i = 0; i < POSAL_MEM_PROF_MAX_ID_PROBES; i++)
+         {
+            posal_mem_prof_counter_t *counter_ptr =
+               &thread_ptr->counters[(hash + i) & (POSAL_MEM_PROF_IDS_PER_THREAD - 1)];
+            if ((uint32_t)heap_id == __atomic_load_n(&counter_ptr->heap_id, __ATOMIC_RELAXED))
+            {
+               mem_count += __atomic_load_n(&counter_ptr->mem_count, __ATOMIC_RELAXED);
+               break;
+            }
+         }
       }
+
+      /** Frees racing with the query can make the sum momentarily negative */
+      *mem_usage_ptr = (mem_count > 0) ? (uint32_t)MIN(mem_count, UINT32_MAX) : 0;
    }
    else
    {
@@ -22,13 +22,22 @@
  * ------------------------------------------------------------------------- */
 #define TRACK_MEM_STATS_TRUE TRUE
 
+extern posal_heap_table_t posal_heap_table[POSAL_HEAP_MGR_MAX_NUM_HEAPS];
+
 /*----------------------------------------------------------------------------------------------------------------------
 
 ----------------------------------------------------------------------------------------------------------------------*/
 
 bool_t posal_check_if_addr_within_heap_idx_range(uint32_t heap_table_idx, void *target_addr)
 {
-   bool_t addr_within_range = FALSE;
+   bool_t   addr_within_range = FALSE;
+   uint64_t addr              = (uint64_t)(uintptr_t)target_addr;
+
+   if (posal_heap_table[heap_table_idx].used_flag && (addr >= posal_heap_table[heap_table_idx].start_addr) &&
+       (addr < posal_heap_table[heap_table_idx].end_addr))
+   {
+      addr_within_range = TRUE;
+   }
 
    return addr_within_range;
 }
@@ -37,9 +46,12 @@ bool_t posal_check_if_addr_within_heap_idx_range(uint32_t heap_table_idx, void *
  test framework has a reference to posal_memory_malloc_internal such that track_mem_stats can be passed as False
 for test fwk. For all other purposes posal_memory_aligned_malloc should be directly used
 the inline function helps heap tracker to look for original caller. Looks like heap walker looks at 2 levels deep in the
-stack only
+stack only. caller_ptr is the return address of the public function, the allocation site for memory profiling.
 ----------------------------------------------------------------------------------------------------------------------*/
-static inline void *posal_memory_malloc_inline(uint32_t unBytes, POSAL_HEAP_ID origheapId, bool_t track_mem_stats)
+static inline void *posal_memory_malloc_inline(uint32_t      unBytes,
+                                               POSAL_HEAP_ID origheapId,
+                                               bool_t        track_mem_stats,
+                                               void *        caller_ptr)
 {
    void *        ptr            = NULL;
 
@@ -91,10 +103,18 @@ static inline void *posal_memory_malloc_inline(uint32_t unBytes, POSAL_HEAP_ID o
       goto __posal_memory_malloc_end;
    }
 
-   ptr = malloc(appended_bytes);
+   // heaps created on a region are served by the heap manager, others (and unmanaged regions) by libc.
+   if ((POSAL_HEAP_DEFAULT != heapId) && posal_heap_table[HEAP_TABLE_INDEX_FROM_HEAP_ID(heapId)].heapmgr_ptr)
+   {
+      ptr = posal_heapmgr_malloc(HEAP_TABLE_INDEX_FROM_HEAP_ID(heapId), appended_bytes);
+   }
+   else
+   {
+      ptr = malloc(appended_bytes);
+   }
 
 __posal_memory_malloc_end:
-   posal_mem_prof_post_process_malloc(ptr, origheapId, (appended_bytes != unBytes));
+   posal_mem_prof_post_process_malloc(ptr, origheapId, (appended_bytes != unBytes), caller_ptr);
    if (NULL == ptr)
    {
 
@@ -129,7 +149,7 @@ __posal_memory_malloc_end:
 
 void *posal_memory_malloc_internal(uint32_t unBytes, POSAL_HEAP_ID origheapId, bool_t track_mem_stats)
 {
-   return posal_memory_malloc_inline(unBytes, origheapId, track_mem_stats);
+   return posal_memory_malloc_inline(unBytes, origheapId, track_mem_stats, __builtin_return_address(0));
 }
 
 /*----------------------------------------------------------------------------------------------------------------------
@@ -147,13 +167,24 @@ void posal_memory_free_internal(void *ptr, bool_t track_mem_stats)
       return;
    }
 
+   bool_t is_heapmgr_ptr = posal_heapmgr_find_heap_idx(ptr, &heap_table_idx);
+   heap_id = is_heapmgr_ptr ? (POSAL_HEAP_ID)HEAP_ID_FROM_HEAP_TABLE_INDEX(heap_table_idx) : POSAL_HEAP_DEFAULT;
+
    posal_mem_prof_process_free(ptr);
 
    if (track_mem_stats)
    {
-      posal_memory_stats_update(ptr, IS_FREE, 0, POSAL_DEFAULT_HEAP_INDEX);
+      posal_memory_stats_update(ptr, IS_FREE, 0, heap_id);
+   }
+
+   if (is_heapmgr_ptr)
+   {
+      posal_heapmgr_free(heap_table_idx, ptr);
+   }
+   else
+   {
+      free(ptr);
    }
-   free(ptr);
 }
 
 /*----------------------------------------------------------------------------------------------------------------------
@@ -162,7 +193,8 @@ see comment in the other inline function
 static inline void *posal_memory_aligned_malloc_inline(uint32_t      unBytes,
                                                        uint32_t      unAlignSize,
                                                        POSAL_HEAP_ID origheapId,
-                                                       bool_t        track_mem_stats)
+                                                       bool_t        track_mem_stats,
+                                                       void *        caller_ptr)
 {
    POSAL_HEAP_ID heapId = GET_ACTUAL_HEAP_ID(origheapId);
 
@@ -186,7 +218,10 @@ static inline void *posal_memory_aligned_malloc_inline(uint32_t      unBytes,
 
    /* allocate enough for requested bytes + alignment wasteage + 1 word for storing offset*/
    /* (which will be just before the aligned ptr) */
-   ptr = (char *)posal_memory_malloc_inline(unBytes + unAlignSize + sizeof(int), origheapId, track_mem_stats);
+   ptr = (char *)posal_memory_malloc_inline(unBytes + unAlignSize + sizeof(int),
+                                            origheapId,
+                                            track_mem_stats,
+                                            caller_ptr);
    if (ptr == NULL)
       return (NULL);
    /* allocate enough for requested bytes + alignment wasteage + 1 word for storing offset */
@@ -206,7 +241,11 @@ void *posal_memory_aligned_malloc_internal(uint32_t      unBytes,
                                            POSAL_HEAP_ID origheapId,
                                            bool_t        track_mem_stats)
 {
-   return posal_memory_aligned_malloc_inline(unBytes, unAlignSize, origheapId, track_mem_stats);
+   return posal_memory_aligned_malloc_inline(unBytes,
+                                             unAlignSize,
+                                             origheapId,
+                                             track_mem_stats,
+                                             __builtin_return_address(0));
 }
 /*----------------------------------------------------------------------------------------------------------------------
 
@@ -230,22 +269,9 @@ void posal_memory_aligned_free_internal(void *ptr, bool_t track_mem_stats)
 
 }
 
-ar_result_t posal_memory_heapmgr_create(POSAL_HEAP_ID *heap_id_ptr,
-                                        void *         heap_start_ptr,
-                                        uint32_t       heap_size,
-                                        bool_t         is_init_heap_needed)
-{
-   return AR_EOK;
-}
-
-ar_result_t posal_memory_heapmgr_destroy(POSAL_HEAP_ID origheapId)
-{
-   return AR_EOK;
-}
-
 void *posal_memory_malloc(uint32_t unBytes, POSAL_HEAP_ID origheapId)
 {
-   return posal_memory_malloc_inline(unBytes, origheapId, TRACK_MEM_STATS_TRUE);
+   return posal_memory_malloc_inline(unBytes, origheapId, TRACK_MEM_STATS_TRUE, __builtin_return_address(0));
 }
 
 void posal_memory_free(void *ptr)
@@ -255,7 +281,11 @@ void posal_memory_free(void *ptr)
 
 void *posal_memory_aligned_malloc(uint32_t unBytes, uint32_t unAlignSize, POSAL_HEAP_ID origheapId)
 {
-   return posal_memory_aligned_malloc_inline(unBytes, unAlignSize, origheapId, TRACK_MEM_STATS_TRUE);
+   return posal_memory_aligned_malloc_inline(unBytes,
+                                             unAlignSize,
+                                             origheapId,
+                                             TRACK_MEM_STATS_TRUE,
+                                             __builtin_return_address(0));
 }
 
 void posal_memory_aligned_free(void *ptr)
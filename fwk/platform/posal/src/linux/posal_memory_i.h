@@ -29,6 +29,7 @@ typedef struct posal_heap_table_t
    bool_t         is_phys_addr_range; /* If heap range is physical address flag, else it is virtual */
    uint64_t       start_addr;         /* Start address of the heap. */
    uint64_t       end_addr;           /* End address of the heap. */
+   void          *heapmgr_ptr;        /* Heap manager carved out of the heap, NULL if not managed by SPF. */
 } posal_heap_table_t;
 
 /* -------------------------------------------------------------------------
@@ -36,4 +37,16 @@ typedef struct posal_heap_table_t
  * ------------------------------------------------------------------------- */
 bool_t posal_check_if_addr_within_heap_idx_range(uint32_t heap_table_idx, void *target_addr);
 
+/* Allocates from a heap created with posal_memory_heapmgr_create. Returns NULL if the heap is not managed by SPF. */
+void *posal_heapmgr_malloc(uint32_t heap_table_idx, uint32_t bytes);
+
+/* Returns TRUE and the heap table index if ptr was allocated from a heap managed by SPF. */
+bool_t posal_heapmgr_find_heap_idx(void *ptr, uint32_t *heap_table_idx_ptr);
+
+/* Frees memory allocated with posal_heapmgr_malloc */
+void posal_heapmgr_free(uint32_t heap_table_idx, void *ptr);
+
+/* Usable size of memory allocated with posal_heapmgr_malloc */
+uint32_t posal_heapmgr_get_block_size(uint32_t heap_table_idx, void *ptr);
+
 #endif // POSAL_BUFMGR_I_H
\ No newline at end of file
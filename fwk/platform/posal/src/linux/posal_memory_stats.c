@@ -38,6 +38,23 @@ void posal_memory_stats_deinit(void)
 
 void posal_memory_stats_update(void *ptr, uint32_t is_malloc, uint32_t bytes, POSAL_HEAP_ID origheapId)
 {
+   // allocation counts are always kept so that host tools can report allocations per command/frame
+   // byte usage of the heaps created on a region is kept by the heap manager
+   POSAL_HEAP_ID heap_id = GET_ACTUAL_HEAP_ID(origheapId);
+   if (heap_id >= POSAL_HEAP_OUT_OF_RANGE)
+   {
+      heap_id = POSAL_HEAP_DEFAULT;
+   }
+
+   if (IS_MALLOC == is_malloc)
+   {
+      __atomic_fetch_add(&posal_globalstate.avs_stats[heap_id].num_mallocs, 1, __ATOMIC_RELAXED);
+   }
+   else
+   {
+      __atomic_fetch_add(&posal_globalstate.avs_stats[heap_id].num_frees, 1, __ATOMIC_RELAXED);
+   }
+
 #if defined(DEBUG_POSAL_MEMORY) || defined(HEAP_PROFILING)
    uint32_t un_bytes = posal_mem_prof_get_mem_size(ptr, origheapId);
    un_bytes          = un_bytes ? un_bytes : bytes; // if zero is returned by posal_mem_prof_get_mem_size
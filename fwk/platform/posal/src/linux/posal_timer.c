@@ -15,6 +15,7 @@ INCLUDE FILES FOR MODULE
 #include <signal.h>           /* Definition of SIGEV_* constants */
 #include <time.h>
 #include <unistd.h> // for usleep
+#include <pthread.h>
 #include "posal_internal.h"
 #include "posal_target_i.h"
 #include <ar_osal_timer.h>
@@ -26,6 +27,22 @@ INCLUDE FILES FOR MODULE
 #define TIMER_SIGNAL_MARGIN 300
 #define TIMER_SLEEP_MARGIN 200
 
+/* Max number of periodic timers driven by the simulated clock */
+#define POSAL_TIMER_SIM_MAX_TIMERS 16
+
+/* Simulated clock. When enabled, time queries return the simulated time and periodic
+ * timers are fired from posal_timer_sim_clock_advance() instead of the OS timer. */
+typedef struct posal_timer_sim_clock_t
+{
+   bool_t              is_enabled;
+   uint64_t            now_us;
+   pthread_mutex_t     lock;
+   posal_timer_info_t *timers[POSAL_TIMER_SIM_MAX_TIMERS];
+   uint64_t            next_fire_us[POSAL_TIMER_SIM_MAX_TIMERS];
+} posal_timer_sim_clock_t;
+
+static posal_timer_sim_clock_t posal_timer_sim_clock = { .is_enabled = FALSE, .lock = PTHREAD_MUTEX_INITIALIZER };
+
 /* =======================================================================
  **                          Function Definitions
  ** ======================================================================= */
@@ -49,11 +66,29 @@ ar_result_t posal_timer_destroy(posal_timer_t *pp_obj)
    return posal_timer_destroy_v2(pp_obj);
 }
 
+static void posal_timer_sim_remove(posal_timer_info_t *p_timer)
+{
+   pthread_mutex_lock(&posal_timer_sim_clock.lock);
+   for (uint32_t i = 0; i < POSAL_TIMER_SIM_MAX_TIMERS; i++)
+   {
+      if (p_timer == posal_timer_sim_clock.timers[i])
+      {
+         posal_timer_sim_clock.timers[i] = NULL;
+      }
+   }
+   pthread_mutex_unlock(&posal_timer_sim_clock.lock);
+}
+
 ar_result_t posal_timer_destroy_v2(posal_timer_t *pp_obj)
 {
    posal_timer_info_t *p_timer = NULL;
    int                 nStatus = 0;
 
+   if ((NULL != pp_obj) && (NULL != *pp_obj) && posal_timer_sim_clock.is_enabled)
+   {
+      posal_timer_sim_remove((posal_timer_info_t *)*pp_obj);
+   }
+
    return AR_EOK;
 }
 
@@ -252,6 +287,10 @@ int32_t posal_timer_sleep(int64_t llMicrosec)
  */
 uint64_t posal_timer_get_time(void)
 {
+   if (posal_timer_sim_clock.is_enabled)
+   {
+      return __atomic_load_n(&posal_timer_sim_clock.now_us, __ATOMIC_ACQUIRE);
+   }
    return ar_timer_get_time_in_us();
 }
 
@@ -273,6 +312,10 @@ uint64_t posal_timer_get_time(void)
  */
 uint64_t posal_timer_get_time_in_msec(void)
 {
+   if (posal_timer_sim_clock.is_enabled)
+   {
+      return posal_timer_get_time() / 1000;
+   }
    return  ar_timer_get_time_in_ms();
 }
 
@@ -318,6 +361,27 @@ int32_t posal_timer_periodic_start(posal_timer_t p_obj, int64_t duration)
    timer_t *timer = (timer_t*) p_timer->timer_obj;
    struct itimerspec its = {0};
 
+   if (posal_timer_sim_clock.is_enabled)
+   {
+      ar_result_t result = AR_ENORESOURCE;
+      posal_timer_sim_remove(p_timer);
+
+      pthread_mutex_lock(&posal_timer_sim_clock.lock);
+      for (uint32_t i = 0; i < POSAL_TIMER_SIM_MAX_TIMERS; i++)
+      {
+         if (NULL == posal_timer_sim_clock.timers[i])
+         {
+            p_timer->duration                      = duration;
+            posal_timer_sim_clock.timers[i]       = p_timer;
+            posal_timer_sim_clock.next_fire_us[i] = posal_timer_sim_clock.now_us + duration;
+            result                                 = AR_EOK;
+            break;
+         }
+      }
+      pthread_mutex_unlock(&posal_timer_sim_clock.lock);
+      return result;
+   }
+
    //Set the timer delay and interval
    its.it_interval.tv_sec = 0;
    its.it_interval.tv_nsec = duration * 1000; //Convert duration to nanoseconds
@@ -371,6 +435,10 @@ int32_t posal_timer_periodic_start_with_offset(posal_timer_t p_obj, int64_t peri
  */
 int32_t posal_timer_stop(posal_timer_t p_obj)
 {
+   if ((NULL != p_obj) && posal_timer_sim_clock.is_enabled)
+   {
+      posal_timer_sim_remove((posal_timer_info_t *)p_obj);
+   }
    return AR_EOK;
 }
 
@@ -393,7 +461,8 @@ uint64_t posal_timer_get_remaining_duration(posal_timer_t p_obj)
 }
 
 /**
-   Gets the HW tick
+   Gets the HW tick. On Linux a tick is one nanosecond of CLOCK_MONOTONIC, it is not affected
+   by the simulated clock.
 
    @param[in] none
 
@@ -403,11 +472,86 @@ uint64_t posal_timer_get_remaining_duration(posal_timer_t p_obj)
 
 uint64_t posal_timer_get_hw_ticks(void)
 {
-   return AR_ENOTIMPL;
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ((uint64_t)ts.tv_sec * 1000000000) + (uint64_t)ts.tv_nsec;
 }
 
+uint64_t posal_convert_tick_to_time(uint64_t tick_count)
+{
+   return tick_count / 1000;
+}
 
 uint64_t posal_timer_time_to_tick(uint64_t time_us)
 {
-   return AR_ENOTIMPL;
+   return time_us * 1000;
+}
+
+/**
+  Switches the POSAL time source to a simulated clock starting at the given time.
+
+  @param[in] start_time_us  Initial value of the simulated clock, in microseconds.
+
+  @detdesc
+  Must be called before any timer is started. Used by host tools to run graphs
+  faster than real time.
+ */
+void posal_timer_sim_clock_enable(uint64_t start_time_us)
+{
+   pthread_mutex_lock(&posal_timer_sim_clock.lock);
+   memset(posal_timer_sim_clock.timers, 0, sizeof(posal_timer_sim_clock.timers));
+   __atomic_store_n(&posal_timer_sim_clock.now_us, start_time_us, __ATOMIC_RELEASE);
+   posal_timer_sim_clock.is_enabled = TRUE;
+   pthread_mutex_unlock(&posal_timer_sim_clock.lock);
+}
+
+/**
+  Advances the simulated clock.
+
+  @param[in] duration_us  Time to advance, in microseconds.
+
+  @detdesc
+  Periodic timers that expire within the advanced duration are signaled once each,
+  in expiry order. Expiries of one timer within a single advance are coalesced.
+ */
+void posal_timer_sim_clock_advance(uint64_t duration_us)
+{
+   pthread_mutex_lock(&posal_timer_sim_clock.lock);
+
+   uint64_t target_us = posal_timer_sim_clock.now_us + duration_us;
+
+   while (TRUE)
+   {
+      int32_t  next_idx     = -1;
+      uint64_t next_fire_us = target_us;
+
+      for (uint32_t i = 0; i < POSAL_TIMER_SIM_MAX_TIMERS; i++)
+      {
+         if ((NULL != posal_timer_sim_clock.timers[i]) && (posal_timer_sim_clock.next_fire_us[i] <= next_fire_us))
+         {
+            next_idx     = i;
+            next_fire_us = posal_timer_sim_clock.next_fire_us[i];
+         }
+      }
+
+      if (next_idx < 0)
+      {
+         break;
+      }
+
+      posal_timer_info_t *p_timer = posal_timer_sim_clock.timers[next_idx];
+      __atomic_store_n(&posal_timer_sim_clock.now_us, next_fire_us, __ATOMIC_RELEASE);
+
+      // skip the expiries that fall in this advance, they are coalesced into one signal
+      do
+      {
+         posal_timer_sim_clock.next_fire_us[next_idx] += MAX(p_timer->duration, 1);
+      } while (posal_timer_sim_clock.next_fire_us[next_idx] <= target_us);
+
+      union sigval sv = { .sival_ptr = p_timer };
+      posal_timer_expire_cb(sv);
+   }
+
+   __atomic_store_n(&posal_timer_sim_clock.now_us, target_us, __ATOMIC_RELEASE);
+   pthread_mutex_unlock(&posal_timer_sim_clock.lock);
 }
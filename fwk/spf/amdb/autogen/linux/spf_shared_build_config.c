@@ -0,0 +1,23 @@
+/** Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved. */
+/** SPDX-License-Identifier: BSD-3-Clause-Clear */
+/** ***** This is an autogenerated file ***** **/
+/** ***** DO NOT EDIT THIS FILE ***** **/
+
+#include "spf_begin_pragma.h" 
+#include "spf_shared_build_config.h"
+
+const amdb_dynamic_capi_module_t amdb_spf_dynamic_capi_modules[] = 
+{
+
+};
+
+const uint32_t amdb_spf_num_dynamic_capi_modules = 0;
+
+const amdb_dynamic_capi_module_t amdb_dynamic_capi_modules[] = 
+{
+
+};
+
+const uint32_t amdb_num_dynamic_capi_modules = 0;
+
+#include "spf_end_pragma.h"
@@ -0,0 +1,52 @@
+/** Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved. */
+/** SPDX-License-Identifier: BSD-3-Clause-Clear */
+/** ***** This is an autogenerated file ***** **/
+/** ***** DO NOT EDIT THIS FILE ***** **/
+
+#include "spf_begin_pragma.h" 
+#include "spf_static_build_config.h"
+
+const amdb_module_id_t amdb_virtual_stub_modules[] = 
+{
+
+};
+
+const uint32_t amdb_num_virtual_stub_modules = 0;
+
+const amdb_static_capi_module_t amdb_spf_static_capi_modules[] = 
+{
+{        PP,  0x7001014, capi_multistageiir_get_static_properties, capi_multistageiir_init                 },
+{ END_POINT, 0x18000002, capi_alsa_device_sink_get_static_properties, capi_alsa_device_sink_init              },
+{   GENERIC,  0x700106a, capi_data_marker_get_static_properties  , capi_data_marker_init                   },
+{        PP,  0x7001017, capi_iir_mbdrc_get_static_properties    , capi_iir_mbdrc_init                     },
+{   GENERIC,  0x7001032, capi_spr_get_static_properties          , capi_spr_init                           },
+{        PP,  0x7001003, capi_pcm_cnv_get_static_properties      , capi_pcm_cnv_init                       },
+{   GENERIC,  0x700101a, capi_data_logging_get_static_properties , capi_data_logging_init                  },
+{   GENERIC,  0x7001038, capi_sync_get_static_properties         , capi_sync_init                          },
+{   GENERIC,  0x7001007, capi_push_mode_get_static_properties    , capi_push_mode_init                     },
+{        PP,  0x7001015, capi_mfc_get_static_properties          , capi_mfc_init                           },
+{   GENERIC,  0x7001011, capi_splitter_get_static_properties     , capi_splitter_init                      },
+{        PP,  0x7001016, capi_dynamic_resampler_get_static_properties, capi_dynamic_resampler_init             },
+{   GENERIC,  0x7001041, capi_siso_rat_get_static_properties     , capi_siso_rat_init                      },
+{ FRAMEWORK,  0x7001000, NULL                                    , NULL                                    },
+{        PP,  0x7001018, capi_iir_resampler_get_static_properties, capi_iir_resampler_init                 },
+{   GENERIC,  0x700101c, capi_latency_get_static_properties      , capi_latency_init                       },
+{   ENCODER,  0x7001004, capi_pcm_enc_get_static_properties      , capi_pcm_enc_init                       },
+{   DECODER,  0x7001005, capi_pcm_dec_get_static_properties      , capi_pcm_dec_init                       },
+{   GENERIC,  0x7001028, capi_priority_sync_get_static_properties, capi_priority_sync_init                 },
+{        PP,  0x7001066, capi_drc_get_static_properties          , capi_drc_init                           },
+{   GENERIC,  0x7001006, capi_pull_mode_get_static_properties    , capi_pull_mode_init                     },
+{        PP,  0x7001013, capi_chmixer_get_static_properties      , capi_chmixer_init                       },
+
+};
+
+const uint32_t amdb_spf_num_static_capi_modules = 22;
+
+const amdb_static_capi_module_t amdb_static_capi_modules[] = 
+{
+
+};
+
+const uint32_t amdb_num_static_capi_modules = 0;
+
+#include "spf_end_pragma.h"
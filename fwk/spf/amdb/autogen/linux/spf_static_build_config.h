@@ -0,0 +1,99 @@
+/** Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved. */
+/** SPDX-License-Identifier: BSD-3-Clause-Clear */
+/** ***** This is an autogenerated file ***** **/
+/** ***** DO NOT EDIT THIS FILE ***** **/
+
+#ifndef __SPF_STATIC_BUILD_CONFIG_H_
+#define __SPF_STATIC_BUILD_CONFIG_H_
+
+#include "amdb_api.h"
+#include "capi.h"
+#include "amdb_autogen_def.h"
+
+#define VIRTUAL_STUB 1
+#define CAPI       2
+
+#define GENERIC    2
+#define DECODER    3
+#define ENCODER    4
+#define CONVERTER  5
+#define PACKETIZER 6
+#define DEPACKETIZER 7
+#define DETECTOR   8
+#define GENERATOR  9
+#define PP         10
+#define END_POINT  11
+#define FRAMEWORK  1
+
+#ifdef __cplusplus 
+extern "C" {
+#endif //__cplusplus 
+capi_err_t capi_multistageiir_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_multistageiir_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+capi_err_t capi_alsa_device_sink_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_alsa_device_sink_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+capi_err_t capi_data_marker_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_data_marker_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+capi_err_t capi_iir_mbdrc_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_iir_mbdrc_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+capi_err_t capi_spr_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_spr_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+capi_err_t capi_pcm_cnv_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_pcm_cnv_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+capi_err_t capi_data_logging_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_data_logging_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+capi_err_t capi_sync_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_sync_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+capi_err_t capi_push_mode_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_push_mode_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+capi_err_t capi_mfc_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_mfc_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+capi_err_t capi_splitter_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_splitter_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+capi_err_t capi_dynamic_resampler_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_dynamic_resampler_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+capi_err_t capi_siso_rat_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_siso_rat_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+capi_err_t capi_iir_resampler_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_iir_resampler_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+capi_err_t capi_latency_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_latency_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+capi_err_t capi_pcm_enc_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_pcm_enc_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+capi_err_t capi_pcm_dec_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_pcm_dec_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+capi_err_t capi_priority_sync_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_priority_sync_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+capi_err_t capi_drc_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_drc_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+capi_err_t capi_pull_mode_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_pull_mode_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+capi_err_t capi_chmixer_get_static_properties (capi_proplist_t *init_set_proplist, capi_proplist_t *static_proplist);
+capi_err_t capi_chmixer_init (capi_t* _pif, capi_proplist_t *init_set_proplist);
+
+#ifdef __cplusplus 
+} /*extern c*/ 
+#endif //__cplusplus 
+
+#endif /*__SPF_STATIC_BUILD_CONFIG_H_*/
+
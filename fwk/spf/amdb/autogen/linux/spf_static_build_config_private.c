@@ -0,0 +1,16 @@
+/** Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved. */
+/** SPDX-License-Identifier: BSD-3-Clause-Clear */
+/** ***** This is an autogenerated file ***** **/
+/** ***** DO NOT EDIT THIS FILE ***** **/
+
+#include "spf_begin_pragma.h" 
+#include "spf_static_build_config_private.h"
+
+const amdb_static_capi_module_t amdb_private_static_capi_modules[] = 
+{
+
+};
+
+const uint32_t amdb_num_static_private_capi_modules = 0;
+
+#include "spf_end_pragma.h"
@@ -0,0 +1,36 @@
+/** Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved. */
+/** SPDX-License-Identifier: BSD-3-Clause-Clear */
+/** ***** This is an autogenerated file ***** **/
+/** ***** DO NOT EDIT THIS FILE ***** **/
+
+#ifndef __SPF_STATIC_PRIV_BUILD_CONFIG_H_
+#define __SPF_STATIC_PRIV_BUILD_CONFIG_H_
+
+#include "amdb_api.h"
+#include "capi.h"
+#include "amdb_autogen_def.h"
+
+#define VIRTUAL_STUB 1
+#define CAPI       2
+
+#define GENERIC    2
+#define DECODER    3
+#define ENCODER    4
+#define CONVERTER  5
+#define PACKETIZER 6
+#define DEPACKETIZER 7
+#define DETECTOR   8
+#define GENERATOR  9
+#define PP         10
+#define END_POINT  11
+#define FRAMEWORK  1
+
+#ifdef __cplusplus 
+extern "C" {
+#endif //__cplusplus 
+#ifdef __cplusplus 
+} /*extern c*/ 
+#endif //__cplusplus 
+
+#endif /*__SPF_STATIC_PRIVATE_BUILD_CONFIG_H_*/
+
@@ -86,10 +86,17 @@ typedef struct apm_container_t apm_container_t;
  *  Constants/Macros
  *----------------------------------------------------------------------------*/
 
+/**< Max number of commands under process in parallel. Command control objects
+     are allocated on demand, one per slot, and retained for reuse. Bounded by the
+     width of the 32-bit active command masks */
 #if defined(CHIP_SPECIFIC) && defined(APM_NUM_MAX_PARALLEL_CMD)
     //APM_NUM_MAX_PARALLEL_CMD gets injected from chipspecific
 #else
-  #define APM_NUM_MAX_PARALLEL_CMD  (4)
+  #define APM_NUM_MAX_PARALLEL_CMD  (32)
+#endif
+
+#if (APM_NUM_MAX_PARALLEL_CMD > 32)
+  #error "APM_NUM_MAX_PARALLEL_CMD must fit in the 32-bit active command mask"
 #endif
 
 #define APM_NUM_MAX_CAPABILITIES    (4)
@@ -556,8 +563,9 @@ struct apm_cont_cmd_list_t
    uint32_t                   active_cmd_mask;
    /**< Bit mask for active commands under process */
 
-   apm_cont_cmd_ctrl_t        cmd_ctrl_list[APM_NUM_MAX_PARALLEL_CMD];
-   /**< Cached configuration parameters from client */
+   apm_cont_cmd_ctrl_t       *cmd_ctrl_list[APM_NUM_MAX_PARALLEL_CMD];
+   /**< Command control objects, allocated on first use
+        of the slot */
 };
 
 
@@ -254,6 +254,9 @@ void apm_destroy()
    /** Destroy the channel */
    posal_channel_destroy(&apm_info_ptr->channel_ptr);
 
+   /** Free up the command control objects, once the work loop has exited */
+   apm_cmd_slot_list_free((void **)apm_info_ptr->cmd_ctrl_list);
+
    AR_MSG(DBG_HIGH_PRIO, "Completed apm_destroy() ...");
 
    return;
@@ -61,24 +61,24 @@ static ar_result_t apm_allocate_cmd_ctrl_obj(apm_t *apm_info_ptr, spf_msg_t *msg
    /** Get GPR packet pointer */
    cmd_opcode = apm_get_cmd_opcode_from_msg_payload(msg_ptr);
 
-   /** Check if all the slots in the command obj list are
-    *  occupied.
-    *  This condition should not hit as the APM cmd Q is removed
-    *  from the wait mask once all the cmd obj slots are
+   /** Get the next available slot in the command list.
+    *  Running out of slots should not hit as the APM cmd Q is
+    *  removed from the wait mask once all the cmd obj slots are
     *  occupied. */
-   if (APM_CMD_LIST_FULL_MASK == apm_info_ptr->active_cmd_mask)
+   if (NULL == (cmd_ctrl_ptr = (apm_cmd_ctrl_t *)apm_cmd_slot_alloc(&apm_info_ptr->active_cmd_mask,
+                                                                    (void **)apm_info_ptr->cmd_ctrl_list,
+                                                                    sizeof(apm_cmd_ctrl_t),
+                                                                    APM_INTERNAL_STATIC_HEAP_ID,
+                                                                    &cmd_slot_idx)))
    {
-      AR_MSG(DBG_ERROR_PRIO, "apm_set_cmd_ctrl(), cmd obj list is full, cmd_opcode[0x%lX]", cmd_opcode);
+      AR_MSG(DBG_ERROR_PRIO,
+             "apm_set_cmd_ctrl(), failed to get cmd obj, cmd_opcode[0x%lX], active_cmd_mask[0x%lX]",
+             cmd_opcode,
+             apm_info_ptr->active_cmd_mask);
 
-      return AR_EFAILED;
+      return (APM_CMD_LIST_FULL_MASK == apm_info_ptr->active_cmd_mask) ? AR_EFAILED : AR_ENOMEMORY;
    }
 
-   /** Find the next available slot in the command list */
-   cmd_slot_idx = s32_ct1_s32(apm_info_ptr->active_cmd_mask);
-
-   /** Set this bit in the active command mask */
-   APM_SET_BIT(&apm_info_ptr->active_cmd_mask, cmd_slot_idx);
-
    /** If the command list is full remove the CmdQ from the wait mask.
     *  Start listening to cmdQ again as soon as at least one of the slot becomes free */
    if (APM_CMD_LIST_FULL_MASK == apm_info_ptr->active_cmd_mask)
@@ -86,10 +86,6 @@ static ar_result_t apm_allocate_cmd_ctrl_obj(apm_t *apm_info_ptr, spf_msg_t *msg
       apm_info_ptr->curr_wait_mask &= ~(APM_CMD_Q_MASK);
    }
 
-   /** Get the pointer to command control object corresponding to
-    *  available slot */
-   cmd_ctrl_ptr = &apm_info_ptr->cmd_ctrl_list[cmd_slot_idx];
-
    /** Save the list index in cmd obj */
    cmd_ctrl_ptr->list_idx = cmd_slot_idx;
 
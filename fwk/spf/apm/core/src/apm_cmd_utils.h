@@ -89,9 +89,10 @@ static inline ar_result_t apm_cmd_ctrl_clear_cmd_pending_status(apm_cmd_ctrl_t *
    return AR_EOK;
 }
 
+/** Returns NULL if the n'th slot is out of range or was never used */
 static inline apm_cmd_ctrl_t *apm_get_nth_cmd_ctrl_obj(apm_t *apm_info_ptr, uint32_t n)
 {
-   return (&(apm_info_ptr->cmd_ctrl_list[n]));
+   return ((n < APM_NUM_MAX_PARALLEL_CMD) ? apm_info_ptr->cmd_ctrl_list[n] : NULL);
 }
 
 static inline bool_t apm_is_module_static_inst_id(uint32_t instance_id)
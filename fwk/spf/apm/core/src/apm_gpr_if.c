@@ -39,6 +39,8 @@ uint32_t apm_gpr_call_back_f(gpr_packet_t *gpr_pkt_ptr, void *cb_ctx_ptr)
 
    AR_MSG(DBG_HIGH_PRIO, "APM GPR CB, rcvd cmd opcode[0x%08lX], token:[0x%x] ", cmd_opcode, gpr_pkt_ptr->token);
 
+   POSAL_TRACE(POSAL_TRACE_GPR_RECV, gpr_pkt_ptr->dst_port, (((uint64_t)cmd_opcode << 32) | gpr_pkt_ptr->token));
+
    /* Validate GPR callback context pointer */
    if (!cb_ctx_ptr)
    {
@@ -137,8 +137,9 @@ struct apm_t
    uint32_t                active_cmd_mask;
    /**< Bit mask for active commands under process */
 
-   apm_cmd_ctrl_t          cmd_ctrl_list[APM_NUM_MAX_PARALLEL_CMD];
-   /**< List of commands under process */
+   apm_cmd_ctrl_t          *cmd_ctrl_list[APM_NUM_MAX_PARALLEL_CMD];
+   /**< List of commands under process, objects are
+        allocated on first use of the slot */
 
    apm_deferred_cmd_list_t def_cmd_list;
    /**< Commands for which the processing
@@ -388,6 +388,9 @@ ar_result_t apm_destroy_container(apm_t *apm_info_ptr, apm_container_t *containe
              container_node_ptr->container_id);
    }
 
+   /** Free up the container command control objects */
+   apm_cont_free_cmd_ctrl_list(container_node_ptr);
+
    /** Free up container memory */
    posal_memory_free(container_node_ptr);
 
@@ -3002,12 +3002,73 @@ ar_result_t apm_gm_cmd_pre_processing(apm_cmd_ctrl_t *apm_cmd_ctrl_ptr, apm_grap
    return result;
 }
 
+void *apm_cmd_slot_alloc(uint32_t     *active_cmd_mask_ptr,
+                         void        **slot_list_pptr,
+                         uint32_t      slot_size,
+                         POSAL_HEAP_ID heap_id,
+                         uint32_t     *slot_idx_ptr)
+{
+   uint32_t cmd_slot_idx;
+
+   /** Check if all the slots in the command obj list are
+    *  occupied */
+   if (APM_CMD_LIST_FULL_MASK == *active_cmd_mask_ptr)
+   {
+      return NULL;
+   }
+
+   /** Find the next available slot in the command list */
+   cmd_slot_idx = s32_ct1_s32(*active_cmd_mask_ptr);
+
+   /** Slot objects are allocated on the first use of the slot and
+    *  retained afterwards, so the memory follows the peak number
+    *  of commands in parallel instead of the max */
+   if (!slot_list_pptr[cmd_slot_idx])
+   {
+      if (NULL == (slot_list_pptr[cmd_slot_idx] = posal_memory_malloc(slot_size, heap_id)))
+      {
+         AR_MSG(DBG_ERROR_PRIO, "apm_cmd_slot_alloc(), Failed to allocate cmd obj for slot idx[%lu]", cmd_slot_idx);
+
+         return NULL;
+      }
+
+      memset(slot_list_pptr[cmd_slot_idx], 0, slot_size);
+   }
+
+   /** Set this bit in the active command mask */
+   APM_SET_BIT(active_cmd_mask_ptr, cmd_slot_idx);
+
+   *slot_idx_ptr = cmd_slot_idx;
+
+   return slot_list_pptr[cmd_slot_idx];
+}
+
+void apm_cmd_slot_list_free(void **slot_list_pptr)
+{
+   for (uint32_t idx = 0; idx < APM_NUM_MAX_PARALLEL_CMD; idx++)
+   {
+      if (slot_list_pptr[idx])
+      {
+         posal_memory_free(slot_list_pptr[idx]);
+         slot_list_pptr[idx] = NULL;
+      }
+   }
+}
+
+void apm_cont_free_cmd_ctrl_list(apm_container_t *container_node_ptr)
+{
+   apm_cmd_slot_list_free((void **)container_node_ptr->cmd_list.cmd_ctrl_list);
+
+   container_node_ptr->cmd_list.active_cmd_mask = 0;
+}
+
 ar_result_t apm_get_allocated_cont_cmd_ctrl_obj(apm_container_t *     container_node_ptr,
                                                 apm_cmd_ctrl_t *      apm_cmd_ctrl_ptr,
                                                 apm_cont_cmd_ctrl_t **cont_cmd_ctrl_pptr)
 {
    ar_result_t          result = AR_EFAILED;
    apm_cont_cmd_ctrl_t *cont_cmd_ctrl_ptr;
+   uint32_t             active_cmd_mask;
 
    if (!container_node_ptr || !cont_cmd_ctrl_pptr)
    {
@@ -3015,23 +3076,22 @@ ar_result_t apm_get_allocated_cont_cmd_ctrl_obj(apm_container_t *     container_
       return AR_EFAILED;
    }
 
-   /** Get the pointer to this container's command control
-    *  object list */
-   cont_cmd_ctrl_ptr = container_node_ptr->cmd_list.cmd_ctrl_list;
-
    /** Init the return pointer */
    *cont_cmd_ctrl_pptr = NULL;
 
-   /** Check if any of the cmd obj is already allocated for current
-    *  APM command */
-   for (uint32_t idx = 0; idx < APM_NUM_MAX_PARALLEL_CMD; idx++)
+   /** Check if any of the active cmd obj is already allocated for
+    *  current APM command */
+   for (active_cmd_mask = container_node_ptr->cmd_list.active_cmd_mask; active_cmd_mask;
+        active_cmd_mask &= (active_cmd_mask - 1))
    {
+      cont_cmd_ctrl_ptr = container_node_ptr->cmd_list.cmd_ctrl_list[s32_get_lsb_s32(active_cmd_mask)];
+
       /** If the APM cmd ctrl pointer matches with the in container
        *  cmd obj */
-      if ((void *)apm_cmd_ctrl_ptr == cont_cmd_ctrl_ptr[idx].apm_cmd_ctrl_ptr)
+      if ((void *)apm_cmd_ctrl_ptr == cont_cmd_ctrl_ptr->apm_cmd_ctrl_ptr)
       {
          /** Match found, return */
-         *cont_cmd_ctrl_pptr = &cont_cmd_ctrl_ptr[idx];
+         *cont_cmd_ctrl_pptr = cont_cmd_ctrl_ptr;
 
          return AR_EOK;
       }
@@ -3077,30 +3137,25 @@ ar_result_t apm_get_cont_cmd_ctrl_obj(apm_container_t *     container_node_ptr,
    /** Execution falls through if a new object needs to be
     *  allocated now */
 
-   /** Check if all the slots in the command obj list are
-    *  occupied.
-    *  This condition should not hit as the APM cmd Q is removed
-    *  from the wait mask once all the cmd obj slots are
+   /** Get the next available slot in the command list.
+    *  Running out of slots should not hit as the APM cmd Q is
+    *  removed from the wait mask once all the cmd obj slots are
     *  occupied. */
-   if (APM_CMD_LIST_FULL_MASK == container_node_ptr->cmd_list.active_cmd_mask)
+   if (NULL == (cont_cmd_ctrl_ptr = (apm_cont_cmd_ctrl_t *)
+                   apm_cmd_slot_alloc(&container_node_ptr->cmd_list.active_cmd_mask,
+                                      (void **)container_node_ptr->cmd_list.cmd_ctrl_list,
+                                      sizeof(apm_cont_cmd_ctrl_t),
+                                      APM_INTERNAL_STATIC_HEAP_ID,
+                                      &cmd_slot_idx)))
    {
       AR_MSG(DBG_ERROR_PRIO,
-             "apm_get_cont_cmd_ctrl_obj(), cmd obj list is full, CONT_ID[0x%lX]",
-             container_node_ptr->container_id);
+             "apm_get_cont_cmd_ctrl_obj(), failed to get cmd obj, CONT_ID[0x%lX], active_cmd_mask[0x%lX]",
+             container_node_ptr->container_id,
+             container_node_ptr->cmd_list.active_cmd_mask);
 
       return AR_EFAILED;
    }
 
-   /** Find the next available slot in the command list */
-   cmd_slot_idx = s32_ct1_s32(container_node_ptr->cmd_list.active_cmd_mask);
-
-   /** Set this bit in the active command mask */
-   APM_SET_BIT(&container_node_ptr->cmd_list.active_cmd_mask, cmd_slot_idx);
-
-   /** Get the pointer to command control object corresponding to
-    *  available slot */
-   cont_cmd_ctrl_ptr = &container_node_ptr->cmd_list.cmd_ctrl_list[cmd_slot_idx];
-
    cont_cmd_ctrl_ptr->msg_token = APM_CMD_TOKEN_CONTAINER_CTRL_TYPE;
 
    /** Save the list index in cmd obj */
@@ -50,7 +50,7 @@ extern "C" {
 
 #define APM_NUM_MAX_CONT_MSG              (3)
 
-#define APM_CMD_LIST_FULL_MASK            ((1UL << APM_NUM_MAX_PARALLEL_CMD) - 1)
+#define APM_CMD_LIST_FULL_MASK            ((uint32_t)(0xFFFFFFFFUL >> (32 - APM_NUM_MAX_PARALLEL_CMD)))
 
 #define SIZE_OF_PTR()                     (sizeof(void *))
 
@@ -506,6 +506,16 @@ ar_result_t apm_get_allocated_cont_cmd_ctrl_obj(apm_container_t *     container_
                                                 apm_cmd_ctrl_t *      apm_cmd_ctrl_ptr,
                                                 apm_cont_cmd_ctrl_t **cont_cmd_ctrl_pptr);
 
+void *apm_cmd_slot_alloc(uint32_t     *active_cmd_mask_ptr,
+                         void        **slot_list_pptr,
+                         uint32_t      slot_size,
+                         POSAL_HEAP_ID heap_id,
+                         uint32_t     *slot_idx_ptr);
+
+void apm_cmd_slot_list_free(void **slot_list_pptr);
+
+void apm_cont_free_cmd_ctrl_list(apm_container_t *container_node_ptr);
+
 ar_result_t apm_add_cont_to_pending_msg_send_list(apm_cmd_ctrl_t *     apm_cmd_ctrl_ptr,
                                                   apm_container_t *    container_node_ptr,
                                                   apm_cont_cmd_ctrl_t *cont_cmd_ctrl_ptr);
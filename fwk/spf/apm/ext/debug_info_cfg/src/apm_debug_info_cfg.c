@@ -100,11 +100,15 @@ static ar_result_t apm_util_cfg_port_media_fmt_reporting(apm_t *apm_info_ptr, ap
       {
          host_cont_node_ptr = (apm_container_t *)curr_ptr->obj_ptr;
 
-         apm_cont_cmd_ctrl_t *             cont_cmd_ctrl_ptr = host_cont_node_ptr->cmd_list.cmd_ctrl_list;
+         apm_cont_cmd_ctrl_t *             cont_cmd_ctrl_ptr = NULL;
          apm_cont_aggregate_payload_cfg_t *port_media_fmt_cfg_ptr;
          apm_cont_cached_cfg_t *           cont_cached_cfg_ptr;
 
-         apm_get_cont_cmd_ctrl_obj(host_cont_node_ptr, apm_info_ptr->curr_cmd_ctrl_ptr, &cont_cmd_ctrl_ptr);
+         if (AR_EOK !=
+             (result = apm_get_cont_cmd_ctrl_obj(host_cont_node_ptr, apm_info_ptr->curr_cmd_ctrl_ptr, &cont_cmd_ctrl_ptr)))
+         {
+            return result;
+         }
 
          if (NULL == (port_media_fmt_cfg_ptr = (apm_cont_aggregate_payload_cfg_t *)
                          posal_memory_malloc(sizeof(apm_cont_aggregate_payload_cfg_t), POSAL_HEAP_DEFAULT)))
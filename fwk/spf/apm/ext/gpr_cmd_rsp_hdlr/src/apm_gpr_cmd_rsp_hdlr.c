@@ -75,7 +75,7 @@ static ar_result_t apm_gpr_basic_rsp_handler(apm_t *apm_info_ptr, spf_msg_t *msg
    gpr_rsp_payload_ptr = GPR_PKT_GET_PAYLOAD(gpr_ibasic_rsp_result_t, gpr_pkt_ptr);
 
    cmd_ctrl_list_idx = gpr_pkt_ptr->token;
-   if (cmd_ctrl_list_idx >= APM_NUM_MAX_PARALLEL_CMD)
+   if (NULL == (apm_cmd_ctrl_ptr = apm_get_nth_cmd_ctrl_obj(apm_info_ptr, cmd_ctrl_list_idx)))
    {
       AR_MSG(DBG_ERROR_PRIO,
              "APM: apm_gpr_basic_rsp_handler: Unexpected Error: Can't recover the cmd ctx. Token %lu",
@@ -88,8 +88,6 @@ static ar_result_t apm_gpr_basic_rsp_handler(apm_t *apm_info_ptr, spf_msg_t *msg
           "apm_gpr_basic_rsp_handler(): Received GPR basic response for opcode: 0x%lX",
           gpr_rsp_payload_ptr->opcode);
 
-   apm_cmd_ctrl_ptr = apm_get_nth_cmd_ctrl_obj(apm_info_ptr, cmd_ctrl_list_idx);
-
    if (AR_EPENDING == (result = apm_aggregate_gpr_rsp(apm_info_ptr, apm_cmd_ctrl_ptr, gpr_rsp_payload_ptr)))
    {
       result |= __gpr_cmd_free(gpr_pkt_ptr);
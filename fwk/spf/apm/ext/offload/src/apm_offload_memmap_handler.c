@@ -169,7 +169,7 @@ ar_result_t apm_offload_mem_shared_memory_map_regions_rsp_handler(apm_t *apm_inf
    // First figure out which command this is a response to.
    uint32_t cmd_ctrl_list_idx = pkt_ptr->token;
 
-   if (cmd_ctrl_list_idx >= APM_NUM_MAX_PARALLEL_CMD)
+   if (NULL == (ctrl_obj_ptr = apm_get_nth_cmd_ctrl_obj(apm_info_ptr, cmd_ctrl_list_idx)))
    {
       AR_MSG(DBG_ERROR_PRIO,
              " Unexpected Error: MDF Memmap Rsp Handler: NOT sending MEMMAP RSP to the client. Can't recover the "
@@ -180,8 +180,6 @@ ar_result_t apm_offload_mem_shared_memory_map_regions_rsp_handler(apm_t *apm_inf
       return (result | AR_EUNEXPECTED);
    }
 
-   ctrl_obj_ptr = apm_get_nth_cmd_ctrl_obj(apm_info_ptr, cmd_ctrl_list_idx);
-
    if (ctrl_obj_ptr->cmd_opcode != APM_CMD_SHARED_SATELLITE_MEM_MAP_REGIONS)
    {
       AR_MSG(DBG_ERROR_PRIO,
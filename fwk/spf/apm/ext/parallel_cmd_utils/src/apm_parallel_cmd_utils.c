@@ -40,316 +40,294 @@ apm_parallel_cmd_utils_vtable_t parallel_cmd_util_funcs = {
    .apm_update_deferred_gm_cmd_fptr = apm_update_deferred_gm_cmd
 };
 
-static ar_result_t apm_gm_cmd_check_overlap_for_single_sg_id(apm_cmd_ctrl_t *curr_cmd_ctrl_ptr,
-                                                             apm_cmd_ctrl_t *list_cmd_ctrl_ptr,
-                                                             uint32_t        tgt_sg_id,
-                                                             bool_t *        sg_list_overlap_ptr)
+/** Sub-graph ID sets for the overlap check, open addressing with linear probing. Sets are sized to at least twice
+ *  the number of entries, a check needing up to APM_SG_ID_SET_STACK_SIZE slots in total does not allocate. */
+#define APM_SG_ID_SET_STACK_SIZE (128)
+#define APM_SG_ID_SET_MIN_SIZE   (8)
+
+typedef struct apm_sg_id_set_t apm_sg_id_set_t;
+
+struct apm_sg_id_set_t
 {
-   ar_result_t         result = AR_EOK;
-   apm_sub_graph_id_t *list_sg_list_ptr;
-   uint32_t            list_num_sg_id;
-   spf_list_node_t *   curr_list_sg_node_ptr;
-   apm_sub_graph_t *   curr_list_sg_obj_ptr;
+   uint32_t *slot_ptr;
+   /**< Hash slots, APM_SG_ID_INVALID marks an empty slot */
 
-   if (!curr_cmd_ctrl_ptr || !list_cmd_ctrl_ptr || !tgt_sg_id)
-   {
-      AR_MSG(DBG_ERROR_PRIO,
-             "apm_gm_cmd_check_overlap_for_single_sg_id(): Invalid i/p arg curr_cmd_ctrl[0x%lX], "
-             "list_cmd_ctrl[0x%lX], tgt SG_ID[0x%lX]",
-             curr_cmd_ctrl_ptr,
-             list_cmd_ctrl_ptr,
-             tgt_sg_id);
+   uint32_t mask;
+   /**< Number of slots - 1, number of slots is a power of 2 */
+};
 
-      return AR_EFAILED;
+static inline uint32_t apm_sg_id_set_get_size(uint32_t num_entries)
+{
+   uint32_t size = APM_SG_ID_SET_MIN_SIZE;
+
+   while (size < (num_entries << 1))
+   {
+      size <<= 1;
    }
 
-   /** Get the pointer to list of sub-graph ID for concurrent graph
-    *  managment commands under process */
-   list_sg_list_ptr = list_cmd_ctrl_ptr->graph_mgmt_cmd_ctrl.sg_list.cmd_sg_id_list_ptr;
-   list_num_sg_id   = list_cmd_ctrl_ptr->graph_mgmt_cmd_ctrl.sg_list.num_cmd_sg_id;
+   return size;
+}
 
-   for (uint32_t list_idx = 0; list_idx < list_num_sg_id; list_idx++)
-   {
-      if (tgt_sg_id == list_sg_list_ptr[list_idx].sub_graph_id)
-      {
-         /** If the match is found, return   */
-         *sg_list_overlap_ptr = TRUE;
+static inline uint32_t apm_sg_id_set_hash(uint32_t sg_id, uint32_t mask)
+{
+   /** Sub-graph ID's are mostly assigned in sequence, mix the
+    *  high bits in before masking */
+   sg_id *= 0x9E3779B1UL;
 
-         AR_MSG(DBG_HIGH_PRIO,
-                "apm_gm_cmd_check_overlap_for_single_sg_id(): SG_ID[0x%lX] in cmd_list_idx[%lu], cmd_opcode[0x%lX] , "
-                "directly matches "
-                "with cmd_list_idx[%lu], cmd_opcode[0x%lX] ",
-                tgt_sg_id,
-                curr_cmd_ctrl_ptr->list_idx,
-                curr_cmd_ctrl_ptr->cmd_opcode,
-                list_cmd_ctrl_ptr->list_idx,
-                list_cmd_ctrl_ptr->cmd_opcode);
+   return ((sg_id ^ (sg_id >> 16)) & mask);
+}
 
-         return AR_EOK;
+static void apm_sg_id_set_insert(apm_sg_id_set_t *set_ptr, uint32_t sg_id)
+{
+   uint32_t idx = apm_sg_id_set_hash(sg_id, set_ptr->mask);
 
-      } /** End of if (sub-graph ID match ) */
+   if (APM_SG_ID_INVALID == sg_id)
+   {
+      return;
+   }
 
-   } /** End of for(list sub-graph id arr) */
+   while ((APM_SG_ID_INVALID != set_ptr->slot_ptr[idx]) && (sg_id != set_ptr->slot_ptr[idx]))
+   {
+      idx = (idx + 1) & set_ptr->mask;
+   }
 
-   /** Execution falls through if current target sub-graph ID
-    *  received directly as part of GM command is not present in
-    *  other commands. Now check if this target sub-graph ID
-    *  matches with sub-graph ID being processed due to link
-    *  operation as part of other concurrently active commands */
+   set_ptr->slot_ptr[idx] = sg_id;
+}
 
-   /** Get the list of sub-graph ID's being processed due to GM
-    *  operation on links */
-   curr_list_sg_node_ptr = list_cmd_ctrl_ptr->graph_mgmt_cmd_ctrl.sg_list.cont_port_hdl_sg_list_ptr;
+static bool_t apm_sg_id_set_find(apm_sg_id_set_t *set_ptr, uint32_t sg_id)
+{
+   uint32_t idx = apm_sg_id_set_hash(sg_id, set_ptr->mask);
 
-   /** Iterate over the list of sub-graph ID's. If any of the
-    *  sub-graph matches with target sub-graph ID, break the
-    *  loop */
-   while (curr_list_sg_node_ptr)
+   while (APM_SG_ID_INVALID != set_ptr->slot_ptr[idx])
    {
-      curr_list_sg_obj_ptr = (apm_sub_graph_t *)curr_list_sg_node_ptr->obj_ptr;
-
-      /** If the match is found, break  */
-      if (tgt_sg_id == curr_list_sg_obj_ptr->sub_graph_id)
+      if (sg_id == set_ptr->slot_ptr[idx])
       {
-         *sg_list_overlap_ptr = TRUE;
+         return TRUE;
+      }
 
-         AR_MSG(DBG_HIGH_PRIO,
-                "apm_gm_cmd_check_overlap_for_single_sg_id(): SG_ID[0x%lX] in cmd_list_idx[%lu], cmd_opcode[0x%lX], "
-                "indirectly matches "
-                "with cmd_list_idx[%lu], cmd_opcode[0x%lX] ",
-                tgt_sg_id,
-                curr_cmd_ctrl_ptr->list_idx,
-                curr_cmd_ctrl_ptr->cmd_opcode,
-                list_cmd_ctrl_ptr->list_idx,
-                list_cmd_ctrl_ptr->cmd_opcode);
+      idx = (idx + 1) & set_ptr->mask;
+   }
 
-         return AR_EOK;
-      }
+   return FALSE;
+}
 
-      /** Advance to next node in the list   */
-      curr_list_sg_node_ptr = curr_list_sg_node_ptr->next_ptr;
+static void apm_gm_cmd_add_claimed_sg_ids(apm_cmd_ctrl_t *list_cmd_ctrl_ptr, apm_sg_id_set_t *claimed_sg_set_ptr)
+{
+   apm_sub_graph_id_t *list_sg_list_ptr;
+   spf_list_node_t *   curr_list_sg_node_ptr;
+
+   /** Sub-graph ID's received directly as part of the graph
+    *  management command */
+   list_sg_list_ptr = list_cmd_ctrl_ptr->graph_mgmt_cmd_ctrl.sg_list.cmd_sg_id_list_ptr;
 
-   } /** End of while(list sub-graph ID arr) */
+   for (uint32_t list_idx = 0; list_idx < list_cmd_ctrl_ptr->graph_mgmt_cmd_ctrl.sg_list.num_cmd_sg_id; list_idx++)
+   {
+      apm_sg_id_set_insert(claimed_sg_set_ptr, list_sg_list_ptr[list_idx].sub_graph_id);
+   }
 
-   return result;
+   /** Sub-graph ID's being processed due to GM operation on links */
+   for (curr_list_sg_node_ptr = list_cmd_ctrl_ptr->graph_mgmt_cmd_ctrl.sg_list.cont_port_hdl_sg_list_ptr;
+        curr_list_sg_node_ptr;
+        curr_list_sg_node_ptr = curr_list_sg_node_ptr->next_ptr)
+   {
+      apm_sg_id_set_insert(claimed_sg_set_ptr, ((apm_sub_graph_t *)curr_list_sg_node_ptr->obj_ptr)->sub_graph_id);
+   }
 }
 
-static ar_result_t apm_gm_cmd_check_sg_list_overlap(apm_t *         apm_info_ptr,
-                                                    apm_cmd_ctrl_t *curr_cmd_ctrl_ptr,
-                                                    apm_cmd_ctrl_t *list_cmd_ctrl_ptr,
-                                                    bool_t *        sg_list_overlap_ptr)
+static bool_t apm_gm_cmd_check_sg_list_overlap(apm_t *          apm_info_ptr,
+                                               apm_cmd_ctrl_t * curr_cmd_ctrl_ptr,
+                                               apm_sg_id_set_t *claimed_sg_set_ptr,
+                                               apm_sg_id_set_t *tgt_sg_set_ptr)
 {
-   ar_result_t                   result = AR_EOK;
    apm_sub_graph_id_t *          tgt_sg_list_ptr;
    uint32_t                      tgt_num_sg_id;
-   spf_list_node_t *             curr_tgt_sg_node_ptr, *curr_node_ptr;
+   spf_list_node_t *             curr_node_ptr;
    apm_sub_graph_t *             curr_tgt_sg_obj_ptr;
    apm_cont_port_connect_info_t *curr_port_conn_info_obj_ptr;
 
-   /** Validate input arguments   */
-   if (!curr_cmd_ctrl_ptr || !list_cmd_ctrl_ptr || !sg_list_overlap_ptr)
-   {
-      AR_MSG(DBG_ERROR_PRIO,
-             "apm_gm_cmd_check_sg_list_overlap(): Invalid i/p arg, curr_cmd_ctrl_ptr[0x%lX], list_cmd_ctrl_ptr[0x%lX], "
-             "sg_list_overlap_ptr[0x%lX] ",
-             curr_cmd_ctrl_ptr,
-             list_cmd_ctrl_ptr,
-             sg_list_overlap_ptr);
-
-      return AR_EFAILED;
-   }
-
-   AR_MSG(DBG_HIGH_PRIO,
-          "apm_gm_cmd_check_sg_list_overlap(): Checking overlap across, curr_cmd_ctrl_idx[%lu], "
-          "list_cmd_ctrl_idx[%lu] ",
-          curr_cmd_ctrl_ptr->list_idx,
-          list_cmd_ctrl_ptr->list_idx);
-
-   /** Init the return value  */
-   *sg_list_overlap_ptr = FALSE;
-
    /** Get the pointer to the list of sub-graph IDs for current
     *  graph managment command under process */
    tgt_sg_list_ptr = curr_cmd_ctrl_ptr->graph_mgmt_cmd_ctrl.sg_list.cmd_sg_id_list_ptr;
    tgt_num_sg_id   = curr_cmd_ctrl_ptr->graph_mgmt_cmd_ctrl.sg_list.num_cmd_sg_id;
 
-   /** Check if there is at least 1 sub-graph ID matches for the
-    *  current command with other active commands */
+   /** Check if any of the target sub-graph ID's is directly
+    *  claimed by other active commands */
    for (uint32_t tgt_idx = 0; tgt_idx < tgt_num_sg_id; tgt_idx++)
    {
-      if (AR_EOK != (result = apm_gm_cmd_check_overlap_for_single_sg_id(curr_cmd_ctrl_ptr,
-                                                                        list_cmd_ctrl_ptr,
-                                                                        tgt_sg_list_ptr[tgt_idx].sub_graph_id,
-                                                                        sg_list_overlap_ptr)))
+      if (apm_sg_id_set_find(claimed_sg_set_ptr, tgt_sg_list_ptr[tgt_idx].sub_graph_id))
       {
-         AR_MSG(DBG_ERROR_PRIO,
-                "apm_gm_cmd_check_sg_list_overlap(): Failed to check overlap for SG_ID[0x%lX] "
-                "cmd_opcode[0x%lX] ",
+         AR_MSG(DBG_HIGH_PRIO,
+                "apm_gm_cmd_check_sg_list_overlap(): SG_ID[0x%lX] in cmd_list_idx[%lu], cmd_opcode[0x%lX], "
+                "directly matches with an active cmd",
                 tgt_sg_list_ptr[tgt_idx].sub_graph_id,
+                curr_cmd_ctrl_ptr->list_idx,
                 curr_cmd_ctrl_ptr->cmd_opcode);
 
-         return result;
-      }
-
-      /** If overlap found, break the loop */
-      if (*sg_list_overlap_ptr)
-      {
-         break;
+         return TRUE;
       }
 
-      /** Execution falls through  if no overlap found for the
-       *  current sub-graph ID */
+      apm_sg_id_set_insert(tgt_sg_set_ptr, tgt_sg_list_ptr[tgt_idx].sub_graph_id);
+   }
 
-      /** For current sub-graph ID, fetch its peer sub-graph ID and
-       *  check if that is getting processed as part of a parallel
-       *  command execution */
-      curr_node_ptr = apm_info_ptr->graph_info.sub_graph_conn_list_ptr;
+   /** Check if the peer of any target sub-graph ID is getting
+    *  processed as part of a parallel command execution. One pass
+    *  over the connections covers all the target sub-graphs */
+   for (curr_node_ptr = apm_info_ptr->graph_info.sub_graph_conn_list_ptr; curr_node_ptr;
+        curr_node_ptr = curr_node_ptr->next_ptr)
+   {
+      curr_port_conn_info_obj_ptr = (apm_cont_port_connect_info_t *)curr_node_ptr->obj_ptr;
 
-      /** Iterate over the list of all the connected sub-graphs   */
-      while (curr_node_ptr)
+      /** Get the data connection where the target sub-graph ID is
+       *  self sub-graph ID */
+      if (curr_port_conn_info_obj_ptr->self_sg_obj_ptr && curr_port_conn_info_obj_ptr->peer_sg_obj_ptr &&
+          apm_sg_id_set_find(tgt_sg_set_ptr, curr_port_conn_info_obj_ptr->self_sg_obj_ptr->sub_graph_id) &&
+          apm_sg_id_set_find(claimed_sg_set_ptr, curr_port_conn_info_obj_ptr->peer_sg_obj_ptr->sub_graph_id))
       {
-         curr_port_conn_info_obj_ptr = (apm_cont_port_connect_info_t *)curr_node_ptr->obj_ptr;
-
-         /** Get the data connection where the target sub-graph ID is
-          *  self sub-graph ID */
-         if (curr_port_conn_info_obj_ptr->self_sg_obj_ptr && curr_port_conn_info_obj_ptr->peer_sg_obj_ptr &&
-             (tgt_sg_list_ptr[tgt_idx].sub_graph_id == curr_port_conn_info_obj_ptr->self_sg_obj_ptr->sub_graph_id))
-         {
-            if (AR_EOK != (result = apm_gm_cmd_check_overlap_for_single_sg_id(curr_cmd_ctrl_ptr,
-                                                                              list_cmd_ctrl_ptr,
-                                                                              curr_port_conn_info_obj_ptr
-                                                                                 ->peer_sg_obj_ptr->sub_graph_id,
-                                                                              sg_list_overlap_ptr)))
-            {
-               AR_MSG(DBG_ERROR_PRIO,
-                      "apm_gm_cmd_check_sg_list_overlap(): Failed to check overlap for SG_ID[0x%lX] "
-                      "cmd_opcode[0x%lX] ",
-                      tgt_sg_list_ptr[tgt_idx].sub_graph_id,
-                      curr_cmd_ctrl_ptr->cmd_opcode);
-
-               return result;
-            }
-         }
-
-         /** If overlap found, break the loop */
-         if (*sg_list_overlap_ptr)
-         {
-            break;
-         }
-
-         /** Advance to next node in the list   */
-         curr_node_ptr = curr_node_ptr->next_ptr;
-
-      } /** End of while(global sub-graph connection list) */
+         AR_MSG(DBG_HIGH_PRIO,
+                "apm_gm_cmd_check_sg_list_overlap(): Peer SG_ID[0x%lX] of SG_ID[0x%lX] in cmd_list_idx[%lu], "
+                "cmd_opcode[0x%lX], matches with an active cmd",
+                curr_port_conn_info_obj_ptr->peer_sg_obj_ptr->sub_graph_id,
+                curr_port_conn_info_obj_ptr->self_sg_obj_ptr->sub_graph_id,
+                curr_cmd_ctrl_ptr->list_idx,
+                curr_cmd_ctrl_ptr->cmd_opcode);
 
-      /** If overlap found, break the outer for-loop */
-      if (*sg_list_overlap_ptr)
-      {
-         break;
+         return TRUE;
       }
+   }
 
-   } /** End of for(target sub-graph ID arr) */
-
-   /** Execution falls through if no match found in the list of
-    *  sub-graph ID's received directly as part of graph mgmt
-    *  commands. Next to check overlap with sub-graph id's
-    *  getting processed indirectly e.g. as part of link closure */
-
-   if (!(*sg_list_overlap_ptr))
+   /** Next to check overlap with sub-graph id's getting processed
+    *  indirectly e.g. as part of link closure */
+   for (curr_node_ptr = curr_cmd_ctrl_ptr->graph_mgmt_cmd_ctrl.sg_list.cont_port_hdl_sg_list_ptr; curr_node_ptr;
+        curr_node_ptr = curr_node_ptr->next_ptr)
    {
-      /** Get the pointer to list of sub-graphs getting parsed as
-       *  part of data/control link operation */
-      curr_tgt_sg_node_ptr = curr_cmd_ctrl_ptr->graph_mgmt_cmd_ctrl.sg_list.cont_port_hdl_sg_list_ptr;
+      curr_tgt_sg_obj_ptr = (apm_sub_graph_t *)curr_node_ptr->obj_ptr;
 
-      /** Iterate over this sub-graph list  */
-      while (curr_tgt_sg_node_ptr)
+      if (apm_sg_id_set_find(claimed_sg_set_ptr, curr_tgt_sg_obj_ptr->sub_graph_id))
       {
-         /** Get the pointer to current sub-graph object   */
-         curr_tgt_sg_obj_ptr = (apm_sub_graph_t *)curr_tgt_sg_node_ptr->obj_ptr;
-
-         if (AR_EOK != (result = apm_gm_cmd_check_overlap_for_single_sg_id(curr_cmd_ctrl_ptr,
-                                                                           list_cmd_ctrl_ptr,
-                                                                           curr_tgt_sg_obj_ptr->sub_graph_id,
-                                                                           sg_list_overlap_ptr)))
-         {
-            AR_MSG(DBG_ERROR_PRIO,
-                   "apm_gm_cmd_check_sg_list_overlap(): Failed to check overlap for SG_ID[0x%lX] "
-                   "cmd_opcode[0x%lX] ",
-                   curr_tgt_sg_obj_ptr->sub_graph_id,
-                   curr_cmd_ctrl_ptr->cmd_opcode);
-
-            return result;
-         }
-
-         /** Advance to next node in the list   */
-         curr_tgt_sg_node_ptr = curr_tgt_sg_node_ptr->next_ptr;
-
-      } /** End of wehile (cont port hdl sgid list) */
+         AR_MSG(DBG_HIGH_PRIO,
+                "apm_gm_cmd_check_sg_list_overlap(): SG_ID[0x%lX] in cmd_list_idx[%lu], cmd_opcode[0x%lX], "
+                "indirectly matches with an active cmd",
+                curr_tgt_sg_obj_ptr->sub_graph_id,
+                curr_cmd_ctrl_ptr->list_idx,
+                curr_cmd_ctrl_ptr->cmd_opcode);
 
-   } /** End of if(no overlap with direct sg id list) */
+         return TRUE;
+      }
+   }
 
-   return result;
+   return FALSE;
 }
 
 ar_result_t apm_check_sg_id_overlap_across_parallel_cmds(apm_t *         apm_info_ptr,
                                                          apm_cmd_ctrl_t *curr_cmd_ctrl_ptr,
                                                          bool_t *        sg_list_overlap_ptr)
 {
-   ar_result_t     result = AR_EOK;
    apm_cmd_ctrl_t *list_cmd_ctrl_ptr;
+   uint32_t        active_cmd_mask;
+   uint32_t        num_claimed_sg_id = 0;
+   uint32_t        claimed_set_size, tgt_set_size;
+   uint32_t        set_stack_buf[APM_SG_ID_SET_STACK_SIZE];
+   uint32_t *      set_buf_ptr = set_stack_buf;
+   apm_sg_id_set_t claimed_sg_set, tgt_sg_set;
 
    /** Init return value   */
    *sg_list_overlap_ptr = FALSE;
 
    /** Iterate over the list of all the concurrently active
-    *  commands  */
-   for (uint32_t idx = 0; idx < APM_NUM_MAX_PARALLEL_CMD; idx++)
+    *  commands to size the set of sub-graph ID's they claim */
+   for (active_cmd_mask = apm_info_ptr->active_cmd_mask; active_cmd_mask; active_cmd_mask &= (active_cmd_mask - 1))
    {
-      list_cmd_ctrl_ptr = &apm_info_ptr->cmd_ctrl_list[idx];
+      list_cmd_ctrl_ptr = apm_info_ptr->cmd_ctrl_list[s32_get_lsb_s32(active_cmd_mask)];
 
-      if (list_cmd_ctrl_ptr->cmd_pending && (list_cmd_ctrl_ptr != curr_cmd_ctrl_ptr))
+      if (!list_cmd_ctrl_ptr->cmd_pending || (list_cmd_ctrl_ptr == curr_cmd_ctrl_ptr))
       {
-         /** In case atleast one command is pending (which is checked by
-          *  above check) in the assigned list and the current commands
-          *  evaluated for resume is close all. CLOSE_ALL resume is
-          *  deferred. */
+         continue;
+      }
 
-         if (APM_CMD_CLOSE_ALL == curr_cmd_ctrl_ptr->cmd_opcode)
-         {
-            AR_MSG(DBG_HIGH_PRIO,
-                   "apm_check_sg_id_overlap_across_parallel_cmds(): Did not resume already deferred CLOSE_ALL ");
+      /** In case atleast one command is pending (which is checked by
+       *  above check) in the assigned list and the current commands
+       *  evaluated for resume is close all. CLOSE_ALL resume is
+       *  deferred. */
+      if (APM_CMD_CLOSE_ALL == curr_cmd_ctrl_ptr->cmd_opcode)
+      {
+         AR_MSG(DBG_HIGH_PRIO,
+                "apm_check_sg_id_overlap_across_parallel_cmds(): Did not resume already deferred CLOSE_ALL ");
 
-            *sg_list_overlap_ptr = TRUE;
-            break;
-         }
+         *sg_list_overlap_ptr = TRUE;
+
+         return AR_EOK;
+      }
 
-         result =
-            apm_gm_cmd_check_sg_list_overlap(apm_info_ptr, curr_cmd_ctrl_ptr, list_cmd_ctrl_ptr, sg_list_overlap_ptr);
+      /** If CLOSE_ALL cmd is already in progress, APM will initiate
+       *  the STOP sequence as part of it. Hence APM can ignore the
+       *  current PROXY graph mgmt cmd from VCPM. */
+      if (((curr_cmd_ctrl_ptr->cmd_opcode == SPF_MSG_CMD_PROXY_GRAPH_STOP) ||
+           (curr_cmd_ctrl_ptr->cmd_opcode == SPF_MSG_CMD_PROXY_GRAPH_START) ||
+           (curr_cmd_ctrl_ptr->cmd_opcode == SPF_MSG_CMD_PROXY_GRAPH_PREPARE)) &&
+          (list_cmd_ctrl_ptr->cmd_opcode == APM_CMD_CLOSE_ALL))
+      {
+         curr_cmd_ctrl_ptr->cmd_status  = AR_EBUSY;
+         curr_cmd_ctrl_ptr->cmd_pending = FALSE;
 
-         /** If CLOSE_ALL cmd is already in progress, break the loop. As part of processing CLOSE_ALL cmd,
-           * APM will initiate the STOP sequence. Hence APM can ignore the current PROXY graph mgmt cmd from VCPM.   */
-         if ( ( (curr_cmd_ctrl_ptr->cmd_opcode == SPF_MSG_CMD_PROXY_GRAPH_STOP  ) ||
-                 (curr_cmd_ctrl_ptr->cmd_opcode == SPF_MSG_CMD_PROXY_GRAPH_START  ) ||
-                 (curr_cmd_ctrl_ptr->cmd_opcode == SPF_MSG_CMD_PROXY_GRAPH_PREPARE  ) ) && 
-               (list_cmd_ctrl_ptr->cmd_opcode == APM_CMD_CLOSE_ALL ))
-         {
-            curr_cmd_ctrl_ptr->cmd_status  = AR_EBUSY;
-            curr_cmd_ctrl_ptr->cmd_pending = FALSE;
-            result                         = AR_EBUSY;
+         AR_MSG(DBG_HIGH_PRIO,
+                "apm_check_sg_id_overlap_across_parallel_cmds():  found overlap of CLOSE_ALL and PROXY STOP");
 
-            AR_MSG(DBG_HIGH_PRIO,
-                   "apm_check_sg_id_overlap_across_parallel_cmds():  found overlap of CLOSE_ALL and PROXY STOP");
-            break;
-         }
-         /** If sub-graph list overlap is found, break the loop   */
-         if (*sg_list_overlap_ptr)
-         {
-            break;
-         }
+         return AR_EBUSY;
       }
+
+      num_claimed_sg_id += list_cmd_ctrl_ptr->graph_mgmt_cmd_ctrl.sg_list.num_cmd_sg_id +
+                           spf_list_count_elements(list_cmd_ctrl_ptr->graph_mgmt_cmd_ctrl.sg_list.cont_port_hdl_sg_list_ptr);
    }
 
-   return result;
+   /** Nothing claimed by other commands, no overlap possible */
+   if (!num_claimed_sg_id)
+   {
+      return AR_EOK;
+   }
+
+   claimed_set_size = apm_sg_id_set_get_size(num_claimed_sg_id);
+   tgt_set_size     = apm_sg_id_set_get_size(curr_cmd_ctrl_ptr->graph_mgmt_cmd_ctrl.sg_list.num_cmd_sg_id);
+
+   if ((claimed_set_size + tgt_set_size) > APM_SG_ID_SET_STACK_SIZE)
+   {
+      if (NULL == (set_buf_ptr = (uint32_t *)posal_memory_malloc((claimed_set_size + tgt_set_size) * sizeof(uint32_t),
+                                                                 APM_INTERNAL_STATIC_HEAP_ID)))
+      {
+         AR_MSG(DBG_ERROR_PRIO,
+                "apm_check_sg_id_overlap_across_parallel_cmds(): Failed to allocate SG ID sets, num_sg_id[%lu]",
+                num_claimed_sg_id);
+
+         return AR_ENOMEMORY;
+      }
+   }
+
+   memset(set_buf_ptr, 0, (claimed_set_size + tgt_set_size) * sizeof(uint32_t));
+
+   claimed_sg_set.slot_ptr = set_buf_ptr;
+   claimed_sg_set.mask     = claimed_set_size - 1;
+   tgt_sg_set.slot_ptr     = set_buf_ptr + claimed_set_size;
+   tgt_sg_set.mask         = tgt_set_size - 1;
+
+   /** Collect the sub-graph ID's claimed by all the other active
+    *  commands, each one is then checked with a single lookup */
+   for (active_cmd_mask = apm_info_ptr->active_cmd_mask; active_cmd_mask; active_cmd_mask &= (active_cmd_mask - 1))
+   {
+      list_cmd_ctrl_ptr = apm_info_ptr->cmd_ctrl_list[s32_get_lsb_s32(active_cmd_mask)];
+
+      if (list_cmd_ctrl_ptr->cmd_pending && (list_cmd_ctrl_ptr != curr_cmd_ctrl_ptr))
+      {
+         apm_gm_cmd_add_claimed_sg_ids(list_cmd_ctrl_ptr, &claimed_sg_set);
+      }
+   }
+
+   *sg_list_overlap_ptr = apm_gm_cmd_check_sg_list_overlap(apm_info_ptr, curr_cmd_ctrl_ptr, &claimed_sg_set, &tgt_sg_set);
+
+   if (set_stack_buf != set_buf_ptr)
+   {
+      posal_memory_free(set_buf_ptr);
+   }
+
+   return AR_EOK;
 }
 
 static ar_result_t apm_resume_deferred_cmd_proc(apm_t *apm_info_ptr, spf_list_node_t **def_cmd_ctrl_list_node_pptr)
@@ -398,9 +376,10 @@ static uint32_t apm_get_num_available_cmd(apm_t *apm_info_ptr)
 {
    uint32_t num_available_cmd = 0;
 
-   for (uint32_t list_idx = 0; list_idx < APM_NUM_MAX_PARALLEL_CMD; list_idx++)
+   for (uint32_t active_cmd_mask = apm_info_ptr->active_cmd_mask; active_cmd_mask;
+        active_cmd_mask &= (active_cmd_mask - 1))
    {
-      if (apm_info_ptr->cmd_ctrl_list[list_idx].cmd_pending)
+      if (apm_info_ptr->cmd_ctrl_list[s32_get_lsb_s32(active_cmd_mask)]->cmd_pending)
       {
          num_available_cmd++;
       }
@@ -490,9 +469,10 @@ static bool_t apm_check_if_graph_close_cmd_active(apm_t *apm_info_ptr)
 {
    apm_cmd_ctrl_t *curr_cmd_ctrl_ptr;
 
-   for (uint32_t idx = 0; idx < APM_NUM_MAX_PARALLEL_CMD; idx++)
+   for (uint32_t active_cmd_mask = apm_info_ptr->active_cmd_mask; active_cmd_mask;
+        active_cmd_mask &= (active_cmd_mask - 1))
    {
-      curr_cmd_ctrl_ptr = &apm_info_ptr->cmd_ctrl_list[idx];
+      curr_cmd_ctrl_ptr = apm_info_ptr->cmd_ctrl_list[s32_get_lsb_s32(active_cmd_mask)];
 
       if (curr_cmd_ctrl_ptr->cmd_pending && (APM_CMD_GRAPH_CLOSE == curr_cmd_ctrl_ptr->cmd_opcode))
       {
@@ -202,8 +202,8 @@ struct apm_proxy_cmd_list_t
    /**< Current proxy command control object
         under process */
 
-   apm_proxy_cmd_ctrl_t cmd_ctrl_list[APM_NUM_MAX_PARALLEL_CMD];
-   /**< array of cmd control structures. */
+   apm_proxy_cmd_ctrl_t *cmd_ctrl_list[APM_NUM_MAX_PARALLEL_CMD];
+   /**< array of cmd control structures, allocated on first use of the slot. */
 };
 
 typedef struct apm_vcpm_proxy_properties_t apm_vcpm_proxy_properties_t;
@@ -56,6 +56,8 @@ ar_result_t apm_clear_active_proxy_list(apm_t *apm_info_ptr, apm_cmd_ctrl_t *apm
 ar_result_t apm_proxy_util_release_cmd_ctrl_obj(apm_proxy_manager_t * proxy_mgr_ptr,
                                                 apm_proxy_cmd_ctrl_t *proxy_cmd_ctrl_ptr);
 
+void apm_proxy_util_free_proxy_mgr(apm_proxy_manager_t *proxy_mgr_ptr);
+
 ar_result_t apm_move_proxies_to_active_list(apm_t *apm_info_ptr);
 
 ar_result_t apm_move_proxy_to_active_list_by_id(apm_t *apm_info_ptr, uint32_t instance_id);
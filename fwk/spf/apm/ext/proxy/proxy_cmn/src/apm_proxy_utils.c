@@ -50,10 +50,6 @@ ar_result_t apm_proxy_util_get_allocated_cmd_ctrl_obj(apm_proxy_manager_t   *pro
       return AR_EBADPARAM;
    }
 
-   /** Get the pointer to this container's commond control
-    *  object list */
-   proxy_cmd_ctrl_ptr = proxy_mgr_ptr->cmd_list.cmd_ctrl_list;
-
    /** Init the return pointer */
    *proxy_cmd_ctrl_pptr = NULL;
 
@@ -61,12 +57,14 @@ ar_result_t apm_proxy_util_get_allocated_cmd_ctrl_obj(apm_proxy_manager_t   *pro
     *  APM command */
    for (uint32_t idx = 0; idx < APM_NUM_MAX_PARALLEL_CMD; idx++)
    {
+      proxy_cmd_ctrl_ptr = proxy_mgr_ptr->cmd_list.cmd_ctrl_list[idx];
+
       /** If the APM cmd ctrl pointer matches with the in container
        *  cmd obj */
-      if ((void *)apm_cmd_ctrl_ptr == proxy_cmd_ctrl_ptr[idx].apm_cmd_ctrl_ptr)
+      if (proxy_cmd_ctrl_ptr && ((void *)apm_cmd_ctrl_ptr == proxy_cmd_ctrl_ptr->apm_cmd_ctrl_ptr))
       {
          /** Match found, return */
-         *proxy_cmd_ctrl_pptr = &proxy_cmd_ctrl_ptr[idx];
+         *proxy_cmd_ctrl_pptr = proxy_cmd_ctrl_ptr;
 
          AR_MSG(DBG_HIGH_PRIO,
                 "apm_proxy_util_get_allocated_cmd_ctrl_obj(): found allocated proxy cmd ctrl obj with list idx %d for "
@@ -226,30 +224,24 @@ ar_result_t apm_proxy_util_get_cmd_ctrl_obj(apm_proxy_manager_t   *proxy_mgr_ptr
    /** Execeution falls through if a new object needs to be
     *  allocated now */
 
-   /** Check if all the slots in the command obj list are
-    *  occupied.
-    *  This condition should not hit as the APM cmd Q is removed
-    *  from the wait mask once all the cmd obj slots are
+   /** Get the next available slot in the command list.
+    *  Running out of slots should not hit as the APM cmd Q is
+    *  removed from the wait mask once all the cmd obj slots are
     *  occupied. */
-   if (APM_CMD_LIST_FULL_MASK == proxy_mgr_ptr->cmd_list.active_cmd_mask)
+   if (NULL == (proxy_cmd_ctrl_ptr = (apm_proxy_cmd_ctrl_t *)
+                   apm_cmd_slot_alloc(&proxy_mgr_ptr->cmd_list.active_cmd_mask,
+                                      (void **)proxy_mgr_ptr->cmd_list.cmd_ctrl_list,
+                                      sizeof(apm_proxy_cmd_ctrl_t),
+                                      APM_INTERNAL_STATIC_HEAP_ID,
+                                      &cmd_slot_idx)))
    {
       AR_MSG(DBG_ERROR_PRIO,
-             "apm_proxy_util_get_cmd_ctrl_obj(), cmd obj list is full, Proxy Instance_ID[0x%lX]",
+             "apm_proxy_util_get_cmd_ctrl_obj(), failed to get cmd obj, Proxy Instance_ID[0x%lX]",
              proxy_mgr_ptr->proxy_instance_id);
 
       return AR_EFAILED;
    }
 
-   /** Find the next available slot in the command list */
-   cmd_slot_idx = s32_ct1_s32(proxy_mgr_ptr->cmd_list.active_cmd_mask);
-
-   /** Set this bit in the active command mask */
-   APM_SET_BIT(&proxy_mgr_ptr->cmd_list.active_cmd_mask, cmd_slot_idx);
-
-   /** Get the pointer to command control object corrsponding to
-    *  available slot */
-   proxy_cmd_ctrl_ptr = &proxy_mgr_ptr->cmd_list.cmd_ctrl_list[cmd_slot_idx];
-
    proxy_cmd_ctrl_ptr->msg_token = APM_CMD_TOKEN_PROXY_CTRL_TYPE;
 
    /** Save the list index in cmd obj */
@@ -274,6 +266,14 @@ ar_result_t apm_proxy_util_get_cmd_ctrl_obj(apm_proxy_manager_t   *proxy_mgr_ptr
    return result;
 }
 
+void apm_proxy_util_free_proxy_mgr(apm_proxy_manager_t *proxy_mgr_ptr)
+{
+   /** Free up the command control objects along with the proxy manager */
+   apm_cmd_slot_list_free((void **)proxy_mgr_ptr->cmd_list.cmd_ctrl_list);
+
+   posal_memory_free(proxy_mgr_ptr);
+}
+
 ar_result_t apm_clear_active_proxy_list(apm_t *apm_info_ptr, apm_cmd_ctrl_t *apm_cmd_ctrl_ptr)
 {
    ar_result_t           result = AR_EOK;
@@ -343,7 +343,7 @@ ar_result_t apm_clear_active_proxy_list(apm_t *apm_info_ptr, apm_cmd_ctrl_t *apm
                apm_db_remove_node_from_list(&apm_info_ptr->graph_info.proxy_manager_list_ptr,
                                             proxy_mgr_ptr,
                                             &apm_info_ptr->graph_info.num_proxy_managers);
-               posal_memory_free(proxy_mgr_ptr);
+               apm_proxy_util_free_proxy_mgr(proxy_mgr_ptr);
             }
          }
       }
@@ -443,7 +443,7 @@ ar_result_t apm_free_proxy_mgr_from_id(apm_t *apm_info_ptr, uint32_t instance_id
          apm_db_remove_node_from_list(&apm_info_ptr->graph_info.proxy_manager_list_ptr,
                                       proxy_mgr,
                                       &apm_info_ptr->graph_info.num_proxy_managers);
-         posal_memory_free(proxy_mgr);
+         apm_proxy_util_free_proxy_mgr(proxy_mgr);
          break;
       }
       proxy_mgr_list_ptr = proxy_mgr_list_ptr->next_ptr;
@@ -270,7 +270,7 @@ bool_t apm_proxy_merge_proxy_objects(apm_graph_info_t *graph_info_ptr, uint32_t
                                 &graph_info_ptr->num_proxy_managers);
 
    /** Free the memory allocated to proxy manager node.*/
-   posal_memory_free(proxy_mgr2);
+   apm_proxy_util_free_proxy_mgr(proxy_mgr2);
 
    return true;
 }
@@ -2099,7 +2099,7 @@ ar_result_t apm_proxy_util_remove_closed_subgraphs_from_proxy_mgrs(apm_t *apm_in
                                       &graph_info_ptr->num_proxy_managers);
 
          /** Free the memory allocated to proxy manager node.*/
-         posal_memory_free(proxy_mgr_node);
+         apm_proxy_util_free_proxy_mgr(proxy_mgr_node);
       }
    }
 
@@ -2351,7 +2351,7 @@ static void apm_proxy_util_clear_proxy_helper(apm_t            *apm_info_ptr,
                apm_db_remove_node_from_list(&apm_info_ptr->graph_info.proxy_manager_list_ptr,
                                             proxy_mgr_ptr,
                                             &apm_info_ptr->graph_info.num_proxy_managers);
-               posal_memory_free(proxy_mgr_ptr);
+               apm_proxy_util_free_proxy_mgr(proxy_mgr_ptr);
             }
 
             AR_MSG(DBG_HIGH_PRIO, "Proxy removed during error handling");
@@ -41,6 +41,7 @@
 #include "cu_prof.h"
 #include "cu_exit_island.h"
 #include "cu_duty_cycle.h"
+#include "cu_placement.h"
 #include "cu_global_shmem_msg.h"
 #include "posal_internal_inline.h"
 #ifdef CONTAINER_ASYNC_CMD_HANDLING
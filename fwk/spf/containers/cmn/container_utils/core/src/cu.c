@@ -155,6 +155,8 @@ ar_result_t cu_deinit(cu_base_t *me_ptr)
 {
    cu_operate_on_delay_paths(me_ptr, 0, CU_PATH_DELAY_OP_REMOVE);
 
+   cu_placement_remove(me_ptr);
+
    /* Release signal bit in mask */
    cu_release_bit_in_bit_mask(me_ptr, posal_signal_get_channel_bit(me_ptr->gp_signal_ptr));
 
@@ -324,6 +326,9 @@ ar_result_t cu_check_launch_thread(cu_base_t *me_ptr,
              "old thread id = 0x%lX, new thread id = 0x%lX",
              posal_thread_get_tid_v2(old_thread_id),
              posal_thread_get_tid_v2(me_ptr->cmd_handle.thread_id));
+
+      // new thread starts with the configured affinity, bind it to the core it was placed on.
+      cu_placement_update(me_ptr, TRUE /*thread_relaunched*/);
    }
 
    CATCH(result, CU_MSG_PREFIX, me_ptr->gu_ptr->log_id)
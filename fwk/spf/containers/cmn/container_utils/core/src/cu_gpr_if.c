@@ -34,6 +34,8 @@ uint32_t cu_gpr_callback(gpr_packet_t *packet, void *callback_data)
           packet->opcode,
           packet->token);
 
+   POSAL_TRACE(POSAL_TRACE_GPR_RECV, packet->dst_port, (((uint64_t)packet->opcode << 32) | packet->token));
+
    spf_msg_t msg;
    uint32_t  thread_id = 0;
    msg.payload_ptr     = packet;
@@ -157,6 +159,9 @@ ar_result_t cu_gpr_generate_ack(cu_base_t *   me_ptr,
 {
    ar_result_t result = AR_EOK;
    uint32_t    opcode = packet_ptr->opcode;
+
+   POSAL_TRACE(POSAL_TRACE_GPR_SEND, packet_ptr->dst_port, (((uint64_t)opcode << 32) | packet_ptr->token));
+
    switch (opcode)
    {
       case DATA_CMD_WR_SH_MEM_EP_EOS:
@@ -299,6 +299,9 @@ ar_result_t cu_handle_clk_vote_change(cu_base_t *       me_ptr,
    {
       me_ptr->pm_info.prev_kpps_vote        = total_kpps;
       me_ptr->pm_info.prev_floor_clock_vote = floor_clock;
+
+      // load changed, the container may be better off on another core.
+      cu_placement_update(me_ptr, FALSE /*thread_relaunched*/);
    }
 
    if (is_bw_req)
@@ -0,0 +1,55 @@
+#ifndef _CU_PLACEMENT_H_
+#define _CU_PLACEMENT_H_
+
+/**
+ * \file cu_placement.h
+ *
+ * \brief
+ *     This file defines the container to core placement functions.
+ *
+ *     Containers without a configured core affinity are placed on the least loaded core, preferring
+ *     the cores that share the last level cache with the containers they exchange data with.
+ *
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "posal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif //__cplusplus
+
+/** Placement of a container, see cu_placement_get_info */
+typedef struct cu_placement_info_t
+{
+   uint32_t core;
+   /**< Core the container thread is bound to */
+
+   uint32_t load_kpps;
+   /**< Load accounted for the container */
+
+   uint32_t num_moves;
+   /**< Number of times the container moved to another core */
+} cu_placement_info_t;
+
+/**
+ * Re-evaluates the core of the container thread and applies it if it changed.
+ * Must only be called at points where the container thread can move, e.g. after a clock vote change
+ * or a thread relaunch. thread_relaunched forces the affinity to be applied to the new thread.
+ */
+ar_result_t cu_placement_update(cu_base_t *me_ptr, bool_t thread_relaunched);
+
+/** Removes the container from the placement, called when the container is destroyed. */
+void cu_placement_remove(cu_base_t *me_ptr);
+
+/** Gets the current placement of the container. Returns AR_ENOTEXIST if the container is not placed. */
+ar_result_t cu_placement_get_info(cu_base_t *me_ptr, cu_placement_info_t *info_ptr);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
+#endif // #ifndef _CU_PLACEMENT_H_
@@ -0,0 +1,288 @@
+/**
+ * \file cu_placement.c
+ * \brief
+ *     This file contains the container to core placement functions.
+ *
+ *     All placed containers are kept in one registry with the core they are bound to and their load.
+ *     The load of a container is its KPPS vote. On every update, the candidate cores are the cache
+ *     domains of the placed containers connected to it over data links (all cores if none), and the
+ *     least loaded candidate is picked. A container only moves if the imbalance between its current
+ *     core and the best core is larger than its own load, so that votes changing back and forth do
+ *     not make containers bounce between cores.
+ *
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "cu_i.h"
+
+/* =======================================================================
+Macros
+========================================================================== */
+#define CU_PLACEMENT_MAX_CNTRS 64
+
+/* Affinity masks are 32 bit */
+#define CU_PLACEMENT_MAX_CORES 32
+
+#define CU_PLACEMENT_INVALID_CORE 0xFFFFFFFF
+
+/* =======================================================================
+Structure Definitions
+========================================================================== */
+typedef struct cu_placement_entry_t
+{
+   spf_handle_t *cntr_handle_ptr;
+   /**< Container, NULL if the entry is free */
+
+   cu_placement_info_t info;
+} cu_placement_entry_t;
+
+typedef struct cu_placement_t
+{
+   cu_placement_entry_t entries[CU_PLACEMENT_MAX_CNTRS];
+
+   uint32_t cache_domain[CU_PLACEMENT_MAX_CORES];
+   /**< Cores sharing the last level cache with each core, 0 until queried */
+
+   uint32_t lock;
+   /**< Updates come from different container threads, placement decisions are rare and short. */
+} cu_placement_t;
+
+/* =======================================================================
+Static Variables
+========================================================================== */
+static cu_placement_t cu_placement;
+
+/* =======================================================================
+Static Function Definitions
+========================================================================== */
+static inline void cu_placement_lock(void)
+{
+   while (__atomic_exchange_n(&cu_placement.lock, 1, __ATOMIC_ACQUIRE))
+   {
+   }
+}
+
+static inline void cu_placement_unlock(void)
+{
+   __atomic_store_n(&cu_placement.lock, 0, __ATOMIC_RELEASE);
+}
+
+static uint32_t cu_placement_get_cache_domain(uint32_t core)
+{
+   uint32_t mask = __atomic_load_n(&cu_placement.cache_domain[core], __ATOMIC_RELAXED);
+   if (0 == mask)
+   {
+      // topology doesn't change, concurrent queries store the same value.
+      mask = posal_thread_get_cache_domain(core);
+      __atomic_store_n(&cu_placement.cache_domain[core], mask, __ATOMIC_RELAXED);
+   }
+   return mask;
+}
+
+static cu_placement_entry_t *cu_placement_find_entry(spf_handle_t *cntr_handle_ptr)
+{
+   for (uint32_t i = 0; i < CU_PLACEMENT_MAX_CNTRS; i++)
+   {
+      if (cntr_handle_ptr == cu_placement.entries[i].cntr_handle_ptr)
+      {
+         return &cu_placement.entries[i];
+      }
+   }
+   return NULL;
+}
+
+/* Cores that share a cache with the placed peers of the container, lock must be held. */
+static uint32_t cu_placement_get_peer_cores(cu_base_t *me_ptr, uint32_t *peer_cores_ptr)
+{
+   uint32_t num_peers = 0;
+   *peer_cores_ptr    = 0;
+
+   for (gu_ext_in_port_list_t *list_ptr = me_ptr->gu_ptr->ext_in_port_list_ptr; NULL != list_ptr;
+        LIST_ADVANCE(list_ptr))
+   {
+      cu_placement_entry_t *peer_ptr =
+         cu_placement_find_entry(list_ptr->ext_in_port_ptr->upstream_handle.spf_handle_ptr);
+      if (peer_ptr && peer_ptr->cntr_handle_ptr && (peer_ptr->info.core < CU_PLACEMENT_MAX_CORES))
+      {
+         *peer_cores_ptr |= (1u << peer_ptr->info.core);
+         num_peers++;
+      }
+   }
+
+   for (gu_ext_out_port_list_t *list_ptr = me_ptr->gu_ptr->ext_out_port_list_ptr; NULL != list_ptr;
+        LIST_ADVANCE(list_ptr))
+   {
+      cu_placement_entry_t *peer_ptr =
+         cu_placement_find_entry(list_ptr->ext_out_port_ptr->downstream_handle.spf_handle_ptr);
+      if (peer_ptr && peer_ptr->cntr_handle_ptr && (peer_ptr->info.core < CU_PLACEMENT_MAX_CORES))
+      {
+         *peer_cores_ptr |= (1u << peer_ptr->info.core);
+         num_peers++;
+      }
+   }
+
+   return num_peers;
+}
+
+/* =======================================================================
+Public Functions
+========================================================================== */
+ar_result_t cu_placement_update(cu_base_t *me_ptr, bool_t thread_relaunched)
+{
+   ar_result_t result = AR_EOK;
+
+   if (APM_CONT_CORE_AFFINITY_IGNORE != me_ptr->configured_core_affinity)
+   {
+      // affinity given by the client is never overridden.
+      return AR_EOK;
+   }
+
+   uint32_t num_cores = posal_thread_get_num_cores();
+   if (num_cores < 2)
+   {
+      return AR_EOK;
+   }
+
+   uint32_t all_cores = (num_cores >= CU_PLACEMENT_MAX_CORES) ? 0xFFFFFFFF : ((1u << num_cores) - 1);
+   uint32_t core_domain[CU_PLACEMENT_MAX_CORES];
+   for (uint32_t c = 0; c < num_cores; c++)
+   {
+      core_domain[c] = cu_placement_get_cache_domain(c) & all_cores;
+   }
+
+   uint32_t load_kpps = MAX(me_ptr->pm_info.prev_kpps_vote, 1);
+   uint32_t core_load[CU_PLACEMENT_MAX_CORES];
+   memset(core_load, 0, sizeof(core_load));
+
+   cu_placement_lock();
+
+   cu_placement_entry_t *entry_ptr = cu_placement_find_entry(&me_ptr->spf_handle);
+   if (NULL == entry_ptr)
+   {
+      entry_ptr = cu_placement_find_entry(NULL);
+      if (NULL == entry_ptr)
+      {
+         cu_placement_unlock();
+         CU_MSG(me_ptr->gu_ptr->log_id,
+                DBG_HIGH_PRIO,
+                "Placement: more than %lu containers, not placing this one",
+                CU_PLACEMENT_MAX_CNTRS);
+         return AR_EOK;
+      }
+      entry_ptr->cntr_handle_ptr = &me_ptr->spf_handle;
+      entry_ptr->info.core       = CU_PLACEMENT_INVALID_CORE;
+      entry_ptr->info.num_moves  = 0;
+   }
+   entry_ptr->info.load_kpps = load_kpps;
+
+   for (uint32_t i = 0; i < CU_PLACEMENT_MAX_CNTRS; i++)
+   {
+      cu_placement_entry_t *other_ptr = &cu_placement.entries[i];
+      if ((other_ptr != entry_ptr) && other_ptr->cntr_handle_ptr && (other_ptr->info.core < num_cores))
+      {
+         core_load[other_ptr->info.core] += other_ptr->info.load_kpps;
+      }
+   }
+
+   uint32_t peer_cores = 0;
+   uint32_t candidates = 0;
+   uint32_t num_peers  = cu_placement_get_peer_cores(me_ptr, &peer_cores);
+   for (uint32_t c = 0; c < num_cores; c++)
+   {
+      if (peer_cores & (1u << c))
+      {
+         candidates |= core_domain[c];
+      }
+   }
+   if (0 == candidates)
+   {
+      candidates = all_cores;
+   }
+
+   uint32_t best_core = CU_PLACEMENT_INVALID_CORE;
+   for (uint32_t c = 0; c < num_cores; c++)
+   {
+      if ((candidates & (1u << c)) &&
+          ((CU_PLACEMENT_INVALID_CORE == best_core) || (core_load[c] < core_load[best_core])))
+      {
+         best_core = c;
+      }
+   }
+
+   uint32_t prev_core = entry_ptr->info.core;
+   uint32_t new_core  = best_core;
+   if ((prev_core < num_cores) && (candidates & (1u << prev_core)) &&
+       (core_load[prev_core] <= core_load[best_core] + load_kpps))
+   {
+      // moving would not reduce the imbalance
+      new_core = prev_core;
+   }
+
+   if (new_core != prev_core)
+   {
+      entry_ptr->info.core = new_core;
+      if (CU_PLACEMENT_INVALID_CORE != prev_core)
+      {
+         entry_ptr->info.num_moves++;
+      }
+   }
+
+   uint32_t num_moves = entry_ptr->info.num_moves;
+
+   cu_placement_unlock();
+
+   // thread is not launched yet on the first update during graph open, it is bound after the launch.
+   if (((new_core != prev_core) || thread_relaunched) && (NULL != me_ptr->cmd_handle.thread_id))
+   {
+      result = posal_thread_set_affinity(me_ptr->cmd_handle.thread_id, (1u << new_core));
+
+      CU_MSG(me_ptr->gu_ptr->log_id,
+             DBG_HIGH_PRIO,
+             "Placement: core %ld -> %lu, load %lu kpps, core load %lu kpps, num peers %lu, candidates 0x%lx, "
+             "num moves %lu, result %d",
+             (int32_t)prev_core,
+             new_core,
+             load_kpps,
+             core_load[new_core],
+             num_peers,
+             candidates,
+             num_moves,
+             result);
+   }
+
+   return result;
+}
+
+void cu_placement_remove(cu_base_t *me_ptr)
+{
+   cu_placement_lock();
+
+   cu_placement_entry_t *entry_ptr = cu_placement_find_entry(&me_ptr->spf_handle);
+   if (entry_ptr)
+   {
+      memset(entry_ptr, 0, sizeof(*entry_ptr));
+   }
+
+   cu_placement_unlock();
+}
+
+ar_result_t cu_placement_get_info(cu_base_t *me_ptr, cu_placement_info_t *info_ptr)
+{
+   ar_result_t result = AR_ENOTEXIST;
+
+   cu_placement_lock();
+
+   cu_placement_entry_t *entry_ptr = cu_placement_find_entry(&me_ptr->spf_handle);
+   if (entry_ptr)
+   {
+      *info_ptr = entry_ptr->info;
+      result    = AR_EOK;
+   }
+
+   cu_placement_unlock();
+
+   return result;
+}
@@ -0,0 +1,31 @@
+/**
+ * \file cu_placement.c
+ * \brief
+ *     This file contains stubbed container to core placement functions.
+ *
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "cu_i.h"
+
+/* =======================================================================
+Public Functions
+========================================================================== */
+
+ar_result_t cu_placement_update(cu_base_t *me_ptr, bool_t thread_relaunched)
+{
+   return AR_EOK;
+}
+
+void cu_placement_remove(cu_base_t *me_ptr)
+{
+   return;
+}
+
+ar_result_t cu_placement_get_info(cu_base_t *me_ptr, cu_placement_info_t *info_ptr)
+{
+   return AR_ENOTEXIST;
+}
@@ -308,6 +308,9 @@ typedef struct gu_module_flags_t
    uint8_t is_elementary         : 1;  /** TRUE if this module is an elementary module according to get static properties CAPI_IS_ELEMENTARY */
    uint8_t is_ds_at_sg_or_cntr_boundary : 1;  /** TRUE if this module's any output is at subgraph or container boundary */
    uint8_t is_us_at_sg_or_cntr_boundary : 1;  /** TRUE if this module's any input is at subgraph or container boundary */
+   uint8_t is_opening : 1;       /**< TRUE only while the module's subgraph is being merged into the primary gu. */
+   uint8_t is_conn_updated : 1;  /**< TRUE only while merging, if an already sorted module got new connections. */
+   uint8_t is_sort_pending : 1;  /**< TRUE only while merging, until the opening module is spliced into the sorted list. */
 } gu_module_flags_t;
 
 /**
@@ -408,6 +411,8 @@ typedef struct gu_t
    uint8_t           num_ext_out_ports;
    uint8_t           num_ext_ctrl_ports;
    uint8_t           num_parallel_paths; /**< number of parallel paths */
+   bool_t            skip_parallel_path_update; /**< TRUE if path index of newly opened modules is already assigned
+                                                      incrementally, next gu_update_parallel_paths can be skipped. */
    gu_sg_list_t      *sg_list_ptr;   /**< list of subgraphs. Each node is a gu_sg_t.*/
    gu_module_list_t  *sorted_module_list_ptr; /**< sorted module list. Sorted in DAG order. Each node is gu_module_t. Modules could
                                                     belong to different subgraphs. sg_ptr->module_list_ptr is the primary list. */
@@ -696,6 +701,10 @@ static inline gu_t* get_gu_ptr_for_current_command_context(gu_t* gu_ptr)
 	return (gu_ptr->async_gu_ptr)? &gu_ptr->async_gu_ptr->gu: gu_ptr;
 }
 
+#ifdef ENABLE_GRAPH_UTILS_TEST
+ar_result_t graph_utils_test();
+#endif
+
 #ifdef __cplusplus
 }
 #endif //__cplusplus
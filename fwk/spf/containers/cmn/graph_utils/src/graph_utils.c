@@ -26,6 +26,7 @@
 
 /** max ports just for bounds check. also internal variables for num ports are 8 bits*/
 #define MAX_PORTS 100
+#define GU_INVALID_PATH_INDEX 0xFF
 
 #define GU_MSG_PREFIX "GU  :%08lX: "
 
@@ -2527,6 +2528,248 @@ ar_result_t gu_update_sorted_list(gu_t *gu_ptr, POSAL_HEAP_ID heap_id)
    return result;
 }
 
+static bool_t gu_are_all_conn_inputs_marked(gu_module_t *module_ptr)
+{
+   for (gu_input_port_list_t *ip_port_list_ptr = module_ptr->input_port_list_ptr; ip_port_list_ptr;
+        LIST_ADVANCE(ip_port_list_ptr))
+   {
+      if (ip_port_list_ptr->ip_port_ptr->conn_out_port_ptr && !ip_port_list_ptr->ip_port_ptr->cmn.flags.mark)
+      {
+         return FALSE;
+      }
+   }
+   return TRUE;
+}
+
+static ar_result_t gu_insert_after_sorted_node(gu_t *            gu_ptr,
+                                               gu_module_list_t *node_ptr,
+                                               gu_module_t *     module_ptr,
+                                               POSAL_HEAP_ID     heap_id)
+{
+   if (node_ptr->next_ptr)
+   {
+      return spf_list_create_and_insert_before_node((spf_list_node_t **)&gu_ptr->sorted_module_list_ptr,
+                                                    (void *)module_ptr,
+                                                    (spf_list_node_t *)node_ptr->next_ptr,
+                                                    heap_id,
+                                                    TRUE /* use_pool*/);
+   }
+
+   return spf_list_insert_tail((spf_list_node_t **)&gu_ptr->sorted_module_list_ptr,
+                               (void *)module_ptr,
+                               heap_id,
+                               TRUE /* use_pool*/);
+}
+
+/**
+ * Splices the opening modules into the existing sorted list without re-sorting the modules which are already in it.
+ *
+ * affected_list_ptr has the opening modules (flags.is_opening) and the already sorted modules which got new
+ * connections (flags.is_conn_updated). Input ports are marked as their upstream module is visited, an opening module is
+ * inserted right after the visit which marks its last connected input. Walk stops as soon as all affected modules are
+ * visited, so unrelated part of the sorted list is not touched.
+ *
+ * Returns failure if the existing order can't accommodate the new connections, caller must fall back to full sort.
+ */
+static ar_result_t gu_splice_sorted_list(gu_t *gu_ptr, gu_module_list_t *affected_list_ptr, POSAL_HEAP_ID heap_id)
+{
+   INIT_EXCEPTION_HANDLING
+   ar_result_t result      = AR_EOK;
+   uint32_t    num_pending = 0;
+
+   // opening modules without any internal upstream connection go to the head, like the edge modules in full sort.
+   for (gu_module_list_t *list_ptr = affected_list_ptr; list_ptr; LIST_ADVANCE(list_ptr))
+   {
+      gu_module_t *module_ptr = list_ptr->module_ptr;
+      num_pending++;
+
+      if (module_ptr->flags.is_sort_pending && gu_are_all_conn_inputs_marked(module_ptr))
+      {
+         TRY(result,
+             spf_list_insert_head((spf_list_node_t **)&gu_ptr->sorted_module_list_ptr,
+                                  (void *)module_ptr,
+                                  heap_id,
+                                  TRUE /* use_pool*/));
+         module_ptr->flags.is_sort_pending = FALSE;
+      }
+   }
+
+   for (gu_module_list_t *node_ptr = gu_ptr->sorted_module_list_ptr; node_ptr && num_pending; LIST_ADVANCE(node_ptr))
+   {
+      gu_module_t *module_ptr = node_ptr->module_ptr;
+
+      if (!(module_ptr->flags.is_opening || module_ptr->flags.is_conn_updated))
+      {
+         continue;
+      }
+      num_pending--;
+
+      // every upstream connection which is new must have been visited already.
+      for (gu_input_port_list_t *ip_port_list_ptr = module_ptr->input_port_list_ptr; ip_port_list_ptr;
+           LIST_ADVANCE(ip_port_list_ptr))
+      {
+         gu_input_port_t *in_port_ptr = ip_port_list_ptr->ip_port_ptr;
+         if (!in_port_ptr->conn_out_port_ptr || in_port_ptr->cmn.flags.mark)
+         {
+            continue;
+         }
+
+         gu_module_t *prev_module_ptr = in_port_ptr->conn_out_port_ptr->cmn.module_ptr;
+         VERIFY(result, !(module_ptr->flags.is_opening || prev_module_ptr->flags.is_opening ||
+                          prev_module_ptr->flags.is_conn_updated));
+      }
+
+      gu_module_list_t *insert_after_ptr = node_ptr;
+      for (gu_output_port_list_t *op_port_list_ptr = module_ptr->output_port_list_ptr; op_port_list_ptr;
+           LIST_ADVANCE(op_port_list_ptr))
+      {
+         gu_input_port_t *next_in_port_ptr = op_port_list_ptr->op_port_ptr->conn_in_port_ptr;
+         if (!next_in_port_ptr)
+         {
+            continue;
+         }
+
+         next_in_port_ptr->cmn.flags.mark = TRUE;
+
+         gu_module_t *next_module_ptr = next_in_port_ptr->cmn.module_ptr;
+         if (next_module_ptr->flags.is_sort_pending && gu_are_all_conn_inputs_marked(next_module_ptr))
+         {
+            TRY(result, gu_insert_after_sorted_node(gu_ptr, insert_after_ptr, next_module_ptr, heap_id));
+            next_module_ptr->flags.is_sort_pending = FALSE;
+            LIST_ADVANCE(insert_after_ptr);
+         }
+      }
+   }
+
+   // an opening module which is never placed or an updated module which is never reached means the order is broken.
+   VERIFY(result, 0 == num_pending);
+
+   CATCH(result, GU_MSG_PREFIX, gu_ptr->log_id)
+   {
+   }
+
+   // clear marks only where they could have been set.
+   for (gu_module_list_t *list_ptr = affected_list_ptr; list_ptr; LIST_ADVANCE(list_ptr))
+   {
+      gu_module_t *module_ptr = list_ptr->module_ptr;
+      for (gu_input_port_list_t *ip_port_list_ptr = module_ptr->input_port_list_ptr; ip_port_list_ptr;
+           LIST_ADVANCE(ip_port_list_ptr))
+      {
+         ip_port_list_ptr->ip_port_ptr->cmn.flags.mark = FALSE;
+      }
+      for (gu_output_port_list_t *op_port_list_ptr = module_ptr->output_port_list_ptr; op_port_list_ptr;
+           LIST_ADVANCE(op_port_list_ptr))
+      {
+         if (op_port_list_ptr->op_port_ptr->conn_in_port_ptr)
+         {
+            op_port_list_ptr->op_port_ptr->conn_in_port_ptr->cmn.flags.mark = FALSE;
+         }
+      }
+   }
+
+   return result;
+}
+
+#ifdef GU_VERIFY_INCREMENTAL_SORT
+/**
+ * Checker for the incremental sort. Verifies that the spliced list is a valid topological order and that it has
+ * exactly the modules which the full sort would have.
+ */
+static void gu_verify_incremental_sort(gu_t *gu_ptr, POSAL_HEAP_ID heap_id)
+{
+   gu_module_list_t *spliced_list_ptr = gu_ptr->sorted_module_list_ptr;
+   uint32_t          num_spliced      = spf_list_count_elements((spf_list_node_t *)spliced_list_ptr);
+   bool_t            is_valid         = TRUE;
+
+   for (gu_module_list_t *node_ptr = spliced_list_ptr; node_ptr; LIST_ADVANCE(node_ptr))
+   {
+      if (!gu_are_all_conn_inputs_marked(node_ptr->module_ptr))
+      {
+         GU_MSG(gu_ptr->log_id,
+                DBG_ERROR_PRIO,
+                "Incremental sort: module 0x%lx is placed before its upstream",
+                node_ptr->module_ptr->module_instance_id);
+         is_valid = FALSE;
+      }
+
+      for (gu_output_port_list_t *op_port_list_ptr = node_ptr->module_ptr->output_port_list_ptr; op_port_list_ptr;
+           LIST_ADVANCE(op_port_list_ptr))
+      {
+         if (op_port_list_ptr->op_port_ptr->conn_in_port_ptr)
+         {
+            op_port_list_ptr->op_port_ptr->conn_in_port_ptr->cmn.flags.mark = TRUE;
+         }
+      }
+   }
+   gu_reset_graph_port_markers(gu_ptr);
+
+   // run the full sort on the side and compare the module sets.
+   gu_ptr->sorted_module_list_ptr = NULL;
+   if (AR_SUCCEEDED(gu_update_sorted_list(gu_ptr, heap_id)))
+   {
+      uint32_t num_full = spf_list_count_elements((spf_list_node_t *)gu_ptr->sorted_module_list_ptr);
+      for (gu_module_list_t *node_ptr = gu_ptr->sorted_module_list_ptr; node_ptr; LIST_ADVANCE(node_ptr))
+      {
+         if (!spf_list_contains_node((spf_list_node_t **)&spliced_list_ptr, node_ptr->module_ptr))
+         {
+            GU_MSG(gu_ptr->log_id,
+                   DBG_ERROR_PRIO,
+                   "Incremental sort: module 0x%lx is missing",
+                   node_ptr->module_ptr->module_instance_id);
+            is_valid = FALSE;
+         }
+      }
+      is_valid = is_valid && (num_full == num_spliced);
+      spf_list_delete_list((spf_list_node_t **)&gu_ptr->sorted_module_list_ptr, TRUE /* pool_used */);
+   }
+   gu_ptr->sorted_module_list_ptr = spliced_list_ptr;
+
+   GU_MSG(gu_ptr->log_id,
+          is_valid ? DBG_HIGH_PRIO : DBG_ERROR_PRIO,
+          "Incremental sort: verification %s, num sorted modules %lu",
+          is_valid ? "passed" : "failed",
+          num_spliced);
+}
+#endif
+
+/**
+ * Updates the sorted list after new subgraphs/connections are merged into the primary gu. Splices the opening
+ * modules into the existing order when possible, falls back to full sort otherwise.
+ */
+static ar_result_t gu_update_sorted_list_incremental(gu_t *            gu_ptr,
+                                                     gu_module_list_t *affected_list_ptr,
+                                                     POSAL_HEAP_ID     heap_id)
+{
+   ar_result_t result  = AR_EOK;
+   uint64_t    time_us = posal_timer_get_time();
+
+   if (!gu_ptr->sorted_module_list_ptr || !affected_list_ptr)
+   {
+      result = gu_update_sorted_list(gu_ptr, heap_id);
+   }
+   else if (AR_SUCCEEDED(gu_splice_sorted_list(gu_ptr, affected_list_ptr, heap_id)))
+   {
+      gu_ptr->sort_status = GU_SORT_UPDATED;
+
+#ifdef GU_VERIFY_INCREMENTAL_SORT
+      gu_verify_incremental_sort(gu_ptr, heap_id);
+#endif
+   }
+   else
+   {
+      GU_MSG(gu_ptr->log_id, DBG_HIGH_PRIO, "Incremental sort not possible, falling back to full sort");
+      result = gu_update_sorted_list(gu_ptr, heap_id);
+   }
+
+   GU_MSG(gu_ptr->log_id,
+          DBG_LOW_PRIO,
+          "Sorted list updated in %lu us, result 0x%lx",
+          (uint32_t)(posal_timer_get_time() - time_us),
+          result);
+
+   return result;
+}
+
 static void gu_propagate_path_index(gu_t *gu_ptr, gu_module_t *module_ptr, uint16_t path_index);
 static void gu_propagate_path_index_forward(gu_t *gu_ptr, gu_output_port_t *op_port_ptr, uint16_t path_index);
 static void gu_propagate_path_index_backward(gu_t *gu_ptr, gu_input_port_t *ip_port_ptr, uint16_t path_index);
@@ -2582,9 +2825,16 @@ static void gu_propagate_path_index_forward(gu_t *gu_ptr, gu_output_port_t *op_p
 
 void gu_update_parallel_paths(gu_t *gu_ptr)
 {
-   uint8_t  INVALID_PATH_INDEX = 0xFF;
+   uint8_t  INVALID_PATH_INDEX = GU_INVALID_PATH_INDEX;
    uint16_t path_index         = 0;
 
+   // path index of the newly opened modules is already assigned while merging them.
+   if (gu_ptr->skip_parallel_path_update)
+   {
+      gu_ptr->skip_parallel_path_update = FALSE;
+      return;
+   }
+
    gu_ptr->num_parallel_paths = 0;
 
    // Assign all path index to INVALID_PATH_INDEX.
@@ -2649,6 +2899,125 @@ void gu_update_parallel_paths(gu_t *gu_ptr)
    GU_MSG(gu_ptr->log_id, DBG_HIGH_PRIO, "Total number of parallel paths %hu", gu_ptr->num_parallel_paths);
 }
 
+// labels the connected set of opening modules reachable from module_ptr, and finds the path index of the already
+// existing modules that it connects to.
+static void gu_label_opening_modules(gu_module_t *module_ptr,
+                                     uint8_t      label,
+                                     uint8_t *    existing_path_index_ptr,
+                                     bool_t *     is_conflict_ptr)
+{
+   module_ptr->path_index = label;
+
+   for (gu_input_port_list_t *ip_port_list_ptr = module_ptr->input_port_list_ptr; ip_port_list_ptr;
+        LIST_ADVANCE(ip_port_list_ptr))
+   {
+      gu_output_port_t *prev_out_port_ptr = ip_port_list_ptr->ip_port_ptr->conn_out_port_ptr;
+      if (prev_out_port_ptr)
+      {
+         gu_module_t *prev_module_ptr = prev_out_port_ptr->cmn.module_ptr;
+         if (!prev_module_ptr->flags.is_opening)
+         {
+            *is_conflict_ptr |= ((GU_INVALID_PATH_INDEX != *existing_path_index_ptr) &&
+                                 (*existing_path_index_ptr != prev_module_ptr->path_index));
+            *existing_path_index_ptr = prev_module_ptr->path_index;
+         }
+         else if (label != prev_module_ptr->path_index)
+         {
+            gu_label_opening_modules(prev_module_ptr, label, existing_path_index_ptr, is_conflict_ptr);
+         }
+      }
+   }
+
+   for (gu_output_port_list_t *op_port_list_ptr = module_ptr->output_port_list_ptr; op_port_list_ptr;
+        LIST_ADVANCE(op_port_list_ptr))
+   {
+      if (op_port_list_ptr->op_port_ptr->attached_module_ptr)
+      {
+         op_port_list_ptr->op_port_ptr->attached_module_ptr->path_index = label;
+      }
+
+      gu_input_port_t *next_in_port_ptr = op_port_list_ptr->op_port_ptr->conn_in_port_ptr;
+      if (next_in_port_ptr)
+      {
+         gu_module_t *next_module_ptr = next_in_port_ptr->cmn.module_ptr;
+         if (!next_module_ptr->flags.is_opening)
+         {
+            *is_conflict_ptr |= ((GU_INVALID_PATH_INDEX != *existing_path_index_ptr) &&
+                                 (*existing_path_index_ptr != next_module_ptr->path_index));
+            *existing_path_index_ptr = next_module_ptr->path_index;
+         }
+         else if (label != next_module_ptr->path_index)
+         {
+            gu_label_opening_modules(next_module_ptr, label, existing_path_index_ptr, is_conflict_ptr);
+         }
+      }
+   }
+}
+
+/**
+ * Assigns path index to the opening modules without re-walking the existing graph. Opening modules which join one
+ * existing path inherit its index, the ones which are not connected to any existing module get a new index.
+ * Returns FALSE if the opening modules merge two existing paths, full update is needed in that case.
+ */
+static bool_t gu_update_parallel_paths_incremental(gu_t *gu_ptr, gu_module_list_t *opening_list_ptr)
+{
+   uint8_t num_parallel_paths = gu_ptr->num_parallel_paths;
+
+   for (gu_module_list_t *list_ptr = opening_list_ptr; list_ptr; LIST_ADVANCE(list_ptr))
+   {
+      list_ptr->module_ptr->path_index = GU_INVALID_PATH_INDEX;
+   }
+
+   for (gu_module_list_t *list_ptr = opening_list_ptr; list_ptr; LIST_ADVANCE(list_ptr))
+   {
+      gu_module_t *module_ptr          = list_ptr->module_ptr;
+      uint8_t      existing_path_index = GU_INVALID_PATH_INDEX;
+      bool_t       is_conflict         = FALSE;
+
+      if (GU_INVALID_PATH_INDEX != module_ptr->path_index)
+      {
+         continue;
+      }
+
+      if (!module_ptr->input_port_list_ptr && !module_ptr->output_port_list_ptr)
+      {
+         module_ptr->path_index = 0;
+         continue;
+      }
+
+      // need one spare label which is not an existing path index
+      if ((GU_INVALID_PATH_INDEX - 1) <= num_parallel_paths)
+      {
+         return FALSE;
+      }
+
+      gu_label_opening_modules(module_ptr, num_parallel_paths, &existing_path_index, &is_conflict);
+
+      if (is_conflict)
+      {
+         return FALSE;
+      }
+
+      if (GU_INVALID_PATH_INDEX == existing_path_index)
+      {
+         num_parallel_paths++;
+      }
+      else
+      {
+         gu_label_opening_modules(module_ptr, existing_path_index, &existing_path_index, &is_conflict);
+      }
+   }
+
+   gu_ptr->num_parallel_paths = num_parallel_paths;
+
+   GU_MSG(gu_ptr->log_id,
+          DBG_HIGH_PRIO,
+          "Total number of parallel paths %hu, updated incrementally",
+          gu_ptr->num_parallel_paths);
+
+   return TRUE;
+}
+
 gu_ext_ctrl_port_t *gu_get_ext_ctrl_port_for_inter_proc_imcl(gu_t *   gu_ptr,
                                                              uint32_t local_miid,
                                                              uint32_t remote_domain_id,
@@ -3102,6 +3471,9 @@ ar_result_t gu_destroy_graph(gu_t *gu_ptr, bool_t b_destroy_everything)
       return AR_EOK;
    }
 
+   // path index must be re-evaluated after modules are destroyed.
+   gu_ptr->skip_parallel_path_update = FALSE;
+
    {
       // check and destroy external input ports
       gu_ext_in_port_list_t *list_ptr = gu_ptr->ext_in_port_list_ptr;
@@ -4187,6 +4559,9 @@ ar_result_t gu_prepare_async_destroy(gu_t *gu_ptr, POSAL_HEAP_ID heap_id)
 
    MALLOC_MEMSET(gu_ptr->async_gu_ptr, gu_async_graph_t, sizeof(gu_async_graph_t), heap_id, result);
 
+   // path index must be re-evaluated after modules are destroyed.
+   gu_ptr->skip_parallel_path_update = FALSE;
+
    gu_t *dst_gu_ptr                  = &gu_ptr->async_gu_ptr->gu;
    dst_gu_ptr->log_id                = gu_ptr->log_id;
    dst_gu_ptr->container_instance_id = gu_ptr->container_instance_id;
@@ -4302,8 +4677,11 @@ ar_result_t gu_prepare_async_destroy(gu_t *gu_ptr, POSAL_HEAP_ID heap_id)
 ar_result_t gu_finish_async_create(gu_t *gu_ptr, POSAL_HEAP_ID heap_id)
 {
    INIT_EXCEPTION_HANDLING
-   ar_result_t result           = AR_EOK;
-   bool_t      b_sorting_needed = FALSE;
+   ar_result_t       result            = AR_EOK;
+   bool_t            b_sorting_needed  = FALSE;
+   gu_module_list_t *opening_list_ptr  = NULL; // modules of the subgraphs being merged
+   gu_module_list_t *affected_list_ptr = NULL; // opening modules + sorted modules which get new connections
+   bool_t            is_existing_link  = FALSE; // TRUE if a new link connects two modules which were already open
    if (!gu_ptr)
    {
       return AR_EBADPARAM;
@@ -4319,6 +4697,60 @@ ar_result_t gu_finish_async_create(gu_t *gu_ptr, POSAL_HEAP_ID heap_id)
    // if new internal links or SG are opened then need to sort the module list
    b_sorting_needed = (gu_ptr->async_gu_ptr->port_list_ptr || (src_gu_ptr->num_subgraphs)) ? TRUE : FALSE;
 
+   // collect the modules which need to be placed in the sorted list, before the SG lists are merged.
+   for (gu_sg_list_t *sg_list_ptr = src_gu_ptr->sg_list_ptr; sg_list_ptr; LIST_ADVANCE(sg_list_ptr))
+   {
+      for (gu_module_list_t *module_list_ptr = sg_list_ptr->sg_ptr->module_list_ptr; module_list_ptr;
+           LIST_ADVANCE(module_list_ptr))
+      {
+         gu_module_t *module_ptr = module_list_ptr->module_ptr;
+
+         // attached modules are not part of the sorted list
+         if (module_ptr->host_output_port_ptr)
+         {
+            continue;
+         }
+
+         module_ptr->flags.is_opening      = TRUE;
+         module_ptr->flags.is_sort_pending = TRUE;
+         TRY(result,
+             spf_list_insert_tail((spf_list_node_t **)&opening_list_ptr, module_ptr, heap_id, TRUE /* use_pool*/));
+         TRY(result,
+             spf_list_insert_tail((spf_list_node_t **)&affected_list_ptr, module_ptr, heap_id, TRUE /* use_pool*/));
+      }
+   }
+
+   for (gu_cmn_port_list_t *cmn_port_list_ptr = gu_ptr->async_gu_ptr->port_list_ptr; cmn_port_list_ptr;
+        LIST_ADVANCE(cmn_port_list_ptr))
+   {
+      gu_cmn_port_t *cmn_port_ptr  = cmn_port_list_ptr->cmn_port_ptr;
+      gu_module_t *  module_ptr    = cmn_port_ptr->module_ptr;
+      gu_module_t *  peer_mod_ptr  = NULL;
+      bool_t         is_input_port =
+         (AR_PORT_DIR_TYPE_INPUT == spf_get_bits(cmn_port_ptr->id, AR_PORT_DIR_TYPE_MASK, AR_PORT_DIR_TYPE_SHIFT));
+
+      if (is_input_port)
+      {
+         gu_input_port_t *in_port_ptr = (gu_input_port_t *)cmn_port_ptr;
+         peer_mod_ptr = in_port_ptr->conn_out_port_ptr ? in_port_ptr->conn_out_port_ptr->cmn.module_ptr : NULL;
+      }
+      else
+      {
+         gu_output_port_t *out_port_ptr = (gu_output_port_t *)cmn_port_ptr;
+         peer_mod_ptr = out_port_ptr->conn_in_port_ptr ? out_port_ptr->conn_in_port_ptr->cmn.module_ptr : NULL;
+      }
+
+      // such a link can join two existing parallel paths, which only the full path update handles.
+      is_existing_link |= (peer_mod_ptr && !peer_mod_ptr->flags.is_opening);
+
+      if (!(module_ptr->flags.is_opening || module_ptr->flags.is_conn_updated))
+      {
+         module_ptr->flags.is_conn_updated = TRUE;
+         TRY(result,
+             spf_list_insert_tail((spf_list_node_t **)&affected_list_ptr, module_ptr, heap_id, TRUE /* use_pool*/));
+      }
+   }
+
    gu_ptr->num_subgraphs += src_gu_ptr->num_subgraphs;
    spf_list_merge_lists(((spf_list_node_t **)&(gu_ptr->sg_list_ptr)), ((spf_list_node_t **)&(src_gu_ptr->sg_list_ptr)));
 
@@ -4338,13 +4770,26 @@ ar_result_t gu_finish_async_create(gu_t *gu_ptr, POSAL_HEAP_ID heap_id)
 
    if (b_sorting_needed)
    {
-      TRY(result, gu_update_sorted_list(gu_ptr, heap_id));
+      TRY(result, gu_update_sorted_list_incremental(gu_ptr, affected_list_ptr, heap_id));
+
+      // path index is assigned incrementally only if the new links all lead to opening modules.
+      gu_ptr->skip_parallel_path_update =
+         (!is_existing_link) && gu_update_parallel_paths_incremental(gu_ptr, opening_list_ptr);
    }
 
    CATCH(result, GU_MSG_PREFIX, gu_ptr->log_id)
    {
    }
 
+   for (gu_module_list_t *list_ptr = affected_list_ptr; list_ptr; LIST_ADVANCE(list_ptr))
+   {
+      list_ptr->module_ptr->flags.is_opening      = FALSE;
+      list_ptr->module_ptr->flags.is_conn_updated = FALSE;
+      list_ptr->module_ptr->flags.is_sort_pending = FALSE;
+   }
+   spf_list_delete_list((spf_list_node_t **)&opening_list_ptr, TRUE /* pool_used */);
+   spf_list_delete_list((spf_list_node_t **)&affected_list_ptr, TRUE /* pool_used */);
+
    MFREE_NULLIFY(gu_ptr->async_gu_ptr);
 
    return result;
@@ -0,0 +1,473 @@
+/**
+ * \file graph_utils_test.c
+ *
+ * \brief
+ *
+ *     Graph utils test file
+ *
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "ar_defs.h"
+#include "posal.h"
+#include "spf_utils.h"
+#include "ar_msg.h"
+#include "ar_ids.h"
+#include "graph_utils.h"
+
+#ifdef ENABLE_GRAPH_UTILS_TEST
+
+#ifdef __cplusplus
+extern "C" {
+#endif //__cplusplus
+
+/* Modules 0 (A) and 1 (B) are in SG 1, 2 (C) and 3 (D) in SG 2. 4 and 5 are in SG 3, which is opened by the tests. */
+#define GU_TEST_NUM_MODULES      6
+#define GU_TEST_NUM_OPEN_MODULES 4
+#define GU_TEST_NUM_SGS          3
+
+/* Port ids with the direction bit, even ids are inputs and odd ids are outputs. */
+#define GU_TEST_IN_PORT_ID  0x2
+#define GU_TEST_OUT_PORT_ID 0x1
+
+typedef struct gu_test_graph_t
+{
+   gu_t             gu;
+   gu_sg_t          sg[GU_TEST_NUM_SGS];
+   gu_module_t      module[GU_TEST_NUM_MODULES];
+   gu_input_port_t  in_port[GU_TEST_NUM_MODULES];
+   gu_output_port_t out_port[GU_TEST_NUM_MODULES];
+} gu_test_graph_t;
+
+static void gu_test_init_module(gu_test_graph_t *graph_ptr, uint32_t i, gu_sg_t *sg_ptr)
+{
+   gu_module_t *module_ptr = &graph_ptr->module[i];
+
+   module_ptr->module_instance_id = 0x1000 + i;
+   module_ptr->sg_ptr             = sg_ptr;
+   module_ptr->max_input_ports    = 1;
+   module_ptr->max_output_ports   = 1;
+
+   graph_ptr->in_port[i].cmn.id          = GU_TEST_IN_PORT_ID;
+   graph_ptr->in_port[i].cmn.module_ptr  = module_ptr;
+   graph_ptr->out_port[i].cmn.id         = GU_TEST_OUT_PORT_ID;
+   graph_ptr->out_port[i].cmn.module_ptr = module_ptr;
+
+   spf_list_insert_tail((spf_list_node_t **)&sg_ptr->module_list_ptr, module_ptr, POSAL_HEAP_DEFAULT, TRUE);
+   sg_ptr->num_modules++;
+}
+
+static void gu_test_connect(gu_test_graph_t *graph_ptr, uint32_t src, uint32_t dst)
+{
+   graph_ptr->out_port[src].conn_in_port_ptr = &graph_ptr->in_port[dst];
+   graph_ptr->in_port[dst].conn_out_port_ptr = &graph_ptr->out_port[src];
+}
+
+static void gu_test_insert_out_port(gu_test_graph_t *graph_ptr, uint32_t i)
+{
+   spf_list_insert_tail((spf_list_node_t **)&graph_ptr->module[i].output_port_list_ptr,
+                        &graph_ptr->out_port[i],
+                        POSAL_HEAP_DEFAULT,
+                        TRUE);
+   graph_ptr->module[i].num_output_ports++;
+}
+
+static void gu_test_insert_in_port(gu_test_graph_t *graph_ptr, uint32_t i)
+{
+   spf_list_insert_tail((spf_list_node_t **)&graph_ptr->module[i].input_port_list_ptr,
+                        &graph_ptr->in_port[i],
+                        POSAL_HEAP_DEFAULT,
+                        TRUE);
+   graph_ptr->module[i].num_input_ports++;
+}
+
+static void gu_test_insert_ports(gu_test_graph_t *graph_ptr, uint32_t src, uint32_t dst)
+{
+   gu_test_insert_out_port(graph_ptr, src);
+   gu_test_insert_in_port(graph_ptr, dst);
+}
+
+/* Port of an already open module which the async open connects, it is inserted by gu_finish_async_create. */
+static void gu_test_add_pending_port(gu_test_graph_t *graph_ptr, gu_cmn_port_t *cmn_port_ptr)
+{
+   spf_list_insert_tail((spf_list_node_t **)&graph_ptr->gu.async_gu_ptr->port_list_ptr,
+                        cmn_port_ptr,
+                        POSAL_HEAP_DEFAULT,
+                        TRUE);
+}
+
+static void gu_test_deinit(gu_test_graph_t *graph_ptr)
+{
+   for (uint32_t i = 0; i < GU_TEST_NUM_MODULES; i++)
+   {
+      spf_list_delete_list((spf_list_node_t **)&graph_ptr->module[i].input_port_list_ptr, TRUE);
+      spf_list_delete_list((spf_list_node_t **)&graph_ptr->module[i].output_port_list_ptr, TRUE);
+   }
+   for (uint32_t i = 0; i < GU_TEST_NUM_SGS; i++)
+   {
+      spf_list_delete_list((spf_list_node_t **)&graph_ptr->sg[i].module_list_ptr, TRUE);
+   }
+   if (graph_ptr->gu.async_gu_ptr)
+   {
+      spf_list_delete_list((spf_list_node_t **)&graph_ptr->gu.async_gu_ptr->gu.sg_list_ptr, TRUE);
+      spf_list_delete_list((spf_list_node_t **)&graph_ptr->gu.async_gu_ptr->port_list_ptr, TRUE);
+      posal_memory_free(graph_ptr->gu.async_gu_ptr);
+      graph_ptr->gu.async_gu_ptr = NULL;
+   }
+   spf_list_delete_list((spf_list_node_t **)&graph_ptr->gu.sg_list_ptr, TRUE);
+   spf_list_delete_list((spf_list_node_t **)&graph_ptr->gu.sorted_module_list_ptr, TRUE);
+}
+
+/**
+ * Allocates the test graph with two running subgraphs, A->B in SG 1 and C->D in SG 2. SG 3 is only initialized, its
+ * modules are not connected.
+ */
+static gu_test_graph_t *gu_test_create_graph()
+{
+   gu_test_graph_t *graph_ptr =
+      (gu_test_graph_t *)posal_memory_malloc(sizeof(gu_test_graph_t), POSAL_HEAP_DEFAULT);
+
+   if (NULL == graph_ptr)
+   {
+      return NULL;
+   }
+   memset(graph_ptr, 0, sizeof(gu_test_graph_t));
+
+   for (uint32_t i = 0; i < GU_TEST_NUM_SGS; i++)
+   {
+      graph_ptr->sg[i].id = 0x100 + i;
+   }
+
+   for (uint32_t i = 0; i < 2; i++)
+   {
+      spf_list_insert_tail((spf_list_node_t **)&graph_ptr->gu.sg_list_ptr,
+                           &graph_ptr->sg[i],
+                           POSAL_HEAP_DEFAULT,
+                           TRUE);
+      graph_ptr->gu.num_subgraphs++;
+   }
+
+   for (uint32_t i = 0; i < GU_TEST_NUM_MODULES; i++)
+   {
+      gu_test_init_module(graph_ptr, i, &graph_ptr->sg[i / 2]);
+   }
+
+   gu_test_connect(graph_ptr, 0, 1);
+   gu_test_insert_ports(graph_ptr, 0, 1);
+   gu_test_connect(graph_ptr, 2, 3);
+   gu_test_insert_ports(graph_ptr, 2, 3);
+
+   return graph_ptr;
+}
+
+/**
+ * Replaces the sorted list with the given order of the open modules. Used to start from a valid order which the full
+ * sort would not produce, so that a fall back to the full sort is visible in the result.
+ */
+static ar_result_t gu_test_set_sorted_list(gu_test_graph_t *graph_ptr, const uint32_t *order_ptr, uint32_t num)
+{
+   ar_result_t result = AR_EOK;
+
+   spf_list_delete_list((spf_list_node_t **)&graph_ptr->gu.sorted_module_list_ptr, TRUE);
+   for (uint32_t i = 0; i < num; i++)
+   {
+      result |= spf_list_insert_tail((spf_list_node_t **)&graph_ptr->gu.sorted_module_list_ptr,
+                                     &graph_ptr->module[order_ptr[i]],
+                                     POSAL_HEAP_DEFAULT,
+                                     TRUE);
+   }
+   graph_ptr->gu.sort_status = GU_SORT_UPDATED;
+
+   return result;
+}
+
+static ar_result_t gu_test_check_sorted_list(gu_test_graph_t *graph_ptr,
+                                             uint32_t         test_num,
+                                             const uint32_t * order_ptr,
+                                             uint32_t         num)
+{
+   ar_result_t       result   = AR_EOK;
+   uint32_t          i        = 0;
+   gu_module_list_t *list_ptr = graph_ptr->gu.sorted_module_list_ptr;
+
+   for (; list_ptr && (i < num); LIST_ADVANCE(list_ptr), i++)
+   {
+      if (list_ptr->module_ptr != &graph_ptr->module[order_ptr[i]])
+      {
+         AR_MSG(DBG_ERROR_PRIO,
+                "graph_utils_test %lu: sorted list position %lu has module 0x%lx, expected 0x%lx",
+                test_num,
+                i,
+                list_ptr->module_ptr->module_instance_id,
+                graph_ptr->module[order_ptr[i]].module_instance_id);
+         result |= AR_EFAILED;
+      }
+   }
+
+   if (list_ptr || (i != num))
+   {
+      AR_MSG(DBG_ERROR_PRIO,
+             "graph_utils_test %lu: sorted list has %lu modules, expected %lu",
+             test_num,
+             spf_list_count_elements((spf_list_node_t *)graph_ptr->gu.sorted_module_list_ptr),
+             num);
+      result |= AR_EFAILED;
+   }
+
+   return result;
+}
+
+static ar_result_t gu_test_start_async_open(gu_test_graph_t *graph_ptr)
+{
+   graph_ptr->gu.async_gu_ptr =
+      (gu_async_graph_t *)posal_memory_malloc(sizeof(gu_async_graph_t), POSAL_HEAP_DEFAULT);
+   if (NULL == graph_ptr->gu.async_gu_ptr)
+   {
+      return AR_ENOMEMORY;
+   }
+   memset(graph_ptr->gu.async_gu_ptr, 0, sizeof(gu_async_graph_t));
+
+   return AR_EOK;
+}
+
+/* Adds SG 3 to the async gu as the subgraph which is being opened. */
+static void gu_test_open_sg_3(gu_test_graph_t *graph_ptr)
+{
+   gu_t *src_gu_ptr = &graph_ptr->gu.async_gu_ptr->gu;
+
+   spf_list_insert_tail((spf_list_node_t **)&src_gu_ptr->sg_list_ptr, &graph_ptr->sg[2], POSAL_HEAP_DEFAULT, TRUE);
+   src_gu_ptr->num_subgraphs++;
+}
+
+/**
+ * Opens a link between two running subgraphs, A->B in SG 1 and C->D in SG 2, without opening a new subgraph.
+ * The open joins the two parallel paths into one, the path index must be updated even though nothing is opening.
+ */
+static ar_result_t test_1()
+{
+   ar_result_t      result    = AR_EOK;
+   gu_test_graph_t *graph_ptr = gu_test_create_graph();
+
+   if (NULL == graph_ptr)
+   {
+      return AR_ENOMEMORY;
+   }
+
+   result |= gu_update_sorted_list(&graph_ptr->gu, POSAL_HEAP_DEFAULT);
+   gu_update_parallel_paths(&graph_ptr->gu);
+
+   AR_MSG(DBG_HIGH_PRIO,
+          "graph_utils_test 1: before link open, num_parallel_paths: %u",
+          graph_ptr->gu.num_parallel_paths);
+   if (2 != graph_ptr->gu.num_parallel_paths)
+   {
+      result |= AR_EFAILED;
+   }
+
+   // open B->C as pending ports of the async gu, no subgraph is opening.
+   if (AR_EOK != gu_test_start_async_open(graph_ptr))
+   {
+      gu_test_deinit(graph_ptr);
+      posal_memory_free(graph_ptr);
+      return AR_ENOMEMORY;
+   }
+
+   gu_test_connect(graph_ptr, 1, 2);
+   gu_test_add_pending_port(graph_ptr, &graph_ptr->out_port[1].cmn);
+   gu_test_add_pending_port(graph_ptr, &graph_ptr->in_port[2].cmn);
+
+   result |= gu_finish_async_create(&graph_ptr->gu, POSAL_HEAP_DEFAULT);
+   gu_update_parallel_paths(&graph_ptr->gu);
+
+   AR_MSG(DBG_HIGH_PRIO,
+          "graph_utils_test 1: after link open, num_parallel_paths: %u",
+          graph_ptr->gu.num_parallel_paths);
+   if (1 != graph_ptr->gu.num_parallel_paths)
+   {
+      result |= AR_EFAILED;
+   }
+
+   for (uint32_t i = 1; i < GU_TEST_NUM_OPEN_MODULES; i++)
+   {
+      if (graph_ptr->module[i].path_index != graph_ptr->module[0].path_index)
+      {
+         AR_MSG(DBG_ERROR_PRIO,
+                "graph_utils_test 1: module 0x%lx has stale path_index %u, expected %u",
+                graph_ptr->module[i].module_instance_id,
+                graph_ptr->module[i].path_index,
+                graph_ptr->module[0].path_index);
+         result |= AR_EFAILED;
+      }
+   }
+
+   gu_test_deinit(graph_ptr);
+   posal_memory_free(graph_ptr);
+
+   return result;
+}
+
+/**
+ * Async open of SG 3 downstream of a running graph: B->E->F, with E and F opening. The sorted list starts as C, D, A, B,
+ * which is valid but not what the full sort gives. E and F must be spliced in after B and the existing order kept.
+ */
+static ar_result_t test_2()
+{
+   ar_result_t      result        = AR_EOK;
+   const uint32_t   start_order[] = { 2, 3, 0, 1 };
+   const uint32_t   end_order[]   = { 2, 3, 0, 1, 4, 5 };
+   gu_test_graph_t *graph_ptr     = gu_test_create_graph();
+
+   if (NULL == graph_ptr)
+   {
+      return AR_ENOMEMORY;
+   }
+
+   result |= gu_test_set_sorted_list(graph_ptr, start_order, POSAL_ARRAY_SIZE(start_order));
+   result |= gu_test_start_async_open(graph_ptr);
+   if (AR_DID_FAIL(result))
+   {
+      gu_test_deinit(graph_ptr);
+      posal_memory_free(graph_ptr);
+      return result;
+   }
+
+   gu_test_open_sg_3(graph_ptr);
+
+   gu_test_connect(graph_ptr, 4, 5);
+   gu_test_insert_ports(graph_ptr, 4, 5);
+
+   gu_test_connect(graph_ptr, 1, 4);
+   gu_test_insert_in_port(graph_ptr, 4);
+   gu_test_add_pending_port(graph_ptr, &graph_ptr->out_port[1].cmn);
+
+   result |= gu_finish_async_create(&graph_ptr->gu, POSAL_HEAP_DEFAULT);
+   result |= gu_test_check_sorted_list(graph_ptr, 2, end_order, POSAL_ARRAY_SIZE(end_order));
+
+   if (3 != graph_ptr->gu.num_subgraphs)
+   {
+      AR_MSG(DBG_ERROR_PRIO, "graph_utils_test 2: num_subgraphs %lu, expected 3", graph_ptr->gu.num_subgraphs);
+      result |= AR_EFAILED;
+   }
+
+   gu_test_deinit(graph_ptr);
+   posal_memory_free(graph_ptr);
+
+   return result;
+}
+
+/**
+ * Async open of SG 3 upstream of a running graph: E->A, with only E opening. E has no upstream and must be placed at
+ * the head of the sorted list, the order of the running modules C, D, A, B is kept.
+ */
+static ar_result_t test_3()
+{
+   ar_result_t      result        = AR_EOK;
+   const uint32_t   start_order[] = { 2, 3, 0, 1 };
+   const uint32_t   end_order[]   = { 4, 2, 3, 0, 1 };
+   gu_test_graph_t *graph_ptr     = gu_test_create_graph();
+
+   if (NULL == graph_ptr)
+   {
+      return AR_ENOMEMORY;
+   }
+
+   result |= gu_test_set_sorted_list(graph_ptr, start_order, POSAL_ARRAY_SIZE(start_order));
+   result |= gu_test_start_async_open(graph_ptr);
+   if (AR_DID_FAIL(result))
+   {
+      gu_test_deinit(graph_ptr);
+      posal_memory_free(graph_ptr);
+      return result;
+   }
+
+   // only E of SG 3 is used.
+   spf_list_delete_list((spf_list_node_t **)&graph_ptr->sg[2].module_list_ptr, TRUE);
+   graph_ptr->sg[2].num_modules = 0;
+   spf_list_insert_tail((spf_list_node_t **)&graph_ptr->sg[2].module_list_ptr,
+                        &graph_ptr->module[4],
+                        POSAL_HEAP_DEFAULT,
+                        TRUE);
+   graph_ptr->sg[2].num_modules++;
+   gu_test_open_sg_3(graph_ptr);
+
+   gu_test_connect(graph_ptr, 4, 0);
+   gu_test_insert_out_port(graph_ptr, 4);
+   gu_test_add_pending_port(graph_ptr, &graph_ptr->in_port[0].cmn);
+
+   result |= gu_finish_async_create(&graph_ptr->gu, POSAL_HEAP_DEFAULT);
+   result |= gu_test_check_sorted_list(graph_ptr, 3, end_order, POSAL_ARRAY_SIZE(end_order));
+
+   gu_test_deinit(graph_ptr);
+   posal_memory_free(graph_ptr);
+
+   return result;
+}
+
+/**
+ * Cross-SG link B->C between running subgraphs while the sorted list is C, D, A, B. C already comes before B, so the
+ * splice can't take the link and the full sort must run, giving A, B, C, D.
+ */
+static ar_result_t test_4()
+{
+   ar_result_t      result        = AR_EOK;
+   const uint32_t   start_order[] = { 2, 3, 0, 1 };
+   const uint32_t   end_order[]   = { 0, 1, 2, 3 };
+   gu_test_graph_t *graph_ptr     = gu_test_create_graph();
+
+   if (NULL == graph_ptr)
+   {
+      return AR_ENOMEMORY;
+   }
+
+   result |= gu_test_set_sorted_list(graph_ptr, start_order, POSAL_ARRAY_SIZE(start_order));
+   result |= gu_test_start_async_open(graph_ptr);
+   if (AR_DID_FAIL(result))
+   {
+      gu_test_deinit(graph_ptr);
+      posal_memory_free(graph_ptr);
+      return result;
+   }
+
+   gu_test_connect(graph_ptr, 1, 2);
+   gu_test_add_pending_port(graph_ptr, &graph_ptr->out_port[1].cmn);
+   gu_test_add_pending_port(graph_ptr, &graph_ptr->in_port[2].cmn);
+
+   result |= gu_finish_async_create(&graph_ptr->gu, POSAL_HEAP_DEFAULT);
+   result |= gu_test_check_sorted_list(graph_ptr, 4, end_order, POSAL_ARRAY_SIZE(end_order));
+
+   gu_test_deinit(graph_ptr);
+   posal_memory_free(graph_ptr);
+
+   return result;
+}
+
+ar_result_t graph_utils_test()
+{
+   ar_result_t result = AR_EOK, local_result = AR_EOK;
+
+   local_result = test_1();
+   AR_MSG(DBG_HIGH_PRIO, "graph_utils_test: test 1 result: %d", local_result);
+   result |= local_result;
+
+   local_result = test_2();
+   AR_MSG(DBG_HIGH_PRIO, "graph_utils_test: test 2 result: %d", local_result);
+   result |= local_result;
+
+   local_result = test_3();
+   AR_MSG(DBG_HIGH_PRIO, "graph_utils_test: test 3 result: %d", local_result);
+   result |= local_result;
+
+   local_result = test_4();
+   AR_MSG(DBG_HIGH_PRIO, "graph_utils_test: test 4 result: %d", local_result);
+   result |= local_result;
+
+   return result;
+}
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+#endif // ENABLE_GRAPH_UTILS_TEST
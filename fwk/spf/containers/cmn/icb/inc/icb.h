@@ -15,6 +15,7 @@
  */
 
 #include "spf_utils.h"
+#include "icb_nrt_batch.h"
 
 #ifdef __cplusplus
 extern "C" {
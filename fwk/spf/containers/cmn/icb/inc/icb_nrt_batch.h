@@ -0,0 +1,35 @@
+#ifndef ICB_NRT_BATCH_H_
+#define ICB_NRT_BATCH_H_
+
+/**
+ * \file icb_nrt_batch.h
+ *
+ * \brief
+ *
+ *     inter-container-buffering: buffering between non-real-time containers.
+ *     Kept apart from icb.h so that tools can set it without the framework utils headers.
+ *
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "ar_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif //__cplusplus
+
+/**
+ * Sets the number of regular buffers used between two non-real-time containers (e.g. file playback, offline render).
+ * With more buffers the upstream runs ahead and each wakeup of either container processes up to that many frames,
+ * amortizing the per-frame framework cost. Applies to buffers created after the call. 1 keeps the default buffering.
+ */
+void icb_set_nrt_batch_frames(uint32_t num_frames);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
+#endif /* ICB_NRT_BATCH_H_ */
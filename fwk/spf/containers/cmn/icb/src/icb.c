@@ -16,6 +16,18 @@
 #define ICB_MSG_PREFIX "ICB :%08X: "
 #define ICB_MSG(ID, xx_ss_mask, xx_fmt, ...) AR_MSG(xx_ss_mask, ICB_MSG_PREFIX xx_fmt, ID, ##__VA_ARGS__)
 
+#ifndef ICB_NRT_BATCH_FRAMES
+#define ICB_NRT_BATCH_FRAMES 1
+#endif
+
+/** Regular buffers between non-real-time containers, see icb_set_nrt_batch_frames */
+static uint32_t icb_nrt_batch_frames = ICB_NRT_BATCH_FRAMES;
+
+void icb_set_nrt_batch_frames(uint32_t num_frames)
+{
+   icb_nrt_batch_frames = (0 == num_frames) ? 1 : num_frames;
+}
+
 /** x must be larger than y & both must be fixed-point */
 static inline bool_t icb_is_multiple(uint32_t x, uint32_t y)
 {
@@ -227,6 +239,16 @@ ar_result_t icb_determine_buffering(icb_upstream_info_t *  us_ptr,
 #endif
    }
 
+   /**
+    * Neither side is paced by a clock: let the upstream run ahead by the batch size so that the upstream produces and
+    * the downstream consumes several frames per wakeup. Real time paths are not affected.
+    */
+   if (!us_ptr->flags.is_real_time && !ds_ptr->flags.is_real_time && (APM_SUB_GRAPH_SID_VOICE_CALL != us_ptr->sid) &&
+       (icb_nrt_batch_frames > result_ptr->num_reg_bufs))
+   {
+      result_ptr->num_reg_bufs = icb_nrt_batch_frames;
+   }
+
    ICB_MSG(us_ptr->log_id,
            DBG_HIGH_PRIO,
            "ICB: US ( frame len = %lu samples, sample rate = %lu kHz, frame len = %lu us, period = %lu us)",
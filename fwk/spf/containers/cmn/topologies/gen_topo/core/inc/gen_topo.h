@@ -57,6 +57,7 @@
 #include "topo_buf_mgr.h"
 #include "gen_topo_pure_st.h"
 #include "rtm_logging_api.h"
+#include "spf_thread_pool.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -502,6 +503,8 @@ typedef struct gen_topo_graph_init_t
    gpr_callback_t             gpr_cb_fn;
 
    topo_capi_callback_f       capi_cb;          /**< CAPI callback function */
+   uint32_t                   max_init_stack_size; /**< if nonzero, CAPI init is not done (AR_ENEEDMORE) for modules
+                                                        needing a bigger stack. Used for parallel create on pool workers */
 
    /** output */
    uint32_t                   max_stack_size;   /**< max stack size required for the topo (max of all CAPIs) */
@@ -655,6 +658,10 @@ typedef struct gen_topo_t
    uint32_t                      port_mf_rtm_dump_seq_num;  /**< sequence number used for dumping port MF to RTM */
 
    topo_capi_callback_f       capi_cb;          /**< CAPI callback function */
+
+   spf_thread_pool_inst_t       *create_tp_ptr;             /**< thread pool used to create CAPIs in parallel during graph open */
+   posal_nmutex_t                create_cb_lock;            /**< set only while CAPIs are created in parallel. Serializes the
+                                                                 events those modules raise from init */
 } gen_topo_t;
 
 
@@ -753,6 +760,7 @@ typedef union gen_topo_module_flags_t
       uint64_t supports_module_allow_duty_cycling : 1;  /**< INTF_EXTN_DUTY_CYCLING_ISLAND: Module to raise allow/disallow duty cycling to container unblock island entry */
       uint64_t supports_period : 1; /** < INTF_EXTN_PERIOD */
       uint64_t supports_stm_ts : 1; /**< INTF_EXTN_STM_TS: Module requires the latest signal-triggered timestamp value*/
+      uint64_t supports_shared_output_buf : 1; /**< INTF_EXTN_SHARED_OUTPUT_BUF: outputs are a copy of the input, fwk can publish the input buf on outputs */
    };
    uint64_t word;
 } gen_topo_module_flags_t;
@@ -770,6 +778,18 @@ typedef struct gen_topo_cached_event_node_t
    capi_register_event_to_dsp_client_v2_t reg_event_payload;
 } gen_topo_cached_event_node_t;
 
+/** Max ports of a module for which trigger groups are compiled into port index masks. */
+#define GEN_TOPO_TRIGGER_GROUP_MASK_MAX_PORTS 32
+
+/** Trigger group compiled into port index masks when the policy is set. Ports with a non-trigger policy are excluded. */
+typedef struct gen_topo_trigger_group_mask_t
+{
+   uint32_t                                  in_present_mask;     /**< input ports with PRESENT affinity to the group */
+   uint32_t                                  in_absent_mask;      /**< input ports with ABSENT affinity to the group */
+   uint32_t                                  out_present_mask;    /**< output ports with PRESENT affinity to the group */
+   uint32_t                                  out_absent_mask;     /**< output ports with ABSENT affinity to the group */
+} gen_topo_trigger_group_mask_t;
+
 typedef struct gen_topo_trigger_policy_t
 {
    fwk_extn_port_nontrigger_group_t          nontrigger_policy;   /**< ports belongs to non-trigger category? */
@@ -777,6 +797,9 @@ typedef struct gen_topo_trigger_policy_t
    fwk_extn_port_trigger_policy_t            port_trigger_policy; /**< port trigger policy */
    uint32_t                                  num_trigger_groups;  /**< groups of ports that can trigger */
    fwk_extn_port_trigger_group_t             *trigger_groups_ptr; /**< trigger groups */
+   gen_topo_trigger_group_mask_t             *group_masks_ptr;    /**< one per trigger group. NULL if module has more than
+                                                                       GEN_TOPO_TRIGGER_GROUP_MASK_MAX_PORTS ports on either
+                                                                       side, or no trigger groups were given. */
 } gen_topo_trigger_policy_t;
 
 typedef struct gen_topo_module_t
@@ -879,6 +902,10 @@ typedef union gen_topo_port_flags_t
                                                 GEN_TOPO_MF_PCM_UNPACKED_V2=0x2 indicates unpacked V2 */
 
       uint32_t       supports_buffer_resuse_extn: 2; /**< GEN_TOPO_MODULE_* bit mask */
+
+      uint32_t       is_shared_buf : 1;      /**< buf-mgr buffer is shared read-only with the fan-out ports of a module supporting
+                                                  INTF_EXTN_SHARED_OUTPUT_BUF. Must be unshared (gen_topo_check_unshare_port_buf) before
+                                                  writing into it. Cleared when the buffer is returned. */
    };
    uint32_t          word;
 
@@ -1918,12 +1945,18 @@ static inline bool_t gen_topo_is_dm_enabled(gen_topo_module_t *module_ptr)
    return (module_ptr->flags.is_dm_disabled == 0);
 }
 
+// A bypassed module only forwards its input, so it's called once per topo process irrespective of the LCM threshold.
+// This keeps it inplace, its input buf is handed to the next module without a copy.
+static inline uint32_t gen_topo_get_num_proc_loops(gen_topo_module_t *module_ptr)
+{
+   return module_ptr->bypass_ptr ? 1 : module_ptr->num_proc_loops;
+}
+
 // If a module is inplace (or) dynamic inplace (or) disabled, && current no of in/out ports is '1'.
 // then its considered inplace for topo buffer assignment.
 static inline bool_t gen_topo_is_inplace_or_disabled_siso(gen_topo_module_t *module_ptr)
 {
-   return ((module_ptr->flags.inplace || module_ptr->flags.dynamic_inplace ||
-            (module_ptr->bypass_ptr && (module_ptr->num_proc_loops == 1))) &&
+   return ((module_ptr->flags.inplace || module_ptr->flags.dynamic_inplace || module_ptr->bypass_ptr) &&
            (module_ptr->gu.num_input_ports == 1) && (module_ptr->gu.num_output_ports == 1));
 }
 
@@ -33,6 +33,12 @@ ar_result_t gen_topo_check_get_in_buf_from_buf_mgr_util_(gen_topo_t *
                                                          gen_topo_input_port_t * curr_in_port_ptr,
                                                          gen_topo_output_port_t *prev_out_port_ptr);
 
+/* Dont call this function directly, use gen_topo_check_unshare_port_buf() instead */
+ar_result_t gen_topo_unshare_port_buf_util_(gen_topo_t *            topo_ptr,
+                                            gen_topo_common_port_t *cmn_port_ptr,
+                                            uint32_t                module_inst_id,
+                                            uint32_t                port_id);
+
 ar_result_t gen_topo_initialize_bufs_sdata(gen_topo_t *            topo_ptr,
                                            gen_topo_common_port_t *cmn_port_ptr,
                                            uint32_t                miid,
@@ -49,7 +55,26 @@ ar_result_t gen_topo_initialize_bufs_sdata(gen_topo_t *            topo_ptr,
  * After every module process its input buffer and previous out buf are returned if
  *    empty by calling gen_topo_return_one_buf_mgr_buf.
  * Last module releases the buf from container by calling gen_topo_return_one_buf_mgr_buf
+ * Modules supporting INTF_EXTN_SHARED_OUTPUT_BUF get their input buf on the outputs (is_shared_buf).
+ *    - such a buf is read-only, ports unshare it with gen_topo_check_unshare_port_buf before writing.
  */
+
+/**
+ * A port whose buf is shared by a fan-out gets a private copy before the buf is written into.
+ */
+static inline ar_result_t gen_topo_check_unshare_port_buf(gen_topo_t *            topo_ptr,
+                                                          gen_topo_common_port_t *cmn_port_ptr,
+                                                          uint32_t                module_inst_id,
+                                                          uint32_t                port_id)
+{
+   if (!cmn_port_ptr->flags.is_shared_buf)
+   {
+      return AR_EOK;
+   }
+
+   return gen_topo_unshare_port_buf_util_(topo_ptr, cmn_port_ptr, module_inst_id, port_id);
+}
+
 /**
  * get out buf from buf mgr
  * in case of inplace out buf can be same as in buf, which should be assigned by this time.
@@ -70,7 +95,11 @@ static inline ar_result_t gen_topo_check_get_out_buf_from_buf_mgr(gen_topo_t *
 
    if (NULL != curr_out_port_ptr->common.bufs_ptr[0].data_ptr)
    {
-      return result;
+      // module is about to write into a buf it still shares with the fan-out.
+      return gen_topo_check_unshare_port_buf(topo_ptr,
+                                             &curr_out_port_ptr->common,
+                                             module_ptr->gu.module_instance_id,
+                                             curr_out_port_ptr->gu.cmn.id);
    }
 
    return gen_topo_check_get_out_buf_from_buf_mgr_util_(topo_ptr, module_ptr, curr_out_port_ptr);
@@ -302,7 +331,9 @@ static inline ar_result_t gen_topo_return_one_buf_mgr_buf(gen_topo_t *
             //     adjusted when borrowed and must be updated everytime dtmf borrows.
             //  2. IF data flow state is not at GAP, in other words if data is flowing.
             //  3. We can hold buffers only in Real time paths. In FTRT paths, the pile up can vary
+            //  4. Buffer is not shared with a fan-out, others may still be reading it.
             if ((cmn_port_ptr->data_flow_state != TOPO_DATA_FLOW_STATE_AT_GAP) &&
+                (FALSE == cmn_port_ptr->flags.is_shared_buf) &&
                 (FALSE == cmn_port_ptr->flags.downstream_req_data_buffering) &&
                  gen_topo_is_port_in_realtime_path(cmn_port_ptr))
             {
@@ -315,6 +346,7 @@ static inline ar_result_t gen_topo_return_one_buf_mgr_buf(gen_topo_t *
       }
 
       gen_topo_buf_mgr_wrapper_dec_ref_count_return(topo_ptr, module_inst_id, port_id, cmn_port_ptr);
+      cmn_port_ptr->flags.is_shared_buf = FALSE;
    }
 
    if (GEN_TOPO_BUF_ORIGIN_EXT_BUF != cmn_port_ptr->flags.buf_origin)
@@ -425,6 +457,10 @@ void       topo_buf_check_for_corruption_(uint32_t                log_id,
                                           uint32_t                port_id,
                                           gen_topo_common_port_t *cmn_port_ptr);
 
+#ifdef ENABLE_SHARED_BUF_TEST
+ar_result_t gen_topo_shared_buf_test();
+#endif
+
 #ifdef __cplusplus
 }
 #endif //__cplusplus
@@ -16,6 +16,7 @@
 #include "gen_topo_buf_mgr.h"
 #include "gen_topo_prof.h"
 #include "gen_topo_ctrl_port.h"
+#include "gen_topo_i.h"
 
 // clang-format off
 static const topo_cu_vtable_t gen_topo_cu_vtable =
@@ -344,15 +345,22 @@ static ar_result_t gen_topo_create_virtual_stub(gen_topo_t *           topo_ptr,
    return result;
 }
 
+/**
+ * is_prepared - serial num and GPR registration are already done by gen_topo_parallel_create_capis
+ */
 static ar_result_t gen_topo_create_module(gen_topo_t *           topo_ptr,
                                           gen_topo_graph_init_t *graph_init_ptr,
-                                          gen_topo_module_t *    module_ptr)
+                                          gen_topo_module_t *    module_ptr,
+                                          bool_t                 is_prepared)
 {
    ar_result_t result = AR_EOK;
    INIT_EXCEPTION_HANDLING
 
-   module_ptr->serial_num           = topo_ptr->module_count++;
-   module_ptr->kpps_scale_factor_q4 = UNITY_Q4;
+   if (!is_prepared)
+   {
+      module_ptr->serial_num           = topo_ptr->module_count++;
+      module_ptr->kpps_scale_factor_q4 = UNITY_Q4;
+   }
 
    spf_handle_t *gpr_cb_handle = graph_init_ptr->spf_handle_ptr;
 
@@ -364,7 +372,11 @@ static ar_result_t gen_topo_create_module(gen_topo_t *           topo_ptr,
    {
       if (AMDB_MODULE_TYPE_FRAMEWORK != module_ptr->gu.module_type)
       {
-         TRY(result, __gpr_cmd_register(module_ptr->gu.module_instance_id, graph_init_ptr->gpr_cb_fn, gpr_cb_handle));
+         if (!is_prepared)
+         {
+            TRY(result,
+                __gpr_cmd_register(module_ptr->gu.module_instance_id, graph_init_ptr->gpr_cb_fn, gpr_cb_handle));
+         }
          // In XPAN use cases, during module init, module registers with CPSS, which sends commands to the module
          // through GPR. If we have not registered for GPR first than this operation fails. Hence GPR registration
          // is required first.
@@ -592,6 +604,7 @@ ar_result_t gen_topo_create_modules(gen_topo_t *topo_ptr, gen_topo_graph_init_t
 {
    ar_result_t result = AR_EOK;
    INIT_EXCEPTION_HANDLING
+   gen_topo_parallel_create_t *pc_ptr = NULL;
 
    /* If async open is going on then this function will operate on async_gu which only contains new Subgraph.
     * If async open is not going on then this function will operate on main gu which will have all subgraphs.
@@ -601,6 +614,9 @@ ar_result_t gen_topo_create_modules(gen_topo_t *topo_ptr, gen_topo_graph_init_t
 
    topo_ptr->capi_cb = (NULL == graph_init_ptr->capi_cb) ? gen_topo_capi_callback : graph_init_ptr->capi_cb;
 
+   // CAPI init of large opens is fanned out first, rest of the create below stays in the module order.
+   pc_ptr = gen_topo_parallel_create_capis(topo_ptr, graph_init_ptr);
+
    for (; (NULL != sg_list_ptr); LIST_ADVANCE(sg_list_ptr))
    {
       gu_sg_t *sg_ptr = sg_list_ptr->sg_ptr;
@@ -624,10 +640,20 @@ ar_result_t gen_topo_create_modules(gen_topo_t *topo_ptr, gen_topo_graph_init_t
             // New modules - create from AMDB; also set/get properties
             if (GU_STATUS_NEW == module_ptr->gu.gu_status)
             {
+               ar_result_t capi_result = AR_EOK;
+               bool_t      is_prepared = gen_topo_parallel_create_is_prepared(pc_ptr, module_ptr, &capi_result);
+
+               // AR_ENEEDMORE: CAPI init needs more stack than the pool has, or the module didn't take the container
+               // callback after the parallel create. Created below from this thread.
+               if (AR_ENEEDMORE != capi_result)
+               {
+                  TRY(result, capi_result);
+               }
+
                module_ptr->topo_ptr = topo_ptr;
 
                // Also sets the ports.
-               TRY(result, gen_topo_create_module(topo_ptr, graph_init_ptr, module_ptr));
+               TRY(result, gen_topo_create_module(topo_ptr, graph_init_ptr, module_ptr, is_prepared));
             }
 
             /* Do data in/out port operations, and get port thresholds for all ports */
@@ -664,6 +690,8 @@ ar_result_t gen_topo_create_modules(gen_topo_t *topo_ptr, gen_topo_graph_init_t
    {
    }
 
+   gen_topo_parallel_create_release(pc_ptr);
+
    return result;
 }
 
@@ -975,6 +1003,8 @@ ar_result_t gen_topo_destroy_topo(gen_topo_t *topo_ptr)
 
    // free the started sorted module list if not done yet
    spf_list_delete_list((spf_list_node_t **)&topo_ptr->started_sorted_module_list_ptr, TRUE);
+
+   spf_thread_pool_release_instance(&topo_ptr->create_tp_ptr, topo_ptr->gu.log_id);
    return AR_EOK;
 }
 
@@ -162,6 +162,52 @@ capi_err_t gen_topo_mark_buf_mgr_buffers_to_force_return(gen_topo_t *topo_ptr)
    return CAPI_EOK;
 }
 
+/**
+ * A module which only duplicates its input (INTF_EXTN_SHARED_OUTPUT_BUF) gets its input buf on the output, instead of
+ * a new buf which it would fill with the same data. The buf stays read-only as long as more than one port refers to
+ * it, see gen_topo_check_unshare_port_buf().
+ */
+static void gen_topo_check_share_in_buf_with_output(gen_topo_t *            topo_ptr,
+                                                    gen_topo_module_t *     module_ptr,
+                                                    gen_topo_output_port_t *curr_out_port_ptr)
+{
+   // in low latency mode bufs are held across process calls along the nblc and cannot be shared.
+   if ((TOPO_BUF_LOW_LATENCY == topo_ptr->buf_mgr.mode) || (1 != module_ptr->gu.num_input_ports))
+   {
+      return;
+   }
+
+   gen_topo_input_port_t *in_port_ptr = (gen_topo_input_port_t *)module_ptr->gu.input_port_list_ptr->ip_port_ptr;
+
+   // only own buf-mgr bufs with the same layout as the output can be shared.
+   if ((NULL == in_port_ptr->common.bufs_ptr[0].data_ptr) ||
+       (GEN_TOPO_BUF_ORIGIN_BUF_MGR != in_port_ptr->common.flags.buf_origin) ||
+       (in_port_ptr->common.sdata.bufs_num != curr_out_port_ptr->common.sdata.bufs_num) ||
+       (in_port_ptr->common.flags.is_pcm_unpacked != curr_out_port_ptr->common.flags.is_pcm_unpacked) ||
+       (in_port_ptr->common.bufs_ptr[0].max_data_len != curr_out_port_ptr->common.max_buf_len_per_buf))
+   {
+      return;
+   }
+
+   gen_topo_assign_bufs_ptr(topo_ptr->gu.log_id,
+                            &curr_out_port_ptr->common,
+                            &in_port_ptr->common,
+                            module_ptr,
+                            curr_out_port_ptr->gu.cmn.id);
+   curr_out_port_ptr->common.flags.buf_origin = GEN_TOPO_BUF_ORIGIN_BUF_MGR;
+   gen_topo_buf_mgr_wrapper_inc_ref_count(&curr_out_port_ptr->common);
+
+   curr_out_port_ptr->common.flags.is_shared_buf = TRUE;
+   in_port_ptr->common.flags.is_shared_buf       = TRUE;
+
+   // upstream output is returned only after this module's process, it must not write into the buf until then.
+   gen_topo_output_port_t *prev_out_port_ptr = (gen_topo_output_port_t *)in_port_ptr->gu.conn_out_port_ptr;
+   if (prev_out_port_ptr && (prev_out_port_ptr->common.bufs_ptr[0].data_ptr == in_port_ptr->common.bufs_ptr[0].data_ptr))
+   {
+      prev_out_port_ptr->common.flags.is_shared_buf = TRUE;
+   }
+}
+
 /**
  * Dont call this function directly, use gen_topo_check_get_out_buf_from_buf_mgr() instead
  *
@@ -186,18 +232,35 @@ ar_result_t gen_topo_check_get_out_buf_from_buf_mgr_util_(gen_topo_t *
 {
    ar_result_t result = AR_EOK;
 
+   curr_out_port_ptr->common.flags.is_shared_buf = FALSE;
+
    if (gen_topo_is_inplace_or_disabled_siso(module_ptr))
    {
       gen_topo_input_port_t *in_port_ptr = (gen_topo_input_port_t *)module_ptr->gu.input_port_list_ptr->ip_port_ptr;
       if (in_port_ptr->common.bufs_ptr[0].data_ptr)
       {
+         // inplace module writes into its input, bypassed module only forwards it.
+         // if unsharing fails the output is left without buf, same as any failure to get a buf.
+         if (!module_ptr->bypass_ptr)
+         {
+            result = gen_topo_check_unshare_port_buf(topo_ptr,
+                                                     &in_port_ptr->common,
+                                                     module_ptr->gu.module_instance_id,
+                                                     in_port_ptr->gu.cmn.id);
+            if (AR_DID_FAIL(result))
+            {
+               return result;
+            }
+         }
+
          gen_topo_assign_bufs_ptr(topo_ptr->gu.log_id,
                                   &curr_out_port_ptr->common,
                                   &in_port_ptr->common,
                                   module_ptr,
                                   curr_out_port_ptr->gu.cmn.id);
          // in place modules are SISO (already checked)
-         curr_out_port_ptr->common.flags.buf_origin = in_port_ptr->common.flags.buf_origin;
+         curr_out_port_ptr->common.flags.buf_origin    = in_port_ptr->common.flags.buf_origin;
+         curr_out_port_ptr->common.flags.is_shared_buf = in_port_ptr->common.flags.is_shared_buf;
          gen_topo_buf_mgr_wrapper_inc_ref_count(&curr_out_port_ptr->common);
       }
    }
@@ -280,6 +343,11 @@ ar_result_t gen_topo_check_get_out_buf_from_buf_mgr_util_(gen_topo_t *
       }
    }
 
+   if ((NULL == curr_out_port_ptr->common.bufs_ptr[0].data_ptr) && module_ptr->flags.supports_shared_output_buf)
+   {
+      gen_topo_check_share_in_buf_with_output(topo_ptr, module_ptr, curr_out_port_ptr);
+   }
+
    // even after nblc end look up above, if we don't have buf, use topo buf mgr
    if (NULL == curr_out_port_ptr->common.bufs_ptr[0].data_ptr)
    {
@@ -325,12 +393,15 @@ ar_result_t gen_topo_check_get_in_buf_from_buf_mgr_util_(gen_topo_t *
                                module_ptr,
                                curr_in_port_ptr->gu.cmn.id);
 
-      curr_in_port_ptr->common.flags.buf_origin = prev_out_port_ptr->common.flags.buf_origin;
+      curr_in_port_ptr->common.flags.buf_origin    = prev_out_port_ptr->common.flags.buf_origin;
+      curr_in_port_ptr->common.flags.is_shared_buf = prev_out_port_ptr->common.flags.is_shared_buf;
       gen_topo_buf_mgr_wrapper_inc_ref_count(&curr_in_port_ptr->common);
       // don't release prev_out_port_ptr->common.bufs_ptr[0].data_ptr here, as return_buf is called.
    }
    else
    {
+      curr_in_port_ptr->common.flags.is_shared_buf = FALSE;
+
       if (curr_in_port_ptr->nblc_end_ptr &&
           gen_topo_is_inplace_nblc_from_ext_in(topo_ptr, module_ptr, curr_in_port_ptr))
       {
@@ -389,6 +460,76 @@ ar_result_t gen_topo_check_get_in_buf_from_buf_mgr_util_(gen_topo_t *
    return result;
 }
 
+/* Dont call this function directly, use gen_topo_check_unshare_port_buf() instead.
+ *
+ * The private copy keeps the layout of the shared buf, so lengths and channel spacing of the port stay valid. Whole
+ * bufs are copied since data may be present beyond actual_data_len (e.g. input not yet moved to beginning).
+ */
+ar_result_t gen_topo_unshare_port_buf_util_(gen_topo_t *            topo_ptr,
+                                            gen_topo_common_port_t *cmn_port_ptr,
+                                            uint32_t                module_inst_id,
+                                            uint32_t                port_id)
+{
+   ar_result_t result = AR_EOK;
+
+   // last reference, the port owns the buf now.
+   if ((NULL == cmn_port_ptr->bufs_ptr[0].data_ptr) || (gen_topo_buf_mgr_wrapper_get_ref_count(cmn_port_ptr) <= 1))
+   {
+      cmn_port_ptr->flags.is_shared_buf = FALSE;
+      return result;
+   }
+
+   int8_t *                    shared_buf_ptr     = cmn_port_ptr->bufs_ptr[0].data_ptr;
+   topo_buf_manager_element_t *shared_wrapper_ptr = (topo_buf_manager_element_t *)(shared_buf_ptr - TBF_BUF_PTR_OFFSET);
+   int8_t *                    new_buf_ptr        = NULL;
+
+   result = topo_buf_manager_get_buf(topo_ptr, &new_buf_ptr, shared_wrapper_ptr->size);
+   if (NULL == new_buf_ptr)
+   {
+      TOPO_MSG_ISLAND(topo_ptr->gu.log_id,
+                      DBG_ERROR_PRIO,
+                      " Module 0x%lX: Port 0x%lx, failed to get buffer to unshare 0x%p",
+                      module_inst_id,
+                      port_id,
+                      shared_buf_ptr);
+      return AR_DID_FAIL(result) ? result : AR_ENOMEMORY;
+   }
+
+   for (uint32_t b = 0; b < cmn_port_ptr->sdata.bufs_num; b++)
+   {
+      uint32_t offset      = (uint32_t)(cmn_port_ptr->bufs_ptr[b].data_ptr - shared_buf_ptr);
+      uint32_t buf_max_len = cmn_port_ptr->flags.is_pcm_unpacked ? cmn_port_ptr->bufs_ptr[0].max_data_len
+                                                                 : cmn_port_ptr->bufs_ptr[b].max_data_len;
+
+      TOPO_MEMSCPY_NO_RET(new_buf_ptr + offset,
+                          shared_wrapper_ptr->size - offset,
+                          cmn_port_ptr->bufs_ptr[b].data_ptr,
+                          buf_max_len,
+                          topo_ptr->gu.log_id,
+                          "COW: (0x%lX, 0x%lX) ",
+                          module_inst_id,
+                          port_id);
+
+      cmn_port_ptr->bufs_ptr[b].data_ptr = new_buf_ptr + offset;
+   }
+
+   // others still refer to the shared buf, so ref count doesn't reach zero here.
+   shared_wrapper_ptr->ref_count--;
+   cmn_port_ptr->flags.is_shared_buf = FALSE;
+
+#ifdef BUF_MGMT_DEBUG
+   TOPO_MSG_ISLAND(topo_ptr->gu.log_id,
+                   DBG_LOW_PRIO,
+                   " Module 0x%lX: Port 0x%lx, unshared buffer 0x%p -> 0x%p",
+                   module_inst_id,
+                   port_id,
+                   shared_buf_ptr,
+                   new_buf_ptr);
+#endif
+
+   return result;
+}
+
 /*********************************
  *
  *
@@ -12,6 +12,7 @@
 
 #include "gen_topo.h"
 #include "gen_topo_capi.h"
+#include "shared_output_buf_pvt_api.h"
 
 /* =======================================================================
 Public Function Definitions
@@ -506,6 +507,7 @@ static ar_result_t gen_topo_capi_query_intf_extn_support(void *             amdb
                               { INTF_EXTN_DUTY_CYCLING_ISLAND_MODE,  FALSE, { NULL, 0, 0 } },      \
                               { INTF_EXTN_PERIOD,                    FALSE, { NULL, 0, 0 } },      \
                               { INTF_EXTN_STM_TS,                    FALSE, { NULL, 0, 0 } },      \
+                              { INTF_EXTN_SHARED_OUTPUT_BUF,         FALSE, { NULL, 0, 0 } },      \
                             }
 
    #define LEN_OF_INTF_EXTNS_ARRAY SIZE_OF_ARRAY((capi_interface_extn_desc_t[]) INTF_EXTNS_ARRAY)
@@ -603,6 +605,11 @@ static ar_result_t gen_topo_capi_query_intf_extn_support(void *             amdb
                   module_ptr->flags.supports_stm_ts = TRUE;
                   break;
                }
+               case INTF_EXTN_SHARED_OUTPUT_BUF:
+               {
+                  module_ptr->flags.supports_shared_output_buf = TRUE;
+                  break;
+               }
                default:
                {
                   // Something can't be supported and not be handled. Shouldn't get here.
@@ -715,6 +722,19 @@ ar_result_t gen_topo_capi_create_from_amdb(gen_topo_module_t *    module_ptr,
    // get stack size and find max.
    TRY(result, gen_topo_capi_get_stack_size(amdb_handle, topo_ptr->gu.log_id, &stack_size, &init_proplist));
 
+   // calling thread cannot host this module's init; caller has to create it from a thread with a bigger stack.
+   if (graph_init_ptr->max_init_stack_size && (stack_size > graph_init_ptr->max_init_stack_size))
+   {
+      TOPO_MSG(log_id,
+               DBG_MED_PRIO,
+               "Module 0x%lX: stack size %lu is more than %lu, deferring init",
+               module_instance_id,
+               stack_size,
+               graph_init_ptr->max_init_stack_size);
+      MFREE_NULLIFY(capi_ptr);
+      return AR_ENEEDMORE;
+   }
+
    graph_init_ptr->max_stack_size = MAX(graph_init_ptr->max_stack_size, stack_size);
 
    gen_topo_capi_is_inplace_n_requires_data_buf(amdb_handle,
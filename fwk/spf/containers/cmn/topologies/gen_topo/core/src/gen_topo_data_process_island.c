@@ -388,6 +388,36 @@ ar_result_t gen_topo_copy_data_from_prev_to_next(gen_topo_t *            topo_pt
    }
    else
    {
+      // bufs shared by a fan-out are read-only: next is appended to and prev is written only if data is left in it.
+      // if unsharing fails nothing is copied, data stays in prev and is copied in a later pass.
+      result = gen_topo_check_unshare_port_buf(topo_ptr,
+                                               &next_in_port_ptr->common,
+                                               next_module_ptr->gu.module_instance_id,
+                                               next_in_port_ptr->gu.cmn.id);
+      if (AR_DID_FAIL(result))
+      {
+         return result;
+      }
+
+      if (prev_out_port_ptr->common.flags.is_shared_buf)
+      {
+         for (uint32_t b = 0; b < gen_topo_get_num_sdata_bufs_to_update(&next_in_port_ptr->common); b++)
+         {
+            if (prev_bufs_ptr[b].actual_data_len > (next_bufs_ptr[b].max_data_len - next_bufs_ptr[b].actual_data_len))
+            {
+               result = gen_topo_unshare_port_buf_util_(topo_ptr,
+                                                        &prev_out_port_ptr->common,
+                                                        prev_out_port_ptr->gu.cmn.module_ptr->module_instance_id,
+                                                        prev_out_port_ptr->gu.cmn.id);
+               if (AR_DID_FAIL(result))
+               {
+                  return result;
+               }
+               break;
+            }
+         }
+      }
+
       if (SPF_IS_PCM_DATA_FORMAT(next_med_fmt_ptr->data_format) &&
           (TOPO_DEINTERLEAVED_PACKED == next_med_fmt_ptr->pcm.interleaving))
       {
@@ -998,7 +1028,7 @@ ar_result_t gen_topo_populate_sdata_bufs(gen_topo_t *            topo_ptr,
 #ifdef VERBOSE_DEBUGGING
                                                                    1 ||
 #endif
-                                                                   (module_ptr->num_proc_loops == 1)))
+                                                                   (gen_topo_get_num_proc_loops(module_ptr) == 1)))
       {
          TOPO_MSG_ISLAND(topo_ptr->gu.log_id,
                          DBG_ERROR_PRIO,
@@ -1012,7 +1042,7 @@ ar_result_t gen_topo_populate_sdata_bufs(gen_topo_t *            topo_ptr,
 
    // for 1 looping, the sdata buf_ptr is already assigned properly. For more than one loop case, we neeed to use buf
    // from scratch mem as CAPI would need need data_ptr starting from zero (for output).
-   if (1 == module_ptr->num_proc_loops)
+   if (1 == gen_topo_get_num_proc_loops(module_ptr))
    {
       return AR_EOK;
    }
@@ -1083,7 +1113,7 @@ ar_result_t gen_topo_update_out_buf_len_after_process(gen_topo_t *            to
    // use sdata_ptr->bufs because buffers actual could be from  out_port_ptr->common.bufs_ptr (num_proc_loops=1) or from
    // pc_ptr->bufs (num_proc_loops>1)
 
-   if ((1 == module_ptr->num_proc_loops) && !err_check)
+   if ((1 == gen_topo_get_num_proc_loops(module_ptr)) && !err_check)
    {
       return AR_EOK;
    }
@@ -1262,6 +1292,27 @@ ar_result_t gen_topo_move_data_to_beginning_after_process(gen_topo_t *
 
    // This function needs to update actual data len
 
+   // leftover is moved within the buf, a buf shared by a fan-out must be unshared first.
+   // if unsharing fails the leftover cannot be moved and is dropped.
+   if (remaining_size_after_per_buf)
+   {
+      ar_result_t result = gen_topo_check_unshare_port_buf(topo_ptr,
+                                                           &in_port_ptr->common,
+                                                           in_port_ptr->gu.cmn.module_ptr->module_instance_id,
+                                                           in_port_ptr->gu.cmn.id);
+      if (AR_DID_FAIL(result))
+      {
+         TOPO_MSG_ISLAND(topo_ptr->gu.log_id,
+                         DBG_ERROR_PRIO,
+                         " Module 0x%lX: in-port-id 0x%lx: Dropping %lu bytes per buf left after process",
+                         in_port_ptr->gu.cmn.module_ptr->module_instance_id,
+                         in_port_ptr->gu.cmn.id,
+                         remaining_size_after_per_buf);
+         gen_topo_set_all_bufs_len_to_zero(&in_port_ptr->common);
+         return result;
+      }
+   }
+
    // remaining_size_after_per_buf is based on first ch or buf only, which is sufficient to check if any data remains.
    // Exact amount varies per buf.
    // whether remaining length is zero or not, the 'else' logic works.
@@ -1768,7 +1819,7 @@ GEN_TOPO_STATIC ar_result_t gen_topo_module_process(gen_topo_t *       topo_ptr,
          }
       }
 
-      if ((module_ptr->num_proc_loops) > 1 || err_check)
+      if ((gen_topo_get_num_proc_loops(module_ptr) > 1) || err_check)
       {
          if (AR_EOK != (local_result = gen_topo_populate_sdata_bufs(topo_ptr, module_ptr, out_port_ptr, err_check)))
          {
@@ -2404,6 +2455,8 @@ ar_result_t gen_topo_topo_process(gen_topo_t        *topo_ptr,
                    (path_index_ptr ? *path_index_ptr : 0));
 #endif
 
+   POSAL_TRACE(POSAL_TRACE_TOPO_PROCESS_BEGIN, topo_ptr->gu.container_instance_id, 0);
+
    for (gu_module_list_t *module_list_ptr = *start_module_list_pptr; (NULL != module_list_ptr);
         LIST_ADVANCE(module_list_ptr))
    {
@@ -2587,15 +2640,22 @@ ar_result_t gen_topo_topo_process(gen_topo_t        *topo_ptr,
          /** module process
           * return code: fail, success, need-more */
          bool_t terminate = FALSE;
-         for (uint32_t loop = 0; loop < module_ptr->num_proc_loops; loop++)
+         POSAL_TRACE(POSAL_TRACE_MODULE_PROCESS_BEGIN,
+                     module_ptr->gu.module_instance_id,
+                     topo_ptr->gu.container_instance_id);
+         uint32_t num_proc_loops = gen_topo_get_num_proc_loops(module_ptr);
+         for (uint32_t loop = 0; loop < num_proc_loops; loop++)
          {
-            bool_t is_final_loop = (loop == (module_ptr->num_proc_loops - 1));
+            bool_t is_final_loop = (loop == (num_proc_loops - 1));
             result |= gen_topo_module_process(topo_ptr, module_ptr, &terminate, is_final_loop);
             if (terminate)
             {
                break;
             }
          }
+         POSAL_TRACE(POSAL_TRACE_MODULE_PROCESS_END,
+                     module_ptr->gu.module_instance_id,
+                     topo_ptr->gu.container_instance_id);
       }
 
       for (gu_input_port_list_t *in_port_list_ptr = module_ptr->gu.input_port_list_ptr; (NULL != in_port_list_ptr);
@@ -2807,6 +2867,8 @@ ar_result_t gen_topo_topo_process(gen_topo_t        *topo_ptr,
       *start_module_list_pptr = NULL;
    }
 
+   POSAL_TRACE(POSAL_TRACE_TOPO_PROCESS_END, topo_ptr->gu.container_instance_id, 0);
+
    return result;
 }
 
@@ -19,6 +19,19 @@
 extern "C" {
 #endif //__cplusplus
 
+/** Context of the parallel CAPI create of one graph open, see gen_topo_parallel_create.c */
+typedef struct gen_topo_parallel_create_t gen_topo_parallel_create_t;
+
+gen_topo_parallel_create_t *gen_topo_parallel_create_capis(gen_topo_t *topo_ptr, gen_topo_graph_init_t *graph_init_ptr);
+bool_t                      gen_topo_parallel_create_is_prepared(gen_topo_parallel_create_t *pc_ptr,
+                                                                 gen_topo_module_t *         module_ptr,
+                                                                 ar_result_t *               result_ptr);
+void                        gen_topo_parallel_create_release(gen_topo_parallel_create_t *pc_ptr);
+
+#ifdef ENABLE_PARALLEL_CREATE_TEST
+ar_result_t gen_topo_parallel_create_test();
+#endif
+
 
 #if defined(__cplusplus)
 }
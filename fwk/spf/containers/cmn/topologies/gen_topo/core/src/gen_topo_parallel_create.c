@@ -0,0 +1,427 @@
+/**
+ * \file gen_topo_parallel_create.c
+ * \brief
+ *     This file contains functions to create the CAPIs of newly opened modules in parallel on the thread pool.
+ *
+ *     Only the per module part of the create (static properties, memory allocation and CAPI init) is fanned out.
+ *     GPR registration, fmwk/intf extension handling, port setup and everything that touches the graph stays on the
+ *     command thread, in the same module order as before.
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "gen_topo.h"
+#include "gen_topo_capi.h"
+#include "gen_topo_i.h"
+
+/* =======================================================================
+Macros
+========================================================================== */
+
+/** Minimum number of new CAPI modules in one open for parallel create. Below this the job hand off costs more than
+ *  the init it overlaps. */
+#define GEN_TOPO_PARALLEL_CREATE_MIN_MODULES (4)
+
+/** Max jobs pushed per open. Command thread also creates modules while the jobs run. */
+#define GEN_TOPO_PARALLEL_CREATE_MAX_JOBS (SPF_DEFAULT_THREAD_POOL_NUM_OF_WORKER_THREADS)
+
+/** Worker stack left for the framework frames below the CAPI init. */
+#define GEN_TOPO_PARALLEL_CREATE_FWK_STACK_MARGIN (2 * 1024)
+
+/* =======================================================================
+Structure Definitions
+========================================================================== */
+
+/** Shared by the command thread and the pool jobs of one open. Ref counted, since a job which is still queued when all
+ *  modules are done must not be waited for (pool workers may be busy with commands of other containers which are
+ *  themselves waiting); it finds nothing to do and drops its reference. */
+struct gen_topo_parallel_create_t
+{
+   gen_topo_t           *topo_ptr;
+   gen_topo_graph_init_t graph_init;     /**< copy of the callers graph init, with stack limit and serialized cb */
+   posal_nmutex_t        lock;           /**< protects the counters below and serializes the module events */
+   posal_condvar_t       done_cond;      /**< signalled when the last module is done */
+   uint32_t              ref_count;      /**< command thread + pushed jobs */
+   uint32_t              num_modules;    /**< number of modules in module_pptr */
+   uint32_t              next_idx;       /**< next module to be claimed */
+   uint32_t              num_done;       /**< number of modules done */
+   uint32_t              cursor;         /**< next module to be consumed by the serial create, see *_is_prepared */
+   uint32_t              max_stack_size; /**< max stack size of the modules created in parallel */
+   gen_topo_module_t   **module_pptr;    /**< modules in the order of creation */
+   ar_result_t          *result_ptr;     /**< create result per module */
+   spf_thread_pool_job_t jobs[GEN_TOPO_PARALLEL_CREATE_MAX_JOBS];
+};
+
+/* =======================================================================
+Static Functions
+========================================================================== */
+
+/**
+ * Event callback of the modules while they are created in parallel. Events raised from CAPI init on different threads
+ * are serialized. Only used within the create window, see gen_topo_parallel_create_restore_callback.
+ */
+static capi_err_t gen_topo_parallel_create_capi_callback(void *             context_ptr,
+                                                         capi_event_id_t    id,
+                                                         capi_event_info_t *event_info_ptr)
+{
+   gen_topo_module_t *module_ptr = (gen_topo_module_t *)context_ptr;
+   gen_topo_t *       topo_ptr   = module_ptr->topo_ptr;
+   posal_nmutex_t     lock       = topo_ptr->create_cb_lock;
+   capi_err_t         err_code   = CAPI_EOK;
+
+   posal_nmutex_lock(lock);
+   err_code = topo_ptr->capi_cb(context_ptr, id, event_info_ptr);
+   posal_nmutex_unlock(lock);
+
+   return err_code;
+}
+
+static bool_t gen_topo_parallel_create_is_allowed(gen_topo_t *topo_ptr)
+{
+#ifdef CONTAINER_ASYNC_CMD_HANDLING
+   /* Pool workers are neither the data path thread nor in the critical section. Fan out only if the caller isn't
+    * either, so that events raised from init go to the same event flags and can't deadlock on the critical section. */
+   return ((posal_thread_get_curr_tid() != topo_ptr->gu.data_path_thread_id) &&
+           (0 == topo_ptr->gu.is_sync_cmd_context_));
+#else
+   return TRUE;
+#endif
+}
+
+static bool_t gen_topo_parallel_create_is_candidate(gen_topo_module_t *module_ptr)
+{
+   return ((GU_STATUS_NEW == module_ptr->gu.gu_status) && (AMDB_INTERFACE_TYPE_STUB != module_ptr->gu.itype) &&
+           (AMDB_MODULE_TYPE_FRAMEWORK != module_ptr->gu.module_type) && (NULL != module_ptr->gu.amdb_handle) &&
+           (NULL == module_ptr->capi_ptr));
+}
+
+static uint32_t gen_topo_parallel_create_count_modules(gu_sg_list_t *sg_list_ptr, gen_topo_module_t **module_pptr)
+{
+   uint32_t num_modules = 0;
+
+   for (; (NULL != sg_list_ptr); LIST_ADVANCE(sg_list_ptr))
+   {
+      if (GU_STATUS_DEFAULT == sg_list_ptr->sg_ptr->gu_status)
+      {
+         continue;
+      }
+
+      for (gu_module_list_t *module_list_ptr = sg_list_ptr->sg_ptr->module_list_ptr; (NULL != module_list_ptr);
+           LIST_ADVANCE(module_list_ptr))
+      {
+         gen_topo_module_t *module_ptr = (gen_topo_module_t *)module_list_ptr->module_ptr;
+
+         if (gen_topo_parallel_create_is_candidate(module_ptr))
+         {
+            if (module_pptr)
+            {
+               module_pptr[num_modules] = module_ptr;
+            }
+            num_modules++;
+         }
+      }
+   }
+
+   return num_modules;
+}
+
+/**
+ * Claims modules one by one and creates their CAPI until none is left. Runs on the command thread and the pool jobs.
+ */
+static void gen_topo_parallel_create_run(gen_topo_parallel_create_t *pc_ptr)
+{
+   gen_topo_t *topo_ptr = pc_ptr->topo_ptr;
+
+   posal_nmutex_lock(pc_ptr->lock);
+
+   while (pc_ptr->next_idx < pc_ptr->num_modules)
+   {
+      uint32_t idx = pc_ptr->next_idx++;
+      posal_nmutex_unlock(pc_ptr->lock);
+
+      gen_topo_module_t *   module_ptr = pc_ptr->module_pptr[idx];
+      gen_topo_graph_init_t graph_init = pc_ptr->graph_init;
+      ar_result_t           result     = gen_topo_capi_create_from_amdb(module_ptr,
+                                                           topo_ptr,
+                                                           (void *)module_ptr->gu.amdb_handle,
+                                                           module_ptr->gu.module_heap_id,
+                                                           &graph_init);
+
+      posal_nmutex_lock(pc_ptr->lock);
+
+      pc_ptr->result_ptr[idx] = result;
+      pc_ptr->max_stack_size  = MAX(pc_ptr->max_stack_size, graph_init.max_stack_size);
+
+      if (++pc_ptr->num_done == pc_ptr->num_modules)
+      {
+         posal_condvar_signal(pc_ptr->done_cond);
+      }
+   }
+
+   posal_nmutex_unlock(pc_ptr->lock);
+}
+
+static ar_result_t gen_topo_parallel_create_job(void *ctx_ptr)
+{
+   gen_topo_parallel_create_t *pc_ptr = (gen_topo_parallel_create_t *)ctx_ptr;
+
+   gen_topo_parallel_create_run(pc_ptr);
+
+   gen_topo_parallel_create_release(pc_ptr);
+
+   return AR_EOK;
+}
+
+/**
+ * Done on the command thread before fanning out, in the module order.
+ * GPR registration has to be done before init (see gen_topo_create_module).
+ */
+static ar_result_t gen_topo_parallel_create_prepare_module(gen_topo_t *           topo_ptr,
+                                                           gen_topo_graph_init_t *graph_init_ptr,
+                                                           gen_topo_module_t *    module_ptr)
+{
+   ar_result_t result = AR_EOK;
+
+   result =
+      __gpr_cmd_register(module_ptr->gu.module_instance_id, graph_init_ptr->gpr_cb_fn, graph_init_ptr->spf_handle_ptr);
+   if (AR_FAILED(result))
+   {
+      return result;
+   }
+
+   module_ptr->topo_ptr             = topo_ptr;
+   module_ptr->serial_num           = topo_ptr->module_count++;
+   module_ptr->kpps_scale_factor_q4 = UNITY_Q4;
+
+   return result;
+}
+
+/**
+ * Points the event callback of a module created in parallel back to the container callback, so that its events after
+ * the create neither take the create lock nor go through the extra hop.
+ * A module which doesn't take the callback at set properties is destroyed, and created again by the serial create.
+ */
+static ar_result_t gen_topo_parallel_create_restore_callback(gen_topo_t *topo_ptr, gen_topo_module_t *module_ptr)
+{
+   capi_err_t                 err_code = CAPI_EOK;
+   capi_event_callback_info_t cb_obj   = { .event_cb = topo_ptr->capi_cb, .event_context = (void *)module_ptr };
+   capi_prop_t                props[1];
+   capi_proplist_t            props_list;
+
+   props[0].id                      = CAPI_EVENT_CALLBACK_INFO;
+   props[0].payload.actual_data_len = sizeof(capi_event_callback_info_t);
+   props[0].payload.max_data_len    = sizeof(capi_event_callback_info_t);
+   props[0].payload.data_ptr        = (int8_t *)&cb_obj;
+   props[0].port_info.is_valid      = FALSE;
+
+   props_list.props_num = 1;
+   props_list.prop_ptr  = props;
+
+   err_code = module_ptr->capi_ptr->vtbl_ptr->set_properties(module_ptr->capi_ptr, &props_list);
+   if (CAPI_SUCCEEDED(err_code))
+   {
+      return AR_EOK;
+   }
+
+   TOPO_MSG(topo_ptr->gu.log_id,
+            DBG_MED_PRIO,
+            "Module 0x%lX: setting event callback failed 0x%lx, creating again serially",
+            module_ptr->gu.module_instance_id,
+            err_code);
+
+   module_ptr->capi_ptr->vtbl_ptr->end(module_ptr->capi_ptr);
+   MFREE_NULLIFY(module_ptr->capi_ptr);
+
+   return AR_ENEEDMORE;
+}
+
+/* =======================================================================
+Public Functions
+========================================================================== */
+
+/**
+ * Creates the CAPIs of the new modules in parallel, if there are enough of them.
+ * Returns NULL if nothing was done, in which case the modules are created serially as usual.
+ */
+gen_topo_parallel_create_t *gen_topo_parallel_create_capis(gen_topo_t *topo_ptr, gen_topo_graph_init_t *graph_init_ptr)
+{
+   gen_topo_parallel_create_t *pc_ptr      = NULL;
+   uint32_t                    log_id      = topo_ptr->gu.log_id;
+   uint32_t                    num_jobs    = 0;
+   gu_sg_list_t *              sg_list_ptr = get_gu_ptr_for_current_command_context(&topo_ptr->gu)->sg_list_ptr;
+
+   if (!gen_topo_parallel_create_is_allowed(topo_ptr))
+   {
+      return NULL;
+   }
+
+   uint32_t num_modules = gen_topo_parallel_create_count_modules(sg_list_ptr, NULL);
+   if (num_modules < GEN_TOPO_PARALLEL_CREATE_MIN_MODULES)
+   {
+      return NULL;
+   }
+
+   // same parameters as the default pool so that its workers are shared instead of launching new ones.
+   if ((NULL == topo_ptr->create_tp_ptr) &&
+       AR_FAILED(spf_thread_pool_get_instance(&topo_ptr->create_tp_ptr,
+                                              POSAL_HEAP_DEFAULT,
+                                              SPF_DEFAULT_THREAD_POOL_PRIO,
+                                              FALSE, /*is_dedicated_pool*/
+                                              SPF_DEFAULT_THREAD_POOL_STACK_SIZE,
+                                              SPF_DEFAULT_THREAD_POOL_NUM_OF_WORKER_THREADS,
+                                              log_id)))
+   {
+      return NULL;
+   }
+
+   uint32_t size = ALIGN_8_BYTES(sizeof(gen_topo_parallel_create_t)) +
+                   ALIGN_8_BYTES(num_modules * sizeof(gen_topo_module_t *)) + (num_modules * sizeof(ar_result_t));
+
+   pc_ptr = (gen_topo_parallel_create_t *)posal_memory_malloc(size, topo_ptr->heap_id);
+   if (NULL == pc_ptr)
+   {
+      return NULL;
+   }
+   memset(pc_ptr, 0, size);
+
+   pc_ptr->module_pptr = (gen_topo_module_t **)((int8_t *)pc_ptr + ALIGN_8_BYTES(sizeof(gen_topo_parallel_create_t)));
+   pc_ptr->result_ptr  = (ar_result_t *)((int8_t *)pc_ptr->module_pptr +
+                                        ALIGN_8_BYTES(num_modules * sizeof(gen_topo_module_t *)));
+
+   if (AR_FAILED(posal_nmutex_create(&pc_ptr->lock, topo_ptr->heap_id)) ||
+       AR_FAILED(posal_condvar_create(&pc_ptr->done_cond, topo_ptr->heap_id)))
+   {
+      pc_ptr->ref_count = 1;
+      gen_topo_parallel_create_release(pc_ptr);
+      return NULL;
+   }
+
+   pc_ptr->topo_ptr                       = topo_ptr;
+   pc_ptr->ref_count                      = 1;
+   pc_ptr->graph_init                     = *graph_init_ptr;
+   pc_ptr->graph_init.capi_cb             = gen_topo_parallel_create_capi_callback;
+   pc_ptr->graph_init.max_init_stack_size = SPF_DEFAULT_THREAD_POOL_STACK_SIZE - GEN_TOPO_PARALLEL_CREATE_FWK_STACK_MARGIN;
+
+   gen_topo_parallel_create_count_modules(sg_list_ptr, pc_ptr->module_pptr);
+
+   // a registration failure is left to the serial create, which fails the open at the same module as before.
+   for (; pc_ptr->num_modules < num_modules; pc_ptr->num_modules++)
+   {
+      if (AR_FAILED(
+             gen_topo_parallel_create_prepare_module(topo_ptr, graph_init_ptr, pc_ptr->module_pptr[pc_ptr->num_modules])))
+      {
+         break;
+      }
+   }
+
+   topo_ptr->create_cb_lock = pc_ptr->lock;
+
+   // no lock needed until the first job is pushed.
+   num_jobs = (pc_ptr->num_modules > 1) ? MIN(pc_ptr->num_modules - 1, GEN_TOPO_PARALLEL_CREATE_MAX_JOBS) : 0;
+   pc_ptr->ref_count += num_jobs;
+
+   for (uint32_t i = 0; i < num_jobs; i++)
+   {
+      spf_thread_pool_job_t *job_ptr = &pc_ptr->jobs[i];
+      job_ptr->job_func_ptr          = gen_topo_parallel_create_job;
+      job_ptr->job_context_ptr       = (void *)pc_ptr;
+
+      if (AR_FAILED(spf_thread_pool_push_job(topo_ptr->create_tp_ptr, job_ptr, 0)))
+      {
+         posal_nmutex_lock(pc_ptr->lock);
+         pc_ptr->ref_count -= (num_jobs - i);
+         posal_nmutex_unlock(pc_ptr->lock);
+         num_jobs = i;
+         break;
+      }
+   }
+
+   gen_topo_parallel_create_run(pc_ptr);
+
+   // only modules claimed by the jobs which are already running are waited for.
+   posal_nmutex_lock(pc_ptr->lock);
+   while (pc_ptr->num_done < pc_ptr->num_modules)
+   {
+      posal_condvar_wait(pc_ptr->done_cond, pc_ptr->lock);
+   }
+   posal_nmutex_unlock(pc_ptr->lock);
+
+   topo_ptr->create_cb_lock = NULL;
+
+   // all jobs are done with the modules, from here on their events must not go through the create lock.
+   for (uint32_t i = 0; i < pc_ptr->num_modules; i++)
+   {
+      gen_topo_module_t *module_ptr = pc_ptr->module_pptr[i];
+
+      if ((AR_EOK == pc_ptr->result_ptr[i]) && (NULL != module_ptr->capi_ptr))
+      {
+         pc_ptr->result_ptr[i] = gen_topo_parallel_create_restore_callback(topo_ptr, module_ptr);
+      }
+   }
+
+   graph_init_ptr->max_stack_size = MAX(graph_init_ptr->max_stack_size, pc_ptr->max_stack_size);
+
+   TOPO_MSG(log_id,
+            DBG_HIGH_PRIO,
+            "Created %lu of %lu new CAPIs in parallel with %lu pool jobs",
+            pc_ptr->num_modules,
+            num_modules,
+            num_jobs);
+
+   return pc_ptr;
+}
+
+/**
+ * Consumes the next prepared module, modules must be queried in the creation order.
+ * Returns TRUE if the module was prepared by gen_topo_parallel_create_capis, along with its create result.
+ * AR_ENEEDMORE means the CAPI still has to be created by the caller.
+ */
+bool_t gen_topo_parallel_create_is_prepared(gen_topo_parallel_create_t *pc_ptr,
+                                            gen_topo_module_t *         module_ptr,
+                                            ar_result_t *               result_ptr)
+{
+   *result_ptr = AR_EOK;
+
+   if ((NULL == pc_ptr) || (pc_ptr->cursor >= pc_ptr->num_modules) ||
+       (module_ptr != pc_ptr->module_pptr[pc_ptr->cursor]))
+   {
+      return FALSE;
+   }
+
+   *result_ptr = pc_ptr->result_ptr[pc_ptr->cursor++];
+   return TRUE;
+}
+
+void gen_topo_parallel_create_release(gen_topo_parallel_create_t *pc_ptr)
+{
+   bool_t is_last = TRUE;
+
+   if (NULL == pc_ptr)
+   {
+      return;
+   }
+
+   if (pc_ptr->lock)
+   {
+      posal_nmutex_lock(pc_ptr->lock);
+      is_last = (0 == --pc_ptr->ref_count);
+      posal_nmutex_unlock(pc_ptr->lock);
+   }
+
+   if (is_last)
+   {
+      if (pc_ptr->done_cond)
+      {
+         posal_condvar_destroy(&pc_ptr->done_cond);
+      }
+
+      if (pc_ptr->lock)
+      {
+         posal_nmutex_destroy(&pc_ptr->lock);
+      }
+
+      posal_memory_free(pc_ptr);
+   }
+}
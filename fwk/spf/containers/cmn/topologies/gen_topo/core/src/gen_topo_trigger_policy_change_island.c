@@ -81,6 +81,57 @@ static ar_result_t gen_topo_validate_trigger_non_trigger(uint32_t
    return result;
 }
 
+/**
+ * Compiles the port affinities of each trigger group into port index masks, so that the ports dictating a group
+ * don't have to be looked up port by port during every trigger evaluation.
+ */
+static void gen_topo_compile_trigger_group_masks(gen_topo_module_t *module_ptr, gen_topo_trigger_policy_t *tp_ptr)
+{
+   fwk_extn_port_nontrigger_policy_t *in_nontrigger_ptr  = tp_ptr->nontrigger_policy.in_port_grp_policy_ptr;
+   fwk_extn_port_nontrigger_policy_t *out_nontrigger_ptr = tp_ptr->nontrigger_policy.out_port_grp_policy_ptr;
+
+   for (uint32_t g = 0; g < tp_ptr->num_trigger_groups; g++)
+   {
+      gen_topo_trigger_group_mask_t *mask_ptr = &tp_ptr->group_masks_ptr[g];
+      memset(mask_ptr, 0, sizeof(*mask_ptr));
+
+      for (uint32_t i = 0; i < module_ptr->gu.max_input_ports; i++)
+      {
+         if (in_nontrigger_ptr && GEN_TOPO_IS_NON_TRIGGERABLE_PORT(in_nontrigger_ptr[i]))
+         {
+            continue;
+         }
+
+         fwk_extn_port_trigger_affinity_t a = tp_ptr->trigger_groups_ptr[g].in_port_grp_affinity_ptr[i];
+         if (FWK_EXTN_PORT_TRIGGER_AFFINITY_PRESENT == a)
+         {
+            mask_ptr->in_present_mask |= (1u << i);
+         }
+         else if (FWK_EXTN_PORT_TRIGGER_AFFINITY_ABSENT == a)
+         {
+            mask_ptr->in_absent_mask |= (1u << i);
+         }
+      }
+
+      for (uint32_t i = 0; i < module_ptr->gu.max_output_ports; i++)
+      {
+         if (out_nontrigger_ptr && GEN_TOPO_IS_NON_TRIGGERABLE_PORT(out_nontrigger_ptr[i]))
+         {
+            continue;
+         }
+
+         fwk_extn_port_trigger_affinity_t a = tp_ptr->trigger_groups_ptr[g].out_port_grp_affinity_ptr[i];
+         if (FWK_EXTN_PORT_TRIGGER_AFFINITY_PRESENT == a)
+         {
+            mask_ptr->out_present_mask |= (1u << i);
+         }
+         else if (FWK_EXTN_PORT_TRIGGER_AFFINITY_ABSENT == a)
+         {
+            mask_ptr->out_absent_mask |= (1u << i);
+         }
+      }
+   }
+}
 
 capi_err_t gen_topo_change_data_trigger_policy_cb_fn(void *                            context_ptr,
                                                             fwk_extn_port_nontrigger_group_t *nontriggerable_ports_ptr,
@@ -240,6 +291,15 @@ capi_err_t gen_topo_change_trigger_policy_cb_fn(gen_topo_trigger_t
                                           sizeof(fwk_extn_port_trigger_affinity_t) * module_ptr->gu.max_input_ports +
                                           sizeof(fwk_extn_port_trigger_affinity_t) * module_ptr->gu.max_output_ports);
 
+   // group masks are placed at the end, only if port indices fit in the masks.
+   bool_t   need_group_masks = (module_ptr->gu.max_input_ports <= GEN_TOPO_TRIGGER_GROUP_MASK_MAX_PORTS) &&
+                             (module_ptr->gu.max_output_ports <= GEN_TOPO_TRIGGER_GROUP_MASK_MAX_PORTS);
+   uint32_t masks_offset     = ALIGN_8_BYTES(size);
+   if (need_group_masks)
+   {
+      size = masks_offset + num_groups * sizeof(gen_topo_trigger_group_mask_t);
+   }
+
    /* If non-trigger policy for input or output changes i.e:
       - present earlier but not raised now
       - not present earlier but raised now we need to free and recreate the memory
@@ -271,7 +331,8 @@ capi_err_t gen_topo_change_trigger_policy_cb_fn(gen_topo_trigger_t
        *                [conditional:max-out-ports for nontrigger policy on output],
        *                array of [fwk_extn_port_trigger_group_t],
        *                array of [fwk_extn_port_trigger_affinity_t for each input,
-       *                 fwk_extn_port_trigger_affinity_t for each out]
+       *                 fwk_extn_port_trigger_affinity_t for each out],
+       *                [conditional:array of gen_topo_trigger_group_mask_t]
        *                }
        */
       gen_topo_exit_island_temporarily(topo_ptr);
@@ -383,6 +444,13 @@ capi_err_t gen_topo_change_trigger_policy_cb_fn(gen_topo_trigger_t
          any_change                      = TRUE;
          (*tp_pptr)->port_trigger_policy = port_trigger_policy;
       }
+
+      (*tp_pptr)->group_masks_ptr = NULL;
+      if (need_group_masks && triggerable_groups_ptr && num_groups)
+      {
+         (*tp_pptr)->group_masks_ptr = (gen_topo_trigger_group_mask_t *)((int8_t *)(*tp_pptr) + masks_offset);
+         gen_topo_compile_trigger_group_masks(module_ptr, *tp_pptr);
+      }
    }
 
 #ifdef TRIGGER_DEBUG
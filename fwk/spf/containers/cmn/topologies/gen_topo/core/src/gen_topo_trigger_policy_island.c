@@ -278,6 +278,17 @@ static fwk_extn_port_trigger_affinity_t gen_topo_get_port_affinity_to_group_for_
    return FWK_EXTN_PORT_TRIGGER_AFFINITY_PRESENT;
 }
 
+static inline fwk_extn_port_trigger_affinity_t gen_topo_get_port_affinity_from_group_masks(uint32_t present_mask,
+                                                                                         uint32_t absent_mask,
+                                                                                         uint32_t port_bit)
+{
+   if (present_mask & port_bit)
+   {
+      return FWK_EXTN_PORT_TRIGGER_AFFINITY_PRESENT;
+   }
+   return (absent_mask & port_bit) ? FWK_EXTN_PORT_TRIGGER_AFFINITY_ABSENT : FWK_EXTN_PORT_TRIGGER_AFFINITY_NONE;
+}
+
 static fwk_extn_port_nontrigger_policy_t gen_topo_get_default_nontrigger_policy(gen_topo_module_t *module_ptr,
                                                                                 gen_topo_trigger_t curr_trigger)
 {
@@ -623,24 +634,57 @@ static bool_t gen_topo_is_data_trigger_satisfied_for_trigger_policy_module(gen_t
 
    uint32_t num_groups = gen_topo_get_num_trigger_groups(module_ptr, curr_trigger);
 
+   /**
+    * With group masks, ports are picked from the masks and the trigger presence of each port is evaluated only once
+    * per call, even if the port belongs to many groups. Bit i of the masks below is port index i.
+    * Without masks (too many ports), port bit is zero and ports are looked up and evaluated for each group.
+    */
+   gen_topo_trigger_policy_t *    tp_ptr    = module_ptr->tp_ptr[GEN_TOPO_INDEX_OF_TRIGGER(curr_trigger)];
+   gen_topo_trigger_group_mask_t *masks_ptr = tp_ptr ? tp_ptr->group_masks_ptr : NULL;
+   uint32_t in_evaluated_mask = 0, in_present_mask = 0, in_ext_not_satisfied_mask = 0;
+   uint32_t out_evaluated_mask = 0, out_present_mask = 0, out_ext_not_satisfied_mask = 0;
+
+   // masks don't include the default non-trigger policy, which applies to all ports if module didn't give one.
+   bool_t in_ports_triggerable  = TRUE;
+   bool_t out_ports_triggerable = TRUE;
+   if (masks_ptr)
+   {
+      bool_t default_triggerable =
+         !GEN_TOPO_IS_NON_TRIGGERABLE_PORT(gen_topo_get_default_nontrigger_policy(module_ptr, curr_trigger));
+      in_ports_triggerable  = (NULL != tp_ptr->nontrigger_policy.in_port_grp_policy_ptr) || default_triggerable;
+      out_ports_triggerable = (NULL != tp_ptr->nontrigger_policy.out_port_grp_policy_ptr) || default_triggerable;
+   }
+
    for (uint32_t g = 0; g < num_groups; g++)
    {
       bool_t in_ports_satisfied = FALSE, out_ports_satisfied = FALSE;
       bool_t is_in_port_dictating_policy  = FALSE;
       bool_t is_out_port_dictating_policy = FALSE;
 
-      for (gu_input_port_list_t *in_port_list_ptr = module_ptr->gu.input_port_list_ptr; (NULL != in_port_list_ptr);
+      for (gu_input_port_list_t *in_port_list_ptr = in_ports_triggerable ? module_ptr->gu.input_port_list_ptr : NULL;
+           (NULL != in_port_list_ptr);
            LIST_ADVANCE(in_port_list_ptr))
       {
-         gen_topo_input_port_t *in_port_ptr = (gen_topo_input_port_t *)in_port_list_ptr->ip_port_ptr;
+         gen_topo_input_port_t *          in_port_ptr = (gen_topo_input_port_t *)in_port_list_ptr->ip_port_ptr;
+         uint32_t                         port_bit    = 0;
+         fwk_extn_port_trigger_affinity_t a;
 
-         if (GEN_TOPO_IS_NON_TRIGGERABLE_PORT(gen_topo_get_nontrigger_policy_for_input(in_port_ptr, curr_trigger)))
+         if (masks_ptr)
          {
-            continue;
+            port_bit = (1u << in_port_ptr->gu.cmn.index);
+            a        = gen_topo_get_port_affinity_from_group_masks(masks_ptr[g].in_present_mask,
+                                                                   masks_ptr[g].in_absent_mask,
+                                                                   port_bit);
          }
+         else
+         {
+            if (GEN_TOPO_IS_NON_TRIGGERABLE_PORT(gen_topo_get_nontrigger_policy_for_input(in_port_ptr, curr_trigger)))
+            {
+               continue;
+            }
 
-         fwk_extn_port_trigger_affinity_t a =
-            gen_topo_get_port_affinity_to_group_for_input(in_port_ptr, g, curr_trigger);
+            a = gen_topo_get_port_affinity_to_group_for_input(in_port_ptr, g, curr_trigger);
+         }
 
          if (FWK_EXTN_PORT_TRIGGER_AFFINITY_NONE == a)
          {
@@ -667,10 +711,22 @@ static bool_t gen_topo_is_data_trigger_satisfied_for_trigger_policy_module(gen_t
          if (a == FWK_EXTN_PORT_TRIGGER_AFFINITY_PRESENT)
          {
             bool_t ext_trigger_not_satisfied = FALSE;
-            bool_t trigger_present =
-               topo_ptr->gen_topo_vtable_ptr->input_port_is_trigger_present(topo_ptr,
-                                                                            in_port_ptr,
-                                                                            &ext_trigger_not_satisfied);
+            bool_t trigger_present           = FALSE;
+            if (in_evaluated_mask & port_bit)
+            {
+               trigger_present           = (in_present_mask & port_bit) ? TRUE : FALSE;
+               ext_trigger_not_satisfied = (in_ext_not_satisfied_mask & port_bit) ? TRUE : FALSE;
+            }
+            else
+            {
+               trigger_present = topo_ptr->gen_topo_vtable_ptr->input_port_is_trigger_present(topo_ptr,
+                                                                                             in_port_ptr,
+                                                                                             &ext_trigger_not_satisfied);
+               in_evaluated_mask |= port_bit;
+               in_present_mask |= trigger_present ? port_bit : 0;
+               in_ext_not_satisfied_mask |= ext_trigger_not_satisfied ? port_bit : 0;
+            }
+
             if (!trigger_present)
             {
                port_satisfied = FALSE;
@@ -730,18 +786,32 @@ static bool_t gen_topo_is_data_trigger_satisfied_for_trigger_policy_module(gen_t
          }
       }
 
-      for (gu_output_port_list_t *out_port_list_ptr = module_ptr->gu.output_port_list_ptr; (NULL != out_port_list_ptr);
+      for (gu_output_port_list_t *out_port_list_ptr =
+              out_ports_triggerable ? module_ptr->gu.output_port_list_ptr : NULL;
+           (NULL != out_port_list_ptr);
            LIST_ADVANCE(out_port_list_ptr))
       {
-         gen_topo_output_port_t *out_port_ptr = (gen_topo_output_port_t *)out_port_list_ptr->op_port_ptr;
+         gen_topo_output_port_t *         out_port_ptr = (gen_topo_output_port_t *)out_port_list_ptr->op_port_ptr;
+         uint32_t                         port_bit     = 0;
+         fwk_extn_port_trigger_affinity_t a;
 
-         if (GEN_TOPO_IS_NON_TRIGGERABLE_PORT(gen_topo_get_nontrigger_policy_for_output(out_port_ptr, curr_trigger)))
+         if (masks_ptr)
          {
-            continue;
+            port_bit = (1u << out_port_ptr->gu.cmn.index);
+            a        = gen_topo_get_port_affinity_from_group_masks(masks_ptr[g].out_present_mask,
+                                                                   masks_ptr[g].out_absent_mask,
+                                                                   port_bit);
+         }
+         else
+         {
+            if (GEN_TOPO_IS_NON_TRIGGERABLE_PORT(
+                   gen_topo_get_nontrigger_policy_for_output(out_port_ptr, curr_trigger)))
+            {
+               continue;
+            }
+            // Assume PRESENT by default (if module doesn't specify)
+            a = gen_topo_get_port_affinity_to_group_for_output(out_port_ptr, g, curr_trigger);
          }
-         // Assume PRESENT by default (if module doesn't specify)
-         fwk_extn_port_trigger_affinity_t a =
-            gen_topo_get_port_affinity_to_group_for_output(out_port_ptr, g, curr_trigger);
 
          if (FWK_EXTN_PORT_TRIGGER_AFFINITY_NONE == a)
          {
@@ -756,10 +826,23 @@ static bool_t gen_topo_is_data_trigger_satisfied_for_trigger_policy_module(gen_t
          if (FWK_EXTN_PORT_TRIGGER_AFFINITY_PRESENT == a)
          {
             bool_t ext_trigger_not_satisfied = FALSE;
-            bool_t trigger_present =
-               topo_ptr->gen_topo_vtable_ptr->output_port_is_trigger_present(topo_ptr,
-                                                                             out_port_ptr,
-                                                                             &ext_trigger_not_satisfied);
+            bool_t trigger_present           = FALSE;
+            if (out_evaluated_mask & port_bit)
+            {
+               trigger_present           = (out_present_mask & port_bit) ? TRUE : FALSE;
+               ext_trigger_not_satisfied = (out_ext_not_satisfied_mask & port_bit) ? TRUE : FALSE;
+            }
+            else
+            {
+               trigger_present =
+                  topo_ptr->gen_topo_vtable_ptr->output_port_is_trigger_present(topo_ptr,
+                                                                                out_port_ptr,
+                                                                                &ext_trigger_not_satisfied);
+               out_evaluated_mask |= port_bit;
+               out_present_mask |= trigger_present ? port_bit : 0;
+               out_ext_not_satisfied_mask |= ext_trigger_not_satisfied ? port_bit : 0;
+            }
+
             if (!trigger_present)
             {
                port_satisfied = FALSE;
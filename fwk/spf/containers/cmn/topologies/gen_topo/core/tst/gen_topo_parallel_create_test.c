@@ -0,0 +1,506 @@
+/**
+ * \file gen_topo_parallel_create_test.c
+ *
+ * \brief
+ *
+ *     Parallel CAPI create test file
+ *
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "ar_defs.h"
+#include "posal.h"
+#include "spf_utils.h"
+#include "ar_msg.h"
+#include "ar_ids.h"
+#include "amdb_static.h"
+#include "amdb_cntr_if.h"
+#include "gen_topo_capi.h"
+#include "gen_topo_i.h"
+
+#ifdef ENABLE_PARALLEL_CREATE_TEST
+
+#ifdef __cplusplus
+extern "C" {
+#endif //__cplusplus
+
+#define PC_TEST_MODULE_ID   0x0700FFF1
+#define PC_TEST_NUM_MODULES 8
+
+/* Module instance which doesn't take the event callback at set properties, in test 1. */
+#define PC_TEST_REJECT_MIID 0x5003
+
+/* Cost of one CAPI init. */
+#define PC_TEST_INIT_COST_US 2000
+
+typedef struct pc_test_capi_t
+{
+   const capi_vtbl_t         *vtbl_ptr;
+   capi_event_callback_info_t cb_info;
+   uint32_t                   miid;
+} pc_test_capi_t;
+
+typedef struct pc_test_graph_t
+{
+   gen_topo_t        topo;
+   gu_sg_t           sg;
+   gen_topo_module_t module[PC_TEST_NUM_MODULES];
+} pc_test_graph_t;
+
+/* TRUE: init waits (e.g. on memory or a DSP service), FALSE: init keeps the CPU busy. */
+static bool_t   pc_test_is_blocking_init;
+static uint32_t pc_test_reject_miid;
+static uint32_t pc_test_num_events;
+static uint32_t pc_test_num_cb_inside;
+static bool_t   pc_test_is_cb_concurrent;
+
+/* =======================================================================
+Test CAPI
+========================================================================== */
+
+static capi_err_t pc_test_capi_process(capi_t *_pif, capi_stream_data_t *input[], capi_stream_data_t *output[])
+{
+   return CAPI_EOK;
+}
+
+static capi_err_t pc_test_capi_end(capi_t *_pif)
+{
+   return CAPI_EOK;
+}
+
+static capi_err_t pc_test_capi_set_param(capi_t *                _pif,
+                                         uint32_t                param_id,
+                                         const capi_port_info_t *port_info_ptr,
+                                         capi_buf_t *            params_ptr)
+{
+   return CAPI_EUNSUPPORTED;
+}
+
+static capi_err_t pc_test_capi_get_param(capi_t *                _pif,
+                                         uint32_t                param_id,
+                                         const capi_port_info_t *port_info_ptr,
+                                         capi_buf_t *            params_ptr)
+{
+   return CAPI_EUNSUPPORTED;
+}
+
+static capi_err_t pc_test_capi_set_properties(capi_t *_pif, capi_proplist_t *proplist_ptr)
+{
+   pc_test_capi_t *me_ptr = (pc_test_capi_t *)_pif;
+
+   for (uint32_t i = 0; i < proplist_ptr->props_num; i++)
+   {
+      capi_prop_t *prop_ptr = &proplist_ptr->prop_ptr[i];
+
+      if (CAPI_EVENT_CALLBACK_INFO == prop_ptr->id)
+      {
+         if (pc_test_reject_miid == me_ptr->miid)
+         {
+            return CAPI_EUNSUPPORTED;
+         }
+         me_ptr->cb_info = *((capi_event_callback_info_t *)prop_ptr->payload.data_ptr);
+      }
+      else if (CAPI_MODULE_INSTANCE_ID == prop_ptr->id)
+      {
+         me_ptr->miid = ((capi_module_instance_id_t *)prop_ptr->payload.data_ptr)->module_instance_id;
+      }
+   }
+
+   return CAPI_EOK;
+}
+
+static capi_err_t pc_test_capi_get_properties(capi_t *_pif, capi_proplist_t *proplist_ptr)
+{
+   return CAPI_EUNSUPPORTED;
+}
+
+static const capi_vtbl_t pc_test_capi_vtbl = { pc_test_capi_process,        pc_test_capi_end,
+                                               pc_test_capi_set_param,      pc_test_capi_get_param,
+                                               pc_test_capi_set_properties, pc_test_capi_get_properties };
+
+static capi_err_t pc_test_capi_get_static_properties(capi_proplist_t *init_set_properties,
+                                                     capi_proplist_t *static_properties)
+{
+   for (uint32_t i = 0; i < static_properties->props_num; i++)
+   {
+      capi_prop_t *prop_ptr = &static_properties->prop_ptr[i];
+
+      if (CAPI_INIT_MEMORY_REQUIREMENT == prop_ptr->id)
+      {
+         ((capi_init_memory_requirement_t *)prop_ptr->payload.data_ptr)->size_in_bytes = sizeof(pc_test_capi_t);
+         prop_ptr->payload.actual_data_len = sizeof(capi_init_memory_requirement_t);
+      }
+      else if (CAPI_STACK_SIZE == prop_ptr->id)
+      {
+         ((capi_stack_size_t *)prop_ptr->payload.data_ptr)->size_in_bytes = 1024;
+         prop_ptr->payload.actual_data_len                               = sizeof(capi_stack_size_t);
+      }
+   }
+
+   return CAPI_EOK;
+}
+
+/* Takes PC_TEST_INIT_COST_US and raises one event from init. */
+static capi_err_t pc_test_capi_init(capi_t *_pif, capi_proplist_t *init_set_properties)
+{
+   pc_test_capi_t *me_ptr = (pc_test_capi_t *)_pif;
+
+   memset(me_ptr, 0, sizeof(pc_test_capi_t));
+   me_ptr->vtbl_ptr = &pc_test_capi_vtbl;
+
+   // callback info is taken even by the rejecting instance, it only fails the set after init.
+   for (uint32_t i = 0; i < init_set_properties->props_num; i++)
+   {
+      capi_prop_t *prop_ptr = &init_set_properties->prop_ptr[i];
+
+      if (CAPI_EVENT_CALLBACK_INFO == prop_ptr->id)
+      {
+         me_ptr->cb_info = *((capi_event_callback_info_t *)prop_ptr->payload.data_ptr);
+      }
+      else if (CAPI_MODULE_INSTANCE_ID == prop_ptr->id)
+      {
+         me_ptr->miid = ((capi_module_instance_id_t *)prop_ptr->payload.data_ptr)->module_instance_id;
+      }
+   }
+
+   if (pc_test_is_blocking_init)
+   {
+      posal_timer_sleep(PC_TEST_INIT_COST_US);
+   }
+   else
+   {
+      uint64_t start_us = posal_timer_get_time();
+      while ((posal_timer_get_time() - start_us) < PC_TEST_INIT_COST_US)
+      {
+      }
+   }
+
+   capi_event_KPPS_t kpps       = { .KPPS = 100 };
+   capi_event_info_t event_info = { 0 };
+
+   event_info.payload.data_ptr        = (int8_t *)&kpps;
+   event_info.payload.actual_data_len = sizeof(kpps);
+   event_info.payload.max_data_len    = sizeof(kpps);
+
+   return me_ptr->cb_info.event_cb(me_ptr->cb_info.event_context, CAPI_EVENT_KPPS, &event_info);
+}
+
+/* =======================================================================
+Test container
+========================================================================== */
+
+/* Container callback, must never be entered by two threads at once. */
+static capi_err_t pc_test_cntr_capi_cb(void *context_ptr, capi_event_id_t id, capi_event_info_t *event_info_ptr)
+{
+   if (++pc_test_num_cb_inside > 1)
+   {
+      pc_test_is_cb_concurrent = TRUE;
+   }
+
+   pc_test_num_events++;
+   posal_timer_sleep(100);
+
+   pc_test_num_cb_inside--;
+   return CAPI_EOK;
+}
+
+static ar_result_t pc_test_get_required_fmwk_extensions(void *           topo_ptr,
+                                                        void *           module_ptr,
+                                                        void *           amdb_handle,
+                                                        capi_proplist_t *init_proplist_ptr)
+{
+   return AR_EOK;
+}
+
+static uint32_t pc_test_gpr_cb(gpr_packet_t *packet_ptr, void *cb_ctx_ptr)
+{
+   return AR_EOK;
+}
+
+static const gen_topo_vtable_t pc_test_topo_vtable = {
+   .capi_get_required_fmwk_extensions = pc_test_get_required_fmwk_extensions,
+};
+
+static void pc_test_init_graph(pc_test_graph_t *graph_ptr, void *amdb_handle)
+{
+   gen_topo_t *topo_ptr = &graph_ptr->topo;
+
+   memset(graph_ptr, 0, sizeof(pc_test_graph_t));
+
+   topo_ptr->heap_id             = POSAL_HEAP_DEFAULT;
+   topo_ptr->capi_cb             = pc_test_cntr_capi_cb;
+   topo_ptr->gen_topo_vtable_ptr = &pc_test_topo_vtable;
+
+   graph_ptr->sg.id        = 0x100;
+   graph_ptr->sg.gu_status = GU_STATUS_NEW;
+   spf_list_insert_tail((spf_list_node_t **)&topo_ptr->gu.sg_list_ptr, &graph_ptr->sg, POSAL_HEAP_DEFAULT, TRUE);
+   topo_ptr->gu.num_subgraphs = 1;
+
+   for (uint32_t i = 0; i < PC_TEST_NUM_MODULES; i++)
+   {
+      gen_topo_module_t *module_ptr = &graph_ptr->module[i];
+
+      module_ptr->topo_ptr              = topo_ptr;
+      module_ptr->gu.module_id          = PC_TEST_MODULE_ID;
+      module_ptr->gu.module_instance_id = 0x5000 + i;
+      module_ptr->gu.module_type        = AMDB_MODULE_TYPE_GENERIC;
+      module_ptr->gu.itype              = AMDB_INTERFACE_TYPE_CAPI;
+      module_ptr->gu.amdb_handle        = amdb_handle;
+      module_ptr->gu.module_heap_id     = POSAL_HEAP_DEFAULT;
+      module_ptr->gu.max_input_ports    = 1;
+      module_ptr->gu.max_output_ports   = 1;
+      module_ptr->gu.gu_status          = GU_STATUS_NEW;
+      module_ptr->gu.sg_ptr             = &graph_ptr->sg;
+
+      spf_list_insert_tail((spf_list_node_t **)&graph_ptr->sg.module_list_ptr, module_ptr, POSAL_HEAP_DEFAULT, TRUE);
+      graph_ptr->sg.num_modules++;
+   }
+
+   pc_test_num_events       = 0;
+   pc_test_num_cb_inside    = 0;
+   pc_test_is_cb_concurrent = FALSE;
+}
+
+static void pc_test_deinit_graph(pc_test_graph_t *graph_ptr, bool_t is_gpr_registered)
+{
+   for (uint32_t i = 0; i < PC_TEST_NUM_MODULES; i++)
+   {
+      gen_topo_module_t *module_ptr = &graph_ptr->module[i];
+
+      if (module_ptr->capi_ptr)
+      {
+         module_ptr->capi_ptr->vtbl_ptr->end(module_ptr->capi_ptr);
+         MFREE_NULLIFY(module_ptr->capi_ptr);
+      }
+
+      if (is_gpr_registered)
+      {
+         __gpr_cmd_deregister(module_ptr->gu.module_instance_id);
+      }
+   }
+
+   spf_thread_pool_release_instance(&graph_ptr->topo.create_tp_ptr, graph_ptr->topo.gu.log_id);
+   spf_list_delete_list((spf_list_node_t **)&graph_ptr->sg.module_list_ptr, TRUE);
+   spf_list_delete_list((spf_list_node_t **)&graph_ptr->topo.gu.sg_list_ptr, TRUE);
+}
+
+/* Serial create, as done by gen_topo_create_module when nothing was prepared. Returns the time taken. */
+static ar_result_t pc_test_create_serial(pc_test_graph_t *graph_ptr, uint64_t *time_us_ptr)
+{
+   ar_result_t           result     = AR_EOK;
+   gen_topo_graph_init_t graph_init = { .capi_cb = pc_test_cntr_capi_cb };
+   uint64_t              start_us   = posal_timer_get_time();
+
+   for (uint32_t i = 0; i < PC_TEST_NUM_MODULES; i++)
+   {
+      gen_topo_module_t *module_ptr = &graph_ptr->module[i];
+
+      module_ptr->serial_num = graph_ptr->topo.module_count++;
+      result |= gen_topo_capi_create_from_amdb(module_ptr,
+                                               &graph_ptr->topo,
+                                               (void *)module_ptr->gu.amdb_handle,
+                                               module_ptr->gu.module_heap_id,
+                                               &graph_init);
+   }
+
+   *time_us_ptr = posal_timer_get_time() - start_us;
+   return result;
+}
+
+/* Parallel create, followed by the serial create of what was deferred. Returns the time taken. */
+static ar_result_t pc_test_create_parallel(pc_test_graph_t *graph_ptr, uint64_t *time_us_ptr)
+{
+   ar_result_t                 result     = AR_EOK;
+   gen_topo_graph_init_t       graph_init = { .capi_cb = pc_test_cntr_capi_cb, .gpr_cb_fn = pc_test_gpr_cb };
+   uint64_t                    start_us   = posal_timer_get_time();
+   gen_topo_parallel_create_t *pc_ptr     = gen_topo_parallel_create_capis(&graph_ptr->topo, &graph_init);
+
+   if (NULL == pc_ptr)
+   {
+      return AR_EFAILED;
+   }
+
+   for (uint32_t i = 0; i < PC_TEST_NUM_MODULES; i++)
+   {
+      gen_topo_module_t *module_ptr  = &graph_ptr->module[i];
+      ar_result_t        capi_result = AR_EOK;
+
+      if (!gen_topo_parallel_create_is_prepared(pc_ptr, module_ptr, &capi_result))
+      {
+         result |= AR_EFAILED;
+      }
+      else if (AR_ENEEDMORE == capi_result)
+      {
+         result |= gen_topo_capi_create_from_amdb(module_ptr,
+                                                  &graph_ptr->topo,
+                                                  (void *)module_ptr->gu.amdb_handle,
+                                                  module_ptr->gu.module_heap_id,
+                                                  &graph_init);
+      }
+      else
+      {
+         result |= capi_result;
+      }
+   }
+
+   *time_us_ptr = posal_timer_get_time() - start_us;
+
+   gen_topo_parallel_create_release(pc_ptr);
+   return result;
+}
+
+/**
+ * Creates the modules in parallel. The events raised from init must be serialized, and afterwards every module must
+ * call the container callback directly. The module which doesn't take the callback must be created again serially.
+ */
+static ar_result_t test_1(void *amdb_handle)
+{
+   ar_result_t      result    = AR_EOK;
+   uint64_t         time_us   = 0;
+   pc_test_graph_t *graph_ptr = (pc_test_graph_t *)posal_memory_malloc(sizeof(pc_test_graph_t), POSAL_HEAP_DEFAULT);
+
+   if (NULL == graph_ptr)
+   {
+      return AR_ENOMEMORY;
+   }
+
+   pc_test_is_blocking_init = TRUE;
+   pc_test_reject_miid      = PC_TEST_REJECT_MIID;
+   pc_test_init_graph(graph_ptr, amdb_handle);
+
+   result |= pc_test_create_parallel(graph_ptr, &time_us);
+
+   if (NULL != graph_ptr->topo.create_cb_lock)
+   {
+      AR_MSG(DBG_ERROR_PRIO, "parallel_create_test 1: create lock is left set after the create");
+      result |= AR_EFAILED;
+   }
+
+   // reject instance raises its event twice, once from each create.
+   if (pc_test_is_cb_concurrent || ((PC_TEST_NUM_MODULES + 1) != pc_test_num_events))
+   {
+      AR_MSG(DBG_ERROR_PRIO,
+             "parallel_create_test 1: init events concurrent %u, num events %lu",
+             pc_test_is_cb_concurrent,
+             pc_test_num_events);
+      result |= AR_EFAILED;
+   }
+
+   for (uint32_t i = 0; i < PC_TEST_NUM_MODULES; i++)
+   {
+      pc_test_capi_t *capi_ptr = (pc_test_capi_t *)graph_ptr->module[i].capi_ptr;
+
+      if ((NULL == capi_ptr) || (pc_test_cntr_capi_cb != capi_ptr->cb_info.event_cb) ||
+          (&graph_ptr->module[i] != capi_ptr->cb_info.event_context))
+      {
+         AR_MSG(DBG_ERROR_PRIO,
+                "parallel_create_test 1: module 0x%lx is not created or doesn't call the container callback directly",
+                graph_ptr->module[i].gu.module_instance_id);
+         result |= AR_EFAILED;
+      }
+   }
+
+   pc_test_deinit_graph(graph_ptr, TRUE);
+   posal_memory_free(graph_ptr);
+
+   return result;
+}
+
+/**
+ * Measures the create time of PC_TEST_NUM_MODULES modules, serial vs. parallel, for an init which waits and for an
+ * init which keeps the CPU busy. The latter only gains with more than one CPU.
+ */
+static ar_result_t test_2(void *amdb_handle)
+{
+   ar_result_t      result    = AR_EOK;
+   pc_test_graph_t *graph_ptr = (pc_test_graph_t *)posal_memory_malloc(sizeof(pc_test_graph_t), POSAL_HEAP_DEFAULT);
+
+   if (NULL == graph_ptr)
+   {
+      return AR_ENOMEMORY;
+   }
+
+   pc_test_reject_miid = 0;
+
+   for (uint32_t is_blocking = 0; is_blocking < 2; is_blocking++)
+   {
+      uint64_t serial_us = 0, parallel_us = 0;
+
+      pc_test_is_blocking_init = is_blocking;
+
+      pc_test_init_graph(graph_ptr, amdb_handle);
+      result |= pc_test_create_serial(graph_ptr, &serial_us);
+      pc_test_deinit_graph(graph_ptr, FALSE);
+
+      pc_test_init_graph(graph_ptr, amdb_handle);
+      result |= pc_test_create_parallel(graph_ptr, &parallel_us);
+      pc_test_deinit_graph(graph_ptr, TRUE);
+
+      AR_MSG(DBG_HIGH_PRIO,
+             "parallel_create_test 2: %lu modules, %s init of %lu us: serial %lu us, parallel %lu us",
+             PC_TEST_NUM_MODULES,
+             is_blocking ? "waiting" : "busy",
+             PC_TEST_INIT_COST_US,
+             (uint32_t)serial_us,
+             (uint32_t)parallel_us);
+   }
+
+   posal_memory_free(graph_ptr);
+
+   return result;
+}
+
+ar_result_t gen_topo_parallel_create_test()
+{
+   ar_result_t               result = AR_EOK, local_result = AR_EOK;
+   spf_list_node_t *         handle_list_ptr = NULL;
+   amdb_module_handle_info_t handle_info;
+
+   result = amdb_register(AMDB_MODULE_TYPE_GENERIC,
+                          PC_TEST_MODULE_ID,
+                          (void *)pc_test_capi_get_static_properties,
+                          (void *)pc_test_capi_init,
+                          0,
+                          NULL,
+                          0,
+                          NULL,
+                          FALSE /* is_built_in */);
+   if (AR_FAILED(result))
+   {
+      return result;
+   }
+
+   memset(&handle_info, 0, sizeof(handle_info));
+   handle_info.module_id = PC_TEST_MODULE_ID;
+   spf_list_insert_tail(&handle_list_ptr, &handle_info, POSAL_HEAP_DEFAULT, TRUE);
+   amdb_request_module_handles(handle_list_ptr, NULL, NULL);
+
+   if (AR_SUCCEEDED(handle_info.result))
+   {
+      local_result = test_1(handle_info.handle_ptr);
+      AR_MSG(DBG_HIGH_PRIO, "parallel_create_test: test 1 result: %d", local_result);
+      result |= local_result;
+
+      local_result = test_2(handle_info.handle_ptr);
+      AR_MSG(DBG_HIGH_PRIO, "parallel_create_test: test 2 result: %d", local_result);
+      result |= local_result;
+   }
+   else
+   {
+      result |= handle_info.result;
+   }
+
+   amdb_release_module_handles(handle_list_ptr);
+   spf_list_delete_list(&handle_list_ptr, TRUE);
+   amdb_deregister(PC_TEST_MODULE_ID);
+
+   return result;
+}
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+#endif // ENABLE_PARALLEL_CREATE_TEST
@@ -0,0 +1,435 @@
+/**
+ * \file gen_topo_shared_buf_test.c
+ *
+ * \brief
+ *
+ *     Shared output buffer (copy-on-write) test file
+ *
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "ar_defs.h"
+#include "posal.h"
+#include "spf_utils.h"
+#include "ar_msg.h"
+#include "ar_ids.h"
+#include "gen_topo.h"
+#include "gen_topo_buf_mgr.h"
+
+#ifdef ENABLE_SHARED_BUF_TEST
+
+#ifdef __cplusplus
+extern "C" {
+#endif //__cplusplus
+
+#define SB_TEST_NUM_OUTPUTS 3
+#define SB_TEST_FRAME_LEN   480
+
+/* Splitter with SB_TEST_NUM_OUTPUTS outputs, each connected to a SISO next module. */
+typedef struct sb_test_graph_t
+{
+   gen_topo_t             topo;
+   topo_media_fmt_t       media_fmt;
+   gen_topo_module_t      splitter;
+   gen_topo_input_port_t  splitter_in;
+   gen_topo_output_port_t splitter_out[SB_TEST_NUM_OUTPUTS];
+   gen_topo_module_t      next[SB_TEST_NUM_OUTPUTS];
+   gen_topo_input_port_t  next_in[SB_TEST_NUM_OUTPUTS];
+   gen_topo_output_port_t next_out[SB_TEST_NUM_OUTPUTS];
+   topo_buf_t             bufs[2 + 3 * SB_TEST_NUM_OUTPUTS];
+   gu_input_port_list_t   in_list[1 + SB_TEST_NUM_OUTPUTS];
+   gu_output_port_list_t  out_list[SB_TEST_NUM_OUTPUTS];
+} sb_test_graph_t;
+
+static void sb_test_init_port(sb_test_graph_t *       graph_ptr,
+                              gen_topo_common_port_t *cmn_port_ptr,
+                              gu_cmn_port_t *         gu_cmn_ptr,
+                              gen_topo_module_t *     module_ptr,
+                              uint32_t                port_id,
+                              topo_buf_t *            buf_ptr)
+{
+   gu_cmn_ptr->module_ptr              = &module_ptr->gu;
+   gu_cmn_ptr->id                      = port_id;
+   cmn_port_ptr->media_fmt_ptr         = &graph_ptr->media_fmt;
+   cmn_port_ptr->max_buf_len           = SB_TEST_FRAME_LEN;
+   cmn_port_ptr->max_buf_len_per_buf   = SB_TEST_FRAME_LEN;
+   cmn_port_ptr->bufs_ptr              = buf_ptr;
+   cmn_port_ptr->sdata.bufs_num        = 1;
+   cmn_port_ptr->sdata.buf_ptr         = (capi_buf_t *)buf_ptr;
+   cmn_port_ptr->data_flow_state       = TOPO_DATA_FLOW_STATE_FLOWING;
+   cmn_port_ptr->flags.buf_origin      = GEN_TOPO_BUF_ORIGIN_INVALID;
+   cmn_port_ptr->flags.is_pcm_unpacked = FALSE;
+}
+
+static void sb_test_init_graph(sb_test_graph_t *graph_ptr, uint32_t inplace_mask)
+{
+   uint32_t b = 0;
+
+   memset(graph_ptr, 0, sizeof(*graph_ptr));
+
+   graph_ptr->topo.gu.log_id                = 0x5B;
+   graph_ptr->topo.buf_mgr.mode             = TOPO_BUF_LOW_POWER;
+   graph_ptr->media_fmt.data_format         = SPF_FIXED_POINT;
+   graph_ptr->media_fmt.pcm.num_channels    = 1;
+   graph_ptr->media_fmt.pcm.bits_per_sample = 16;
+   graph_ptr->media_fmt.pcm.bit_width       = 16;
+   graph_ptr->media_fmt.pcm.sample_rate     = 48000;
+   graph_ptr->media_fmt.pcm.interleaving    = TOPO_INTERLEAVED;
+   topo_buf_manager_init(&graph_ptr->topo);
+
+   gen_topo_module_t *s_ptr                = &graph_ptr->splitter;
+   s_ptr->gu.module_instance_id            = 0x6000;
+   s_ptr->gu.num_input_ports               = 1;
+   s_ptr->gu.num_output_ports              = SB_TEST_NUM_OUTPUTS;
+   s_ptr->flags.supports_shared_output_buf = TRUE;
+   s_ptr->gu.input_port_list_ptr           = &graph_ptr->in_list[0];
+   graph_ptr->in_list[0].ip_port_ptr       = &graph_ptr->splitter_in.gu;
+   sb_test_init_port(graph_ptr,
+                     &graph_ptr->splitter_in.common,
+                     &graph_ptr->splitter_in.gu.cmn,
+                     s_ptr,
+                     2,
+                     &graph_ptr->bufs[b++]);
+
+   for (uint32_t i = 0; i < SB_TEST_NUM_OUTPUTS; i++)
+   {
+      gen_topo_module_t *     d_ptr     = &graph_ptr->next[i];
+      gen_topo_output_port_t *s_out_ptr = &graph_ptr->splitter_out[i];
+      gen_topo_input_port_t * d_in_ptr  = &graph_ptr->next_in[i];
+      gen_topo_output_port_t *d_out_ptr = &graph_ptr->next_out[i];
+
+      sb_test_init_port(graph_ptr, &s_out_ptr->common, &s_out_ptr->gu.cmn, s_ptr, 2 * i + 1, &graph_ptr->bufs[b++]);
+
+      d_ptr->gu.module_instance_id         = 0x6010 + i;
+      d_ptr->gu.num_input_ports            = 1;
+      d_ptr->gu.num_output_ports           = 1;
+      d_ptr->flags.inplace                 = (inplace_mask >> i) & 1;
+      d_ptr->gu.input_port_list_ptr        = &graph_ptr->in_list[1 + i];
+      d_ptr->gu.output_port_list_ptr       = &graph_ptr->out_list[i];
+      graph_ptr->in_list[1 + i].ip_port_ptr = &d_in_ptr->gu;
+      graph_ptr->out_list[i].op_port_ptr    = &d_out_ptr->gu;
+      sb_test_init_port(graph_ptr, &d_in_ptr->common, &d_in_ptr->gu.cmn, d_ptr, 2, &graph_ptr->bufs[b++]);
+      sb_test_init_port(graph_ptr, &d_out_ptr->common, &d_out_ptr->gu.cmn, d_ptr, 1, &graph_ptr->bufs[b++]);
+
+      s_out_ptr->gu.conn_in_port_ptr = &d_in_ptr->gu;
+      d_in_ptr->gu.conn_out_port_ptr = &s_out_ptr->gu;
+   }
+}
+
+/* Drops the data left at the ports and returns their bufs. */
+static void sb_test_deinit_graph(sb_test_graph_t *graph_ptr)
+{
+   gen_topo_t *topo_ptr = &graph_ptr->topo;
+
+   for (uint32_t b = 0; b < POSAL_ARRAY_SIZE(graph_ptr->bufs); b++)
+   {
+      graph_ptr->bufs[b].actual_data_len = 0;
+   }
+
+   gen_topo_input_port_return_buf_mgr_buf(topo_ptr, &graph_ptr->splitter_in);
+   for (uint32_t i = 0; i < SB_TEST_NUM_OUTPUTS; i++)
+   {
+      gen_topo_output_port_return_buf_mgr_buf(topo_ptr, &graph_ptr->splitter_out[i]);
+      gen_topo_input_port_return_buf_mgr_buf(topo_ptr, &graph_ptr->next_in[i]);
+      gen_topo_output_port_return_buf_mgr_buf(topo_ptr, &graph_ptr->next_out[i]);
+   }
+   topo_buf_manager_deinit(topo_ptr);
+}
+
+static bool_t sb_test_is_pattern(int8_t *data_ptr, uint32_t len)
+{
+   for (uint32_t i = 0; i < len; i++)
+   {
+      if ((int8_t)i != data_ptr[i])
+      {
+         return FALSE;
+      }
+   }
+   return TRUE;
+}
+
+/**
+ * Splitter process: the input is filled with a pattern and published on all outputs, which the splitter then only
+ * has to mark as filled. Then each output is moved to the input of the next module. Returns the shared buf.
+ */
+static int8_t *sb_test_split_frame(sb_test_graph_t *graph_ptr)
+{
+   gen_topo_t *       topo_ptr = &graph_ptr->topo;
+   gen_topo_module_t *s_ptr    = &graph_ptr->splitter;
+
+   gen_topo_buf_mgr_wrapper_get_buf(topo_ptr, &graph_ptr->splitter_in.common);
+
+   int8_t *shared_buf_ptr = graph_ptr->splitter_in.common.bufs_ptr[0].data_ptr;
+   if (NULL == shared_buf_ptr)
+   {
+      return NULL;
+   }
+
+   for (uint32_t i = 0; i < SB_TEST_FRAME_LEN; i++)
+   {
+      shared_buf_ptr[i] = (int8_t)i;
+   }
+   graph_ptr->splitter_in.common.bufs_ptr[0].actual_data_len = SB_TEST_FRAME_LEN;
+
+   for (uint32_t i = 0; i < SB_TEST_NUM_OUTPUTS; i++)
+   {
+      gen_topo_output_port_t *s_out_ptr = &graph_ptr->splitter_out[i];
+
+      gen_topo_check_get_out_buf_from_buf_mgr(topo_ptr, s_ptr, s_out_ptr);
+      if (s_out_ptr->common.bufs_ptr[0].data_ptr == shared_buf_ptr)
+      {
+         s_out_ptr->common.bufs_ptr[0].actual_data_len = SB_TEST_FRAME_LEN;
+      }
+   }
+
+   // input consumed.
+   graph_ptr->splitter_in.common.bufs_ptr[0].actual_data_len = 0;
+   gen_topo_input_port_return_buf_mgr_buf(topo_ptr, &graph_ptr->splitter_in);
+
+   for (uint32_t i = 0; i < SB_TEST_NUM_OUTPUTS; i++)
+   {
+      gen_topo_input_port_t * d_in_ptr  = &graph_ptr->next_in[i];
+      gen_topo_output_port_t *s_out_ptr = &graph_ptr->splitter_out[i];
+
+      gen_topo_check_get_in_buf_from_buf_mgr(topo_ptr, d_in_ptr, s_out_ptr);
+      gen_topo_copy_data_from_prev_to_next(topo_ptr, &graph_ptr->next[i], d_in_ptr, s_out_ptr, FALSE);
+      gen_topo_output_port_return_buf_mgr_buf(topo_ptr, s_out_ptr);
+   }
+
+   return shared_buf_ptr;
+}
+
+/**
+ * One of the downstream modules is inplace and writes into the shared buf. It must get a private copy, while the
+ * other outputs keep reading the splitter input unchanged. All bufs must be returned after the frame.
+ */
+static ar_result_t test_1()
+{
+   ar_result_t      result    = AR_EOK;
+   sb_test_graph_t *graph_ptr = (sb_test_graph_t *)posal_memory_malloc(sizeof(sb_test_graph_t), POSAL_HEAP_DEFAULT);
+
+   if (NULL == graph_ptr)
+   {
+      return AR_ENOMEMORY;
+   }
+
+   sb_test_init_graph(graph_ptr, 1 << 1);
+
+   gen_topo_t *topo_ptr       = &graph_ptr->topo;
+   int8_t *    shared_buf_ptr = sb_test_split_frame(graph_ptr);
+
+   for (uint32_t i = 0; i < SB_TEST_NUM_OUTPUTS; i++)
+   {
+      if ((graph_ptr->next_in[i].common.bufs_ptr[0].data_ptr != shared_buf_ptr) ||
+          !graph_ptr->next_in[i].common.flags.is_shared_buf)
+      {
+         AR_MSG(DBG_ERROR_PRIO, "shared_buf_test 1: input of next module %lu doesn't share the splitter buf", i);
+         result |= AR_EFAILED;
+      }
+   }
+
+   // inplace process of next module 1: writes into its input.
+   gen_topo_input_port_t *w_in_ptr = &graph_ptr->next_in[1];
+   result |= gen_topo_check_get_out_buf_from_buf_mgr(topo_ptr, &graph_ptr->next[1], &graph_ptr->next_out[1]);
+
+   int8_t *w_buf_ptr = graph_ptr->next_out[1].common.bufs_ptr[0].data_ptr;
+   if ((NULL == w_buf_ptr) || (w_buf_ptr == shared_buf_ptr) || (w_buf_ptr != w_in_ptr->common.bufs_ptr[0].data_ptr) ||
+       w_in_ptr->common.flags.is_shared_buf || !sb_test_is_pattern(w_buf_ptr, SB_TEST_FRAME_LEN))
+   {
+      AR_MSG(DBG_ERROR_PRIO, "shared_buf_test 1: inplace module didn't get a private copy of the data");
+      result |= AR_EFAILED;
+   }
+   else
+   {
+      memset(w_buf_ptr, 0, SB_TEST_FRAME_LEN);
+      graph_ptr->next_out[1].common.bufs_ptr[0].actual_data_len = SB_TEST_FRAME_LEN;
+      w_in_ptr->common.bufs_ptr[0].actual_data_len              = 0;
+   }
+
+   for (uint32_t i = 0; i < SB_TEST_NUM_OUTPUTS; i += 2)
+   {
+      if ((graph_ptr->next_in[i].common.bufs_ptr[0].data_ptr != shared_buf_ptr) ||
+          (SB_TEST_FRAME_LEN != graph_ptr->next_in[i].common.bufs_ptr[0].actual_data_len) ||
+          !sb_test_is_pattern(shared_buf_ptr, SB_TEST_FRAME_LEN))
+      {
+         AR_MSG(DBG_ERROR_PRIO, "shared_buf_test 1: data of next module %lu changed by the inplace write", i);
+         result |= AR_EFAILED;
+      }
+   }
+
+   if (2 != gen_topo_buf_mgr_wrapper_get_ref_count(&graph_ptr->next_in[0].common))
+   {
+      AR_MSG(DBG_ERROR_PRIO,
+             "shared_buf_test 1: shared buf ref count %lu, expected 2",
+             gen_topo_buf_mgr_wrapper_get_ref_count(&graph_ptr->next_in[0].common));
+      result |= AR_EFAILED;
+   }
+
+   // next modules consume their input and output is sent downstream.
+   for (uint32_t i = 0; i < SB_TEST_NUM_OUTPUTS; i++)
+   {
+      gen_topo_set_all_bufs_len_to_zero(&graph_ptr->next_in[i].common);
+      gen_topo_set_all_bufs_len_to_zero(&graph_ptr->next_out[i].common);
+      gen_topo_input_port_return_buf_mgr_buf(topo_ptr, &graph_ptr->next_in[i]);
+      gen_topo_output_port_return_buf_mgr_buf(topo_ptr, &graph_ptr->next_out[i]);
+   }
+
+   if (0 != topo_ptr->buf_mgr.num_used_buffers)
+   {
+      AR_MSG(DBG_ERROR_PRIO,
+             "shared_buf_test 1: %lu bufs not returned after the frame",
+             topo_ptr->buf_mgr.num_used_buffers);
+      result |= AR_EFAILED;
+   }
+
+   sb_test_deinit_graph(graph_ptr);
+   posal_memory_free(graph_ptr);
+
+   return result;
+}
+
+/**
+ * Next module 2 holds partial data, so the splitter output is only partly appended to it and the rest has to be moved
+ * to the beginning of the splitter output buf. That output must get a private copy before the move.
+ */
+static ar_result_t test_2()
+{
+   ar_result_t      result    = AR_EOK;
+   uint32_t         held_len  = SB_TEST_FRAME_LEN / 4;
+   sb_test_graph_t *graph_ptr = (sb_test_graph_t *)posal_memory_malloc(sizeof(sb_test_graph_t), POSAL_HEAP_DEFAULT);
+
+   if (NULL == graph_ptr)
+   {
+      return AR_ENOMEMORY;
+   }
+
+   sb_test_init_graph(graph_ptr, 0);
+
+   gen_topo_t *            topo_ptr       = &graph_ptr->topo;
+   gen_topo_output_port_t *s_out_ptr      = &graph_ptr->splitter_out[2];
+   int8_t *                shared_buf_ptr = NULL;
+
+   // only next module 2 holds data: split the frame, then give next 2 its partial data before the copy.
+   gen_topo_buf_mgr_wrapper_get_buf(topo_ptr, &graph_ptr->next_in[2].common);
+   memset(graph_ptr->next_in[2].common.bufs_ptr[0].data_ptr, 0x7F, held_len);
+   graph_ptr->next_in[2].common.bufs_ptr[0].actual_data_len = held_len;
+   shared_buf_ptr                                           = sb_test_split_frame(graph_ptr);
+
+   // next 0 and 1 took the shared buf as is, next 2 got a copy of what fits and the rest stays at the output.
+   if ((graph_ptr->next_in[0].common.bufs_ptr[0].data_ptr != shared_buf_ptr) ||
+       (graph_ptr->next_in[1].common.bufs_ptr[0].data_ptr != shared_buf_ptr) ||
+       !sb_test_is_pattern(shared_buf_ptr, SB_TEST_FRAME_LEN))
+   {
+      AR_MSG(DBG_ERROR_PRIO, "shared_buf_test 2: data of next modules 0, 1 changed by the move of leftover data");
+      result |= AR_EFAILED;
+   }
+
+   if ((s_out_ptr->common.bufs_ptr[0].data_ptr == shared_buf_ptr) || s_out_ptr->common.flags.is_shared_buf ||
+       (held_len != s_out_ptr->common.bufs_ptr[0].actual_data_len) ||
+       ((int8_t)(SB_TEST_FRAME_LEN - held_len) != s_out_ptr->common.bufs_ptr[0].data_ptr[0]))
+   {
+      AR_MSG(DBG_ERROR_PRIO,
+             "shared_buf_test 2: splitter output 2 leftover %lu not moved in a private buf",
+             s_out_ptr->common.bufs_ptr[0].actual_data_len);
+      result |= AR_EFAILED;
+   }
+
+   sb_test_deinit_graph(graph_ptr);
+   posal_memory_free(graph_ptr);
+
+   return result;
+}
+
+/**
+ * Bytes copied per frame for the splitter outputs, without sharing (each output is filled by the splitter) and with
+ * sharing (only the outputs written downstream are copied), for 0 to SB_TEST_NUM_OUTPUTS inplace downstream modules.
+ */
+static ar_result_t test_3()
+{
+   ar_result_t      result    = AR_EOK;
+   sb_test_graph_t *graph_ptr = (sb_test_graph_t *)posal_memory_malloc(sizeof(sb_test_graph_t), POSAL_HEAP_DEFAULT);
+
+   if (NULL == graph_ptr)
+   {
+      return AR_ENOMEMORY;
+   }
+
+   for (uint32_t num_writers = 0; num_writers <= SB_TEST_NUM_OUTPUTS; num_writers++)
+   {
+      uint32_t not_shared_bytes = 0, shared_bytes = 0;
+
+      sb_test_init_graph(graph_ptr, (1 << num_writers) - 1);
+
+      int8_t *shared_buf_ptr = sb_test_split_frame(graph_ptr);
+
+      for (uint32_t i = 0; i < SB_TEST_NUM_OUTPUTS; i++)
+      {
+         not_shared_bytes += SB_TEST_FRAME_LEN;
+
+         result |=
+            gen_topo_check_get_out_buf_from_buf_mgr(&graph_ptr->topo, &graph_ptr->next[i], &graph_ptr->next_out[i]);
+
+         // an inplace module working on its own copy has cost one copy of the frame.
+         if (graph_ptr->next[i].flags.inplace &&
+             (graph_ptr->next_in[i].common.bufs_ptr[0].data_ptr != shared_buf_ptr))
+         {
+            shared_bytes += graph_ptr->next_in[i].common.bufs_ptr[0].max_data_len;
+         }
+      }
+
+      // the last writer owns the splitter buf, no copy is needed for it.
+      uint32_t expected_bytes = (num_writers == SB_TEST_NUM_OUTPUTS) ? (num_writers - 1) * SB_TEST_FRAME_LEN
+                                                                       : num_writers * SB_TEST_FRAME_LEN;
+      if (expected_bytes != shared_bytes)
+      {
+         AR_MSG(DBG_ERROR_PRIO,
+                "shared_buf_test 3: %lu inplace downstream copied %lu bytes, expected %lu",
+                num_writers,
+                shared_bytes,
+                expected_bytes);
+         result |= AR_EFAILED;
+      }
+
+      AR_MSG(DBG_HIGH_PRIO,
+             "shared_buf_test 3: %lu outputs of %lu bytes, %lu inplace downstream: bytes copied not shared %lu, "
+             "shared %lu",
+             SB_TEST_NUM_OUTPUTS,
+             SB_TEST_FRAME_LEN,
+             num_writers,
+             not_shared_bytes,
+             shared_bytes);
+
+      sb_test_deinit_graph(graph_ptr);
+   }
+
+   posal_memory_free(graph_ptr);
+
+   return result;
+}
+
+ar_result_t gen_topo_shared_buf_test()
+{
+   ar_result_t result = AR_EOK, local_result = AR_EOK;
+
+   local_result = test_1();
+   AR_MSG(DBG_HIGH_PRIO, "shared_buf_test: test 1 result: %d", local_result);
+   result |= local_result;
+
+   local_result = test_2();
+   AR_MSG(DBG_HIGH_PRIO, "shared_buf_test: test 2 result: %d", local_result);
+   result |= local_result;
+
+   local_result = test_3();
+   AR_MSG(DBG_HIGH_PRIO, "shared_buf_test: test 3 result: %d", local_result);
+   result |= local_result;
+
+   return result;
+}
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+#endif // ENABLE_SHARED_BUF_TEST
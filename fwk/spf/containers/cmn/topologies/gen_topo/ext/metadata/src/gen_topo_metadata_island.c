@@ -13,6 +13,7 @@
 
 #include "gen_topo.h"
 #include "gen_topo_capi.h"
+#include "gen_topo_buf_mgr.h"
 #include "spf_ref_counter.h"
 
 #define PRINT_MD_PROP_DBG_ISLAND(str1, str2, len_per_ch, str3, ...)                                                    \
@@ -2183,6 +2184,18 @@ ar_result_t gen_topo_push_zeros_at_eos_util_(gen_topo_t *           topo_ptr,
    topo_buf_t *bufs_ptr                     = in_port_ptr->common.bufs_ptr;
    uint32_t    ch                           = in_port_ptr->common.media_fmt_ptr->pcm.num_channels;
    uint32_t    amount_zero_push_per_ch      = module_ptr->pending_zeros_at_eos; // bytes
+
+   // zeros are written into the input buf, a buf shared by a fan-out must be unshared first.
+   // if unsharing fails no zeros are pushed now, pending_zeros_at_eos is left for the next call.
+   result = gen_topo_check_unshare_port_buf(topo_ptr,
+                                            &in_port_ptr->common,
+                                            module_ptr->gu.module_instance_id,
+                                            in_port_ptr->gu.cmn.id);
+   if (AR_DID_FAIL(result))
+   {
+      return result;
+   }
+
    switch (in_port_ptr->common.media_fmt_ptr->pcm.interleaving)
    {
       case TOPO_DEINTERLEAVED_PACKED:
@@ -320,6 +320,9 @@ typedef struct spl_topo_t
    gu_module_list_t  *req_samp_query_start_list_ptr; /* list of module where required-sample queries should start from to calculate
                                                         the required number of input samples at external input port.
                                                         this could be threshold module/trigger policy module/boundary module*/
+   gu_module_list_t  *req_samp_query_start_node_ptr; /* node of started_sorted_module_list_ptr where the data path
+                                                        required-sample query starts. NULL if it has to be searched again,
+                                                        reset whenever either of the lists changes.*/
 
    bool_t                        during_max_traversal; /*set to true if we are in the midst of path traversal to get max samples*/
    spl_topo_fwk_extn_info_t      fwk_extn_info;
@@ -12,6 +12,19 @@
 
 #include "spl_topo_i.h"
 #include "gen_topo_ctrl_port.h"
+/* =======================================================================
+Static Function Definitions
+========================================================================== */
+static ar_result_t spl_topo_check_update_started_sorted_module_list(void *vtopo_ptr, bool_t b_force_update)
+{
+   spl_topo_t *topo_ptr = (spl_topo_t *)vtopo_ptr;
+
+   // cached node belongs to the list which may be rebuilt now.
+   topo_ptr->req_samp_query_start_node_ptr = NULL;
+
+   return gen_topo_check_update_started_sorted_module_list(vtopo_ptr, b_force_update);
+}
+
 /* =======================================================================
 Public Function Definitions
 ========================================================================== */
@@ -49,7 +62,7 @@ static topo_cu_vtable_t spl_topo_cu_vtable =
    .get_prof_info                       = gen_topo_get_prof_info,
 
    .rtm_dump_data_port_media_fmt        = gen_topo_rtm_dump_data_port_mf_for_all_ports,
-   .check_update_started_sorted_module_list   = gen_topo_check_update_started_sorted_module_list,
+   .check_update_started_sorted_module_list   = spl_topo_check_update_started_sorted_module_list,
    .set_global_sh_mem_msg                     = gen_topo_set_global_sh_mem_msg,
 };
 
@@ -197,6 +210,7 @@ ar_result_t spl_topo_destroy_topo(spl_topo_t *topo_ptr)
 #endif
 
    spf_list_delete_list((spf_list_node_t **)&topo_ptr->req_samp_query_start_list_ptr, TRUE);
+   topo_ptr->req_samp_query_start_node_ptr = NULL;
    spf_list_delete_list((spf_list_node_t **)&topo_ptr->simpt_sorted_module_list_ptr, TRUE);
 
    spl_topo_fwk_ext_free_dm_req_samples(topo_ptr);
@@ -2614,9 +2614,13 @@ ar_result_t spl_topo_get_required_input_samples(spl_topo_t *topo_ptr, bool_t is_
    else
    {
       // for data-path-query, use started_sorted_module_list
-      list_end_ptr = topo_ptr->t_base.started_sorted_module_list_ptr;
+      // the start node only changes with the query start list or the started sorted list, reuse it if cached.
+      list_end_ptr = (topo_ptr->req_samp_query_start_node_ptr) ? topo_ptr->req_samp_query_start_node_ptr
+                                                                : topo_ptr->t_base.started_sorted_module_list_ptr;
    }
 
+   bool_t find_start_node = is_max || (NULL == topo_ptr->req_samp_query_start_node_ptr);
+
    //find the last module in sorted module list where sample-query should start from.
    for (gu_module_list_t *module_list_ptr = topo_ptr->req_samp_query_start_list_ptr; (NULL != module_list_ptr);
         LIST_ADVANCE(module_list_ptr))
@@ -2624,6 +2628,11 @@ ar_result_t spl_topo_get_required_input_samples(spl_topo_t *topo_ptr, bool_t is_
       spl_topo_module_t *module_ptr = (spl_topo_module_t *)module_list_ptr->module_ptr;
       spl_topo_set_start_samples(topo_ptr, module_ptr, is_max);
 
+      if (!find_start_node)
+      {
+         continue;
+      }
+
       // If this module is after the previous module in the sorted list then start query from this module.
       gu_module_list_t *tmp_list_end_ptr = NULL;
       if (AR_EOK == spf_list_find_list_node((spf_list_node_t *)list_end_ptr,
@@ -2634,6 +2643,11 @@ ar_result_t spl_topo_get_required_input_samples(spl_topo_t *topo_ptr, bool_t is_
       }
    }
 
+   if (!is_max)
+   {
+      topo_ptr->req_samp_query_start_node_ptr = list_end_ptr;
+   }
+
 #if (SPL_TOPO_DEBUG_LEVEL >= SPL_TOPO_DEBUG_LEVEL_4) || defined(TOPO_DM_DEBUG)
       TOPO_MSG(topo_ptr->t_base.gu.log_id,
                DBG_HIGH_PRIO,
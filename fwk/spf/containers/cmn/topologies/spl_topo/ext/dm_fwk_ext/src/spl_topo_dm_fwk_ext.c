@@ -787,6 +787,7 @@ ar_result_t spl_topo_fwk_ext_update_dm_modes(spl_topo_t *topo_ptr)
 
    // delete the list of modules where required sample query starts.
    spf_list_delete_list((spf_list_node_t **)&topo_ptr->req_samp_query_start_list_ptr, TRUE);
+   topo_ptr->req_samp_query_start_node_ptr = NULL;
 
    // delete the list of modules where required sample query starts.
    // there can be multiple modules in ths list if there are parallel paths each with a fixed output DM module.
@@ -299,6 +299,8 @@ ar_result_t gen_cntr_destroy(cu_base_t *base_ptr, void *temp)
 
    log_id = me_ptr->topo.gu.log_id;
 
+   gen_cntr_pure_st_report_stats(me_ptr);
+
    /** De-register with  GPR    */
    if (AR_EOK != (result = __gpr_cmd_deregister(me_ptr->cu.gu_ptr->container_instance_id)))
    {
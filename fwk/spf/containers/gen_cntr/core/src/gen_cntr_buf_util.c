@@ -2778,6 +2778,17 @@ ar_result_t gen_cntr_deinit_ext_in_port(void *base_ptr, gu_ext_in_port_t *gu_ext
       tu_capi_destroy_raw_compr_med_fmt(&ext_in_port_ptr->cu.media_fmt.raw);
    }
 
+   if (ext_in_port_ptr->copied_bytes || ext_in_port_ptr->lent_bytes)
+   {
+      GEN_CNTR_MSG(me_ptr->topo.gu.log_id,
+                   DBG_HIGH_PRIO,
+                   "Ext in port (0x%lX, 0x%lx): copied %lu KB, used %lu KB without copy",
+                   ext_in_port_ptr->gu.int_in_port_ptr->cmn.module_ptr->module_instance_id,
+                   ext_in_port_ptr->gu.int_in_port_ptr->cmn.id,
+                   (uint32_t)(ext_in_port_ptr->copied_bytes >> 10),
+                   (uint32_t)(ext_in_port_ptr->lent_bytes >> 10));
+   }
+
    if (ext_in_port_ptr->gu.this_handle.q_ptr)
    {
       gen_cntr_flush_input_data_queue(me_ptr, ext_in_port_ptr, FALSE /* keep data msg */);
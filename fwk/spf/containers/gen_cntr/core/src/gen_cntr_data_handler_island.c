@@ -807,6 +807,18 @@ static ar_result_t gen_cntr_data_process_one_frame(gen_cntr_t *me_ptr)
    {
    }
 
+   // peer container buffers used directly by the topo go back upstream once consumed.
+   for (gu_ext_in_port_list_t *ext_in_port_list_ptr = me_ptr->topo.gu.ext_in_port_list_ptr;
+        (NULL != ext_in_port_list_ptr);
+        LIST_ADVANCE(ext_in_port_list_ptr))
+   {
+      gen_cntr_ext_in_port_t *temp_ext_in_port_ptr = (gen_cntr_ext_in_port_t *)ext_in_port_list_ptr->ext_in_port_ptr;
+      if (temp_ext_in_port_ptr->flags.is_buf_lent)
+      {
+         gen_cntr_peer_cntr_release_lent_in_buf(me_ptr, temp_ext_in_port_ptr);
+      }
+   }
+
    return result;
 }
 
@@ -1294,7 +1306,7 @@ ar_result_t gen_cntr_setup_internal_input_port_and_preprocess(gen_cntr_t *
          // Even if client data is not present, process has to be called to flush any remaining input data (esp. @ EoS)
          // Special note: gpr client EOS is popped and read directly in read_data.
          //    So even if there was no EOS at ext-in-port before calling this function, we might end up with one now.
-         result = ext_in_port_ptr->vtbl_ptr->read_data(me_ptr, ext_in_port_ptr, &bytes_copied_per_buf);
+         result = ext_in_port_ptr->vtbl_ptr->read_data(me_ptr, ext_in_port_ptr, &bytes_copied_per_buf, process_info_ptr);
 
          gen_topo_handle_eof_history(in_port_ptr, (bytes_copied_per_buf > 0));
 
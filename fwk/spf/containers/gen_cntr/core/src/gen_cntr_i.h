@@ -163,6 +163,10 @@ typedef struct gen_cntr_ext_in_port_flags_t
 
    uint32_t is_not_reset : 1;                 /**< TRUE indicates port is not in reset state, FALSE indicates port is in reset state*/
 
+   uint32_t is_buf_lent : 1;                  /**< TRUE when the internal input port uses the peer container buffer directly
+                                                   instead of a copy. The buffer is held till the topo consumed it,
+                                                   see gen_cntr_peer_cntr_release_lent_in_buf */
+
 } gen_cntr_ext_in_port_flags_t;
 
 /**
@@ -201,7 +205,13 @@ typedef struct gen_cntr_fwk_module_vtable_t
 typedef struct gen_cntr_ext_in_vtable_t
 {
    ar_result_t (*on_trigger)(gen_cntr_t *me_ptr, gen_cntr_ext_in_port_t *ext_in_port_ptr);
-   ar_result_t (*read_data)(gen_cntr_t *me_ptr, gen_cntr_ext_in_port_t *ext_in_port_ptr, uint32_t *bytes_copied_per_buf_ptr);
+   /**
+    * process_info_ptr is NULL outside the process context (e.g. on data arrival)
+    */
+   ar_result_t (*read_data)(gen_cntr_t *             me_ptr,
+                            gen_cntr_ext_in_port_t * ext_in_port_ptr,
+                            uint32_t *               bytes_copied_per_buf_ptr,
+                            gen_topo_process_info_t *process_info_ptr);
    /**
     * whether the pending buffer is a data buffer
     */
@@ -265,6 +275,10 @@ typedef struct gen_cntr_ext_in_port_t
 
    const gen_cntr_ext_in_vtable_t  *vtbl_ptr;
 
+   uint64_t                        copied_bytes;                 /**< bytes copied from peer container buffers to the topo */
+
+   uint64_t                        lent_bytes;                   /**< bytes handed to the topo without copy */
+
 } gen_cntr_ext_in_port_t;
 
 /**
@@ -397,8 +411,19 @@ typedef struct gen_cntr_flags_t
                                                Not applicable for Signal triggered containers.
                                                MF is handled immediately by dropping left prev data. */
    uint32_t is_thread_prio_bumped_up : 1; /**< temp flag which avoids bumping up priority if already done. */
+   uint32_t is_pure_st_suspended : 1;     /**< Pure ST is temporarily not usable (frame len, signal TP, STM inactive).
+                                               Unlike topo.flags.cannot_be_pure_signal_triggered, this is re-evaluated
+                                               on graph open/start and trigger policy/frame len changes. */
 } gen_cntr_flags_t;
 
+/** Per frame processing time of the pure signal triggered path. */
+typedef struct gen_cntr_pure_st_stats_t
+{
+   uint32_t num_frames;  /**< Frames processed on pure ST path since the last report */
+   uint64_t total_ticks; /**< Total processing time of these frames in HW ticks */
+   uint64_t max_ticks;   /**< Max processing time of a frame in HW ticks */
+} gen_cntr_pure_st_stats_t;
+
 /** instance struct of GEN_CNTR */
 typedef struct gen_cntr_t
 {
@@ -411,6 +436,7 @@ typedef struct gen_cntr_t
    uint32_t         *wait_mask_arr;             /**< wait mask for each parallel path. (me_ptr->cu.gu_ptr->num_parallel_paths)
                                                      this is bitmask where each bit corresponds to an external port.*/
    spf_list_node_t  *async_signal_list_ptr;     /**< list of async signals created for the container, node type is gen_cntr_async_signal_t */
+   gen_cntr_pure_st_stats_t pure_st_stats;      /**< Processing time on pure signal triggered path, reported when leaving it */
 } gen_cntr_t;
 
 typedef struct gen_cntr_render_eos_cb_context_t
@@ -659,7 +685,7 @@ static inline bool_t gen_cntr_ext_in_port_has_data_buffer(gu_ext_in_port_t *gu_e
 
 static inline bool_t gen_cntr_is_pure_signal_triggered(gen_cntr_t *me_ptr)
 {
-   return !me_ptr->topo.flags.cannot_be_pure_signal_triggered;
+   return !me_ptr->topo.flags.cannot_be_pure_signal_triggered && !me_ptr->flags.is_pure_st_suspended;
 }
 
 static inline ar_result_t gen_cntr_check_and_vote_for_island_in_data_path(gen_cntr_t *me_ptr)
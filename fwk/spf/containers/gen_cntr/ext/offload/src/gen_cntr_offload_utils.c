@@ -21,9 +21,10 @@ static ar_result_t gen_cntr_recreate_out_buf_olc_client(gen_cntr_t *
                                                         uint32_t                 num_data_msg,
                                                         uint32_t                 num_bufs_per_data_msg_v2);
 
-static ar_result_t gen_cntr_copy_olc_client_input_to_int_buf(gen_cntr_t *            me_ptr,
-                                                             gen_cntr_ext_in_port_t *ext_in_port_ptr,
-                                                             uint32_t *              bytes_copied_per_buf_ptr);
+static ar_result_t gen_cntr_copy_olc_client_input_to_int_buf(gen_cntr_t *             me_ptr,
+                                                             gen_cntr_ext_in_port_t * ext_in_port_ptr,
+                                                             uint32_t *               bytes_copied_per_buf_ptr,
+                                                             gen_topo_process_info_t *process_info_ptr);
 
 static ar_result_t gen_cntr_send_cmd_path_media_fmt_to_olc_client(gen_cntr_t *             me_ptr,
                                                                   gen_cntr_ext_out_port_t *ext_out_port_ptr);
@@ -1113,9 +1114,10 @@ ar_result_t gen_cntr_offload_pack_write_data(gen_cntr_t *me_ptr, gen_cntr_ext_ou
    return result;
 }
 
-static ar_result_t gen_cntr_copy_olc_client_input_to_int_buf(gen_cntr_t *            me_ptr,
-                                                             gen_cntr_ext_in_port_t *ext_in_port_ptr,
-                                                             uint32_t *              bytes_copied_per_buf_ptr)
+static ar_result_t gen_cntr_copy_olc_client_input_to_int_buf(gen_cntr_t *             me_ptr,
+                                                             gen_cntr_ext_in_port_t * ext_in_port_ptr,
+                                                             uint32_t *               bytes_copied_per_buf_ptr,
+                                                             gen_topo_process_info_t *process_info_ptr)
 {
    ar_result_t result = AR_EOK;
 
@@ -55,6 +55,7 @@ ar_result_t gen_cntr_copy_peer_or_olc_client_input(gen_cntr_t *            me_pt
                                                    gen_cntr_ext_in_port_t *ext_in_port_ptr,
                                                    uint32_t *              bytes_copied_ptr);
 ar_result_t gen_cntr_init_peer_cntr_ext_in_port(gen_cntr_t *me_ptr, gen_cntr_ext_in_port_t *ext_port_ptr);
+ar_result_t gen_cntr_peer_cntr_release_lent_in_buf(gen_cntr_t *me_ptr, gen_cntr_ext_in_port_t *ext_in_port_ptr);
 
 #ifdef __cplusplus
 }
@@ -28,9 +28,10 @@ static ar_result_t gen_cntr_free_input_data_cmd_peer_cntr(gen_cntr_t
                                                           gen_cntr_ext_in_port_t *ext_in_port_ptr,
                                                           ar_result_t             status,
                                                           bool_t                  is_flush);
-static ar_result_t gen_cntr_copy_peer_cntr_input_to_int_buf(gen_cntr_t             *me_ptr,
-                                                            gen_cntr_ext_in_port_t *ext_in_port_ptr,
-                                                            uint32_t               *bytes_copied_ptr);
+static ar_result_t gen_cntr_copy_peer_cntr_input_to_int_buf(gen_cntr_t              *me_ptr,
+                                                            gen_cntr_ext_in_port_t  *ext_in_port_ptr,
+                                                            uint32_t                *bytes_copied_ptr,
+                                                            gen_topo_process_info_t *process_info_ptr);
 static ar_result_t gen_cntr_process_eos_md_from_peer_cntr(gen_cntr_t             *me_ptr,
                                                           gen_cntr_ext_in_port_t *ext_in_port_ptr,
                                                           module_cmn_md_list_t  **md_list_head_pptr);
@@ -339,6 +340,146 @@ ar_result_t gen_cntr_copy_peer_or_olc_client_input(gen_cntr_t             *me_pt
    return result;
 }
 
+/**
+ * Instead of copying, the first module reads directly from the peer container buffer when the buffer holds exactly
+ * one frame in the layout of the input port. Anything else (partial or multiple frames, deinterleaved data, EOF
+ * handling) goes through the copy in gen_cntr_copy_peer_or_olc_client_input.
+ *
+ * The module must not be inplace or bypassed, otherwise the buffer would travel further down the topo and could not be
+ * given back after the process call.
+ */
+static bool_t gen_cntr_peer_cntr_lend_input_buf(gen_cntr_t             *me_ptr,
+                                                gen_cntr_ext_in_port_t *ext_in_port_ptr,
+                                                uint32_t               *bytes_copied_per_buf_ptr)
+{
+   gen_topo_input_port_t *in_port_ptr = (gen_topo_input_port_t *)ext_in_port_ptr->gu.int_in_port_ptr;
+   gen_topo_module_t     *module_ptr  = (gen_topo_module_t *)in_port_ptr->gu.cmn.module_ptr;
+   topo_buf_t            *in_buf_ptr  = &in_port_ptr->common.bufs_ptr[0];
+   uint32_t               frame_len   = in_port_ptr->common.max_buf_len;
+
+   // pure signal triggered containers don't go through gen_cntr_data_process_one_frame, which gives the buffer back.
+   if (me_ptr->topo.flags.is_signal_triggered || gen_cntr_is_ext_in_v2(ext_in_port_ptr) ||
+       (SPF_MSG_DATA_BUFFER != ext_in_port_ptr->cu.input_data_q_msg.msg_opcode))
+   {
+      return FALSE;
+   }
+
+   if ((1 != in_port_ptr->common.sdata.bufs_num) || in_port_ptr->common.flags.is_pcm_unpacked ||
+       (SPF_DEINTERLEAVED_RAW_COMPRESSED == ext_in_port_ptr->cu.media_fmt.data_format) ||
+       (SPF_IS_PCM_DATA_FORMAT(ext_in_port_ptr->cu.media_fmt.data_format) &&
+        (TOPO_INTERLEAVED != ext_in_port_ptr->cu.media_fmt.pcm.interleaving)))
+   {
+      return FALSE;
+   }
+
+   if (module_ptr->flags.inplace || module_ptr->flags.dynamic_inplace || module_ptr->bypass_ptr ||
+       in_port_ptr->flags.was_eof_set)
+   {
+      return FALSE;
+   }
+
+   // whole frame, not read yet, into an empty and unshared buf-mgr buf of full size.
+   if ((0 == frame_len) || (frame_len != ext_in_port_ptr->buf.actual_data_len) ||
+       (ext_in_port_ptr->buf.actual_data_len != ext_in_port_ptr->buf.max_data_len) ||
+       (*bytes_copied_per_buf_ptr < frame_len) ||
+       (GEN_TOPO_BUF_ORIGIN_BUF_MGR != in_port_ptr->common.flags.buf_origin) || (0 != in_buf_ptr->actual_data_len) || (frame_len != in_buf_ptr->max_data_len) ||
+       (1 != gen_topo_buf_mgr_wrapper_get_ref_count(&in_port_ptr->common)))
+   {
+      return FALSE;
+   }
+
+   in_port_ptr->common.flags.force_return_buf = TRUE;
+   gen_topo_input_port_return_buf_mgr_buf(&me_ptr->topo, in_port_ptr);
+
+   // borrowed bufs are dropped by the topo once empty, see gen_topo_return_one_buf_mgr_buf.
+   in_buf_ptr->data_ptr                  = ext_in_port_ptr->buf.data_ptr;
+   in_buf_ptr->actual_data_len           = frame_len;
+   in_buf_ptr->max_data_len              = frame_len;
+   in_port_ptr->common.flags.buf_origin  = GEN_TOPO_BUF_ORIGIN_EXT_BUF_BORROWED;
+   ext_in_port_ptr->buf.actual_data_len  = 0;
+   ext_in_port_ptr->flags.is_buf_lent    = TRUE;
+   ext_in_port_ptr->lent_bytes          += frame_len;
+   *bytes_copied_per_buf_ptr             = frame_len;
+
+   return TRUE;
+}
+
+/**
+ * Takes the peer container buffer back from the input port. Data the module left in it is copied to a buf-mgr buf,
+ * unless it's being dropped.
+ */
+static void gen_cntr_peer_cntr_take_back_lent_in_buf(gen_cntr_t             *me_ptr,
+                                                     gen_cntr_ext_in_port_t *ext_in_port_ptr,
+                                                     bool_t                  is_drop)
+{
+   gen_topo_input_port_t *in_port_ptr = (gen_topo_input_port_t *)ext_in_port_ptr->gu.int_in_port_ptr;
+   topo_buf_t            *in_buf_ptr  = &in_port_ptr->common.bufs_ptr[0];
+
+   ext_in_port_ptr->flags.is_buf_lent = FALSE;
+
+   if ((NULL == in_buf_ptr->data_ptr) || (in_buf_ptr->data_ptr != ext_in_port_ptr->buf.data_ptr))
+   {
+      // already consumed and dropped by the topo.
+      return;
+   }
+
+   int8_t  *lent_ptr      = in_buf_ptr->data_ptr;
+   uint32_t remaining_len = is_drop ? 0 : in_buf_ptr->actual_data_len;
+
+   in_buf_ptr->data_ptr                 = NULL;
+   in_buf_ptr->actual_data_len          = 0;
+   in_port_ptr->common.flags.buf_origin = GEN_TOPO_BUF_ORIGIN_INVALID;
+
+   if (0 == remaining_len)
+   {
+      return;
+   }
+
+   gen_topo_buf_mgr_wrapper_get_buf(&me_ptr->topo, &in_port_ptr->common);
+   if (NULL == in_buf_ptr->data_ptr)
+   {
+      GEN_CNTR_MSG_ISLAND(me_ptr->topo.gu.log_id,
+                          DBG_ERROR_PRIO,
+                          "Dropping %lu bytes left by module 0x%lX in the peer container buffer, no buffer",
+                          remaining_len,
+                          in_port_ptr->gu.cmn.module_ptr->module_instance_id);
+      return;
+   }
+
+   // data is at the beginning, see gen_topo_move_data_to_beginning_after_process.
+   TOPO_MEMSCPY_NO_RET(in_buf_ptr->data_ptr,
+                       in_buf_ptr->max_data_len,
+                       lent_ptr,
+                       remaining_len,
+                       me_ptr->topo.gu.log_id,
+                       "E2I: (0x%lX, 0x%lX)",
+                       in_port_ptr->gu.cmn.module_ptr->module_instance_id,
+                       in_port_ptr->gu.cmn.id);
+   in_buf_ptr->actual_data_len = remaining_len;
+   ext_in_port_ptr->copied_bytes += remaining_len;
+}
+
+/**
+ * Called after topo process. Once the module is done with the peer container buffer, it's returned to the upstream
+ * container.
+ */
+ar_result_t gen_cntr_peer_cntr_release_lent_in_buf(gen_cntr_t *me_ptr, gen_cntr_ext_in_port_t *ext_in_port_ptr)
+{
+   if (!ext_in_port_ptr->flags.is_buf_lent)
+   {
+      return AR_EOK;
+   }
+
+   gen_cntr_peer_cntr_take_back_lent_in_buf(me_ptr, ext_in_port_ptr, FALSE /* is_drop */);
+
+   if (gen_cntr_is_input_a_data_buffer(me_ptr, ext_in_port_ptr) && (0 == ext_in_port_ptr->buf.actual_data_len))
+   {
+      gen_cntr_free_input_data_cmd(me_ptr, ext_in_port_ptr, AR_EOK, FALSE);
+   }
+
+   return AR_EOK;
+}
+
 /*===========================================================================
 
 Copies the contents of input buffer from peer service into the first module
@@ -348,15 +489,29 @@ outputs in interleaved format. Q31 or Q15. little endian.
 At input, bytes_copied_ptr contains max inputs that we can copy.
 
  ===========================================================================*/
-static ar_result_t gen_cntr_copy_peer_cntr_input_to_int_buf(gen_cntr_t             *me_ptr,
-                                                            gen_cntr_ext_in_port_t *ext_in_port_ptr,
-                                                            uint32_t               *bytes_copied_per_buf_ptr)
+static ar_result_t gen_cntr_copy_peer_cntr_input_to_int_buf(gen_cntr_t              *me_ptr,
+                                                            gen_cntr_ext_in_port_t  *ext_in_port_ptr,
+                                                            uint32_t                *bytes_copied_per_buf_ptr,
+                                                            gen_topo_process_info_t *process_info_ptr)
 {
    ar_result_t result = AR_EOK;
 
+   // only lent in the process context, where gen_cntr_data_process_one_frame gives it back after topo process.
+   if (process_info_ptr && gen_cntr_peer_cntr_lend_input_buf(me_ptr, ext_in_port_ptr, bytes_copied_per_buf_ptr))
+   {
+      // buffer is released after topo process, gen_cntr_peer_cntr_release_lent_in_buf
+      return result;
+   }
+
    result |= gen_cntr_copy_peer_or_olc_client_input(me_ptr, ext_in_port_ptr, bytes_copied_per_buf_ptr);
    // input logging is done as soon as buf is popped because otherwise deinterleaved data cannot be handled.
 
+   ext_in_port_ptr->copied_bytes +=
+      (uint64_t)(*bytes_copied_per_buf_ptr) *
+      (gen_cntr_is_ext_in_v2(ext_in_port_ptr)
+          ? ext_in_port_ptr->bufs_num
+          : ((gen_topo_input_port_t *)ext_in_port_ptr->gu.int_in_port_ptr)->common.sdata.bufs_num);
+
    // if we have copied all the data from 'data' (not EOS) buffer, release it
    // PCM decoder use case doesn't come here.
    if (gen_cntr_is_input_a_data_buffer(me_ptr, ext_in_port_ptr) && (0 == ext_in_port_ptr->buf.actual_data_len))
@@ -647,6 +802,11 @@ static ar_result_t gen_cntr_free_input_data_cmd_peer_cntr(gen_cntr_t
 {
    ar_result_t result = AR_EOK;
 
+   if (ext_in_port_ptr->flags.is_buf_lent)
+   {
+      gen_cntr_peer_cntr_take_back_lent_in_buf(me_ptr, ext_in_port_ptr, is_flush /* is_drop */);
+   }
+
    switch (ext_in_port_ptr->cu.input_data_q_msg.msg_opcode)
    {
       case SPF_MSG_DATA_BUFFER:
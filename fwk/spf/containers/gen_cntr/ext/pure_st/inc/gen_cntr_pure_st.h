@@ -23,6 +23,9 @@ ar_result_t gen_cntr_pure_st_process_frames(gen_cntr_t *me_ptr);
 
 ar_result_t gen_cntr_check_and_assign_st_data_process_fn(gen_cntr_t *me_ptr);
 
+/* Prints the per frame processing time on the pure ST path and resets it */
+void gen_cntr_pure_st_report_stats(gen_cntr_t *me_ptr);
+
 /* If st topo lib is compiled in island, we simply return without exiting island */
 void gen_cntr_vote_against_lpi_if_pure_st_topo_lib_in_nlpi(gen_cntr_t *me_ptr);
 
@@ -11,16 +11,21 @@
 #include "gen_cntr_i.h"
 
 /* Checks if pure signal triggered data process frames can be used for signal triggered containers.
-   If there is any module with active trigger policy then it uses generic topology, else it uses
-   pure signal triggered topology. */
+   If there is any module with active signal trigger policy then it uses generic topology, else it uses
+   pure signal triggered topology.
+
+   Static conditions (non-QC modules, threshold mismatch, num proc loops) permanently downgrade the container.
+   Conditions evaluated here can change at runtime, they only suspend pure ST, and the container goes back to
+   pure ST once they are cleared. */
 ar_result_t gen_cntr_check_and_assign_st_data_process_fn(gen_cntr_t *me_ptr)
 {
    // if the container is already downgraded to generic topology then no need to check further.
-   if (!gen_cntr_is_pure_signal_triggered(me_ptr))
+   if (me_ptr->topo.flags.cannot_be_pure_signal_triggered)
    {
       return AR_EOK;
    }
 
+   bool_t   was_pure_st    = gen_cntr_is_pure_signal_triggered(me_ptr);
    uint32_t num_data_tpm   = 0;
    uint32_t num_signal_tpm = 0;
    for (gu_sg_list_t *sg_list_ptr = me_ptr->topo.gu.sg_list_ptr; (NULL != sg_list_ptr); LIST_ADVANCE(sg_list_ptr))
@@ -50,11 +55,9 @@ ar_result_t gen_cntr_check_and_assign_st_data_process_fn(gen_cntr_t *me_ptr)
       }
    }
 
-   // container can be a pure signal triggered, if it never had a module with Data TP or Signal TP.
-   if (num_signal_tpm || !(me_ptr->topo.flags.is_signal_triggered && me_ptr->topo.flags.is_signal_triggered_active))
-   {
-      me_ptr->topo.flags.cannot_be_pure_signal_triggered = TRUE;
-   }
+   // container can be a pure signal triggered, if it doesn't have a module with Signal TP.
+   bool_t is_pure_st_suspended =
+      (num_signal_tpm || !(me_ptr->topo.flags.is_signal_triggered && me_ptr->topo.flags.is_signal_triggered_active));
 
    // if the container frame size is more than 5ms then it cannot be Pure signal triggered,
    // we hold buffers in Pure ST, so its not recommended to use for higher frame lengths since it can
@@ -62,15 +65,44 @@ ar_result_t gen_cntr_check_and_assign_st_data_process_fn(gen_cntr_t *me_ptr)
    uint32_t frame_duration_ms = capi_cmn_divide(me_ptr->cu.cntr_frame_len.frame_len_us , 1000);
    if (frame_duration_ms > PERF_MODE_LOW_POWER_FRAME_DURATION_MS)
    {
-      me_ptr->topo.flags.cannot_be_pure_signal_triggered = TRUE;
+      is_pure_st_suspended = TRUE;
+   }
+
+   me_ptr->flags.is_pure_st_suspended = is_pure_st_suspended;
+
+   if (was_pure_st && !gen_cntr_is_pure_signal_triggered(me_ptr))
+   {
+      gen_cntr_pure_st_report_stats(me_ptr);
    }
 
    GEN_CNTR_MSG(me_ptr->topo.gu.log_id,
                 DBG_LOW_PRIO,
-                "This is pure signal trigger container=%lu, signal_triggered:%lu num_data_tpm:%lu num_signal_tpm:%lu ",
+                "This is pure signal trigger container=%lu, signal_triggered:%lu num_data_tpm:%lu num_signal_tpm:%lu "
+                "frame_duration_ms:%lu",
                 gen_cntr_is_pure_signal_triggered(me_ptr),
                 me_ptr->topo.flags.is_signal_triggered,
                 num_data_tpm,
-                num_signal_tpm);
+                num_signal_tpm,
+                frame_duration_ms);
    return AR_EOK;
 }
+
+/* Prints the per frame processing time of the pure ST path and resets it. Called when the container leaves the
+   pure ST path and at destroy. */
+void gen_cntr_pure_st_report_stats(gen_cntr_t *me_ptr)
+{
+   gen_cntr_pure_st_stats_t *stats_ptr = &me_ptr->pure_st_stats;
+   if (0 == stats_ptr->num_frames)
+   {
+      return;
+   }
+
+   GEN_CNTR_MSG(me_ptr->topo.gu.log_id,
+                DBG_HIGH_PRIO,
+                "Pure ST processed %lu frames, per frame processing time avg %lu us, max %lu us",
+                stats_ptr->num_frames,
+                (uint32_t)posal_convert_tick_to_time(stats_ptr->total_ticks / stats_ptr->num_frames),
+                (uint32_t)posal_convert_tick_to_time(stats_ptr->max_ticks));
+
+   memset(stats_ptr, 0, sizeof(*stats_ptr));
+}
@@ -112,7 +112,7 @@ static ar_result_t gen_cntr_pure_st_setup_internal_input_port_and_preprocess(gen
    // Even if client data is not present, process has to be called to flush any remaining input data (esp. @ EoS)
    // Special note: gpr client EOS is popped and read directly in read_data.
    //    So even if there was no EOS at ext-in-port before calling this function, we might end up with one now.
-   result = ext_in_port_ptr->vtbl_ptr->read_data(me_ptr, ext_in_port_ptr, &bytes_copied_per_buf);
+   result = ext_in_port_ptr->vtbl_ptr->read_data(me_ptr, ext_in_port_ptr, &bytes_copied_per_buf, process_info_ptr);
 
    // By default need_more_input = TRUE when input is reset, set it to false.
    // TODO: can we avoid setting this to TRUE by default in the first place
@@ -461,8 +461,15 @@ ar_result_t gen_cntr_pure_st_process_frames(gen_cntr_t *me_ptr)
     * Important Note: that modules cannot return need more in ST containers. hence we dont need to handle NEED more in
     * the pure signal triggered path.
     */
+   uint64_t start_ticks = posal_timer_get_hw_ticks();
+
    result = gen_cntr_pure_st_data_process_one_frame(me_ptr);
 
+   uint64_t proc_ticks = posal_timer_get_hw_ticks() - start_ticks;
+   me_ptr->pure_st_stats.num_frames++;
+   me_ptr->pure_st_stats.total_ticks += proc_ticks;
+   me_ptr->pure_st_stats.max_ticks = MAX(me_ptr->pure_st_stats.max_ticks, proc_ticks);
+
    /** Poll control channel and check for incoming ctrl msgs.
     * If any present, do set param and return the msgs. */
    cu_poll_and_process_ctrl_msgs(&me_ptr->cu);
@@ -19,3 +19,7 @@ ar_result_t gen_cntr_check_and_assign_st_data_process_fn(gen_cntr_t *me_ptr)
 {
    return AR_EOK;
 }
+
+void gen_cntr_pure_st_report_stats(gen_cntr_t *me_ptr)
+{
+}
@@ -38,9 +38,10 @@ ar_result_t gen_cntr_data_ctrl_cmd_handle_in_media_fmt_from_gpr_client(gen_cntr_
                                                                        bool_t                  is_data_path);
 ar_result_t gen_cntr_input_dataQ_trigger_gpr_client(gen_cntr_t *            me_ptr,
                                                     gen_cntr_ext_in_port_t *ext_in_port_ptr);
-ar_result_t gen_cntr_copy_gpr_client_input_to_int_buf(gen_cntr_t *            me_ptr,
-                                                      gen_cntr_ext_in_port_t *ext_in_port_ptr,
-                                                      uint32_t *              bytes_copied_ptr);
+ar_result_t gen_cntr_copy_gpr_client_input_to_int_buf(gen_cntr_t *             me_ptr,
+                                                      gen_cntr_ext_in_port_t * ext_in_port_ptr,
+                                                      uint32_t *               bytes_copied_ptr,
+                                                      gen_topo_process_info_t *process_info_ptr);
 bool_t gen_cntr_is_input_a_gpr_client_data_buffer(gen_cntr_t *me_ptr, gen_cntr_ext_in_port_t *ext_in_port_ptr);
 ar_result_t gen_cntr_process_pending_data_cmd_gpr_client(gen_cntr_t *me_ptr, gen_cntr_ext_in_port_t *ext_in_port_ptr);
 ar_result_t gen_cntr_free_input_data_cmd_gpr_client(gen_cntr_t *            me_ptr,
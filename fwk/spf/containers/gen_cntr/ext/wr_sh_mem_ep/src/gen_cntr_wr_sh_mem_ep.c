@@ -337,9 +337,10 @@ bool_t gen_cntr_is_input_a_gpr_client_data_buffer(gen_cntr_t *me_ptr, gen_cntr_e
  *
  * At input, bytes_copied_ptr contains max inputs that we can copy.
  */
-ar_result_t gen_cntr_copy_gpr_client_input_to_int_buf(gen_cntr_t *            me_ptr,
-                                                      gen_cntr_ext_in_port_t *ext_in_port_ptr,
-                                                      uint32_t *              bytes_copied_per_buf_ptr)
+ar_result_t gen_cntr_copy_gpr_client_input_to_int_buf(gen_cntr_t *             me_ptr,
+                                                      gen_cntr_ext_in_port_t * ext_in_port_ptr,
+                                                      uint32_t *               bytes_copied_per_buf_ptr,
+                                                      gen_topo_process_info_t *process_info_ptr)
 {
    ar_result_t result = AR_EOK;
 
@@ -224,6 +224,9 @@ typedef struct data_buf_pool_node_t
    bool_t pending_alloc;
    /**< flag set if buffer was in use and would need to marked for reallocation. */
 
+   bool_t is_block_node;
+   /**< flag set if the node is part of the pool's preallocated node block and is not freed on its own */
+
    uint32_t meta_data_buf_size;
    /** < shared memory size allocated to handle the incoming meta data */
 
@@ -265,6 +268,15 @@ typedef struct shmem_data_buf_pool_t
    spf_list_node_t *port_db_list_ptr;
    /**< SDM port data buffer list of type data_buf_pool_node_t*/
 
+   data_buf_pool_node_t *node_block_ptr;
+   /**< Nodes preallocated in one block from the required number of buffers, freed once the pool is emptied */
+
+   uint32_t num_nodes_in_block;
+   /**< Number of nodes in the preallocated block */
+
+   uint32_t block_nodes_in_use_mask;
+   /**< Bit mask of the block nodes currently added to the buffer list */
+
 } shmem_data_buf_pool_t;
 
 /*  base database structure for read/write data ports */
@@ -353,6 +365,12 @@ typedef struct write_data_port_obj_t
    sdm_write_port_t port_info;
    /** < write port information */
 
+   uint64_t copy_window_start_us;
+   /** < start time of the current copy statistics window */
+
+   uint64_t copy_window_bytes;
+   /** < bytes copied into the write shared memory in the current window */
+
 } write_data_port_obj_t;
 
 /* Structure for the read data port*/
@@ -236,6 +236,75 @@ static ar_result_t spdm_alloc_data_pool_shm(spgm_info_t *spgm_ptr, shmem_data_bu
    return result;
 }
 
+/* Function to get a buffer node for the buffer pool.
+ * Nodes are taken from the pool's preallocated node block, which is created in one allocation from the
+ * required number of buffers when the pool is first populated. Only nodes beyond the block are allocated
+ * individually.
+ */
+static data_buf_pool_node_t *spdm_get_new_data_buf_node(spgm_info_t *spgm_ptr, shmem_data_buf_pool_t *data_pool_ptr)
+{
+   data_buf_pool_node_t *node_ptr = NULL;
+
+   if ((NULL == data_pool_ptr->node_block_ptr) && (0 == data_pool_ptr->num_data_buf_in_list))
+   {
+      uint32_t num_block_nodes = MIN(data_pool_ptr->req_num_data_buf, SPDM_MAX_BLOCK_BUF_NODES);
+
+      data_pool_ptr->node_block_ptr =
+         (data_buf_pool_node_t *)posal_memory_malloc(num_block_nodes * sizeof(data_buf_pool_node_t),
+                                                     (POSAL_HEAP_ID)spgm_ptr->cu_ptr->heap_id);
+      if (NULL != data_pool_ptr->node_block_ptr)
+      {
+         data_pool_ptr->num_nodes_in_block      = num_block_nodes;
+         data_pool_ptr->block_nodes_in_use_mask = 0;
+      }
+   }
+
+   for (uint32_t i = 0; (NULL != data_pool_ptr->node_block_ptr) && (i < data_pool_ptr->num_nodes_in_block); i++)
+   {
+      if (0 == (data_pool_ptr->block_nodes_in_use_mask & (1 << i)))
+      {
+         data_pool_ptr->block_nodes_in_use_mask |= (1 << i);
+         node_ptr = &data_pool_ptr->node_block_ptr[i];
+         memset(node_ptr, 0, sizeof(data_buf_pool_node_t));
+         node_ptr->is_block_node = TRUE;
+         return node_ptr;
+      }
+   }
+
+   node_ptr = (data_buf_pool_node_t *)posal_memory_malloc((sizeof(data_buf_pool_node_t)),
+                                                          (POSAL_HEAP_ID)spgm_ptr->cu_ptr->heap_id);
+   if (NULL != node_ptr)
+   {
+      memset(node_ptr, 0, sizeof(data_buf_pool_node_t));
+   }
+
+   return node_ptr;
+}
+
+/* Function to release a buffer node removed from the buffer pool list.
+ * Block nodes are returned to the block, which is freed once none of its nodes are in use.
+ */
+static void spdm_free_data_buf_node(shmem_data_buf_pool_t *data_pool_ptr, data_buf_pool_node_t *data_buf_node_ptr)
+{
+   if (data_buf_node_ptr->is_block_node)
+   {
+      uint32_t i = (uint32_t)(data_buf_node_ptr - data_pool_ptr->node_block_ptr);
+      data_pool_ptr->block_nodes_in_use_mask &= ~(1 << i);
+   }
+   else
+   {
+      posal_memory_free(data_buf_node_ptr);
+   }
+
+   if ((NULL != data_pool_ptr->node_block_ptr) && (0 == data_pool_ptr->block_nodes_in_use_mask) &&
+       (0 == data_pool_ptr->num_data_buf_in_list))
+   {
+      posal_memory_free(data_pool_ptr->node_block_ptr);
+      data_pool_ptr->node_block_ptr     = NULL;
+      data_pool_ptr->num_nodes_in_block = 0;
+   }
+}
+
 /* Function to add a buffer node to the buffer pool */
 static ar_result_t spdm_add_node_to_data_pool(spgm_info_t *          spgm_ptr,
                                               shmem_data_buf_pool_t *data_pool_ptr,
@@ -249,8 +318,7 @@ static ar_result_t spdm_add_node_to_data_pool(spgm_info_t *          spgm_ptr,
 
    while (num_nodes_add < num_buf_nodes_to_add)
    {
-      cur_node_ptr = (data_buf_pool_node_t *)posal_memory_malloc((sizeof(data_buf_pool_node_t)),
-                                                                 (POSAL_HEAP_ID)spgm_ptr->cu_ptr->heap_id);
+      cur_node_ptr = spdm_get_new_data_buf_node(spgm_ptr, data_pool_ptr);
 
       if (NULL == cur_node_ptr)
       {
@@ -262,7 +330,6 @@ static ar_result_t spdm_add_node_to_data_pool(spgm_info_t *          spgm_ptr,
          return AR_ENOMEMORY;
       }
 
-      memset(cur_node_ptr, 0, sizeof(data_buf_pool_node_t));
       cur_node_ptr->pending_alloc = TRUE;
       token                       = posal_atomic_increment(spgm_ptr->token_instance);
       cur_node_ptr->token         = token;
@@ -272,6 +339,7 @@ static ar_result_t spdm_add_node_to_data_pool(spgm_info_t *          spgm_ptr,
                                                         cur_node_ptr,
                                                         &data_pool_ptr->num_data_buf_in_list)))
       {
+         spdm_free_data_buf_node(data_pool_ptr, cur_node_ptr);
          return result;
       }
       num_nodes_add++;
@@ -373,7 +441,7 @@ ar_result_t spdm_remove_node_from_data_pool(spgm_info_t *          spgm_ptr,
             // Indicate the buffer is not with OLC.
             // We will mark for deprecation and delete the node once the
             // buffer is available with OLC
-            posal_memory_free(data_buf_node_ptr);
+            spdm_free_data_buf_node(data_pool_ptr, data_buf_node_ptr);
             data_buf_node_ptr = NULL;
             found_node        = FALSE;
             num_bufs_to_remove--;
@@ -423,7 +491,7 @@ ar_result_t spdm_remove_all_node_from_data_pool(spgm_info_t *          spgm_ptr,
             // Indicate the buffer is not with OLC.
             // We will mark for deprecation and delete the node once the
             // buffer is available with OLC
-            posal_memory_free(data_buf_node_ptr);
+            spdm_free_data_buf_node(data_pool_ptr, data_buf_node_ptr);
             data_buf_node_ptr = NULL;
             found_node        = FALSE;
             num_bufs_to_remove--;
@@ -557,6 +557,7 @@ static ar_result_t spdm_send_write_data_buffer(spgm_info_t          *spgm_ptr,
    INIT_EXCEPTION_HANDLING
    uint32_t               wr_ep_port_id     = 0;
    uint32_t               wr_client_port_id = 0;
+   uint32_t               flush_size        = 0;
    write_data_port_obj_t *wr_port_ptr       = NULL;
    wr_ep_data_header_t   *wr_data_cmd_ptr   = NULL;
 
@@ -569,8 +570,15 @@ static ar_result_t spdm_send_write_data_buffer(spgm_info_t          *spgm_ptr,
    wr_client_port_id = wr_port_ptr->port_info.ctrl_cfg.rw_client_miid;
 
    VERIFY(result, (NULL != data_buf_node_ptr->ipc_data_buf.shm_mem_ptr));
-   if (AR_EOK != (result = posal_cache_flush((uint32_t)data_buf_node_ptr->ipc_data_buf.shm_mem_ptr,
-                                             data_buf_node_ptr->ipc_data_buf.shm_alloc_size)))
+
+   // flush only up to the end of what was written, the metadata follows the full data buffer
+   flush_size = (data_buf_node_ptr->rw_md_data_info.metadata_buf_size)
+                   ? (data_buf_node_ptr->data_buf_size + 2 * GAURD_PROTECTION_BYTES +
+                      data_buf_node_ptr->rw_md_data_info.metadata_buf_size)
+                   : (GAURD_PROTECTION_BYTES + data_buf_node_ptr->offset);
+   flush_size = MIN(flush_size, data_buf_node_ptr->ipc_data_buf.shm_alloc_size);
+
+   if (AR_EOK != (result = posal_cache_flush((uint32_t)data_buf_node_ptr->ipc_data_buf.shm_mem_ptr, flush_size)))
    {
       OLC_SDM_MSG(OLC_SDM_ID, DBG_ERROR_PRIO, "write_data: data buffer cache flush failed");
       return (AR_EPANIC | result);
@@ -645,6 +653,35 @@ static ar_result_t spdm_send_write_data_buffer(spgm_info_t          *spgm_ptr,
    return result;
 }
 
+/* function to account the bytes copied into the write shared memory and report them once per window */
+static void spdm_update_write_copy_stats(spgm_info_t           *spgm_ptr,
+                                         write_data_port_obj_t *wr_ptr,
+                                         uint32_t               bytes_copied,
+                                         uint32_t               port_index)
+{
+   uint64_t cur_time_us = posal_timer_get_time();
+   uint64_t elapsed_us  = 0;
+
+   if (0 == wr_ptr->copy_window_start_us)
+   {
+      wr_ptr->copy_window_start_us = cur_time_us;
+   }
+
+   wr_ptr->copy_window_bytes += bytes_copied;
+   elapsed_us = cur_time_us - wr_ptr->copy_window_start_us;
+
+   if (SPDM_COPY_STATS_WINDOW_US <= elapsed_us)
+   {
+      OLC_SDM_MSG(OLC_SDM_ID,
+                  DBG_LOW_PRIO,
+                  "write_data: copied %lu bytes/sec into write shm",
+                  (uint32_t)((wr_ptr->copy_window_bytes * SPDM_COPY_STATS_WINDOW_US) / elapsed_us));
+
+      wr_ptr->copy_window_start_us = cur_time_us;
+      wr_ptr->copy_window_bytes    = 0;
+   }
+}
+
 static ar_result_t spdm_recreate_wr_data_buffer(spgm_info_t          *spgm_ptr,
                                                 data_buf_pool_node_t *write_data_buf_node_ptr,
                                                 uint32_t              new_input_data_size,
@@ -776,6 +813,8 @@ ar_result_t spdm_process_data_write(spgm_info_t            *spgm_ptr,
                                                    wr_shm_data_size,
                                                    input_data_ptr->data_buf.data_ptr,
                                                    input_data_ptr->data_buf.actual_data_len);
+
+         spdm_update_write_copy_stats(spgm_ptr, wr_ptr, write_data_buf_node_ptr->offset, port_index);
       }
 
       // write ipc buffer is has data, send to satellite graph
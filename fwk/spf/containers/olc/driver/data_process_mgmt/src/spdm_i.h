@@ -53,6 +53,11 @@ OLC SGM Macros
 
 #define GAURD_PROTECTION_BYTES               64
 
+// Max number of buffer nodes preallocated in one block per data pool
+#define SPDM_MAX_BLOCK_BUF_NODES             32
+// Window over which the bytes copied into write shared memory are reported
+#define SPDM_COPY_STATS_WINDOW_US            1000000
+
 /* =======================================================================
 OLC SDM Structure Definitions
 ========================================================================== */
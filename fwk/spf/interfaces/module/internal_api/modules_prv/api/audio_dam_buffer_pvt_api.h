@@ -0,0 +1,58 @@
+/**
+ * \file audio_dam_buffer_pvt_api.h
+ *
+ * \brief
+ *        Private parameters of the Audio Dam buffer module, used only by in-tree clients of spf.
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef _AUDIO_DAM_BUFFER_PVT_API_H_
+#define _AUDIO_DAM_BUFFER_PVT_API_H_
+
+/*----------------------------------------------------------------------------------------------------------------------
+ Include files
+ ---------------------------------------------------------------------------------------------------------------------*/
+#include "ar_defs.h"
+
+/**
+  Parameter to select how the history is stored in the per channel circular buffers.
+
+  In the packed modes 32 bit samples are shifted down to the stored width (with saturation) when written and shifted
+  back up when read. Packing to 24 bits is lossless for 24 bit data in Q27, packing to 16 bits has a bounded error of
+  one 16 bit LSB. 16 bit input and raw compressed data are always stored as is.
+
+  Must be set before PARAM_ID_AUDIO_DAM_INPUT_PORTS_CFG. The module rejects it once any input port is configured.
+
+  This parameter is private to spf: it is not part of the Audio Dam module API header and is not published for
+  calibration tools. The ID is a placeholder that has not been registered.
+
+  @msg_payload
+  param_id_audio_dam_history_storage_mode_t
+ */
+#define PARAM_ID_AUDIO_DAM_HISTORY_STORAGE_MODE 0x08001AB0
+
+/** History is stored with the input sample word size (default). */
+#define AUDIO_DAM_HISTORY_STORAGE_MODE_RAW_PCM 0
+
+/** 32 bit input samples are stored as 16 bit samples. */
+#define AUDIO_DAM_HISTORY_STORAGE_MODE_PACKED_16 1
+
+/** 32 bit input samples are stored as 24 bit samples. */
+#define AUDIO_DAM_HISTORY_STORAGE_MODE_PACKED_24 2
+
+/** Payload of PARAM_ID_AUDIO_DAM_HISTORY_STORAGE_MODE. */
+typedef struct param_id_audio_dam_history_storage_mode_t param_id_audio_dam_history_storage_mode_t;
+
+#include "spf_begin_pack.h"
+struct param_id_audio_dam_history_storage_mode_t
+{
+   uint32_t storage_mode;
+   /**< History storage mode, one of AUDIO_DAM_HISTORY_STORAGE_MODE_*. */
+}
+#include "spf_end_pack.h"
+;
+
+#endif /* _AUDIO_DAM_BUFFER_PVT_API_H_ */
@@ -0,0 +1,34 @@
+/**
+ * \file shared_output_buf_pvt_api.h
+ *
+ * \brief
+ *        Private interface extension between the spf framework and in-tree modules whose outputs duplicate their input.
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef _SHARED_OUTPUT_BUF_PVT_API_H_
+#define _SHARED_OUTPUT_BUF_PVT_API_H_
+
+/*----------------------------------------------------------------------------------------------------------------------
+ Include files
+ ---------------------------------------------------------------------------------------------------------------------*/
+#include "ar_defs.h"
+
+/**
+  Identifier of the Shared Output Buffer interface extension.
+
+  Supported by single-input modules whose every output is an unmodified copy of the input (the simple splitter).
+  When a module reports it, the framework may pass the input buffer pointers as the output buffer pointers. The module
+  must detect this (output data_ptr equal to the input data_ptr) and only update the output lengths, without writing
+  into the buffer. The framework keeps the buffer read-only while more than one port refers to it and gives a private
+  copy to any downstream module that writes into it.
+
+  This extension has no payload; support is only queried. It is private to spf: it is not part of the CAPI headers
+  and must not be used by modules built outside this tree.
+ */
+#define INTF_EXTN_SHARED_OUTPUT_BUF 0x0A001C20
+
+#endif /* _SHARED_OUTPUT_BUF_PVT_API_H_ */
@@ -0,0 +1,3 @@
+//This file is auto-generated. Please do not edit this file.
+
+#define SHARED_LIB_API__BUILD_TOOLS_VERSION 0x000c0200
@@ -357,9 +357,13 @@ capi_err_t capi_audio_dam_buffer_set_properties(capi_t *capi_ptr, capi_proplist_
 
                   num_channels = media_fmt_ptr->format.num_channels;
 
-                  audio_dam_set_pcm_mf(&me_ptr->driver_handle,
-                                       me_ptr->operating_mf.sampling_rate,
-                                       me_ptr->operating_mf.bytes_per_sample);
+                  if (AR_EOK != audio_dam_set_pcm_mf(&me_ptr->driver_handle,
+                                                     me_ptr->operating_mf.sampling_rate,
+                                                     me_ptr->operating_mf.bytes_per_sample,
+                                                     me_ptr->operating_mf.q_factor))
+                  {
+                     return CAPI_ENOMEMORY;
+                  }
 
                   me_ptr->is_input_media_fmt_set = TRUE;
                }
@@ -1004,6 +1008,73 @@ capi_err_t capi_audio_dam_buffer_set_param_non_island(capi_t                 *ca
          }
          break;
       }
+      case PARAM_ID_AUDIO_DAM_HISTORY_STORAGE_MODE:
+      {
+         if (params_ptr->actual_data_len < sizeof(param_id_audio_dam_history_storage_mode_t))
+         {
+            DAM_MSG(me_ptr->miid,
+                    DBG_ERROR_PRIO,
+                    "capi_audio_dam: Param id 0x%lx Bad param size %lu",
+                    (uint32_t)param_id,
+                    params_ptr->actual_data_len);
+            result |= CAPI_ENEEDMORE;
+            break;
+         }
+
+         // circular buffers are sized from the input port config, storage mode can't change after it.
+         bool_t is_inp_cfg_set = FALSE;
+         for (uint32_t i = 0; i < me_ptr->max_input_ports; i++)
+         {
+            is_inp_cfg_set |= (NULL != me_ptr->in_port_info_arr[i].cfg_ptr) ? TRUE : FALSE;
+         }
+
+         if (is_inp_cfg_set)
+         {
+            DAM_MSG(me_ptr->miid,
+                    DBG_ERROR_PRIO,
+                    "capi_audio_dam: Param id 0x%lx must be set before PARAM_ID_AUDIO_DAM_INPUT_PORTS_CFG",
+                    (uint32_t)param_id);
+            result |= CAPI_EUNSUPPORTED;
+            break;
+         }
+
+         param_id_audio_dam_history_storage_mode_t *param_cfg_ptr =
+            (param_id_audio_dam_history_storage_mode_t *)params_ptr->data_ptr;
+
+         uint32_t packed_bits_per_sample = 0;
+         switch (param_cfg_ptr->storage_mode)
+         {
+            case AUDIO_DAM_HISTORY_STORAGE_MODE_RAW_PCM:
+               packed_bits_per_sample = 0;
+               break;
+            case AUDIO_DAM_HISTORY_STORAGE_MODE_PACKED_16:
+               packed_bits_per_sample = 16;
+               break;
+            case AUDIO_DAM_HISTORY_STORAGE_MODE_PACKED_24:
+               packed_bits_per_sample = 24;
+               break;
+            default:
+            {
+               DAM_MSG(me_ptr->miid,
+                       DBG_ERROR_PRIO,
+                       "capi_audio_dam: Unsupported history storage mode %lu",
+                       param_cfg_ptr->storage_mode);
+               return CAPI_EBADPARAM;
+            }
+         }
+
+         if (AR_EOK != audio_dam_set_history_packing(&me_ptr->driver_handle, packed_bits_per_sample))
+         {
+            result |= CAPI_EUNSUPPORTED;
+            break;
+         }
+
+         DAM_MSG(me_ptr->miid,
+                 DBG_HIGH_PRIO,
+                 "capi_audio_dam: History storage mode set to %lu",
+                 param_cfg_ptr->storage_mode);
+         break;
+      }
 
       case INTF_EXTN_PARAM_ID_IMCL_PORT_OPERATION:
       {
@@ -13,6 +13,7 @@
 
 #include "capi.h"
 #include "audio_dam_buffer_api.h"
+#include "audio_dam_buffer_pvt_api.h"
 #include "audio_dam_driver.h"
 #include "capi_audio_dam_buffer.h"
 #include "capi_cmn.h"
@@ -68,8 +68,9 @@ struct audio_dam_driver_t
    /* Is buffering raw frames */
 
    int8_t *ch_frame_scratch_buf_ptr;
-   /* Scratch frame used allocated and used only for raw compressed. For
-      raw compressed data, read/writes are done using hte scratch frame. */
+   /* Scratch frame used allocated and used only for raw compressed and packed history. For
+      raw compressed data, read/writes are done using hte scratch frame. For packed history,
+      samples are packed/unpacked through it in chunks of AUDIO_DAM_PACK_SCRATCH_SAMPLES. */
 
    uint32_t frame_max_data_len_in_us;
    /* Valid only for raw compressed. PCM frame duration of each encoder frame. */
@@ -85,8 +86,24 @@ struct audio_dam_driver_t
 
    uint32_t bytes_per_sample;
    /* Valid only for fixed point data.*/
+
+   uint32_t q_factor;
+   /* Valid only for fixed point data.*/
+
+   uint32_t packed_bits_per_sample;
+   /* Width 32 bit samples are packed to in the circular buffers, 16 or 24. Zero if history is stored as is. */
+
+   uint32_t stored_bytes_per_sample;
+   /* Bytes per sample in the circular buffers. Same as bytes_per_sample unless the history is packed.
+      Reader/writer sizes and offsets are in PCM bytes, and converted at the circular buffer boundary. */
+
+   uint32_t pack_shift;
+   /* Right shift applied to 32 bit samples when packing. Valid only if history is packed. */
 };
 
+/* Max number of samples packed/unpacked per circular buffer access. */
+#define AUDIO_DAM_PACK_SCRATCH_SAMPLES (256)
+
 typedef struct audio_dam_stream_reader_virtual_buf_info_t
 {
    param_id_audio_dam_imcl_virtual_writer_info_t *cfg_ptr;
@@ -376,7 +393,14 @@ ar_result_t audio_dam_set_raw_compressed_mf(audio_dam_driver_t *drv_ptr,
                                             uint32_t            frame_max_data_len_in_bytes);
 
 /* Sets media format of the fixed point PCM data being buffered. */
-ar_result_t audio_dam_set_pcm_mf(audio_dam_driver_t *drv_ptr, uint32_t sampling_rate, uint32_t bytes_per_sample);
+ar_result_t audio_dam_set_pcm_mf(audio_dam_driver_t *drv_ptr,
+                                 uint32_t            sampling_rate,
+                                 uint32_t            bytes_per_sample,
+                                 uint32_t            q_factor);
+
+/* Sets the width 32 bit PCM history is packed to, 16 or 24. Zero stores the history as is.
+   Must be set before stream writer creation. If the PCM media format is already set, it is applied again. */
+ar_result_t audio_dam_set_history_packing(audio_dam_driver_t *drv_ptr, uint32_t packed_bits_per_sample);
 
 /*
  * Adjusts the read pointer posistion of all the channels
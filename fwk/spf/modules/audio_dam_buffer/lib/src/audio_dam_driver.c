@@ -361,7 +361,7 @@ static ar_result_t audio_dam_stream_reader_circ_buf_create_util_(audio_dam_drive
       buf_res = circ_buf_register_client(circ_buf_ptr,
                                          TRUE,
                                          chunk_heap_id,
-                                         downstream_setup_duration_in_bytes,
+                                         audio_dam_pcm_to_stored_bytes(drv_ptr, downstream_setup_duration_in_bytes),
                                          str_rd_ptr->rd_client_ptr_arr[iter]);
       if (buf_res != CIRCBUF_SUCCESS)
       {
@@ -545,7 +545,8 @@ ar_result_t audio_dam_stream_reader_req_resize(audio_dam_stream_reader_t *reader
    }
 
    uint32_t requested_alloc_size_in_bytes =
-      audio_dam_compute_buffer_size_in_bytes(reader_handle->driver_ptr, resize_in_us);
+      audio_dam_pcm_to_stored_bytes(reader_handle->driver_ptr,
+                                    audio_dam_compute_buffer_size_in_bytes(reader_handle->driver_ptr, resize_in_us));
 
    // Iterate through all the Readers channel buffers and request to resize the buffer.
    for (uint32_t iter = 0; iter < reader_handle->num_channels; iter++)
@@ -745,7 +746,10 @@ ar_result_t audio_dam_set_raw_compressed_mf(audio_dam_driver_t *drv_ptr,
    return AR_EOK;
 }
 
-ar_result_t audio_dam_set_pcm_mf(audio_dam_driver_t *drv_ptr, uint32_t sampling_rate, uint32_t bytes_per_sample)
+ar_result_t audio_dam_set_pcm_mf(audio_dam_driver_t *drv_ptr,
+                                 uint32_t            sampling_rate,
+                                 uint32_t            bytes_per_sample,
+                                 uint32_t            q_factor)
 {
    drv_ptr->is_raw_compressed = FALSE;
 
@@ -755,8 +759,68 @@ ar_result_t audio_dam_set_pcm_mf(audio_dam_driver_t *drv_ptr, uint32_t sampling_
 
    drv_ptr->sampling_rate    = sampling_rate;
    drv_ptr->bytes_per_sample = bytes_per_sample;
+   drv_ptr->q_factor         = q_factor;
 
    drv_ptr->bytes_per_one_ms = (sampling_rate / 1000) * bytes_per_sample;
 
+   // Only 32 bit samples are packed, 16 bit data is stored as is.
+   drv_ptr->stored_bytes_per_sample = bytes_per_sample;
+   drv_ptr->pack_shift              = 0;
+   if (drv_ptr->packed_bits_per_sample && (4 == bytes_per_sample))
+   {
+      uint32_t packed_q_factor = drv_ptr->packed_bits_per_sample - 1;
+
+      drv_ptr->stored_bytes_per_sample = drv_ptr->packed_bits_per_sample >> 3;
+      drv_ptr->pack_shift              = (q_factor > packed_q_factor) ? (q_factor - packed_q_factor) : 0;
+
+      if (drv_ptr->ch_frame_scratch_buf_ptr)
+      {
+         posal_memory_free(drv_ptr->ch_frame_scratch_buf_ptr);
+         drv_ptr->ch_frame_scratch_buf_ptr = NULL;
+      }
+
+      if (NULL == (drv_ptr->ch_frame_scratch_buf_ptr =
+                      (int8_t *)posal_memory_malloc(AUDIO_DAM_PACK_SCRATCH_SAMPLES * bytes_per_sample,
+                                                    drv_ptr->heap_id)))
+      {
+         DAM_MSG(drv_ptr->iid, DBG_ERROR_PRIO, "Failed allocating scratch memory for packed history");
+         drv_ptr->stored_bytes_per_sample = bytes_per_sample;
+         return AR_ENOMEMORY;
+      }
+
+      DAM_MSG(drv_ptr->iid,
+              DBG_HIGH_PRIO,
+              "History is packed from %lu to %lu bytes per sample, shift %lu",
+              bytes_per_sample,
+              drv_ptr->stored_bytes_per_sample,
+              drv_ptr->pack_shift);
+   }
+
+   return AR_EOK;
+}
+
+ar_result_t audio_dam_set_history_packing(audio_dam_driver_t *drv_ptr, uint32_t packed_bits_per_sample)
+{
+   if ((0 != packed_bits_per_sample) && (16 != packed_bits_per_sample) && (24 != packed_bits_per_sample))
+   {
+      DAM_MSG(drv_ptr->iid, DBG_ERROR_PRIO, "Unsupported history packing %lu bits", packed_bits_per_sample);
+      return AR_EBADPARAM;
+   }
+
+   // Circular buffers are sized in stored bytes, packing cannot change once they are created.
+   if (drv_ptr->stream_writer_list)
+   {
+      DAM_MSG(drv_ptr->iid, DBG_ERROR_PRIO, "History packing must be set before the stream writers are created");
+      return AR_EUNSUPPORTED;
+   }
+
+   drv_ptr->packed_bits_per_sample = packed_bits_per_sample;
+
+   // update the stored sample size if the pcm media format came first.
+   if (drv_ptr->bytes_per_sample && !drv_ptr->is_raw_compressed)
+   {
+      return audio_dam_set_pcm_mf(drv_ptr, drv_ptr->sampling_rate, drv_ptr->bytes_per_sample, drv_ptr->q_factor);
+   }
+
    return AR_EOK;
 }
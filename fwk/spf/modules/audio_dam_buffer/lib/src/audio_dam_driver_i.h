@@ -24,6 +24,46 @@ uint32_t audio_dam_compute_buffer_size_in_us(audio_dam_driver_t *drv_ptr,
                                              uint32_t            buffer_size_in_bytes,
                                              bool_t              includes_frame_header);
 
+/* Returns TRUE if PCM history is packed in the circular buffers. */
+static inline bool_t audio_dam_is_history_packed(audio_dam_driver_t *drv_ptr)
+{
+   return (drv_ptr->stored_bytes_per_sample != drv_ptr->bytes_per_sample) ? TRUE : FALSE;
+}
+
+/* Converts PCM bytes to bytes stored in the circular buffer. */
+static inline uint32_t audio_dam_pcm_to_stored_bytes(audio_dam_driver_t *drv_ptr, uint32_t pcm_bytes)
+{
+   if (!audio_dam_is_history_packed(drv_ptr))
+   {
+      return pcm_bytes;
+   }
+   return (pcm_bytes / drv_ptr->bytes_per_sample) * drv_ptr->stored_bytes_per_sample;
+}
+
+/* Converts bytes stored in the circular buffer to PCM bytes. */
+static inline uint32_t audio_dam_stored_to_pcm_bytes(audio_dam_driver_t *drv_ptr, uint32_t stored_bytes)
+{
+   if (!audio_dam_is_history_packed(drv_ptr))
+   {
+      return stored_bytes;
+   }
+   return (stored_bytes / drv_ptr->stored_bytes_per_sample) * drv_ptr->bytes_per_sample;
+}
+
+/** Packed history read/write utilities, data lengths are in PCM bytes. */
+circbuf_result_t audio_dam_circ_buf_write_packed(audio_dam_driver_t *drv_ptr,
+                                                 circ_buf_client_t * wr_client_ptr,
+                                                 int8_t *            pcm_ptr,
+                                                 uint32_t            pcm_bytes,
+                                                 uint32_t            is_valid_timestamp,
+                                                 int64_t             timestamp);
+
+circbuf_result_t audio_dam_circ_buf_read_packed(audio_dam_driver_t *drv_ptr,
+                                                circ_buf_client_t * rd_client_ptr,
+                                                int8_t *            pcm_ptr,
+                                                uint32_t            max_pcm_bytes,
+                                                uint32_t *          pcm_bytes_read_ptr);
+
 /** Virtual Buffer utility functions declaration*/
 ar_result_t audio_dam_stream_read_adjust_virt_wr_mode(audio_dam_stream_reader_t *reader_handle,
                                                       uint32_t                   requested_read_offset_in_us,
@@ -12,6 +12,76 @@
 #include "audio_dam_driver_i.h"
 #include "circular_buffer_i.h"
 
+/* Packs 32 bit samples to the stored width, saturating the samples which do not fit. */
+static void audio_dam_pack_samples(audio_dam_driver_t *drv_ptr,
+                                   const int32_t *     src_ptr,
+                                   int8_t *            dst_ptr,
+                                   uint32_t            num_samples)
+{
+   const uint32_t shift   = drv_ptr->pack_shift;
+   const int32_t  max_val = (int32_t)((1u << (drv_ptr->packed_bits_per_sample - 1)) - 1);
+   const int32_t  min_val = -max_val - 1;
+
+   if (2 == drv_ptr->stored_bytes_per_sample)
+   {
+      int16_t *dst16_ptr = (int16_t *)dst_ptr;
+      for (uint32_t i = 0; i < num_samples; i++)
+      {
+         int32_t val  = src_ptr[i] >> shift;
+         val          = (val > max_val) ? max_val : ((val < min_val) ? min_val : val);
+         dst16_ptr[i] = (int16_t)val;
+      }
+   }
+   else
+   {
+      for (uint32_t i = 0; i < num_samples; i++)
+      {
+         int32_t val = src_ptr[i] >> shift;
+         val         = (val > max_val) ? max_val : ((val < min_val) ? min_val : val);
+         *dst_ptr++  = (int8_t)(val);
+         *dst_ptr++  = (int8_t)(val >> 8);
+         *dst_ptr++  = (int8_t)(val >> 16);
+      }
+   }
+}
+
+// packs the PCM data chunk by chunk through the scratch frame and writes it to the channel buffer.
+circbuf_result_t audio_dam_circ_buf_write_packed(audio_dam_driver_t *drv_ptr,
+                                                 circ_buf_client_t * wr_client_ptr,
+                                                 int8_t *            pcm_ptr,
+                                                 uint32_t            pcm_bytes,
+                                                 uint32_t            is_valid_timestamp,
+                                                 int64_t             timestamp)
+{
+   circbuf_result_t circ_buf_res = CIRCBUF_SUCCESS;
+   const int32_t *  src_ptr      = (const int32_t *)pcm_ptr;
+   uint32_t         num_samples  = pcm_bytes / drv_ptr->bytes_per_sample;
+
+   while (num_samples)
+   {
+      uint32_t chunk_samples = MIN(num_samples, AUDIO_DAM_PACK_SCRATCH_SAMPLES);
+
+      audio_dam_pack_samples(drv_ptr, src_ptr, drv_ptr->ch_frame_scratch_buf_ptr, chunk_samples);
+
+      circ_buf_res = circ_buf_write(wr_client_ptr,
+                                    drv_ptr->ch_frame_scratch_buf_ptr,
+                                    chunk_samples * drv_ptr->stored_bytes_per_sample,
+                                    is_valid_timestamp,
+                                    timestamp);
+
+      // overrun only drops the oldest data for the readers, continue writing.
+      if ((CIRCBUF_SUCCESS != circ_buf_res) && (CIRCBUF_OVERRUN != circ_buf_res))
+      {
+         break;
+      }
+
+      src_ptr += chunk_samples;
+      num_samples -= chunk_samples;
+   }
+
+   return circ_buf_res;
+}
+
 // writes data into the stream buffer and caches the timestamp of the latest sample written.
 ar_result_t audio_dam_stream_write(audio_dam_stream_writer_t *writer_handle,
                                    uint32_t                   input_bufs_num,
@@ -82,11 +152,23 @@ ar_result_t audio_dam_stream_write(audio_dam_stream_writer_t *writer_handle,
 
       int64_t latest_sample_ts = input_buf_timestamp + latest_sample_offset_us;
 
-      circ_buf_res = circ_buf_write(&writer_handle->wr_client_arr_ptr[iter],
-                                    frame_ptr,
-                                    frame_len,
-                                    is_valid_timestamp,
-                                    latest_sample_ts);
+      if (audio_dam_is_history_packed(writer_handle->driver_ptr))
+      {
+         circ_buf_res = audio_dam_circ_buf_write_packed(writer_handle->driver_ptr,
+                                                        &writer_handle->wr_client_arr_ptr[iter],
+                                                        frame_ptr,
+                                                        frame_len,
+                                                        is_valid_timestamp,
+                                                        latest_sample_ts);
+      }
+      else
+      {
+         circ_buf_res = circ_buf_write(&writer_handle->wr_client_arr_ptr[iter],
+                                       frame_ptr,
+                                       frame_len,
+                                       is_valid_timestamp,
+                                       latest_sample_ts);
+      }
 
       if (CIRCBUF_OVERRUN == circ_buf_res)
       {
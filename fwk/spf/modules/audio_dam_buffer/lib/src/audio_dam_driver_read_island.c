@@ -12,6 +12,84 @@
 #include "audio_dam_driver_i.h"
 #include "circular_buffer_i.h"
 
+/* Unpacks stored samples back to 32 bit samples in the operating Q format. */
+static void audio_dam_unpack_samples(audio_dam_driver_t *drv_ptr,
+                                     const int8_t *      src_ptr,
+                                     int32_t *           dst_ptr,
+                                     uint32_t            num_samples)
+{
+   const uint32_t shift = drv_ptr->pack_shift;
+
+   if (2 == drv_ptr->stored_bytes_per_sample)
+   {
+      const int16_t *src16_ptr = (const int16_t *)src_ptr;
+      for (uint32_t i = 0; i < num_samples; i++)
+      {
+         dst_ptr[i] = (int32_t)((uint32_t)(int32_t)src16_ptr[i] << shift);
+      }
+   }
+   else
+   {
+      const uint8_t *src8_ptr = (const uint8_t *)src_ptr;
+      for (uint32_t i = 0; i < num_samples; i++)
+      {
+         // sign extend from 24 bits before shifting back to the operating Q format.
+         int32_t val = (int32_t)(((uint32_t)src8_ptr[0] | ((uint32_t)src8_ptr[1] << 8) | ((uint32_t)src8_ptr[2] << 16))
+                                 << 8) >> 8;
+         dst_ptr[i] = (int32_t)((uint32_t)val << shift);
+         src8_ptr += 3;
+      }
+   }
+}
+
+// reads the packed data chunk by chunk through the scratch frame and unpacks it to the PCM buffer.
+circbuf_result_t audio_dam_circ_buf_read_packed(audio_dam_driver_t *drv_ptr,
+                                                circ_buf_client_t * rd_client_ptr,
+                                                int8_t *            pcm_ptr,
+                                                uint32_t            max_pcm_bytes,
+                                                uint32_t *          pcm_bytes_read_ptr)
+{
+   circbuf_result_t circ_buf_res = CIRCBUF_SUCCESS;
+   int32_t *        dst_ptr      = (int32_t *)pcm_ptr;
+   uint32_t num_samples = MIN(max_pcm_bytes, audio_dam_stored_to_pcm_bytes(drv_ptr, rd_client_ptr->unread_bytes)) /
+                          drv_ptr->bytes_per_sample;
+
+   *pcm_bytes_read_ptr = 0;
+   if (0 == num_samples)
+   {
+      // nothing to unpack, let the circular buffer report underrun/errors same as the unpacked case.
+      uint32_t read_len = 0;
+      return circ_buf_read(rd_client_ptr,
+                           drv_ptr->ch_frame_scratch_buf_ptr,
+                           audio_dam_pcm_to_stored_bytes(drv_ptr, max_pcm_bytes),
+                           &read_len);
+   }
+
+   while (num_samples)
+   {
+      uint32_t chunk_samples = MIN(num_samples, AUDIO_DAM_PACK_SCRATCH_SAMPLES);
+      uint32_t read_len      = 0;
+
+      circ_buf_res = circ_buf_read(rd_client_ptr,
+                                   drv_ptr->ch_frame_scratch_buf_ptr,
+                                   chunk_samples * drv_ptr->stored_bytes_per_sample,
+                                   &read_len);
+      if (CIRCBUF_SUCCESS != circ_buf_res)
+      {
+         break;
+      }
+
+      chunk_samples = read_len / drv_ptr->stored_bytes_per_sample;
+      audio_dam_unpack_samples(drv_ptr, drv_ptr->ch_frame_scratch_buf_ptr, dst_ptr, chunk_samples);
+
+      dst_ptr += chunk_samples;
+      num_samples -= chunk_samples;
+      *pcm_bytes_read_ptr += chunk_samples * drv_ptr->bytes_per_sample;
+   }
+
+   return circ_buf_res;
+}
+
 static ar_result_t audio_dam_stream_read_util_(audio_dam_stream_reader_t *reader_handle,   // in
                                                uint32_t                   num_chs_to_read, // in
                                                uint32_t    bytes_req_to_read, // in, considered valid only if non zero
@@ -47,8 +125,19 @@ static ar_result_t audio_dam_stream_read_util_(audio_dam_stream_reader_t *reader
                                  : output_buf_arr[iter].max_data_len - output_buf_arr[iter].actual_data_len;
       }
 
-      buf_result =
-         circ_buf_read(reader_handle->rd_client_ptr_arr[iter], frame_ptr, max_read_frame_len, &actual_data_len);
+      if (audio_dam_is_history_packed(drv_ptr))
+      {
+         buf_result = audio_dam_circ_buf_read_packed(drv_ptr,
+                                                     reader_handle->rd_client_ptr_arr[iter],
+                                                     frame_ptr,
+                                                     max_read_frame_len,
+                                                     &actual_data_len);
+      }
+      else
+      {
+         buf_result =
+            circ_buf_read(reader_handle->rd_client_ptr_arr[iter], frame_ptr, max_read_frame_len, &actual_data_len);
+      }
       if (CIRCBUF_UNDERRUN == buf_result)
       {
          return AR_ENEEDMORE;
@@ -127,7 +216,8 @@ static ar_result_t audio_dam_stream_read_util_(audio_dam_stream_reader_t *reader
    // Update Output buffer timestamp based on the amount of data read
    uint32_t remaining_unread_len_in_us =
       audio_dam_compute_buffer_size_in_us(reader_handle->driver_ptr,
-                                          reader_handle->rd_client_ptr_arr[0]->unread_bytes,
+                                          audio_dam_stored_to_pcm_bytes(reader_handle->driver_ptr,
+                                                                        reader_handle->rd_client_ptr_arr[0]->unread_bytes),
                                           TRUE);
 
    uint32_t output_frame_len_us =
@@ -169,7 +259,8 @@ static ar_result_t audio_dam_stream_batch_read(audio_dam_stream_reader_t *reader
    // setting pending data : pending_batch_bytes = pending_data
    if (0 == reader_handle->pending_batch_bytes)
    {
-      if (reader_handle->rd_client_ptr_arr[0]->unread_bytes >= requested_batch)
+      if (audio_dam_stored_to_pcm_bytes(reader_handle->driver_ptr, reader_handle->rd_client_ptr_arr[0]->unread_bytes) >=
+          requested_batch)
       {
          reader_handle->pending_batch_bytes = requested_batch;
 #ifdef DEBUG_AUDIO_DAM_DRIVER
@@ -275,7 +366,8 @@ ar_result_t audio_dam_get_stream_reader_unread_bytes(audio_dam_stream_reader_t *
    }
    else
    {
-      *unread_bytes = reader_handle->rd_client_ptr_arr[0]->unread_bytes;
+      *unread_bytes = audio_dam_stored_to_pcm_bytes(reader_handle->driver_ptr,
+                                                    reader_handle->rd_client_ptr_arr[0]->unread_bytes);
    }
 
    return result;
@@ -351,15 +443,18 @@ ar_result_t audio_dam_stream_read_adjust(audio_dam_stream_reader_t *reader_handl
          }
       }
 
-      if (rd_client_ptr->unread_bytes < min_unread_bytes)
+      // offsets are computed in PCM bytes, converted to stored bytes only for the circular buffer.
+      uint32_t unread_bytes  = audio_dam_stored_to_pcm_bytes(drv_ptr, rd_client_ptr->unread_bytes);
+      uint32_t written_bytes = audio_dam_stored_to_pcm_bytes(drv_ptr, rd_client_ptr->circ_buf_ptr->write_byte_counter);
+      if (unread_bytes < min_unread_bytes)
       {
-         min_unread_bytes = rd_client_ptr->unread_bytes;
+         min_unread_bytes = unread_bytes;
       }
 
       // track min write byte count among all channels.
-      if (rd_client_ptr->circ_buf_ptr->write_byte_counter < min_written_bytes)
+      if (written_bytes < min_written_bytes)
       {
-         min_written_bytes = rd_client_ptr->circ_buf_ptr->write_byte_counter;
+         min_written_bytes = written_bytes;
       }
    }
 #endif
@@ -427,7 +522,10 @@ ar_result_t audio_dam_stream_read_adjust(audio_dam_stream_reader_t *reader_handl
 #endif
 
       if (CIRCBUF_SUCCESS !=
-          circ_buf_read_adjust(rd_client_ptr, max_possible_read_offset + sync_offset_in_bytes, NULL, force_adjust))
+          circ_buf_read_adjust(rd_client_ptr,
+                               audio_dam_pcm_to_stored_bytes(drv_ptr, max_possible_read_offset + sync_offset_in_bytes),
+                               NULL,
+                               force_adjust))
       {
 #ifdef DEBUG_AUDIO_DAM_DRIVER
          DAM_MSG_ISLAND(drv_ptr->iid,
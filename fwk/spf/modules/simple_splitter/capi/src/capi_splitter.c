@@ -864,6 +864,7 @@ capi_err_t capi_splitter_get_properties(capi_t *_pif, capi_proplist_t *props_ptr
                         case INTF_EXTN_DATA_PORT_OPERATION:
                         case INTF_EXTN_PROP_IS_RT_PORT_PROPERTY:
                         case INTF_EXTN_STM_TS:
+                        case INTF_EXTN_SHARED_OUTPUT_BUF:
                         {
                            curr_intf_extn_desc_ptr->is_supported = TRUE;
                            break;
@@ -24,6 +24,7 @@
 #include "capi_intf_extn_data_port_operation.h"
 #include "capi_fwk_extns_trigger_policy.h"
 #include "capi_intf_extn_prop_is_rt_port_property.h"
+#include "shared_output_buf_pvt_api.h"
 
 #ifdef __cplusplus
 extern "C" {
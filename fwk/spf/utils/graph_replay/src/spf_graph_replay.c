@@ -0,0 +1,963 @@
+/**
+ * \file spf_graph_replay.c
+ * \brief
+ *    Host tool that boots the spf framework in-process and replays a recorded sequence of GPR
+ *    commands against it, faster than real time, for framework overhead benchmarking.
+ *
+ *    The framework (APM, AMDB with the static modules, containers) and the client run in one
+ *    process and talk through the GPR local datalink. Time is taken from the POSAL simulated clock,
+ *    which is advanced by the recorded time between commands, so graphs run as fast as the CPU allows.
+ *
+ *    Trace file layout (little endian):
+ *       spf_replay_file_hdr_t
+ *       { spf_replay_rec_hdr_t, GPR packet (packet_size bytes), out-of-band bytes (oob_size bytes) } ...
+ *
+ *    - The GPR packet is replayed as recorded, the source is replaced with the tool's port.
+ *    - Shared memory map/unmap commands in the trace are skipped, the tool maps its own region once.
+ *    - For APM commands, a non-zero mem_map_handle in apm_cmd_header_t means the payload is
+ *      out-of-band, it is taken from the record's out-of-band bytes and placed in the tool's region.
+ *    - Write/read shared memory EP data buffers are placed in the tool's region, the write data is
+ *      taken from the out-of-band bytes (zeros if none). Data buffer metadata is not replayed.
+ *    - Commands are sent one at a time and waited for, data buffers are kept in flight.
+ *
+ *    Reported: per-opcode command latency and allocations, per-EP data buffer round trip latency,
+ *    allocations per data buffer, the simulated-to-wall time ratio and the CPU time spent per second of
+ *    trace time.
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+/* =======================================================================
+INCLUDE FILES FOR MODULE
+========================================================================== */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#include "posal.h"
+#include "posal_globalstate.h"
+#include "spf_main.h"
+#include "gpr_api_inline.h"
+#include "gpr_msg_if.h"
+#include "apm_api.h"
+#include "apm_memmap_api.h"
+#include "wr_sh_mem_ep_api.h"
+#include "rd_sh_mem_ep_api.h"
+#include "icb_nrt_batch.h"
+
+/* =======================================================================
+**                          Macro definitions
+** ======================================================================= */
+#define SPF_REPLAY_FILE_MAGIC 0x52465053 /* "SPFR" */
+#define SPF_REPLAY_FILE_VERSION 1
+
+#define SPF_REPLAY_SRC_PORT 0x2001 /* client port the tool registers with GPR */
+
+#define SPF_REPLAY_DEFAULT_SHM_SIZE (4 * 1024 * 1024)
+#define SPF_REPLAY_MAX_DATA_SLOTS 32
+#define SPF_REPLAY_DATA_TOKEN_FLAG 0x80000000
+#define SPF_REPLAY_MAX_OPCODES 64
+#define SPF_REPLAY_MAX_DATA_PORTS 16
+#define SPF_REPLAY_DEFAULT_TIMEOUT_MS 2000
+#define SPF_REPLAY_DEFAULT_TRACE_EVENTS (64 * 1024)
+
+/* =======================================================================
+**                          Type definitions
+** ======================================================================= */
+typedef struct spf_replay_file_hdr_t
+{
+   uint32_t magic;
+   uint32_t version;
+} spf_replay_file_hdr_t;
+
+typedef struct spf_replay_rec_hdr_t
+{
+   uint32_t delta_us;    /**< simulated time between the previous record and this one */
+   uint32_t packet_size; /**< size of the GPR packet following this header, GPR header included */
+   uint32_t oob_size;    /**< size of the out-of-band bytes following the packet */
+   uint32_t reserved;
+} spf_replay_rec_hdr_t;
+
+typedef struct spf_replay_stat_t
+{
+   uint32_t id; /**< opcode for commands, EP module instance id for data */
+   uint32_t count;
+   uint32_t num_errors;
+   uint64_t total_us;
+   uint64_t min_us;
+   uint64_t max_us;
+   uint64_t num_mallocs;
+} spf_replay_stat_t;
+
+typedef struct spf_replay_data_slot_t
+{
+   bool_t   in_use;
+   uint32_t dst_port;
+   uint64_t send_time_us;
+} spf_replay_data_slot_t;
+
+/* Chrome trace JSON export of the posal trace events */
+typedef struct spf_replay_trace_export_t
+{
+   FILE    *fp;
+   uint64_t base_ticks;
+   uint32_t num_events;
+} spf_replay_trace_export_t;
+
+typedef struct spf_replay_t
+{
+   pthread_mutex_t lock;
+   pthread_cond_t  cond;
+
+   uint32_t host_domain_id;
+   int      shm_fd;
+   uint8_t *shm_ptr;
+   uint32_t shm_size;
+   uint32_t mem_map_handle;
+   uint32_t data_slot_size;
+   uint32_t timeout_ms;
+
+   /* pending command */
+   uint32_t cmd_token;
+   bool_t   cmd_done;
+   uint32_t cmd_status;
+   uint32_t cmd_rsp_opcode;
+   uint32_t cmd_rsp_payload; /**< first word of the response payload */
+
+   spf_replay_data_slot_t data_slots[SPF_REPLAY_MAX_DATA_SLOTS];
+   uint32_t               num_data_in_flight;
+
+   spf_replay_stat_t cmd_stats[SPF_REPLAY_MAX_OPCODES];
+   uint32_t          num_cmd_stats;
+   spf_replay_stat_t data_stats[SPF_REPLAY_MAX_DATA_PORTS];
+   uint32_t          num_data_stats;
+
+   uint32_t num_events;
+   uint64_t num_data_mallocs;
+   uint32_t num_data_bufs;
+   uint64_t sim_time_us;
+} spf_replay_t;
+
+/* =======================================================================
+**                          Global Variable Definitions
+** ======================================================================= */
+static spf_replay_t g_replay;
+
+/* =======================================================================
+**                          Functions
+** ======================================================================= */
+static uint64_t spf_replay_wall_time_us(void)
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ((uint64_t)ts.tv_sec * 1000000) + ((uint64_t)ts.tv_nsec / 1000);
+}
+
+/* CPU time of all the threads of the process, i.e. the framework and the tool */
+static uint64_t spf_replay_cpu_time_us(void)
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+   return ((uint64_t)ts.tv_sec * 1000000) + ((uint64_t)ts.tv_nsec / 1000);
+}
+
+static uint32_t spf_replay_num_mallocs(void)
+{
+   return __atomic_load_n(&posal_globalstate.avs_stats[POSAL_DEFAULT_HEAP_INDEX].num_mallocs, __ATOMIC_RELAXED);
+}
+
+static spf_replay_stat_t *spf_replay_get_stat(spf_replay_stat_t *stats_ptr,
+                                              uint32_t          *num_stats_ptr,
+                                              uint32_t           max_stats,
+                                              uint32_t           id)
+{
+   for (uint32_t i = 0; i < *num_stats_ptr; i++)
+   {
+      if (id == stats_ptr[i].id)
+      {
+         return &stats_ptr[i];
+      }
+   }
+
+   if (*num_stats_ptr >= max_stats)
+   {
+      return NULL;
+   }
+
+   spf_replay_stat_t *stat_ptr = &stats_ptr[(*num_stats_ptr)++];
+   memset(stat_ptr, 0, sizeof(*stat_ptr));
+   stat_ptr->id     = id;
+   stat_ptr->min_us = UINT64_MAX;
+   return stat_ptr;
+}
+
+static void spf_replay_update_stat(spf_replay_stat_t *stat_ptr, uint64_t duration_us, uint32_t num_mallocs, bool_t is_error)
+{
+   if (NULL == stat_ptr)
+   {
+      return;
+   }
+
+   stat_ptr->count++;
+   stat_ptr->num_errors += is_error ? 1 : 0;
+   stat_ptr->total_us += duration_us;
+   stat_ptr->min_us = MIN(stat_ptr->min_us, duration_us);
+   stat_ptr->max_us = MAX(stat_ptr->max_us, duration_us);
+   stat_ptr->num_mallocs += num_mallocs;
+}
+
+/* GPR callback for the responses and events sent to the tool */
+static uint32_t spf_replay_gpr_callback(gpr_packet_t *packet_ptr, void *callback_data)
+{
+   spf_replay_t *me_ptr  = (spf_replay_t *)callback_data;
+   uint32_t      token   = packet_ptr->token;
+   uint32_t     *pl_ptr  = GPR_PKT_GET_PAYLOAD(uint32_t, packet_ptr);
+   uint32_t      pl_size = GPR_PKT_GET_PAYLOAD_BYTE_SIZE(packet_ptr->header);
+
+   pthread_mutex_lock(&me_ptr->lock);
+
+   if ((DATA_CMD_RSP_WR_SH_MEM_EP_DATA_BUFFER_DONE_V2 == packet_ptr->opcode) ||
+       (DATA_CMD_RSP_RD_SH_MEM_EP_DATA_BUFFER_DONE_V2 == packet_ptr->opcode))
+   {
+      uint32_t slot_idx = token & ~SPF_REPLAY_DATA_TOKEN_FLAG;
+      if ((token & SPF_REPLAY_DATA_TOKEN_FLAG) && (slot_idx < SPF_REPLAY_MAX_DATA_SLOTS) &&
+          me_ptr->data_slots[slot_idx].in_use)
+      {
+         spf_replay_data_slot_t *slot_ptr = &me_ptr->data_slots[slot_idx];
+         spf_replay_stat_t      *stat_ptr = spf_replay_get_stat(me_ptr->data_stats,
+                                                           &me_ptr->num_data_stats,
+                                                           SPF_REPLAY_MAX_DATA_PORTS,
+                                                           slot_ptr->dst_port);
+         bool_t is_error = (pl_size >= sizeof(uint32_t)) &&
+                           (DATA_CMD_RSP_RD_SH_MEM_EP_DATA_BUFFER_DONE_V2 == packet_ptr->opcode) &&
+                           (AR_EOK != pl_ptr[0]);
+
+         spf_replay_update_stat(stat_ptr, spf_replay_wall_time_us() - slot_ptr->send_time_us, 0, is_error);
+
+         slot_ptr->in_use = FALSE;
+         me_ptr->num_data_in_flight--;
+      }
+   }
+   else if (token == me_ptr->cmd_token)
+   {
+      me_ptr->cmd_done        = TRUE;
+      me_ptr->cmd_rsp_opcode  = packet_ptr->opcode;
+      me_ptr->cmd_rsp_payload = (pl_size >= sizeof(uint32_t)) ? pl_ptr[0] : 0;
+      me_ptr->cmd_status      = AR_EOK;
+      if ((GPR_IBASIC_RSP_RESULT == packet_ptr->opcode) && (pl_size >= sizeof(gpr_ibasic_rsp_result_t)))
+      {
+         me_ptr->cmd_status = ((gpr_ibasic_rsp_result_t *)pl_ptr)->status;
+      }
+   }
+   else
+   {
+      me_ptr->num_events++;
+   }
+
+   pthread_cond_broadcast(&me_ptr->cond);
+   pthread_mutex_unlock(&me_ptr->lock);
+
+   __gpr_cmd_free(packet_ptr);
+   return AR_EOK;
+}
+
+/* Waits with the lock held until the pending command is done, returns FALSE on timeout */
+static bool_t spf_replay_wait_cmd_done(spf_replay_t *me_ptr)
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_REALTIME, &ts);
+   ts.tv_sec += me_ptr->timeout_ms / 1000;
+   ts.tv_nsec += (me_ptr->timeout_ms % 1000) * 1000000;
+   if (ts.tv_nsec >= 1000000000)
+   {
+      ts.tv_sec++;
+      ts.tv_nsec -= 1000000000;
+   }
+
+   while (!me_ptr->cmd_done)
+   {
+      if (ETIMEDOUT == pthread_cond_timedwait(&me_ptr->cond, &me_ptr->lock, &ts))
+      {
+         return FALSE;
+      }
+   }
+   return TRUE;
+}
+
+/* Sends a packet allocated by the caller and waits for its response */
+static ar_result_t spf_replay_send_cmd(spf_replay_t *me_ptr, gpr_packet_t *packet_ptr)
+{
+   static uint32_t token = 1;
+   ar_result_t     result;
+   uint32_t        opcode       = packet_ptr->opcode;
+   uint32_t        mallocs_prev = spf_replay_num_mallocs();
+   uint64_t        start_us     = spf_replay_wall_time_us();
+
+   pthread_mutex_lock(&me_ptr->lock);
+   me_ptr->cmd_token   = (token++) & ~SPF_REPLAY_DATA_TOKEN_FLAG;
+   me_ptr->cmd_done    = FALSE;
+   packet_ptr->token   = me_ptr->cmd_token;
+   pthread_mutex_unlock(&me_ptr->lock);
+
+   if (AR_EOK != (result = __gpr_cmd_async_send(packet_ptr)))
+   {
+      fprintf(stderr, "replay: failed to send opcode 0x%08x, result %d\n", opcode, result);
+      __gpr_cmd_free(packet_ptr);
+      return result;
+   }
+
+   pthread_mutex_lock(&me_ptr->lock);
+   if (!spf_replay_wait_cmd_done(me_ptr))
+   {
+      fprintf(stderr, "replay: no response for opcode 0x%08x in %u ms\n", opcode, me_ptr->timeout_ms);
+      me_ptr->cmd_status = AR_ETIMEOUT;
+   }
+   result = me_ptr->cmd_status;
+
+   spf_replay_update_stat(spf_replay_get_stat(me_ptr->cmd_stats, &me_ptr->num_cmd_stats, SPF_REPLAY_MAX_OPCODES, opcode),
+                          spf_replay_wall_time_us() - start_us,
+                          spf_replay_num_mallocs() - mallocs_prev,
+                          (AR_EOK != result));
+   pthread_mutex_unlock(&me_ptr->lock);
+
+   if (AR_EOK != result)
+   {
+      fprintf(stderr, "replay: opcode 0x%08x failed with status 0x%x\n", opcode, result);
+   }
+   return result;
+}
+
+static ar_result_t spf_replay_alloc_packet(spf_replay_t  *me_ptr,
+                                           uint32_t       dst_port,
+                                           uint32_t       opcode,
+                                           uint32_t       payload_size,
+                                           gpr_packet_t **packet_pptr)
+{
+   gpr_cmd_alloc_ext_t args;
+   memset(&args, 0, sizeof(args));
+   args.src_domain_id = me_ptr->host_domain_id;
+   args.src_port      = SPF_REPLAY_SRC_PORT;
+   args.dst_domain_id = me_ptr->host_domain_id;
+   args.dst_port      = dst_port;
+   args.opcode        = opcode;
+   args.payload_size  = payload_size;
+   args.ret_packet    = packet_pptr;
+
+   return __gpr_cmd_alloc_ext(&args);
+}
+
+/* Creates the tool's shared memory region and maps it with the framework in offset mode */
+static ar_result_t spf_replay_map_shm(spf_replay_t *me_ptr)
+{
+   ar_result_t   result;
+   gpr_packet_t *packet_ptr = NULL;
+
+   me_ptr->shm_fd = memfd_create("spf_graph_replay", 0);
+   if ((me_ptr->shm_fd < 0) || (0 != ftruncate(me_ptr->shm_fd, me_ptr->shm_size)))
+   {
+      fprintf(stderr, "replay: failed to create shared memory, %s\n", strerror(errno));
+      return AR_ENOMEMORY;
+   }
+
+   me_ptr->shm_ptr = mmap(NULL, me_ptr->shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, me_ptr->shm_fd, 0);
+   if (MAP_FAILED == me_ptr->shm_ptr)
+   {
+      fprintf(stderr, "replay: failed to map shared memory, %s\n", strerror(errno));
+      me_ptr->shm_ptr = NULL;
+      return AR_ENOMEMORY;
+   }
+
+   uint32_t payload_size = sizeof(apm_cmd_shared_mem_map_regions_t) + sizeof(apm_shared_map_region_payload_t);
+   if (AR_EOK != (result = spf_replay_alloc_packet(me_ptr,
+                                                   APM_MODULE_INSTANCE_ID,
+                                                   APM_CMD_SHARED_MEM_MAP_REGIONS,
+                                                   payload_size,
+                                                   &packet_ptr)))
+   {
+      return result;
+   }
+
+   apm_cmd_shared_mem_map_regions_t *map_ptr = GPR_PKT_GET_PAYLOAD(apm_cmd_shared_mem_map_regions_t, packet_ptr);
+   apm_shared_map_region_payload_t  *reg_ptr = (apm_shared_map_region_payload_t *)(map_ptr + 1);
+
+   map_ptr->mem_pool_id    = APM_MEMORY_MAP_SHMEM8_4K_POOL;
+   map_ptr->num_regions    = 1;
+   map_ptr->property_flag  = APM_MEMORY_MAP_BIT_MASK_IS_OFFSET_MODE;
+   reg_ptr->shm_addr_lsw   = (uint32_t)me_ptr->shm_fd;
+   reg_ptr->shm_addr_msw   = 0;
+   reg_ptr->mem_size_bytes = me_ptr->shm_size;
+
+   result = spf_replay_send_cmd(me_ptr, packet_ptr);
+   if ((AR_EOK != result) || (APM_CMD_RSP_SHARED_MEM_MAP_REGIONS != me_ptr->cmd_rsp_opcode))
+   {
+      fprintf(stderr, "replay: shared memory map failed\n");
+      return AR_EFAILED;
+   }
+
+   me_ptr->mem_map_handle = me_ptr->cmd_rsp_payload;
+
+   /* first half of the region holds out-of-band command payloads, the second half the data buffers */
+   me_ptr->data_slot_size = (me_ptr->shm_size / 2) / SPF_REPLAY_MAX_DATA_SLOTS;
+   return AR_EOK;
+}
+
+static void spf_replay_unmap_shm(spf_replay_t *me_ptr)
+{
+   gpr_packet_t *packet_ptr = NULL;
+
+   if (me_ptr->mem_map_handle &&
+       (AR_EOK == spf_replay_alloc_packet(me_ptr,
+                                          APM_MODULE_INSTANCE_ID,
+                                          APM_CMD_SHARED_MEM_UNMAP_REGIONS,
+                                          sizeof(apm_cmd_shared_mem_unmap_regions_t),
+                                          &packet_ptr)))
+   {
+      GPR_PKT_GET_PAYLOAD(apm_cmd_shared_mem_unmap_regions_t, packet_ptr)->mem_map_handle = me_ptr->mem_map_handle;
+      spf_replay_send_cmd(me_ptr, packet_ptr);
+   }
+   me_ptr->mem_map_handle = 0;
+
+   if (me_ptr->shm_ptr)
+   {
+      munmap(me_ptr->shm_ptr, me_ptr->shm_size);
+      me_ptr->shm_ptr = NULL;
+   }
+   if (me_ptr->shm_fd >= 0)
+   {
+      close(me_ptr->shm_fd);
+      me_ptr->shm_fd = -1;
+   }
+}
+
+/* Waits for a free data slot, returns the slot index or -1 on timeout */
+static int32_t spf_replay_get_data_slot(spf_replay_t *me_ptr)
+{
+   int32_t  slot_idx = -1;
+   uint64_t end_us   = spf_replay_wall_time_us() + (uint64_t)me_ptr->timeout_ms * 1000;
+
+   pthread_mutex_lock(&me_ptr->lock);
+   while (slot_idx < 0)
+   {
+      for (uint32_t i = 0; i < SPF_REPLAY_MAX_DATA_SLOTS; i++)
+      {
+         if (!me_ptr->data_slots[i].in_use)
+         {
+            slot_idx = i;
+            break;
+         }
+      }
+
+      if ((slot_idx < 0) && (spf_replay_wall_time_us() < end_us))
+      {
+         struct timespec ts;
+         clock_gettime(CLOCK_REALTIME, &ts);
+         ts.tv_nsec += 1000000;
+         if (ts.tv_nsec >= 1000000000)
+         {
+            ts.tv_sec++;
+            ts.tv_nsec -= 1000000000;
+         }
+         pthread_cond_timedwait(&me_ptr->cond, &me_ptr->lock, &ts);
+      }
+      else if (slot_idx < 0)
+      {
+         break;
+      }
+   }
+   pthread_mutex_unlock(&me_ptr->lock);
+
+   return slot_idx;
+}
+
+/* Places a write/read data buffer in a data slot and sends it without waiting for the done */
+static ar_result_t spf_replay_send_data(spf_replay_t *me_ptr, gpr_packet_t *packet_ptr, const uint8_t *oob_ptr, uint32_t oob_size)
+{
+   ar_result_t result;
+   uint32_t    buf_size = 0;
+   int32_t     slot_idx = spf_replay_get_data_slot(me_ptr);
+
+   if (slot_idx < 0)
+   {
+      fprintf(stderr, "replay: data buffers are not returned, graph stalled\n");
+      __gpr_cmd_free(packet_ptr);
+      return AR_ETIMEOUT;
+   }
+
+   uint32_t slot_offset = (me_ptr->shm_size / 2) + (slot_idx * me_ptr->data_slot_size);
+
+   if (DATA_CMD_WR_SH_MEM_EP_DATA_BUFFER_V2 == packet_ptr->opcode)
+   {
+      data_cmd_wr_sh_mem_ep_data_buffer_v2_t *wr_ptr =
+         GPR_PKT_GET_PAYLOAD(data_cmd_wr_sh_mem_ep_data_buffer_v2_t, packet_ptr);
+
+      buf_size = MIN(wr_ptr->data_buf_size, me_ptr->data_slot_size);
+      memset(me_ptr->shm_ptr + slot_offset, 0, buf_size);
+      memcpy(me_ptr->shm_ptr + slot_offset, oob_ptr, MIN(oob_size, buf_size));
+
+      wr_ptr->data_buf_addr_lsw   = slot_offset;
+      wr_ptr->data_buf_addr_msw   = 0;
+      wr_ptr->data_mem_map_handle = me_ptr->mem_map_handle;
+      wr_ptr->data_buf_size       = buf_size;
+      wr_ptr->md_buf_addr_lsw     = 0;
+      wr_ptr->md_buf_addr_msw     = 0;
+      wr_ptr->md_mem_map_handle   = 0;
+      wr_ptr->md_buf_size         = 0;
+   }
+   else
+   {
+      data_cmd_rd_sh_mem_ep_data_buffer_v2_t *rd_ptr =
+         GPR_PKT_GET_PAYLOAD(data_cmd_rd_sh_mem_ep_data_buffer_v2_t, packet_ptr);
+
+      buf_size = MIN(rd_ptr->data_buf_size, me_ptr->data_slot_size);
+
+      rd_ptr->data_buf_addr_lsw   = slot_offset;
+      rd_ptr->data_buf_addr_msw   = 0;
+      rd_ptr->data_mem_map_handle = me_ptr->mem_map_handle;
+      rd_ptr->data_buf_size       = buf_size;
+      rd_ptr->md_buf_addr_lsw     = 0;
+      rd_ptr->md_buf_addr_msw     = 0;
+      rd_ptr->md_mem_map_handle   = 0;
+      rd_ptr->md_buf_size         = 0;
+   }
+
+   pthread_mutex_lock(&me_ptr->lock);
+   me_ptr->data_slots[slot_idx].in_use       = TRUE;
+   me_ptr->data_slots[slot_idx].dst_port     = packet_ptr->dst_port;
+   me_ptr->data_slots[slot_idx].send_time_us = spf_replay_wall_time_us();
+   me_ptr->num_data_in_flight++;
+   me_ptr->num_data_bufs++;
+   packet_ptr->token = SPF_REPLAY_DATA_TOKEN_FLAG | (uint32_t)slot_idx;
+   pthread_mutex_unlock(&me_ptr->lock);
+
+   uint32_t mallocs_prev = spf_replay_num_mallocs();
+   if (AR_EOK != (result = __gpr_cmd_async_send(packet_ptr)))
+   {
+      pthread_mutex_lock(&me_ptr->lock);
+      me_ptr->data_slots[slot_idx].in_use = FALSE;
+      me_ptr->num_data_in_flight--;
+      pthread_mutex_unlock(&me_ptr->lock);
+      __gpr_cmd_free(packet_ptr);
+      return result;
+   }
+   me_ptr->num_data_mallocs += spf_replay_num_mallocs() - mallocs_prev;
+
+   return AR_EOK;
+}
+
+/* Replays one record: the packet is copied into a GPR packet from the tool */
+static ar_result_t spf_replay_record(spf_replay_t *me_ptr, const uint8_t *pkt_buf_ptr, uint32_t packet_size, const uint8_t *oob_ptr, uint32_t oob_size)
+{
+   ar_result_t         result;
+   const gpr_packet_t *rec_pkt_ptr = (const gpr_packet_t *)pkt_buf_ptr;
+   gpr_packet_t       *packet_ptr  = NULL;
+
+   if ((packet_size < sizeof(gpr_packet_t)) || (GPR_PKT_GET_PACKET_BYTE_SIZE(rec_pkt_ptr->header) > packet_size))
+   {
+      fprintf(stderr, "replay: malformed packet in trace\n");
+      return AR_EBADPARAM;
+   }
+
+   if ((APM_CMD_SHARED_MEM_MAP_REGIONS == rec_pkt_ptr->opcode) ||
+       (APM_CMD_SHARED_MEM_UNMAP_REGIONS == rec_pkt_ptr->opcode))
+   {
+      return AR_EOK;
+   }
+
+   uint32_t payload_size = GPR_PKT_GET_PAYLOAD_BYTE_SIZE(rec_pkt_ptr->header);
+   if (AR_EOK != (result = spf_replay_alloc_packet(me_ptr, rec_pkt_ptr->dst_port, rec_pkt_ptr->opcode, payload_size, &packet_ptr)))
+   {
+      fprintf(stderr, "replay: failed to allocate a packet of %u bytes\n", payload_size);
+      return result;
+   }
+   memcpy(GPR_PKT_GET_PAYLOAD(uint8_t, packet_ptr),
+          pkt_buf_ptr + GPR_PKT_GET_HEADER_BYTE_SIZE(rec_pkt_ptr->header),
+          payload_size);
+
+   if ((DATA_CMD_WR_SH_MEM_EP_DATA_BUFFER_V2 == packet_ptr->opcode) ||
+       (DATA_CMD_RD_SH_MEM_EP_DATA_BUFFER_V2 == packet_ptr->opcode))
+   {
+      return spf_replay_send_data(me_ptr, packet_ptr, oob_ptr, oob_size);
+   }
+
+   if ((APM_MODULE_INSTANCE_ID == packet_ptr->dst_port) && (payload_size >= sizeof(apm_cmd_header_t)))
+   {
+      apm_cmd_header_t *cmd_hdr_ptr = GPR_PKT_GET_PAYLOAD(apm_cmd_header_t, packet_ptr);
+      if (cmd_hdr_ptr->mem_map_handle)
+      {
+         uint32_t size = MIN(cmd_hdr_ptr->payload_size, me_ptr->shm_size / 2);
+         memset(me_ptr->shm_ptr, 0, size);
+         memcpy(me_ptr->shm_ptr, oob_ptr, MIN(oob_size, size));
+
+         cmd_hdr_ptr->payload_address_lsw = 0;
+         cmd_hdr_ptr->payload_address_msw = 0;
+         cmd_hdr_ptr->mem_map_handle      = me_ptr->mem_map_handle;
+         cmd_hdr_ptr->payload_size        = size;
+      }
+   }
+
+   return spf_replay_send_cmd(me_ptr, packet_ptr);
+}
+
+/* Waits until the framework returned all the data buffers */
+static void spf_replay_drain_data(spf_replay_t *me_ptr)
+{
+   uint64_t end_us = spf_replay_wall_time_us() + (uint64_t)me_ptr->timeout_ms * 1000;
+
+   pthread_mutex_lock(&me_ptr->lock);
+   while (me_ptr->num_data_in_flight && (spf_replay_wall_time_us() < end_us))
+   {
+      pthread_mutex_unlock(&me_ptr->lock);
+      posal_timer_sim_clock_advance(1000);
+      usleep(100);
+      pthread_mutex_lock(&me_ptr->lock);
+   }
+   if (me_ptr->num_data_in_flight)
+   {
+      fprintf(stderr, "replay: %u data buffers not returned\n", me_ptr->num_data_in_flight);
+   }
+   pthread_mutex_unlock(&me_ptr->lock);
+}
+
+static ar_result_t spf_replay_trace(spf_replay_t *me_ptr, FILE *trace_fp, bool_t real_time)
+{
+   ar_result_t           result = AR_EOK;
+   spf_replay_file_hdr_t file_hdr;
+   spf_replay_rec_hdr_t  rec_hdr;
+   uint8_t              *rec_buf_ptr  = NULL;
+   uint32_t              rec_buf_size = 0;
+
+   if ((1 != fread(&file_hdr, sizeof(file_hdr), 1, trace_fp)) || (SPF_REPLAY_FILE_MAGIC != file_hdr.magic) ||
+       (SPF_REPLAY_FILE_VERSION != file_hdr.version))
+   {
+      fprintf(stderr, "replay: not a replay trace or unsupported version\n");
+      return AR_EBADPARAM;
+   }
+
+   while (1 == fread(&rec_hdr, sizeof(rec_hdr), 1, trace_fp))
+   {
+      uint32_t size = rec_hdr.packet_size + rec_hdr.oob_size;
+      if (size > rec_buf_size)
+      {
+         uint8_t *new_buf_ptr = realloc(rec_buf_ptr, size);
+         if (NULL == new_buf_ptr)
+         {
+            result = AR_ENOMEMORY;
+            break;
+         }
+         rec_buf_ptr  = new_buf_ptr;
+         rec_buf_size = size;
+      }
+
+      if (size && (1 != fread(rec_buf_ptr, size, 1, trace_fp)))
+      {
+         fprintf(stderr, "replay: truncated trace\n");
+         result = AR_EBADPARAM;
+         break;
+      }
+
+      if (real_time)
+      {
+         usleep(rec_hdr.delta_us);
+      }
+      else
+      {
+         posal_timer_sim_clock_advance(rec_hdr.delta_us);
+      }
+      me_ptr->sim_time_us += rec_hdr.delta_us;
+
+      result |= spf_replay_record(me_ptr,
+                                  rec_buf_ptr,
+                                  rec_hdr.packet_size,
+                                  rec_buf_ptr + rec_hdr.packet_size,
+                                  rec_hdr.oob_size);
+   }
+
+   spf_replay_drain_data(me_ptr);
+   free(rec_buf_ptr);
+   return result;
+}
+
+static void spf_replay_print_stats(const char *title, const char *id_name, spf_replay_stat_t *stats_ptr, uint32_t num_stats)
+{
+   printf("%s\n", title);
+   printf("  %-10s %8s %6s %10s %10s %10s %10s\n", id_name, "count", "errors", "avg_us", "min_us", "max_us", "mallocs");
+   for (uint32_t i = 0; i < num_stats; i++)
+   {
+      spf_replay_stat_t *s = &stats_ptr[i];
+      printf("  0x%08x %8u %6u %10llu %10llu %10llu %10llu\n",
+             s->id,
+             s->count,
+             s->num_errors,
+             (unsigned long long)(s->count ? s->total_us / s->count : 0),
+             (unsigned long long)(s->count ? s->min_us : 0),
+             (unsigned long long)s->max_us,
+             (unsigned long long)s->num_mallocs);
+   }
+}
+
+static void spf_replay_trace_get_base(int64_t tid, const posal_trace_event_t *event_ptr, void *cb_ctx_ptr)
+{
+   spf_replay_trace_export_t *exp_ptr = (spf_replay_trace_export_t *)cb_ctx_ptr;
+   exp_ptr->base_ticks                = MIN(exp_ptr->base_ticks, event_ptr->ticks);
+}
+
+static void spf_replay_trace_write_event(int64_t tid, const posal_trace_event_t *event_ptr, void *cb_ctx_ptr)
+{
+   spf_replay_trace_export_t *exp_ptr = (spf_replay_trace_export_t *)cb_ctx_ptr;
+   uint64_t                   rel_ns  = posal_convert_tick_to_time((event_ptr->ticks - exp_ptr->base_ticks) * 1000);
+   double                     ts_us   = (double)rel_ns / 1000.0;
+   unsigned long long         ctx     = (unsigned long long)event_ptr->ctx;
+   unsigned long long         arg     = (unsigned long long)event_ptr->arg;
+   char                       common[96];
+
+   snprintf(common, sizeof(common), "\"pid\":1,\"tid\":%lld,\"ts\":%.3f", (long long)tid, ts_us);
+
+   switch (event_ptr->type)
+   {
+      case POSAL_TRACE_TOPO_PROCESS_BEGIN:
+      case POSAL_TRACE_TOPO_PROCESS_END:
+         fprintf(exp_ptr->fp,
+                 "%s{\"name\":\"cntr 0x%llx\",\"cat\":\"topo\",\"ph\":\"%s\",%s}",
+                 exp_ptr->num_events ? ",\n" : "",
+                 ctx,
+                 (POSAL_TRACE_TOPO_PROCESS_BEGIN == event_ptr->type) ? "B" : "E",
+                 common);
+         break;
+      case POSAL_TRACE_MODULE_PROCESS_BEGIN:
+      case POSAL_TRACE_MODULE_PROCESS_END:
+         fprintf(exp_ptr->fp,
+                 "%s{\"name\":\"module 0x%llx\",\"cat\":\"module\",\"ph\":\"%s\",%s,"
+                 "\"args\":{\"cntr\":\"0x%llx\"}}",
+                 exp_ptr->num_events ? ",\n" : "",
+                 ctx,
+                 (POSAL_TRACE_MODULE_PROCESS_BEGIN == event_ptr->type) ? "B" : "E",
+                 common,
+                 arg);
+         break;
+      case POSAL_TRACE_QUEUE_PUSH:
+      case POSAL_TRACE_QUEUE_POP:
+         /* async slice per message from push to pop, shows the time spent waiting in the queue */
+         fprintf(exp_ptr->fp,
+                 "%s{\"name\":\"queue 0x%llx\",\"cat\":\"queue\",\"ph\":\"%s\",\"id\":\"0x%llx\",%s}",
+                 exp_ptr->num_events ? ",\n" : "",
+                 ctx,
+                 (POSAL_TRACE_QUEUE_PUSH == event_ptr->type) ? "b" : "e",
+                 arg,
+                 common);
+         break;
+      case POSAL_TRACE_GPR_RECV:
+      case POSAL_TRACE_GPR_SEND:
+         fprintf(exp_ptr->fp,
+                 "%s{\"name\":\"gpr %s 0x%08llx\",\"cat\":\"gpr\",\"ph\":\"i\",\"s\":\"t\",%s,"
+                 "\"args\":{\"port\":\"0x%llx\",\"token\":\"0x%llx\"}}",
+                 exp_ptr->num_events ? ",\n" : "",
+                 (POSAL_TRACE_GPR_RECV == event_ptr->type) ? "recv" : "ack",
+                 arg >> 32,
+                 common,
+                 ctx,
+                 arg & 0xFFFFFFFF);
+         break;
+      default:
+         return;
+   }
+
+   exp_ptr->num_events++;
+}
+
+/* Writes the recorded posal trace events as Chrome trace JSON, can be opened in Perfetto or chrome://tracing */
+static void spf_replay_export_trace(const char *file_name)
+{
+   spf_replay_trace_export_t exp = { .fp = fopen(file_name, "w"), .base_ticks = UINT64_MAX, .num_events = 0 };
+
+   if (NULL == exp.fp)
+   {
+      fprintf(stderr, "replay: cannot open %s, %s\n", file_name, strerror(errno));
+      return;
+   }
+
+   posal_trace_read_events(spf_replay_trace_get_base, &exp);
+
+   fprintf(exp.fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+   posal_trace_read_events(spf_replay_trace_write_event, &exp);
+   fprintf(exp.fp, "\n]}\n");
+   fclose(exp.fp);
+
+   printf("trace: %u events written to %s\n", exp.num_events, file_name);
+}
+
+static void spf_replay_usage(const char *prog_name)
+{
+   fprintf(stderr,
+           "usage: %s [-l loops] [-m shm_bytes] [-t timeout_ms] [-d domain_id] [-R] [-T json_file [-E events]] "
+           "[-K frames] trace_file\n"
+           "  -l  number of times the trace is replayed (default 1)\n"
+           "  -m  size of the shared memory region (default %u)\n"
+           "  -t  time to wait for a response or a data buffer (default %u ms)\n"
+           "  -d  GPR domain id of the framework (default: GPR host domain)\n"
+           "  -R  pace the trace in real time instead of using the simulated clock\n"
+           "  -T  record framework events during the replay and write them as Chrome trace JSON\n"
+           "  -E  events kept per thread for -T (default %u)\n"
+           "  -K  frames buffered between non-real-time containers (default: build configuration)\n",
+           prog_name,
+           SPF_REPLAY_DEFAULT_SHM_SIZE,
+           SPF_REPLAY_DEFAULT_TIMEOUT_MS,
+           SPF_REPLAY_DEFAULT_TRACE_EVENTS);
+}
+
+int main(int argc, char *argv[])
+{
+   spf_replay_t *me_ptr           = &g_replay;
+   uint32_t      num_loops        = 1;
+   int32_t       domain_id        = -1;
+   bool_t        real_time        = FALSE;
+   const char   *json_file        = NULL;
+   uint32_t      num_trace_events = SPF_REPLAY_DEFAULT_TRACE_EVENTS;
+   ar_result_t   result           = AR_EOK;
+   int           opt;
+
+   memset(me_ptr, 0, sizeof(*me_ptr));
+   pthread_mutex_init(&me_ptr->lock, NULL);
+   pthread_cond_init(&me_ptr->cond, NULL);
+   me_ptr->shm_fd     = -1;
+   me_ptr->shm_size   = SPF_REPLAY_DEFAULT_SHM_SIZE;
+   me_ptr->timeout_ms = SPF_REPLAY_DEFAULT_TIMEOUT_MS;
+
+   while (-1 != (opt = getopt(argc, argv, "l:m:t:d:RT:E:K:")))
+   {
+      switch (opt)
+      {
+         case 'l':
+            num_loops = strtoul(optarg, NULL, 0);
+            break;
+         case 'm':
+            me_ptr->shm_size = strtoul(optarg, NULL, 0);
+            break;
+         case 't':
+            me_ptr->timeout_ms = strtoul(optarg, NULL, 0);
+            break;
+         case 'd':
+            domain_id = strtol(optarg, NULL, 0);
+            break;
+         case 'R':
+            real_time = TRUE;
+            break;
+         case 'T':
+            json_file = optarg;
+            break;
+         case 'E':
+            num_trace_events = strtoul(optarg, NULL, 0);
+            break;
+         case 'K':
+            icb_set_nrt_batch_frames(strtoul(optarg, NULL, 0));
+            break;
+         default:
+            spf_replay_usage(argv[0]);
+            return EXIT_FAILURE;
+      }
+   }
+
+   if (optind >= argc)
+   {
+      spf_replay_usage(argv[0]);
+      return EXIT_FAILURE;
+   }
+
+   FILE *trace_fp = fopen(argv[optind], "rb");
+   if (NULL == trace_fp)
+   {
+      fprintf(stderr, "replay: cannot open %s, %s\n", argv[optind], strerror(errno));
+      return EXIT_FAILURE;
+   }
+
+   if (!real_time)
+   {
+      posal_timer_sim_clock_enable(0);
+   }
+
+   /* boot the framework in-process, the tool and APM share the GPR local datalink */
+   uint64_t boot_start_us  = spf_replay_wall_time_us();
+   uint32_t boot_mallocs   = spf_replay_num_mallocs();
+   posal_init();
+   if ((0 != ((domain_id < 0) ? gpr_init() : gpr_init_domain((uint32_t)domain_id))) ||
+       (AR_EOK != spf_framework_pre_init()) || (AR_EOK != spf_framework_post_init()))
+   {
+      fprintf(stderr, "replay: framework init failed\n");
+      fclose(trace_fp);
+      return EXIT_FAILURE;
+   }
+   printf("framework boot: %llu us, %u mallocs\n",
+          (unsigned long long)(spf_replay_wall_time_us() - boot_start_us),
+          spf_replay_num_mallocs() - boot_mallocs);
+
+   __gpr_cmd_get_host_domain_id(&me_ptr->host_domain_id);
+   if (AR_EOK != __gpr_cmd_register(SPF_REPLAY_SRC_PORT, spf_replay_gpr_callback, me_ptr))
+   {
+      fprintf(stderr, "replay: failed to register with GPR\n");
+      fclose(trace_fp);
+      return EXIT_FAILURE;
+   }
+
+   if (AR_EOK == (result = spf_replay_map_shm(me_ptr)))
+   {
+      if (json_file && (AR_EOK != posal_trace_enable(num_trace_events, POSAL_HEAP_DEFAULT)))
+      {
+         json_file = NULL;
+      }
+
+      uint64_t replay_start_us     = spf_replay_wall_time_us();
+      uint64_t replay_start_cpu_us = spf_replay_cpu_time_us();
+
+      for (uint32_t loop = 0; loop < num_loops; loop++)
+      {
+         rewind(trace_fp);
+         result |= spf_replay_trace(me_ptr, trace_fp, real_time);
+      }
+
+      uint64_t wall_us = spf_replay_wall_time_us() - replay_start_us;
+      uint64_t cpu_us  = spf_replay_cpu_time_us() - replay_start_cpu_us;
+
+      if (json_file)
+      {
+         posal_trace_disable();
+         spf_replay_export_trace(json_file);
+      }
+
+      spf_replay_print_stats("commands (wall time from send to response)", "opcode", me_ptr->cmd_stats, me_ptr->num_cmd_stats);
+      spf_replay_print_stats("data buffers (wall time from send to done, per EP)",
+                             "ep_miid",
+                             me_ptr->data_stats,
+                             me_ptr->num_data_stats);
+      printf("data buffers: %u, mallocs while sending: %llu (%.2f per buffer)\n",
+             me_ptr->num_data_bufs,
+             (unsigned long long)me_ptr->num_data_mallocs,
+             me_ptr->num_data_bufs ? (double)me_ptr->num_data_mallocs / me_ptr->num_data_bufs : 0.0);
+      printf("events: %u\n", me_ptr->num_events);
+      printf("replayed %llu us of trace time in %llu us (%.1fx)\n",
+             (unsigned long long)me_ptr->sim_time_us,
+             (unsigned long long)wall_us,
+             wall_us ? (double)me_ptr->sim_time_us / wall_us : 0.0);
+      printf("cpu time: %llu us, %.1f us per second of trace time\n",
+             (unsigned long long)cpu_us,
+             me_ptr->sim_time_us ? ((double)cpu_us * 1000000.0) / me_ptr->sim_time_us : 0.0);
+   }
+
+   spf_replay_unmap_shm(me_ptr);
+   __gpr_cmd_deregister(SPF_REPLAY_SRC_PORT);
+
+   spf_framework_pre_deinit();
+   spf_framework_post_deinit();
+   gpr_deinit();
+   posal_trace_deinit();
+   posal_deinit();
+
+   fclose(trace_fp);
+   return (AR_EOK == result) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,449 @@
+/**
+ * \file spf_heapmgr_bench.c
+ * \brief
+ *    Host tool that measures the malloc/free latency of a POSAL region heap against glibc malloc
+ *    under fragmentation, and the overhead of memory profiling.
+ *
+ *    Each allocator first gets a fragmented state: a table of slots is filled with blocks of random
+ *    (log-uniform) sizes and every other slot is freed. Then random slots are toggled, a free slot is
+ *    allocated and a used slot is freed, and the latency of each operation is recorded. All allocators
+ *    see the same sequence of sizes and slots. With more than one thread, every thread has its own slots
+ *    and all of them allocate at the same time.
+ *
+ *    Allocators:
+ *       region heap  posal_memory_malloc from a heap created on a region
+ *       posal        posal_memory_malloc from the default heap
+ *       posal+prof   posal_memory_malloc from the default heap with a tracking ID, memory profiling started
+ *       glibc        malloc
+ *
+ *    Reported per allocator and operation: mean, p99, p99.9 and max latency in ns, and for the region
+ *    heap its usage statistics at the end of the run.
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+/* =======================================================================
+INCLUDE FILES FOR MODULE
+========================================================================== */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "posal.h"
+#include "posal_heapmgr.h"
+#include "posal_mem_prof.h"
+
+/* =======================================================================
+**                          Macro definitions
+** ======================================================================= */
+#define SPF_HEAPMGR_BENCH_DEFAULT_REGION_SIZE (256 * 1024 * 1024)
+#define SPF_HEAPMGR_BENCH_DEFAULT_NUM_SLOTS 16384
+#define SPF_HEAPMGR_BENCH_DEFAULT_NUM_OPS 1000000
+#define SPF_HEAPMGR_BENCH_DEFAULT_MAX_SIZE 8192
+#define SPF_HEAPMGR_BENCH_MAX_THREADS 64
+#define SPF_HEAPMGR_BENCH_MIN_SIZE 16
+
+/* Tracking ID of the profiled allocations, as containers do for their modules */
+#define SPF_HEAPMGR_BENCH_TRACKING_ID 0x1000
+
+/* =======================================================================
+**                          Type definitions
+** ======================================================================= */
+typedef enum spf_heapmgr_bench_alloc_t
+{
+   SPF_HEAPMGR_BENCH_ALLOC_REGION_HEAP = 0,
+   SPF_HEAPMGR_BENCH_ALLOC_POSAL,
+   SPF_HEAPMGR_BENCH_ALLOC_POSAL_PROF,
+   SPF_HEAPMGR_BENCH_ALLOC_GLIBC,
+   SPF_HEAPMGR_BENCH_NUM_ALLOCS
+} spf_heapmgr_bench_alloc_t;
+
+typedef struct spf_heapmgr_bench_t spf_heapmgr_bench_t;
+
+typedef struct spf_heapmgr_bench_thread_t
+{
+   spf_heapmgr_bench_t *bench_ptr;
+   pthread_t            thread;
+   uint32_t             seed;
+
+   void   **slots_ptr;
+   uint32_t *malloc_ns_ptr;
+   uint32_t *free_ns_ptr;
+   uint32_t  num_mallocs;
+   uint32_t  num_frees;
+   uint32_t  num_failed_mallocs;
+} spf_heapmgr_bench_thread_t;
+
+struct spf_heapmgr_bench_t
+{
+   uint32_t      region_size;
+   uint32_t      num_slots;
+   uint32_t      num_ops;
+   uint32_t      max_size;
+   uint32_t      seed;
+   uint32_t      num_threads;
+   POSAL_HEAP_ID region_heap_id;
+   POSAL_HEAP_ID tracked_heap_id;
+
+   spf_heapmgr_bench_alloc_t alloc;
+   pthread_barrier_t         barrier;
+
+   spf_heapmgr_bench_thread_t threads[SPF_HEAPMGR_BENCH_MAX_THREADS];
+};
+
+static const char *spf_heapmgr_bench_alloc_names[SPF_HEAPMGR_BENCH_NUM_ALLOCS] = { "region heap",
+                                                                                  "posal",
+                                                                                  "posal+prof",
+                                                                                  "glibc" };
+
+/* =======================================================================
+**                          Function definitions
+** ======================================================================= */
+static inline uint64_t spf_heapmgr_bench_now_ns(void)
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+/* xorshift, so that all allocators see the same sequence for a seed */
+static inline uint32_t spf_heapmgr_bench_rand(uint32_t *state_ptr)
+{
+   uint32_t x = *state_ptr;
+   x ^= x << 13;
+   x ^= x >> 17;
+   x ^= x << 5;
+   *state_ptr = x;
+   return x;
+}
+
+/* log-uniform between SPF_HEAPMGR_BENCH_MIN_SIZE and max_size */
+static uint32_t spf_heapmgr_bench_rand_size(spf_heapmgr_bench_t *me_ptr, uint32_t *state_ptr)
+{
+   uint32_t max_log2 = 31 - __builtin_clz(me_ptr->max_size);
+   uint32_t min_log2 = 31 - __builtin_clz(SPF_HEAPMGR_BENCH_MIN_SIZE);
+   uint32_t log2     = min_log2 + (spf_heapmgr_bench_rand(state_ptr) % (max_log2 - min_log2 + 1));
+   uint32_t size     = (1u << log2) + (spf_heapmgr_bench_rand(state_ptr) & ((1u << log2) - 1));
+   return MIN(size, me_ptr->max_size);
+}
+
+static inline void *spf_heapmgr_bench_malloc(spf_heapmgr_bench_t *me_ptr, uint32_t size)
+{
+   switch (me_ptr->alloc)
+   {
+      case SPF_HEAPMGR_BENCH_ALLOC_REGION_HEAP:
+         return posal_memory_malloc(size, me_ptr->region_heap_id);
+      case SPF_HEAPMGR_BENCH_ALLOC_POSAL:
+         return posal_memory_malloc(size, POSAL_HEAP_DEFAULT);
+      case SPF_HEAPMGR_BENCH_ALLOC_POSAL_PROF:
+         return posal_memory_malloc(size, me_ptr->tracked_heap_id);
+      default:
+         return malloc(size);
+   }
+}
+
+static inline void spf_heapmgr_bench_free(spf_heapmgr_bench_t *me_ptr, void *ptr)
+{
+   if (SPF_HEAPMGR_BENCH_ALLOC_GLIBC != me_ptr->alloc)
+   {
+      posal_memory_free(ptr);
+   }
+   else
+   {
+      free(ptr);
+   }
+}
+
+static int spf_heapmgr_bench_cmp_u32(const void *a_ptr, const void *b_ptr)
+{
+   uint32_t a = *(const uint32_t *)a_ptr;
+   uint32_t b = *(const uint32_t *)b_ptr;
+   return (a > b) - (a < b);
+}
+
+static void spf_heapmgr_bench_report(const char *alloc_name, const char *op_name, uint32_t *ns_ptr, uint32_t count)
+{
+   if (0 == count)
+   {
+      return;
+   }
+
+   uint64_t total_ns = 0;
+   for (uint32_t i = 0; i < count; i++)
+   {
+      total_ns += ns_ptr[i];
+   }
+
+   qsort(ns_ptr, count, sizeof(uint32_t), spf_heapmgr_bench_cmp_u32);
+
+   printf("%-12s %-7s %10u %10lu %10u %10u %10u\n",
+          alloc_name,
+          op_name,
+          count,
+          (unsigned long)(total_ns / count),
+          ns_ptr[(uint32_t)(((uint64_t)count * 990) / 1000)],
+          ns_ptr[(uint32_t)(((uint64_t)count * 999) / 1000)],
+          ns_ptr[count - 1]);
+}
+
+static void *spf_heapmgr_bench_thread_fn(void *arg_ptr)
+{
+   spf_heapmgr_bench_thread_t *thread_ptr = (spf_heapmgr_bench_thread_t *)arg_ptr;
+   spf_heapmgr_bench_t *       me_ptr     = thread_ptr->bench_ptr;
+   uint32_t                    state      = thread_ptr->seed;
+
+   memset(thread_ptr->slots_ptr, 0, me_ptr->num_slots * sizeof(void *));
+   thread_ptr->num_mallocs        = 0;
+   thread_ptr->num_frees          = 0;
+   thread_ptr->num_failed_mallocs = 0;
+
+   // fragment: fill all the slots, then free every other one
+   for (uint32_t i = 0; i < me_ptr->num_slots; i++)
+   {
+      thread_ptr->slots_ptr[i] = spf_heapmgr_bench_malloc(me_ptr, spf_heapmgr_bench_rand_size(me_ptr, &state));
+   }
+   for (uint32_t i = 0; i < me_ptr->num_slots; i += 2)
+   {
+      spf_heapmgr_bench_free(me_ptr, thread_ptr->slots_ptr[i]);
+      thread_ptr->slots_ptr[i] = NULL;
+   }
+
+   pthread_barrier_wait(&me_ptr->barrier);
+
+   for (uint32_t op = 0; op < me_ptr->num_ops; op++)
+   {
+      uint32_t slot = spf_heapmgr_bench_rand(&state) % me_ptr->num_slots;
+      uint32_t size = spf_heapmgr_bench_rand_size(me_ptr, &state);
+
+      if (thread_ptr->slots_ptr[slot])
+      {
+         uint64_t start_ns = spf_heapmgr_bench_now_ns();
+         spf_heapmgr_bench_free(me_ptr, thread_ptr->slots_ptr[slot]);
+         thread_ptr->free_ns_ptr[thread_ptr->num_frees++] = (uint32_t)(spf_heapmgr_bench_now_ns() - start_ns);
+         thread_ptr->slots_ptr[slot]                      = NULL;
+      }
+      else
+      {
+         uint64_t start_ns           = spf_heapmgr_bench_now_ns();
+         thread_ptr->slots_ptr[slot] = spf_heapmgr_bench_malloc(me_ptr, size);
+         thread_ptr->malloc_ns_ptr[thread_ptr->num_mallocs++] = (uint32_t)(spf_heapmgr_bench_now_ns() - start_ns);
+         if (NULL == thread_ptr->slots_ptr[slot])
+         {
+            thread_ptr->num_failed_mallocs++;
+         }
+      }
+   }
+
+   // the profiled usage is queried before the slots are freed
+   pthread_barrier_wait(&me_ptr->barrier);
+   pthread_barrier_wait(&me_ptr->barrier);
+
+   for (uint32_t i = 0; i < me_ptr->num_slots; i++)
+   {
+      spf_heapmgr_bench_free(me_ptr, thread_ptr->slots_ptr[i]);
+   }
+
+   return NULL;
+}
+
+static void spf_heapmgr_bench_run(spf_heapmgr_bench_t *me_ptr, spf_heapmgr_bench_alloc_t alloc)
+{
+   uint32_t num_failed_mallocs = 0;
+
+   me_ptr->alloc = alloc;
+   if (SPF_HEAPMGR_BENCH_ALLOC_POSAL_PROF == alloc)
+   {
+      posal_mem_prof_start();
+   }
+
+   pthread_barrier_init(&me_ptr->barrier, NULL, me_ptr->num_threads + 1);
+   for (uint32_t t = 0; t < me_ptr->num_threads; t++)
+   {
+      pthread_create(&me_ptr->threads[t].thread, NULL, spf_heapmgr_bench_thread_fn, &me_ptr->threads[t]);
+   }
+
+   pthread_barrier_wait(&me_ptr->barrier); // fragmented
+   pthread_barrier_wait(&me_ptr->barrier); // measured
+
+   if (SPF_HEAPMGR_BENCH_ALLOC_POSAL_PROF == alloc)
+   {
+      uint32_t usage = 0;
+      posal_mem_prof_query(me_ptr->tracked_heap_id, &usage);
+      printf("posal+prof: %u bytes profiled for tracking ID 0x%x\n", usage, SPF_HEAPMGR_BENCH_TRACKING_ID);
+   }
+   else if (SPF_HEAPMGR_BENCH_ALLOC_REGION_HEAP == alloc)
+   {
+      posal_heapmgr_stats_t stats;
+      if (AR_EOK == posal_memory_heapmgr_get_stats(me_ptr->region_heap_id, &stats))
+      {
+         printf("region heap: used %u of %u bytes (peak %u), %u used blocks, %u free blocks, largest free block %u\n",
+                stats.used_bytes,
+                stats.heap_size,
+                stats.peak_used_bytes,
+                stats.num_used_blocks,
+                stats.num_free_blocks,
+                stats.largest_free_block);
+      }
+   }
+
+   pthread_barrier_wait(&me_ptr->barrier); // freeing
+   for (uint32_t t = 0; t < me_ptr->num_threads; t++)
+   {
+      pthread_join(me_ptr->threads[t].thread, NULL);
+   }
+   pthread_barrier_destroy(&me_ptr->barrier);
+
+   if (SPF_HEAPMGR_BENCH_ALLOC_POSAL_PROF == alloc)
+   {
+      posal_mem_prof_stop();
+   }
+
+   // latencies of all threads, thread 0 owns the buffers of size num_threads * num_ops
+   spf_heapmgr_bench_thread_t *first_ptr   = &me_ptr->threads[0];
+   uint32_t                    num_mallocs = first_ptr->num_mallocs;
+   uint32_t                    num_frees   = first_ptr->num_frees;
+   num_failed_mallocs += first_ptr->num_failed_mallocs;
+   for (uint32_t t = 1; t < me_ptr->num_threads; t++)
+   {
+      spf_heapmgr_bench_thread_t *thread_ptr = &me_ptr->threads[t];
+      memmove(first_ptr->malloc_ns_ptr + num_mallocs, thread_ptr->malloc_ns_ptr, thread_ptr->num_mallocs * sizeof(uint32_t));
+      memmove(first_ptr->free_ns_ptr + num_frees, thread_ptr->free_ns_ptr, thread_ptr->num_frees * sizeof(uint32_t));
+      num_mallocs += thread_ptr->num_mallocs;
+      num_frees += thread_ptr->num_frees;
+      num_failed_mallocs += thread_ptr->num_failed_mallocs;
+   }
+
+   spf_heapmgr_bench_report(spf_heapmgr_bench_alloc_names[alloc], "malloc", first_ptr->malloc_ns_ptr, num_mallocs);
+   spf_heapmgr_bench_report(spf_heapmgr_bench_alloc_names[alloc], "free", first_ptr->free_ns_ptr, num_frees);
+
+   if (num_failed_mallocs)
+   {
+      printf("%s: %u mallocs failed, increase the region size (-r)\n",
+             spf_heapmgr_bench_alloc_names[alloc],
+             num_failed_mallocs);
+   }
+}
+
+static void spf_heapmgr_bench_usage(const char *prog_name)
+{
+   printf("Usage: %s [-r region_bytes] [-n num_slots] [-o num_ops] [-m max_alloc_bytes] [-s seed] [-t num_threads]\n",
+          prog_name);
+}
+
+int main(int argc, char *argv[])
+{
+   static spf_heapmgr_bench_t bench;
+   spf_heapmgr_bench_t *      me_ptr = &bench;
+   int                        opt;
+
+   me_ptr->region_size = SPF_HEAPMGR_BENCH_DEFAULT_REGION_SIZE;
+   me_ptr->num_slots   = SPF_HEAPMGR_BENCH_DEFAULT_NUM_SLOTS;
+   me_ptr->num_ops     = SPF_HEAPMGR_BENCH_DEFAULT_NUM_OPS;
+   me_ptr->max_size    = SPF_HEAPMGR_BENCH_DEFAULT_MAX_SIZE;
+   me_ptr->seed        = 0x12345678;
+   me_ptr->num_threads = 1;
+
+   while (-1 != (opt = getopt(argc, argv, "r:n:o:m:s:t:")))
+   {
+      switch (opt)
+      {
+         case 'r':
+            me_ptr->region_size = strtoul(optarg, NULL, 0);
+            break;
+         case 'n':
+            me_ptr->num_slots = strtoul(optarg, NULL, 0);
+            break;
+         case 'o':
+            me_ptr->num_ops = strtoul(optarg, NULL, 0);
+            break;
+         case 'm':
+            me_ptr->max_size = strtoul(optarg, NULL, 0);
+            break;
+         case 's':
+            me_ptr->seed = strtoul(optarg, NULL, 0);
+            break;
+         case 't':
+            me_ptr->num_threads = strtoul(optarg, NULL, 0);
+            break;
+         default:
+            spf_heapmgr_bench_usage(argv[0]);
+            return EXIT_FAILURE;
+      }
+   }
+
+   if ((0 == me_ptr->num_slots) || (0 == me_ptr->seed) || (me_ptr->max_size < 2 * SPF_HEAPMGR_BENCH_MIN_SIZE) ||
+       (0 == me_ptr->num_threads) || (me_ptr->num_threads > SPF_HEAPMGR_BENCH_MAX_THREADS))
+   {
+      spf_heapmgr_bench_usage(argv[0]);
+      return EXIT_FAILURE;
+   }
+
+   posal_init();
+
+   void *    region_ptr    = malloc(me_ptr->region_size);
+   uint32_t *malloc_ns_ptr = (uint32_t *)calloc((size_t)me_ptr->num_threads * me_ptr->num_ops, sizeof(uint32_t));
+   uint32_t *free_ns_ptr   = (uint32_t *)calloc((size_t)me_ptr->num_threads * me_ptr->num_ops, sizeof(uint32_t));
+   if (!region_ptr || !malloc_ns_ptr || !free_ns_ptr)
+   {
+      printf("Failed to allocate the benchmark buffers\n");
+      return EXIT_FAILURE;
+   }
+
+   for (uint32_t t = 0; t < me_ptr->num_threads; t++)
+   {
+      spf_heapmgr_bench_thread_t *thread_ptr = &me_ptr->threads[t];
+      thread_ptr->bench_ptr                  = me_ptr;
+      thread_ptr->seed                       = me_ptr->seed + t;
+      thread_ptr->seed                       = thread_ptr->seed ? thread_ptr->seed : 1;
+      thread_ptr->malloc_ns_ptr              = malloc_ns_ptr + (size_t)t * me_ptr->num_ops;
+      thread_ptr->free_ns_ptr                = free_ns_ptr + (size_t)t * me_ptr->num_ops;
+      thread_ptr->slots_ptr                  = (void **)calloc(me_ptr->num_slots, sizeof(void *));
+      if (!thread_ptr->slots_ptr)
+      {
+         printf("Failed to allocate the benchmark buffers\n");
+         return EXIT_FAILURE;
+      }
+   }
+
+   me_ptr->region_heap_id = POSAL_HEAP_DEFAULT;
+   if (AR_EOK != posal_memory_heapmgr_create(&me_ptr->region_heap_id, region_ptr, me_ptr->region_size, TRUE))
+   {
+      printf("Failed to create the region heap\n");
+      return EXIT_FAILURE;
+   }
+   me_ptr->tracked_heap_id =
+      (POSAL_HEAP_ID)MODIFY_HEAP_ID_FOR_MEM_TRACKING(SPF_HEAPMGR_BENCH_TRACKING_ID, POSAL_HEAP_DEFAULT);
+
+   printf("%u threads, %u slots and %u ops per thread, sizes %u..%u bytes, region %u bytes\n",
+          me_ptr->num_threads,
+          me_ptr->num_slots,
+          me_ptr->num_ops,
+          SPF_HEAPMGR_BENCH_MIN_SIZE,
+          me_ptr->max_size,
+          me_ptr->region_size);
+   printf("%-12s %-7s %10s %10s %10s %10s %10s\n", "allocator", "op", "count", "mean_ns", "p99_ns", "p99.9_ns", "max_ns");
+
+   for (uint32_t alloc = 0; alloc < SPF_HEAPMGR_BENCH_NUM_ALLOCS; alloc++)
+   {
+      spf_heapmgr_bench_run(me_ptr, (spf_heapmgr_bench_alloc_t)alloc);
+   }
+
+   posal_memory_heapmgr_destroy(me_ptr->region_heap_id);
+
+   for (uint32_t t = 0; t < me_ptr->num_threads; t++)
+   {
+      free(me_ptr->threads[t].slots_ptr);
+   }
+   free(free_ns_ptr);
+   free(malloc_ns_ptr);
+   free(region_ptr);
+
+   posal_deinit();
+
+   return EXIT_SUCCESS;
+}
@@ -296,6 +296,18 @@ ar_result_t pc_byte_morph_process(void *          me_ptr,
                                   pc_media_fmt_t *input_media_fmt_ptr,
                                   pc_media_fmt_t *output_media_fmt_ptr);
 
+ar_result_t pc_fused_intlv_byte_morph_process(void *          me_ptr,
+                                             capi_buf_t *    input_buf_ptr,
+                                             capi_buf_t *    output_buf_ptr,
+                                             pc_media_fmt_t *input_media_fmt_ptr,
+                                             pc_media_fmt_t *output_media_fmt_ptr);
+
+ar_result_t pc_fused_deintlv_byte_morph_process(void *          me_ptr,
+                                               capi_buf_t *    input_buf_ptr,
+                                               capi_buf_t *    output_buf_ptr,
+                                               pc_media_fmt_t *input_media_fmt_ptr,
+                                               pc_media_fmt_t *output_media_fmt_ptr);
+
 ar_result_t pc_channel_mix_process(void *          me_ptr,
                                    capi_buf_t *    input_buf_ptr,
                                    capi_buf_t *    output_buf_ptr,
@@ -386,6 +398,15 @@ ar_result_t pc_deintlv_unpacked_v2_32_out(capi_buf_t *input_buf_ptr,
                                           uint16_t    q_factor_in,
                                           uint16_t    q_factor_out);
 
+ar_result_t pc_intlv_deintlv_byte_morph(capi_buf_t *input_buf_ptr,
+                                        capi_buf_t *output_buf_ptr,
+                                        uint16_t    num_channels,
+                                        uint16_t    word_size_in,
+                                        uint16_t    q_factor_in,
+                                        uint16_t    q_factor_out,
+                                        bool_t      is_intlv_in,
+                                        bool_t      is_intlv_byte_morph);
+
 ar_result_t pc_change_endianness(int8_t   *src_ptr,
                                  int8_t   *dest_ptr,
                                  uint32_t  src_actual_len,
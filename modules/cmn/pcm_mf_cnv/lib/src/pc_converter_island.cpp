@@ -980,3 +980,142 @@ ar_result_t pc_deintlv_unpacked_v2_32_out(capi_buf_t *input_buf_ptr,
                                   q_factor_out,
                                   TRUE);
 }
+
+/*______________________________________________________________________________________________________________________
+   DESCRIPTION:
+   Single pass de/interleave + byte morph between 16 bit Q15 and 32 bit Q23/Q27/Q31 data.
+   Each channel is converted straight between its deinterleaved buffer and its strided slots in the interleaved
+   buffer, so the data is touched once instead of going through a scratch buffer between the two stages.
+   Per sample arithmetic is identical to the byte morph stage being replaced. is_intlv_byte_morph is TRUE if that
+   stage ran on the interleaved side of the pair (pc_intlv_16_out/pc_intlv_32_out, 32 -> 16 bit is not saturated)
+   and FALSE if it ran on the deinterleaved side (pc_deintlv_unpacked_v2_16_out/32_out, 32 -> 16 bit is saturated).
+______________________________________________________________________________________________________________________*/
+ar_result_t pc_intlv_deintlv_byte_morph(capi_buf_t *input_buf_ptr,
+                                        capi_buf_t *output_buf_ptr,
+                                        uint16_t    num_channels,
+                                        uint16_t    word_size_in,
+                                        uint16_t    q_factor_in,
+                                        uint16_t    q_factor_out,
+                                        bool_t      is_intlv_in,
+                                        bool_t      is_intlv_byte_morph)
+{
+   uint32_t num_samp_per_ch    = 0;
+   uint32_t bytes_per_samp_out = (16 == word_size_in) ? 4 : 2;
+   uint32_t samp, ch;
+
+   if (is_intlv_in)
+   {
+      num_samp_per_ch = input_buf_ptr->actual_data_len / (num_channels * (word_size_in >> 3));
+   }
+   else
+   {
+      num_samp_per_ch = input_buf_ptr[0].actual_data_len / (word_size_in >> 3);
+   }
+
+   if (16 == word_size_in)
+   {
+      uint32_t shift_factor = q_factor_out - q_factor_in;
+
+      if (is_intlv_in)
+      {
+         int16_t *src_ptr = (int16_t *)input_buf_ptr->data_ptr;
+         for (ch = 0; ch < num_channels; ch++)
+         {
+            int32_t *dst_ptr = (int32_t *)output_buf_ptr[ch].data_ptr;
+            int16_t *in_ptr  = src_ptr + ch;
+            for (samp = 0; samp < num_samp_per_ch; samp++)
+            {
+               dst_ptr[samp] = ((int32_t)(*in_ptr)) << shift_factor;
+               in_ptr += num_channels;
+            }
+         }
+      }
+      else
+      {
+         int32_t *dst_ptr = (int32_t *)output_buf_ptr->data_ptr;
+         for (ch = 0; ch < num_channels; ch++)
+         {
+            int16_t *src_ptr = (int16_t *)input_buf_ptr[ch].data_ptr;
+            int32_t *out_ptr = dst_ptr + ch;
+            for (samp = 0; samp < num_samp_per_ch; samp++)
+            {
+               *out_ptr = ((int32_t)src_ptr[samp]) << shift_factor;
+               out_ptr += num_channels;
+            }
+         }
+      }
+   }
+   else if (32 == word_size_in)
+   {
+      uint32_t shift_factor = q_factor_in - PCM_Q_FACTOR_15;
+      int32_t  max_value    = (int32_t)MAX_Q31;
+      int32_t  min_value    = (int32_t)MIN_Q31;
+
+      // pc_intlv_16_out only shifts, so the full Q31 range (no saturation) is kept for it.
+      if (!is_intlv_byte_morph)
+      {
+         if (PCM_Q_FACTOR_23 == q_factor_in)
+         {
+            max_value = (int32_t)MAX_Q23;
+            min_value = (int32_t)MIN_Q23;
+         }
+         else if (PCM_Q_FACTOR_27 == q_factor_in)
+         {
+            max_value = (int32_t)MAX_Q27;
+            min_value = (int32_t)MIN_Q27;
+         }
+      }
+
+      if (is_intlv_in)
+      {
+         int32_t *src_ptr = (int32_t *)input_buf_ptr->data_ptr;
+         for (ch = 0; ch < num_channels; ch++)
+         {
+            int16_t *dst_ptr = (int16_t *)output_buf_ptr[ch].data_ptr;
+            int32_t *in_ptr  = src_ptr + ch;
+            for (samp = 0; samp < num_samp_per_ch; samp++)
+            {
+               int32_t temp32 = *in_ptr;
+               temp32         = (temp32 < min_value) ? min_value : temp32;
+               temp32         = (temp32 > max_value) ? max_value : temp32;
+               dst_ptr[samp]  = (int16_t)(temp32 >> shift_factor);
+               in_ptr += num_channels;
+            }
+         }
+      }
+      else
+      {
+         int16_t *dst_ptr = (int16_t *)output_buf_ptr->data_ptr;
+         for (ch = 0; ch < num_channels; ch++)
+         {
+            int32_t *src_ptr = (int32_t *)input_buf_ptr[ch].data_ptr;
+            int16_t *out_ptr = dst_ptr + ch;
+            for (samp = 0; samp < num_samp_per_ch; samp++)
+            {
+               int32_t temp32 = src_ptr[samp];
+               temp32         = (temp32 < min_value) ? min_value : temp32;
+               temp32         = (temp32 > max_value) ? max_value : temp32;
+               *out_ptr       = (int16_t)(temp32 >> shift_factor);
+               out_ptr += num_channels;
+            }
+         }
+      }
+   }
+   else
+   {
+      output_buf_ptr[0].actual_data_len = 0;
+      return AR_EUNSUPPORTED;
+   }
+
+   if (is_intlv_in)
+   {
+      // optimization: write/read only first ch lens, and assume same lens for rest of the chs
+      output_buf_ptr[0].actual_data_len = num_samp_per_ch * bytes_per_samp_out;
+   }
+   else
+   {
+      output_buf_ptr->actual_data_len = num_samp_per_ch * num_channels * bytes_per_samp_out;
+   }
+
+   return AR_EOK;
+}
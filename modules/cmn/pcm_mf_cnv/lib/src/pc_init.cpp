@@ -874,6 +874,105 @@ void pc_fill_fir_resampler_lib_mf(pc_lib_t *pc_ptr, pc_media_fmt_t *inp_mf, uint
    }
 }
 
+/*______________________________________________________________________________________________________________________
+   DESCRIPTION:
+   Checks if a byte morph from in_mf to out_mf is one of the conversions supported by pc_intlv_deintlv_byte_morph,
+   i.e. fixed point 16 bit Q15 <-> 32 bit Q23/Q27/Q31
+______________________________________________________________________________________________________________________*/
+static bool_t pc_is_fusable_byte_morph(pc_media_fmt_t *in_mf_ptr, pc_media_fmt_t *out_mf_ptr)
+{
+   pc_media_fmt_t *mf_32_ptr = NULL;
+
+   if ((PC_FIXED_FORMAT != in_mf_ptr->data_format) || (PC_FIXED_FORMAT != out_mf_ptr->data_format) ||
+       (in_mf_ptr->num_channels != out_mf_ptr->num_channels))
+   {
+      return FALSE;
+   }
+
+   if ((16 == in_mf_ptr->word_size) && (PCM_Q_FACTOR_15 == in_mf_ptr->q_factor) && (32 == out_mf_ptr->word_size))
+   {
+      mf_32_ptr = out_mf_ptr;
+   }
+   else if ((32 == in_mf_ptr->word_size) && (PC_BW16_W16_Q15 == out_mf_ptr->byte_combo))
+   {
+      mf_32_ptr = in_mf_ptr;
+   }
+   else
+   {
+      return FALSE;
+   }
+
+   return ((PCM_Q_FACTOR_23 == mf_32_ptr->q_factor) || (PCM_Q_FACTOR_27 == mf_32_ptr->q_factor) ||
+           (PCM_Q_FACTOR_31 == mf_32_ptr->q_factor));
+}
+
+/*______________________________________________________________________________________________________________________
+   DESCRIPTION:
+   Collapses an interleaving stage and a byte morph stage which run back to back (in either order) into a single
+   fused stage, so that the data is not written to and read back from a scratch buffer in between.
+   1. The fused process takes the slot of the second stage and keeps its output buffer and media fmt, the first
+      stage is disabled. Media fmt of the first stage is left as is since it is referred elsewhere.
+      The fused process is picked by the side the byte morph ran on, so that the output matches the staged pipeline
+      (32 -> 16 bit is saturated only on the deinterleaved side).
+   2. Only done if the fused stage doesn't read and write the same buffer (scratch buffers alternate between stages).
+   3. For any other stage combination the staged pipeline is used as is.
+______________________________________________________________________________________________________________________*/
+static void pc_fuse_proc_info(pc_lib_t *pc_ptr)
+{
+   pc_proc_info_t *proc_info_ptr   = pc_ptr->core_lib.pc_proc_info;
+   capi_buf_t *    in_buf_ptr      = pc_ptr->core_lib.remap_input_buf_ptr;
+   pc_media_fmt_t *in_mf_ptr       = &pc_ptr->core_lib.input_media_fmt;
+   uint32_t        prev_idx        = NUMBER_OF_PROCESS;
+   capi_buf_t *    prev_in_buf_ptr = NULL;
+   pc_media_fmt_t *prev_in_mf_ptr  = NULL;
+
+   for (uint32_t i = 0; i < NUMBER_OF_PROCESS; i++)
+   {
+      bool_t is_fused = FALSE;
+
+      if (NULL == proc_info_ptr[i].process)
+      {
+         continue;
+      }
+
+      if (NUMBER_OF_PROCESS != prev_idx)
+      {
+         bool_t is_intlv_pair =
+            (((INT_DEINT_PRE == prev_idx) || (INT_DEINT_POST == prev_idx)) &&
+             ((BYTE_CNV_PRE == i) || (BYTE_CNV_POST == i))) ||
+            (((BYTE_CNV_PRE == prev_idx) || (BYTE_CNV_POST == prev_idx)) &&
+             ((INT_DEINT_PRE == i) || (INT_DEINT_POST == i)));
+
+         if (is_intlv_pair && (prev_in_buf_ptr != proc_info_ptr[i].output_buffer_ptr) &&
+             pc_is_fusable_byte_morph(prev_in_mf_ptr, &proc_info_ptr[i].output_media_fmt))
+         {
+            // byte morph reads the pair input if it runs first, else the output of the interleaving stage.
+            bool_t          is_byte_morph_first  = (BYTE_CNV_PRE == prev_idx) || (BYTE_CNV_POST == prev_idx);
+            pc_media_fmt_t *byte_morph_in_mf_ptr = is_byte_morph_first ? prev_in_mf_ptr : in_mf_ptr;
+
+            CNV_MSG(pc_ptr->miid, DBG_HIGH_PRIO, "Fusing process %lu into process %lu", prev_idx, i);
+
+            proc_info_ptr[prev_idx].process = NULL;
+            proc_info_ptr[i].process        = (PC_INTERLEAVED == byte_morph_in_mf_ptr->interleaving)
+                                                 ? pc_fused_intlv_byte_morph_process
+                                                 : pc_fused_deintlv_byte_morph_process;
+
+            // fused stage reads what the first stage of the pair used to read
+            in_buf_ptr = prev_in_buf_ptr;
+            in_mf_ptr  = prev_in_mf_ptr;
+            is_fused   = TRUE;
+         }
+      }
+
+      // a fused stage can't be paired again
+      prev_idx        = is_fused ? NUMBER_OF_PROCESS : i;
+      prev_in_buf_ptr = in_buf_ptr;
+      prev_in_mf_ptr  = in_mf_ptr;
+      in_buf_ptr      = proc_info_ptr[i].output_buffer_ptr;
+      in_mf_ptr       = &proc_info_ptr[i].output_media_fmt;
+   }
+}
+
 /*______________________________________________________________________________________________________________________
    DESCRIPTION:
    Check pc_identify_required_processes function before reading this
@@ -1133,6 +1232,7 @@ void pc_fill_proc_info(pc_lib_t *pc_ptr)
          break;
       }
    }
+   pc_fuse_proc_info(pc_ptr);
 }
 /*______________________________________________________________________________________________________________________
    DESCRIPTION:
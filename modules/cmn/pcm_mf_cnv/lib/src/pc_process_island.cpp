@@ -278,6 +278,48 @@ ar_result_t pc_byte_morph_process(void *          me_ptr,
 
    return result;
 }
+/*______________________________________________________________________________________________________________________
+   DESCRIPTION:
+   Replaces an adjacent interleaving + byte morph stage pair (see pc_fuse_proc_info) in which the byte morph runs
+   on the interleaved data. Input is the media fmt of the first stage of the pair and output is the media fmt of the
+   second one.
+______________________________________________________________________________________________________________________*/
+ar_result_t pc_fused_intlv_byte_morph_process(void *          me_ptr,
+                                             capi_buf_t *    input_buf_ptr,
+                                             capi_buf_t *    output_buf_ptr,
+                                             pc_media_fmt_t *input_media_fmt_ptr,
+                                             pc_media_fmt_t *output_media_fmt_ptr)
+{
+   return pc_intlv_deintlv_byte_morph(input_buf_ptr,
+                                      output_buf_ptr,
+                                      input_media_fmt_ptr->num_channels,
+                                      input_media_fmt_ptr->word_size,
+                                      input_media_fmt_ptr->q_factor,
+                                      output_media_fmt_ptr->q_factor,
+                                      (PC_INTERLEAVED == input_media_fmt_ptr->interleaving),
+                                      TRUE /* is_intlv_byte_morph */);
+}
+
+/*______________________________________________________________________________________________________________________
+   DESCRIPTION:
+   Same as pc_fused_intlv_byte_morph_process, for pairs in which the byte morph runs on the deinterleaved data.
+______________________________________________________________________________________________________________________*/
+ar_result_t pc_fused_deintlv_byte_morph_process(void *          me_ptr,
+                                               capi_buf_t *    input_buf_ptr,
+                                               capi_buf_t *    output_buf_ptr,
+                                               pc_media_fmt_t *input_media_fmt_ptr,
+                                               pc_media_fmt_t *output_media_fmt_ptr)
+{
+   return pc_intlv_deintlv_byte_morph(input_buf_ptr,
+                                      output_buf_ptr,
+                                      input_media_fmt_ptr->num_channels,
+                                      input_media_fmt_ptr->word_size,
+                                      input_media_fmt_ptr->q_factor,
+                                      output_media_fmt_ptr->q_factor,
+                                      (PC_INTERLEAVED == input_media_fmt_ptr->interleaving),
+                                      FALSE /* is_intlv_byte_morph */);
+}
+
 /*______________________________________________________________________________________________________________________
    DESCRIPTION:
 
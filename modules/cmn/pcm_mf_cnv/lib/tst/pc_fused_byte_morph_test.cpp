@@ -0,0 +1,226 @@
+/*==============================================================================
+  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+  SPDX-License-Identifier: BSD-3-Clause-Clear
+  ==============================================================================*/
+
+/*============================================================================
+  FILE:          pc_fused_byte_morph_test.cpp
+
+  OVERVIEW:      Bit exactness test of the fused interleave + byte morph stage
+                 (pc_intlv_deintlv_byte_morph) against the staged pipeline it
+                 replaces, i.e. the interleaving stage followed or preceded by
+                 the byte morph stage.
+
+                 Inputs are full scale and out of range (overflow) samples, so
+                 that the saturation of each side is covered.
+
+  DEPENDENCIES:  pc_converter_island.cpp, spf_interleaver
+
+  ============================================================================*/
+#include <stdio.h>
+#include <string.h>
+
+#include "pc_converter.h"
+
+#define PC_TEST_MAX_CH       8
+#define PC_TEST_SAMP_PER_CH  16
+#define PC_TEST_BUF_SIZE     (PC_TEST_MAX_CH * PC_TEST_SAMP_PER_CH * sizeof(int32_t))
+
+static int8_t in_buf[PC_TEST_BUF_SIZE];
+static int8_t scratch_buf[PC_TEST_BUF_SIZE];
+static int8_t ref_buf[PC_TEST_BUF_SIZE];
+static int8_t fused_buf[PC_TEST_BUF_SIZE];
+
+/* Full scale, out of range for Q23/Q27 and 32 bit extremes. */
+static const int32_t test_32[PC_TEST_SAMP_PER_CH] = { 0,
+                                                      1,
+                                                      -1,
+                                                      (1 << 23) - 1,
+                                                      -(1 << 23),
+                                                      (1 << 23),
+                                                      -(1 << 23) - 1,
+                                                      (1 << 27) - 1,
+                                                      -(1 << 27),
+                                                      (1 << 27),
+                                                      -(1 << 27) - 1,
+                                                      0x7FFFFFFF,
+                                                      (int32_t)0x80000000,
+                                                      0x12345678,
+                                                      -0x12345678,
+                                                      0x00FF8000 };
+
+static const int16_t test_16[PC_TEST_SAMP_PER_CH] = { 0,     1,     -1,     32767, -32768, 16384, -16384, 12345,
+                                                      -12345, 32766, -32767, 256,   -256,   1000,  -1000,  7 };
+
+/* Sets up buf as deinterleaved unpacked v2 (only first ch len) or as one interleaved buffer. */
+static void pc_test_setup_buf(capi_buf_t *buf_ptr,
+                              int8_t *    mem_ptr,
+                              uint32_t    num_ch,
+                              uint32_t    bytes_per_samp,
+                              bool_t      is_intlv,
+                              uint32_t    actual_len)
+{
+   memset(buf_ptr, 0, sizeof(capi_buf_t) * PC_TEST_MAX_CH);
+   if (is_intlv)
+   {
+      buf_ptr[0].data_ptr        = mem_ptr;
+      buf_ptr[0].max_data_len    = PC_TEST_BUF_SIZE;
+      buf_ptr[0].actual_data_len = actual_len;
+      return;
+   }
+
+   for (uint32_t ch = 0; ch < num_ch; ch++)
+   {
+      buf_ptr[ch].data_ptr     = mem_ptr + ch * PC_TEST_SAMP_PER_CH * bytes_per_samp;
+      buf_ptr[ch].max_data_len = PC_TEST_SAMP_PER_CH * bytes_per_samp;
+   }
+   buf_ptr[0].actual_data_len = actual_len;
+}
+
+/* Fills the input with the test vector, rotated per channel so that channels differ. */
+static void pc_test_fill_input(uint32_t num_ch, uint32_t word_size_in)
+{
+   uint32_t n = 0;
+   for (uint32_t ch = 0; ch < num_ch; ch++)
+   {
+      for (uint32_t s = 0; s < PC_TEST_SAMP_PER_CH; s++)
+      {
+         // same memory layout is used for both interleaved and deinterleaved inputs, only the meaning changes.
+         uint32_t idx = (s + ch) % PC_TEST_SAMP_PER_CH;
+         if (32 == word_size_in)
+         {
+            ((int32_t *)in_buf)[n++] = test_32[idx];
+         }
+         else
+         {
+            ((int16_t *)in_buf)[n++] = test_16[idx];
+         }
+      }
+   }
+}
+
+/* Byte morph stage as pc_byte_morph_process runs it for 16 <-> 32 bit. */
+static ar_result_t pc_test_byte_morph(capi_buf_t *in_ptr,
+                                      capi_buf_t *out_ptr,
+                                      uint32_t    num_ch,
+                                      bool_t      is_intlv,
+                                      uint16_t    word_size_in,
+                                      uint16_t    q_in,
+                                      uint16_t    q_out)
+{
+   if (is_intlv)
+   {
+      return (32 == word_size_in) ? pc_intlv_16_out(in_ptr, out_ptr, word_size_in, q_in)
+                                  : pc_intlv_32_out(in_ptr, out_ptr, word_size_in, q_in, q_out);
+   }
+   return (32 == word_size_in) ? pc_deintlv_unpacked_v2_16_out(in_ptr, out_ptr, num_ch, word_size_in, q_in)
+                               : pc_deintlv_unpacked_v2_32_out(in_ptr, out_ptr, num_ch, word_size_in, q_in, q_out);
+}
+
+/* Interleaving stage as pc_interleaving_process runs it. */
+static ar_result_t pc_test_interleave(capi_buf_t *in_ptr,
+                                      capi_buf_t *out_ptr,
+                                      uint32_t    num_ch,
+                                      bool_t      is_intlv_in,
+                                      uint16_t    word_size)
+{
+   if (is_intlv_in)
+   {
+      uint32_t bytes_per_samp  = word_size >> 3;
+      uint32_t num_samp_per_ch = in_ptr->actual_data_len / (num_ch * bytes_per_samp);
+      return spf_intlv_to_deintlv_unpacked_v2(in_ptr, out_ptr, num_ch, bytes_per_samp, num_samp_per_ch);
+   }
+   return spf_deintlv_to_intlv(in_ptr, out_ptr, num_ch, word_size);
+}
+
+static int pc_test_one(uint32_t num_ch,
+                       uint16_t word_size_in,
+                       uint16_t q_32,
+                       bool_t   is_intlv_in,
+                       bool_t   is_byte_morph_first)
+{
+   capi_buf_t  in[PC_TEST_MAX_CH], scratch[PC_TEST_MAX_CH], ref[PC_TEST_MAX_CH], fused[PC_TEST_MAX_CH];
+   uint16_t    word_size_out   = (32 == word_size_in) ? 16 : 32;
+   uint16_t    q_in            = (32 == word_size_in) ? q_32 : PCM_Q_FACTOR_15;
+   uint16_t    q_out           = (32 == word_size_in) ? PCM_Q_FACTOR_15 : q_32;
+   uint32_t    bytes_in        = word_size_in >> 3;
+   uint32_t    bytes_out       = word_size_out >> 3;
+   uint32_t    in_len          = (is_intlv_in ? num_ch : 1) * PC_TEST_SAMP_PER_CH * bytes_in;
+   uint32_t    out_bytes_total = num_ch * PC_TEST_SAMP_PER_CH * bytes_out;
+   ar_result_t result          = AR_EOK;
+
+   // the byte morph runs on the interleaved side if it runs first on interleaved input, or second on deinterleaved
+   bool_t is_intlv_byte_morph = (is_byte_morph_first == is_intlv_in);
+
+   pc_test_fill_input(num_ch, word_size_in);
+   memset(ref_buf, 0, sizeof(ref_buf));
+   memset(fused_buf, 0x5A, sizeof(fused_buf));
+
+   pc_test_setup_buf(in, in_buf, num_ch, bytes_in, is_intlv_in, in_len);
+   pc_test_setup_buf(ref, ref_buf, num_ch, bytes_out, !is_intlv_in, 0);
+   pc_test_setup_buf(fused, fused_buf, num_ch, bytes_out, !is_intlv_in, 0);
+
+   if (is_byte_morph_first)
+   {
+      pc_test_setup_buf(scratch, scratch_buf, num_ch, bytes_out, is_intlv_in, 0);
+      result |= pc_test_byte_morph(in, scratch, num_ch, is_intlv_in, word_size_in, q_in, q_out);
+      result |= pc_test_interleave(scratch, ref, num_ch, is_intlv_in, word_size_out);
+   }
+   else
+   {
+      pc_test_setup_buf(scratch, scratch_buf, num_ch, bytes_in, !is_intlv_in, 0);
+      result |= pc_test_interleave(in, scratch, num_ch, is_intlv_in, word_size_in);
+      result |= pc_test_byte_morph(scratch, ref, num_ch, !is_intlv_in, word_size_in, q_in, q_out);
+   }
+
+   result |= pc_intlv_deintlv_byte_morph(in,
+                                         fused,
+                                         num_ch,
+                                         word_size_in,
+                                         q_in,
+                                         q_out,
+                                         is_intlv_in,
+                                         is_intlv_byte_morph);
+
+   bool_t is_match = (AR_EOK == result) && (ref[0].actual_data_len == fused[0].actual_data_len) &&
+                     (0 == memcmp(ref_buf, fused_buf, out_bytes_total));
+
+   printf("%s ch %lu, %u bit Q%u -> %u bit Q%u, %s in, byte morph %s: %s\n",
+          is_match ? "PASS" : "FAIL",
+          (unsigned long)num_ch,
+          word_size_in,
+          q_in,
+          word_size_out,
+          q_out,
+          is_intlv_in ? "intlv" : "deintlv",
+          is_byte_morph_first ? "first" : "second",
+          is_match ? "bit exact" : "mismatch");
+
+   return is_match ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+   const uint32_t num_ch_list[] = { 1, 2, 8 };
+   const uint16_t q_32_list[]   = { PCM_Q_FACTOR_23, PCM_Q_FACTOR_27, PCM_Q_FACTOR_31 };
+   const uint16_t ws_in_list[]  = { 16, 32 };
+   int            num_failed    = 0;
+
+   for (uint32_t c = 0; c < sizeof(num_ch_list) / sizeof(num_ch_list[0]); c++)
+   {
+      for (uint32_t q = 0; q < sizeof(q_32_list) / sizeof(q_32_list[0]); q++)
+      {
+         for (uint32_t w = 0; w < sizeof(ws_in_list) / sizeof(ws_in_list[0]); w++)
+         {
+            for (uint32_t order = 0; order < 4; order++)
+            {
+               num_failed +=
+                  pc_test_one(num_ch_list[c], ws_in_list[w], q_32_list[q], (order & 1), ((order >> 1) & 1));
+            }
+         }
+      }
+   }
+
+   printf("%d case(s) failed\n", num_failed);
+   return num_failed;
+}
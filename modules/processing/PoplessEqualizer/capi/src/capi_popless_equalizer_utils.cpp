@@ -1278,6 +1278,13 @@ capi_err_t capi_p_eq_set_config(capi_p_eq_t *me_ptr, int8_t *param_payload_ptr,
       P_EQ_MSG(me_ptr->miid, DBG_HIGH_PRIO, "CAPI P_EQ: New Config Cached due to ongoing xfade");
       me_ptr->is_new_config_pending = 1;
    }
+   else if (CAPI_EOK == capi_p_eq_set_config_interpolated(me_ptr))
+   {
+      /* the current equalizers move to the new config by themselves,
+       * no second instance and crossfade is needed. */
+      capi_p_eq_update_headroom(me_ptr);
+      capi_p_eq_update_delay(me_ptr);
+   }
    else
    {
       capi_err_t capi_result = CAPI_EOK;
@@ -1292,6 +1299,31 @@ capi_err_t capi_p_eq_set_config(capi_p_eq_t *me_ptr, int8_t *param_payload_ptr,
    return CAPI_EOK;
 }
 
+/**
+ * Function to move the current equalizers to the new config by
+ * interpolating their coefficients. Costs a single instance per
+ * channel, unlike a crossfade to new equalizers.
+ */
+capi_err_t capi_p_eq_set_config_interpolated(capi_p_eq_t *me_ptr)
+{
+   EQ_RESULT lib_result = EQ_SUCCESS;
+
+   for (int32_t ch = 0; ch < (int)me_ptr->num_channels; ch++)
+   {
+      lib_result = eq_set_param(&(me_ptr->lib_instances[ch][CUR_INST]),
+                                EQ_PARAM_SET_CONFIG_INTERPOLATED,
+                                (int8 *)&(me_ptr->max_eq_cfg),
+                                (uint32)sizeof(me_ptr->max_eq_cfg));
+      if (EQ_SUCCESS != lib_result)
+      {
+         P_EQ_MSG(me_ptr->miid, DBG_HIGH_PRIO, "CAPI P_EQ: interpolated config not possible %d, using crossfade", lib_result);
+         return CAPI_EFAILED;
+      }
+   }
+   P_EQ_MSG(me_ptr->miid, DBG_HIGH_PRIO, "CAPI P_EQ: New config set and coeff interpolation started");
+   return CAPI_EOK;
+}
+
 void capi_p_eq_process_in_vol_ctrl(capi_p_eq_t *       me_ptr,
                                       capi_stream_data_t *input[],
                                       capi_stream_data_t *output[])
@@ -190,6 +190,9 @@ capi_err_t capi_p_eq_check_get_param(
 capi_err_t capi_p_eq_cross_fade_init(
         capi_p_eq_t *me_ptr);
 
+capi_err_t capi_p_eq_set_config_interpolated(
+        capi_p_eq_t *me_ptr);
+
 capi_err_t capi_p_eq_create_new_equalizers(
         capi_p_eq_t *me_ptr,
         EQ_INST inst_id);
@@ -253,6 +253,17 @@ typedef enum eq_mode_t
 // EQ is considered disable only when mode is disable and on/off crossfade is inactive
 // so during off-crossfade period, even though EQ mode is disable, this param ID will return enable
 #define EQ_PARAM_CHECK_STATE           (19)  // read only
+
+
+// set a new config on the running instance and move to it without crossfade
+// this ID uses eq_config_t as payload, same as EQ_PARAM_SET_CONFIG
+// 1. filter coeffs and pregain are interpolated from the current ones to the new ones in steps of
+//    EQ_COEFF_RAMP_BLOCK_SAMPLES samples over EQ_COEFF_RAMP_PERIOD_MSEC, filter memory is kept
+// 2. setting another config during the transition retargets it from the current interpolated coeffs
+// 3. must only be used when EQ is enabled and no crossfade is active on this instance
+#define EQ_PARAM_SET_CONFIG_INTERPOLATED           (20)  // write only
+#define EQ_COEFF_RAMP_BLOCK_SAMPLES                (32)
+#define EQ_COEFF_RAMP_PERIOD_MSEC                  (20)
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -44,6 +44,9 @@ extern const uint32 eq_audio_fx_band_freq_range[EQ_AUDIO_FX_BAND][2];
 
 
 EQ_RESULT eq_msiir_design(eq_lib_mem_t*  eq_lib_mem_ptr, eq_msiir_settings_t   *eq_msiir_settings_ptr);
+EQ_RESULT eq_msiir_config_apply(eq_lib_mem_t*  eq_lib_mem_ptr, eq_msiir_settings_t   *eq_msiir_settings_ptr, eq_logic_t interpolate);
+EQ_RESULT eq_coeff_ramp_apply_step(eq_lib_mem_t*  eq_lib_mem_ptr);
+EQ_RESULT eq_msiir_process(eq_lib_mem_t*  eq_lib_mem_ptr, int8 *out_ptr, int8 *in_ptr, uint32 sample_per_channel, uint32 byte_per_sample);
 void eq_headroom_req_compute(uint32 *headroom_needed_db, eq_band_internal_specs_t   *eq_band_internal_specs_ptr);
 /*----------------------------------------------------------------------------
  * Function Definitions
@@ -80,6 +83,9 @@ EQ_RESULT eq_get_mem_req(eq_lib_mem_requirements_t *eq_lib_mem_requirements_ptr,
     // static struct
     // internal band specs(compatible to internal library)
     // eq_config_t and external bands specs(compatible to upper layer)
+    // eq states
+    // designed coeffs cache
+    // coeff interpolation states
     // iir
     // cross fade
     // audio fx EQ freq ranges table
@@ -102,6 +108,12 @@ EQ_RESULT eq_get_mem_req(eq_lib_mem_requirements_t *eq_lib_mem_requirements_ptr,
     // eq states
     mem_req += ALIGN8(sizeof(eq_states_t));
 
+    // designed coeffs cache
+    mem_req += ALIGN8(sizeof(eq_coeff_cache_t));
+
+    // coeff interpolation states
+    mem_req += ALIGN8(sizeof(eq_coeff_ramp_t));
+
 
     // msiir
     msiir_static_vars.data_width = (int32)eq_static_struct_ptr->data_width;
@@ -225,6 +237,8 @@ EQ_RESULT eq_init_memory(eq_lib_t *eq_lib_ptr, eq_static_struct_t* eq_static_str
     // internal band specs(compatible to internal library)
     // eq_config_t and bands specs(API-interfacing)
     // eq states
+    // designed coeffs cache
+    // coeff interpolation states
     // msiir
     // cross fade
     // audio fx EQ freq ranges table
@@ -276,6 +290,16 @@ EQ_RESULT eq_init_memory(eq_lib_t *eq_lib_ptr, eq_static_struct_t* eq_static_str
     temp_ptr += ALIGN8(sizeof(eq_states_t));
 
 
+    // designed coeffs cache, all entries are empty after the mem clear
+    eq_lib_mem_ptr->eq_coeff_cache_ptr = (eq_coeff_cache_t*)temp_ptr;
+    temp_ptr += ALIGN8(sizeof(eq_coeff_cache_t));
+
+
+    // coeff interpolation states, no ramp in progress after the mem clear
+    eq_lib_mem_ptr->eq_coeff_ramp_ptr = (eq_coeff_ramp_t*)temp_ptr;
+    temp_ptr += ALIGN8(sizeof(eq_coeff_ramp_t));
+
+
     // init iir
     if (MSIIR_SUCCESS != msiir_init_mem(&eq_lib_mem_ptr->msiir_lib_mem, &msiir_static_vars, (void*)temp_ptr, msiir_mem_req.mem_size))
     {
@@ -295,6 +319,8 @@ EQ_RESULT eq_init_memory(eq_lib_t *eq_lib_ptr, eq_static_struct_t* eq_static_str
 
         return EQ_FAILURE;
     }
+    eq_lib_mem_ptr->eq_coeff_ramp_ptr->target = eq_msiir_settings;
+    eq_lib_mem_ptr->eq_coeff_ramp_ptr->target_pregain = eq_lib_mem_ptr->eq_config_ptr->eq_pregain;
     temp_ptr += msiir_mem_req.mem_size;
 
 
@@ -860,12 +886,19 @@ EQ_RESULT eq_set_param(eq_lib_t* eq_lib_ptr, uint32 param_id, int8* mem_ptr, uin
             }
             break;
         case EQ_PARAM_SET_CONFIG:
+        case EQ_PARAM_SET_CONFIG_INTERPOLATED:
+
+            // interpolation runs on the output of this instance, it can't overlap an on/off crossfade
+            if (param_id == EQ_PARAM_SET_CONFIG_INTERPOLATED  &&  (eq_lib_mem_ptr->eq_mode != EQ_ENABLE || eq_lib_mem_ptr->eq_on_off_crossfade_mode == EQ_TRUE))
+            {
+                return EQ_FAILURE;
+            }
 
             if(mem_size >= (sizeof(uint32)+sizeof(int32)+sizeof(eq_settings_t))  &&  mem_size <= ALIGN8(sizeof(eq_config_t) + EQ_MAX_BANDS*sizeof(eq_band_specs_t)))
             {
                 eq_config_t *eq_config_ptr = (eq_config_t*)mem_ptr;
                 eq_msiir_settings_t   eq_msiir_settings;
-                uint32 band, coeff_size;
+                uint32 band;
 
                 eq_band_specs_t *eq_band_specs_lib_ptr = (eq_band_specs_t*)(eq_lib_mem_ptr->eq_config_ptr+1);
 
@@ -1016,24 +1049,9 @@ EQ_RESULT eq_set_param(eq_lib_t* eq_lib_ptr, uint32 param_id, int8* mem_ptr, uin
                         return EQ_FAILURE;
                     }
 
-                    // configure msiir pre-gain
-                    if(msiir_set_param(&eq_lib_mem_ptr->msiir_lib_mem, MSIIR_PARAM_PREGAIN, (void*)&eq_lib_mem_ptr->eq_config_ptr->eq_pregain, sizeof(msiir_pregain_t)) != MSIIR_SUCCESS)
+                    // design msiir coeffs, then set them up with msiir pre-gain
+                    if(eq_msiir_config_apply(eq_lib_mem_ptr, &eq_msiir_settings, (param_id == EQ_PARAM_SET_CONFIG_INTERPOLATED) ? EQ_TRUE : EQ_FALSE) != EQ_SUCCESS)
                     {
-
-                        return EQ_FAILURE;
-                    }
-
-                    // design msiir coeffs
-                    if(eq_msiir_design(eq_lib_mem_ptr, &eq_msiir_settings) != EQ_SUCCESS)
-                    {
-                        return EQ_FAILURE;
-                    }
-
-                    // set up msiir coeffs
-                    coeff_size = sizeof(msiir_config_t) + eq_msiir_settings.msiir_config.num_stages * sizeof(msiir_coeffs_t);
-                    if(msiir_set_param(&eq_lib_mem_ptr->msiir_lib_mem, MSIIR_PARAM_CONFIG, (void*)&eq_msiir_settings, coeff_size) != MSIIR_SUCCESS)
-                    {
-
                         return EQ_FAILURE;
                     }
 
@@ -1083,25 +1101,9 @@ EQ_RESULT eq_set_param(eq_lib_t* eq_lib_ptr, uint32 param_id, int8* mem_ptr, uin
                     }
 
 
-                    // configure msiir pre-gain
-                    if(msiir_set_param(&eq_lib_mem_ptr->msiir_lib_mem, MSIIR_PARAM_PREGAIN, (void*)&eq_lib_mem_ptr->eq_config_ptr->eq_pregain, sizeof(msiir_pregain_t)) != MSIIR_SUCCESS)
+                    // design msiir coeffs, then set them up with msiir pre-gain
+                    if(eq_msiir_config_apply(eq_lib_mem_ptr, &eq_msiir_settings, (param_id == EQ_PARAM_SET_CONFIG_INTERPOLATED) ? EQ_TRUE : EQ_FALSE) != EQ_SUCCESS)
                     {
-
-                        return EQ_FAILURE;
-                    }
-
-
-                    // design msiir coeffs
-                    if(eq_msiir_design(eq_lib_mem_ptr, &eq_msiir_settings) != EQ_SUCCESS)
-                    {
-                        return EQ_FAILURE;
-                    }
-
-                    // set up msiir coeffs
-                    coeff_size = sizeof(msiir_config_t) + eq_msiir_settings.msiir_config.num_stages * sizeof(msiir_coeffs_t);
-                    if(msiir_set_param(&eq_lib_mem_ptr->msiir_lib_mem, MSIIR_PARAM_CONFIG, (void*)&eq_msiir_settings, coeff_size) != MSIIR_SUCCESS)
-                    {
-
                         return EQ_FAILURE;
                     }
 
@@ -1220,7 +1222,7 @@ EQ_RESULT eq_process(eq_lib_t *eq_lib_ptr[TOTAL_INST], int8 *out_ptr, int8 *in_p
     else{ // do EQ
 
         // do processing for existing EQ effects
-        if (msiir_process_v2(&eq_cur_lib_mem_ptr->msiir_lib_mem, (void*)out_ptr, (void*)in_ptr, sample_per_channel) != MSIIR_SUCCESS)
+        if (eq_msiir_process(eq_cur_lib_mem_ptr, out_ptr, in_ptr, sample_per_channel, byte_per_sample) != EQ_SUCCESS)
         {
             return EQ_FAILURE;
         }
@@ -1317,13 +1319,77 @@ EQ_RESULT eq_process(eq_lib_t *eq_lib_ptr[TOTAL_INST], int8 *out_ptr, int8 *in_p
 
 
 
+// look up coeffs designed earlier for the same sample rate and band specs
+static eq_coeff_cache_entry_t* eq_coeff_cache_find(eq_coeff_cache_t *eq_coeff_cache_ptr, uint32 sample_rate, uint32 num_bands, eq_band_internal_specs_t *band_specs_ptr)
+{
+    uint32 i;
+
+    if (num_bands > EQ_MAX_BANDS)
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < EQ_COEFF_CACHE_ENTRIES; i++)
+    {
+        eq_coeff_cache_entry_t *entry_ptr = &eq_coeff_cache_ptr->entries[i];
+
+        if (entry_ptr->last_used != 0  &&  entry_ptr->sample_rate == sample_rate  &&  entry_ptr->num_bands == num_bands  &&
+            memcmp(entry_ptr->band_specs, band_specs_ptr, num_bands*sizeof(eq_band_internal_specs_t)) == 0)
+        {
+            return entry_ptr;
+        }
+    }
+    return NULL;
+}
+
+
+
+// store designed coeffs, replacing the least recently used entry
+static void eq_coeff_cache_store(eq_coeff_cache_t *eq_coeff_cache_ptr, uint32 sample_rate, uint32 num_bands, eq_band_internal_specs_t *band_specs_ptr, eq_msiir_settings_t *eq_msiir_settings_ptr)
+{
+    eq_coeff_cache_entry_t *entry_ptr = &eq_coeff_cache_ptr->entries[0];
+    uint32 i;
+
+    if (num_bands > EQ_MAX_BANDS)
+    {
+        return;
+    }
+
+    for (i = 1; i < EQ_COEFF_CACHE_ENTRIES; i++)
+    {
+        if (eq_coeff_cache_ptr->entries[i].last_used < entry_ptr->last_used)
+        {
+            entry_ptr = &eq_coeff_cache_ptr->entries[i];
+        }
+    }
+
+    entry_ptr->sample_rate = sample_rate;
+    entry_ptr->num_bands = num_bands;
+    memscpy((void*)entry_ptr->band_specs, sizeof(entry_ptr->band_specs), (const void*)band_specs_ptr, num_bands*sizeof(eq_band_internal_specs_t));
+    entry_ptr->msiir_settings = *eq_msiir_settings_ptr;
+    entry_ptr->last_used = ++eq_coeff_cache_ptr->use_count;
+}
+
+
+
 // design msiir coeffs and re-format to the way required by msiir lib
 EQ_RESULT eq_msiir_design(eq_lib_mem_t*  eq_lib_mem_ptr, eq_msiir_settings_t   *eq_msiir_settings_ptr)
 {
     EQFilterDesign_t  EQFilterDesign;
+    eq_coeff_cache_entry_t *cache_entry_ptr;
     uint32  band, i;
 
 
+    // filter design is costly and UIs sweeping a knob keep coming back to the same settings, reuse earlier designs
+    cache_entry_ptr = eq_coeff_cache_find(eq_lib_mem_ptr->eq_coeff_cache_ptr, eq_lib_mem_ptr->eq_static_struct_ptr->sample_rate,
+                                          eq_lib_mem_ptr->eq_config_ptr->num_bands, eq_lib_mem_ptr->eq_band_internal_specs_ptr);
+    if (cache_entry_ptr != NULL)
+    {
+        *eq_msiir_settings_ptr = cache_entry_ptr->msiir_settings;
+        cache_entry_ptr->last_used = ++eq_lib_mem_ptr->eq_coeff_cache_ptr->use_count;
+        return EQ_SUCCESS;
+    }
+
     // init output of ProcessEQFD(filter coeffs, shift factor) to zeros to remove false positive KW warnings
     memset(EQFilterDesign.piFilterCoeff, 0, EQ_MAX_BANDS*(MSIIR_NUM_COEFFS + MSIIR_DEN_COEFFS));
     memset(EQFilterDesign.piNumShiftFactor, 0, EQ_MAX_BANDS);
@@ -1353,9 +1419,214 @@ EQ_RESULT eq_msiir_design(eq_lib_mem_t*  eq_lib_mem_ptr, eq_msiir_settings_t   *
 
     }
 
+    eq_coeff_cache_store(eq_lib_mem_ptr->eq_coeff_cache_ptr, eq_lib_mem_ptr->eq_static_struct_ptr->sample_rate,
+                         eq_lib_mem_ptr->eq_config_ptr->num_bands, eq_lib_mem_ptr->eq_band_internal_specs_ptr, eq_msiir_settings_ptr);
+
+    return EQ_SUCCESS;
+
+}
+
+
+
+// fraction of the ramp done after the given step, in Q30
+static int32 eq_coeff_ramp_fraction(uint32 step, uint32 num_steps)
+{
+    return (int32)(((int64)step << 30) / (int64)num_steps);
+}
+
+
+
+// value at fraction_q30 of the way from start to target
+static int32 eq_interpolate_s32(int32 start, int32 target, int32 fraction_q30)
+{
+    return start + (int32)((((int64)target - (int64)start) * (int64)fraction_q30) >> 30);
+}
+
+
+
+// design msiir coeffs for the current config and set them up with msiir pre-gain
+// coeffs are either set at once, or are ramped to on this instance from the ones in use
+EQ_RESULT eq_msiir_config_apply(eq_lib_mem_t*  eq_lib_mem_ptr, eq_msiir_settings_t   *eq_msiir_settings_ptr, eq_logic_t interpolate)
+{
+    eq_coeff_ramp_t *ramp_ptr = eq_lib_mem_ptr->eq_coeff_ramp_ptr;
+    uint32 coeff_size, ramp_samples;
+
+
+    // design msiir coeffs
+    if(eq_msiir_design(eq_lib_mem_ptr, eq_msiir_settings_ptr) != EQ_SUCCESS)
+    {
+        return EQ_FAILURE;
+    }
+
+    if (interpolate == EQ_FALSE)
+    {
+        // configure msiir pre-gain
+        if(msiir_set_param(&eq_lib_mem_ptr->msiir_lib_mem, MSIIR_PARAM_PREGAIN, (void*)&eq_lib_mem_ptr->eq_config_ptr->eq_pregain, sizeof(msiir_pregain_t)) != MSIIR_SUCCESS)
+        {
+            return EQ_FAILURE;
+        }
+
+        // set up msiir coeffs
+        coeff_size = sizeof(msiir_config_t) + eq_msiir_settings_ptr->msiir_config.num_stages * sizeof(msiir_coeffs_t);
+        if(msiir_set_param(&eq_lib_mem_ptr->msiir_lib_mem, MSIIR_PARAM_CONFIG, (void*)eq_msiir_settings_ptr, coeff_size) != MSIIR_SUCCESS)
+        {
+            return EQ_FAILURE;
+        }
+
+        // a ramp in progress is dropped, the new coeffs are in use already
+        ramp_ptr->num_steps = 0;
+    }
+    else
+    {
+        // the ramp starts from the coeffs in use: the current step's ones if a ramp is in progress, else the last designed ones
+        // if a ramp is set but no step has been taken yet, its start coeffs are still the ones in use
+        if (ramp_ptr->num_steps > 0  &&  ramp_ptr->step > 0)
+        {
+            ramp_ptr->start_pregain = eq_interpolate_s32(ramp_ptr->start_pregain, ramp_ptr->target_pregain, eq_coeff_ramp_fraction(ramp_ptr->step, ramp_ptr->num_steps));
+            ramp_ptr->start = ramp_ptr->step_coeffs;
+        }
+        else if (ramp_ptr->num_steps == 0)
+        {
+            ramp_ptr->start_pregain = ramp_ptr->target_pregain;
+            ramp_ptr->start = ramp_ptr->target;
+        }
+
+        ramp_samples = eq_lib_mem_ptr->eq_static_struct_ptr->sample_rate * EQ_COEFF_RAMP_PERIOD_MSEC / 1000;
+        ramp_ptr->num_steps = (ramp_samples + EQ_COEFF_RAMP_BLOCK_SAMPLES - 1) / EQ_COEFF_RAMP_BLOCK_SAMPLES;
+        if (ramp_ptr->num_steps == 0)
+        {
+            ramp_ptr->num_steps = 1;
+        }
+        ramp_ptr->step = 0;
+        ramp_ptr->samples_left = 0;
+    }
+
+    ramp_ptr->target = *eq_msiir_settings_ptr;
+    ramp_ptr->target_pregain = eq_lib_mem_ptr->eq_config_ptr->eq_pregain;
+
+    return EQ_SUCCESS;
+}
+
+
+
+// move the coeff ramp to its next step and set up msiir with the coeffs of that step
+// 1. stages missing on either side of the ramp are taken as unity pass-through stages
+// 2. numerators are interpolated in the Q format of the larger of the two shift factors
+// 3. denominators are interpolated directly: the stable region of (a1, a2) is a triangle,
+//    so every point between two stable biquads is stable as well
+// 4. the last step lands exactly on the designed coeffs
+EQ_RESULT eq_coeff_ramp_apply_step(eq_lib_mem_t*  eq_lib_mem_ptr)
+{
+    eq_coeff_ramp_t *ramp_ptr = eq_lib_mem_ptr->eq_coeff_ramp_ptr;
+    eq_msiir_settings_t *step_ptr = &ramp_ptr->step_coeffs;
+    eq_msiir_coeffs_t unity_stage;
+    const eq_msiir_coeffs_t *start_stage_ptr, *target_stage_ptr;
+    int32 stage, i, num_stages, shift_factor, start_coeff, target_coeff, fraction_q30;
+    msiir_pregain_t pregain;
+    uint32 coeff_size;
+
+
+    ramp_ptr->step++;
+    if (ramp_ptr->step >= ramp_ptr->num_steps)
+    {
+        *step_ptr = ramp_ptr->target;
+        pregain = ramp_ptr->target_pregain;
+    }
+    else
+    {
+        memset(&unity_stage, 0, sizeof(unity_stage));
+        unity_stage.iir_coeffs[0] = EQ_UNITY_NUM_COEFF;
+        unity_stage.shift_factor = EQ_UNITY_SHIFT_FACTOR;
+
+        fraction_q30 = eq_coeff_ramp_fraction(ramp_ptr->step, ramp_ptr->num_steps);
+        num_stages = s32_max_s32_s32(ramp_ptr->start.msiir_config.num_stages, ramp_ptr->target.msiir_config.num_stages);
+
+        for (stage = 0; stage < num_stages; stage++)
+        {
+            start_stage_ptr = (stage < ramp_ptr->start.msiir_config.num_stages) ? &ramp_ptr->start.msiir_coeffs[stage] : &unity_stage;
+            target_stage_ptr = (stage < ramp_ptr->target.msiir_config.num_stages) ? &ramp_ptr->target.msiir_coeffs[stage] : &unity_stage;
+            shift_factor = s32_max_s32_s32(start_stage_ptr->shift_factor, target_stage_ptr->shift_factor);
+
+            for (i = 0; i < MSIIR_COEFF_LENGTH; i++)
+            {
+                start_coeff = start_stage_ptr->iir_coeffs[i];
+                target_coeff = target_stage_ptr->iir_coeffs[i];
+                if (i < MSIIR_NUM_COEFFS)
+                {
+                    start_coeff = start_coeff >> (shift_factor - start_stage_ptr->shift_factor);
+                    target_coeff = target_coeff >> (shift_factor - target_stage_ptr->shift_factor);
+                }
+                step_ptr->msiir_coeffs[stage].iir_coeffs[i] = eq_interpolate_s32(start_coeff, target_coeff, fraction_q30);
+            }
+            step_ptr->msiir_coeffs[stage].shift_factor = shift_factor;
+        }
+        step_ptr->msiir_config.num_stages = num_stages;
+        pregain = eq_interpolate_s32(ramp_ptr->start_pregain, ramp_ptr->target_pregain, fraction_q30);
+    }
+
+    if(msiir_set_param(&eq_lib_mem_ptr->msiir_lib_mem, MSIIR_PARAM_PREGAIN, (void*)&pregain, sizeof(msiir_pregain_t)) != MSIIR_SUCCESS)
+    {
+        return EQ_FAILURE;
+    }
+
+    // filter memory must be kept across steps, otherwise every step clicks
+    coeff_size = sizeof(msiir_config_t) + step_ptr->msiir_config.num_stages * sizeof(msiir_coeffs_t);
+    if(msiir_set_param(&eq_lib_mem_ptr->msiir_lib_mem, MSIIR_PARAM_CONFIG_KEEP_STATE, (void*)step_ptr, coeff_size) != MSIIR_SUCCESS)
+    {
+        return EQ_FAILURE;
+    }
 
     return EQ_SUCCESS;
+}
+
+
+
+// msiir processing of one instance, split in EQ_COEFF_RAMP_BLOCK_SAMPLES blocks while a coeff ramp is in progress
+EQ_RESULT eq_msiir_process(eq_lib_mem_t*  eq_lib_mem_ptr, int8 *out_ptr, int8 *in_ptr, uint32 sample_per_channel, uint32 byte_per_sample)
+{
+    eq_coeff_ramp_t *ramp_ptr = eq_lib_mem_ptr->eq_coeff_ramp_ptr;
+    uint32 block_samples;
+
+
+    while (ramp_ptr->num_steps > 0  &&  sample_per_channel > 0)
+    {
+        if (ramp_ptr->samples_left == 0)
+        {
+            if (eq_coeff_ramp_apply_step(eq_lib_mem_ptr) != EQ_SUCCESS)
+            {
+                return EQ_FAILURE;
+            }
 
+            if (ramp_ptr->step >= ramp_ptr->num_steps)
+            {
+                // designed coeffs are in use, rest is processed as a whole
+                ramp_ptr->num_steps = 0;
+                break;
+            }
+            ramp_ptr->samples_left = EQ_COEFF_RAMP_BLOCK_SAMPLES;
+        }
+
+        block_samples = (sample_per_channel < ramp_ptr->samples_left) ? sample_per_channel : ramp_ptr->samples_left;
+        if (msiir_process_v2(&eq_lib_mem_ptr->msiir_lib_mem, (void*)out_ptr, (void*)in_ptr, block_samples) != MSIIR_SUCCESS)
+        {
+            return EQ_FAILURE;
+        }
+
+        out_ptr += block_samples*byte_per_sample;
+        in_ptr += block_samples*byte_per_sample;
+        sample_per_channel -= block_samples;
+        ramp_ptr->samples_left -= block_samples;
+    }
+
+    if (sample_per_channel > 0)
+    {
+        if (msiir_process_v2(&eq_lib_mem_ptr->msiir_lib_mem, (void*)out_ptr, (void*)in_ptr, sample_per_channel) != MSIIR_SUCCESS)
+        {
+            return EQ_FAILURE;
+        }
+    }
+
+    return EQ_SUCCESS;
 }
 
 
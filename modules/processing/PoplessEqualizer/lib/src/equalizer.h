@@ -24,7 +24,7 @@ extern "C" {
 #endif /* __cplusplus */
 
 
-#define EQ_LIB_VER   (0x01000202)   // lib version : 1.2.2
+#define EQ_LIB_VER   (0x01000300)   // lib version : 1.3.0
                                        // (major.minor.bug) (8.16.8 bits)
 
 static const uint32 eq_max_stack_size = 1050;   // worst case stack mem in bytes
@@ -77,6 +77,41 @@ typedef enum eq_logic_t{
 }eq_logic_t;
 
 
+#define EQ_COEFF_CACHE_ENTRIES   (4)            // designed coeffs kept per instance
+#define EQ_UNITY_NUM_COEFF       (1 << 30)      // b0 = 1.0 with EQ_UNITY_SHIFT_FACTOR
+#define EQ_UNITY_SHIFT_FACTOR    (2)
+
+// designed coeffs cache entry, keyed by sample rate and internal band specs
+typedef struct eq_coeff_cache_entry_t
+{
+	uint32						sample_rate;
+	uint32						num_bands;
+	eq_band_internal_specs_t	band_specs[EQ_MAX_BANDS];
+	eq_msiir_settings_t			msiir_settings;
+	uint32						last_used;          // 0 means entry is empty
+} eq_coeff_cache_entry_t;
+
+// designed coeffs cache
+typedef struct eq_coeff_cache_t
+{
+	eq_coeff_cache_entry_t	entries[EQ_COEFF_CACHE_ENTRIES];
+	uint32					use_count;
+} eq_coeff_cache_t;
+
+// coeff interpolation between two designed configs on a single instance
+typedef struct eq_coeff_ramp_t
+{
+	eq_msiir_settings_t		start;              // coeffs when the ramp started
+	eq_msiir_settings_t		target;             // coeffs to converge to; also the coeffs in use when no ramp
+	eq_msiir_settings_t		step_coeffs;        // scratch for the coeffs of the current step
+	int32					start_pregain;
+	int32					target_pregain;
+	uint32					num_steps;          // 0 means no ramp in progress
+	uint32					step;               // current step, 1 ~ num_steps
+	uint32					samples_left;       // samples left in the current step
+} eq_coeff_ramp_t;
+
+
 // EQ lib mem structure
 typedef struct eq_lib_mem_t 
 {
@@ -86,6 +121,8 @@ typedef struct eq_lib_mem_t
 	uint32					eq_band_internal_specs_size;
 	eq_config_t				*eq_config_ptr;
 	eq_states_t				*eq_states_ptr;
+	eq_coeff_cache_t		*eq_coeff_cache_ptr;
+	eq_coeff_ramp_t			*eq_coeff_ramp_ptr;
 	msiir_lib_t             msiir_lib_mem;     
     cross_fade_lib_t        cross_fade_lib_mem;
 	uint32*					eq_audio_fx_freq_ranges_table_ptr;
@@ -46,6 +46,15 @@ typedef struct msiir_config_t {        //
 
 #define MSIIR_PARAM_RESET        (3)   // ** param: reset filter memory
                                        //    access: set only
+
+#define MSIIR_PARAM_CONFIG_KEEP_STATE (4) // ** param: stages, coeffs & shift
+                                       //    payload same as MSIIR_PARAM_CONFIG
+                                       //    filter memory is kept (re-scaled
+                                       //    if a stage's shift changes), only
+                                       //    stages newly put in use start from
+                                       //    zero. For small per-block coeff
+                                       //    steps, e.g. coeff interpolation
+                                       //    access: set only
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
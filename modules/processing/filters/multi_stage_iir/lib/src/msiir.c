@@ -43,6 +43,12 @@ static void set_default(mult_stage_iir_t *obj_ptr)
    // by using parameter id MSIIR_PARAM_CONFIG
 }
 
+/* stage states are kept in Q(x - max(shift_factor, MSIIR_DEN_SHIFT)) */
+static int32 state_shift(int32 shift_factor)
+{
+   return (shift_factor > MSIIR_DEN_SHIFT) ? shift_factor : MSIIR_DEN_SHIFT;
+}
+
 /* process for 16 bit data */
 static MSIIR_RESULT process_16(mult_stage_iir_t *obj_ptr, int16 *out_ptr, int16 *in_ptr, int32 samples)
 {
@@ -207,7 +213,8 @@ MSIIR_RESULT msiir_set_param(msiir_lib_t* lib_ptr, uint32 param_id, void* param_
    mult_stage_iir_t *obj_ptr = (mult_stage_iir_t *)lib_ptr->mem_ptr;
    msiir_coeffs_t *coeffs_ptr;
    msiir_config_t *cfg_ptr;
-   int32 i, j, reset_flag;
+   int32 i, j, reset_flag, shift_diff;
+   iir_data_t *sos_ptr;
 
    switch (param_id) {
    case MSIIR_PARAM_PREGAIN:
@@ -250,6 +257,40 @@ MSIIR_RESULT msiir_set_param(msiir_lib_t* lib_ptr, uint32 param_id, void* param_
       }
       break;
 
+   case MSIIR_PARAM_CONFIG_KEEP_STATE:
+      cfg_ptr = (msiir_config_t *)param_ptr;
+      if (cfg_ptr->num_stages < 0 || cfg_ptr->num_stages > obj_ptr->static_vars.max_stages) {
+         return MSIIR_FAILURE; // invalid num stages must be within [0, max]
+      }
+      if (param_size != sizeof(msiir_config_t) + cfg_ptr->num_stages * sizeof(msiir_coeffs_t)) {
+         return MSIIR_MEMERROR;
+      }
+      coeffs_ptr = (msiir_coeffs_t *)((char*)cfg_ptr + sizeof(msiir_config_t));
+
+      for (i = 0; i < cfg_ptr->num_stages; ++i) {
+         sos_ptr = &obj_ptr->sos[i];
+         if (i >= obj_ptr->num_stages) {
+            // stage was not in use, its memory may be stale
+            for (j = 0; j < MSIIR_FILTER_STATES; ++j) {
+               sos_ptr->states[j] = 0;
+            }
+         } else {
+            // keep the memory in the Q format of the new shift factor
+            shift_diff = state_shift(sos_ptr->shift_factor) - state_shift((coeffs_ptr+i)->shift_factor);
+            if (0 != shift_diff) {
+               for (j = 0; j < MSIIR_FILTER_STATES; ++j) {
+                  sos_ptr->states[j] = s64_shl_s64(sos_ptr->states[j], (int16)shift_diff);
+               }
+            }
+         }
+         for (j = 0; j < MSIIR_COEFF_LENGTH; ++j) {
+            sos_ptr->coeffs[j] = (coeffs_ptr+i)->iir_coeffs[j];
+         }
+         sos_ptr->shift_factor = (coeffs_ptr+i)->shift_factor;
+      }
+      obj_ptr->num_stages = cfg_ptr->num_stages;
+      break;
+
    case MSIIR_PARAM_RESET:
       reset(obj_ptr);
       break;
@@ -184,6 +184,50 @@ int32 search_global_peak(int32 *history_peak_buf, int32 num_history_peaks)
 }
 
 #ifndef LIM_ASM
+/*----------------------------------------------------------------------------
+Returns the peak absolute value of a block of samples. Kept branch-free so
+that the compiler can vectorize it.
+----------------------------------------------------------------------------*/
+static int32 block_peak(const int32 *buf_ptr, int32 samples)
+{
+   int32 peak = 0;
+   int32 i;
+
+   for (i = 0; i < samples; i++)
+   {
+      peak = s32_max_s32_s32(peak, (int32)u32_abs_s32_sat(buf_ptr[i]));
+   }
+   return peak;
+}
+
+/*----------------------------------------------------------------------------
+Applies a constant Q27 gain followed by hard-limiting, with the same
+arithmetic as the per-sample loop. When dly_buf is not NULL the gain is
+applied on the delayed samples and the delay line is refilled with the input.
+----------------------------------------------------------------------------*/
+static void apply_const_gain(int32 *scratch32, int32 *dly_buf, int32 gain_q27, int32 hard_thresh, int32 samples)
+{
+   int32 i, inpL32, outL32;
+
+   for (i = 0; i < samples; i++)
+   {
+      inpL32 = scratch32[i];
+      outL32 = (NULL != dly_buf) ? dly_buf[i] : inpL32;
+      outL32 = s32_saturate_s64(s64_shl_s64(s64_add_s64_s64(s64_mult_s32_s32(outL32, gain_q27), 0x4000000), -27));
+
+      if (outL32 > hard_thresh || outL32 < -hard_thresh)
+      {
+         outL32 = outL32 > 0 ? hard_thresh : -hard_thresh;
+      }
+      scratch32[i] = outL32;
+
+      if (NULL != dly_buf)
+      {
+         dly_buf[i] = inpL32;
+      }
+   }
+}
+
 /*----------------------------------------------------------------------------
 Apply gain smoothing logic to smooth the gain, so that the gain will achieve
 the target gain within pre-defined time constant.
@@ -202,7 +246,8 @@ static void process_with_history_peak(limiter_per_ch_t *per_ch_ptr,
                                       int32             samples,
                                       int32             q_factor)
 {
-   int32  j, gp_change_flag = 0;
+   int32  j, blk_end, blk_samples, gp_change_flag = 0;
+   int32  blk_peak, dly_peak;
    int64  accu64;
    int32  inpL32, attn32, absL32, iq32 /*, prod32*/;
    int32  cur_idx, peak_subbuf_idx, prev_peak_idx, max_wait_smps_m1;
@@ -225,138 +270,183 @@ static void process_with_history_peak(limiter_per_ch_t *per_ch_ptr,
    target_gain_q27 = per_ch_ptr->target_gain_q27;
    gain_q27        = per_ch_ptr->gain_q27;
 
-   for (j = 0; j < samples; ++j)
+   j = 0;
+   while (j < samples)
    {
-
-      // Extract and store the current input data
-      inpL32 = scratch32[j];
-
-      // Compute the absolute magnitude of the input
-      absL32 = (int32)u32_abs_s32_sat(inpL32);
-
-      // Compute the local maxima in the input audio
-      local_max_peak = s32_max_s32_s32(local_max_peak, absL32);
+      blk_end = j + s32_min_s32_s32(samples - j, c_steady_blk_size);
 
       /************************************************************************
-      Compute the global maxima - start
+      Steady state: when the gain has settled and no sample of the block can
+      raise the global peak, the gain stays constant over the block as long as
+      it does not cross a peak sub-buffer or delay line boundary.
        *************************************************************************/
-      gp_change_flag = 0;
-      if (global_peak < local_max_peak)
+      if ((gain_q27 == target_gain_q27) && (local_max_peak <= global_peak))
       {
-         global_peak    = local_max_peak;
-         gp_change_flag = 1;
-      }
+         blk_samples = s32_min_s32_s32(blk_end - j, max_wait_smps_m1 - peak_subbuf_idx);
+         if (dly_smps_m1 >= 0)
+         {
+            blk_samples = s32_min_s32_s32(blk_samples, dly_smps_m1 + 1 - cur_idx);
+         }
 
-      peak_subbuf_idx++;
+         if (blk_samples > 0)
+         {
+            blk_peak = block_peak(&scratch32[j], blk_samples);
+            dly_peak = (dly_smps_m1 >= 0) ? block_peak(&per_ch_ptr->delay_buf[cur_idx], blk_samples)
+                                          : (int32)u32_abs_s32_sat(per_ch_ptr->delay_buf[cur_idx]);
 
-      // If the 'max_wait_smps_m1' samples' local maxima is computed, store the
-      // value into the peak history buffer, and re-compute the global peak
-      if (peak_subbuf_idx > max_wait_smps_m1)
-      {
-         per_ch_ptr->history_peak_buf[prev_peak_idx] = local_max_peak;
-         prev_peak_idx                               = s32_modwrap_s32_u32(prev_peak_idx + 1, c_local_peak_bufsize);
-         local_max_peak                              = 0;
-         peak_subbuf_idx                             = 0;
+            if ((blk_peak <= global_peak) && (dly_peak <= global_peak))
+            {
+               local_max_peak = s32_max_s32_s32(local_max_peak, blk_peak);
+               peak_subbuf_idx += blk_samples;
 
-         new_global_peak = search_global_peak(per_ch_ptr->history_peak_buf, c_local_peak_bufsize);
-         if (global_peak != new_global_peak)
-         {
-            global_peak    = new_global_peak;
-            gp_change_flag = 1;
+               apply_const_gain(&scratch32[j],
+                                (dly_smps_m1 >= 0) ? &per_ch_ptr->delay_buf[cur_idx] : NULL,
+                                gain_q27,
+                                hard_thresh,
+                                blk_samples);
+
+               if (dly_smps_m1 >= 0)
+               {
+                  cur_idx = s32_modwrap_s32_u32(cur_idx + blk_samples, dly_smps_m1 + 1);
+               }
+               j += blk_samples;
+               continue;
+            }
          }
       }
 
-      // When the user wrongly set history window length < delay, this case will happen
-      // Set global peak = abs(current sample) to avoid overshoot
-      if ((int32)u32_abs_s32_sat(per_ch_ptr->delay_buf[cur_idx]) > global_peak)
+      for (; j < blk_end; ++j)
       {
-         global_peak    = (int32)u32_abs_s32_sat(per_ch_ptr->delay_buf[cur_idx]);
-         gp_change_flag = 1;
-      }
+         // Extract and store the current input data
+         inpL32 = scratch32[j];
 
-      if (gp_change_flag == 1)
-      {
-         if (global_peak > threshold)
-         {
-            // Use Q6 DSP's linear approximation division routine to lower down the MIPS
-            // The inverse is computed with a normalized shift factor
-            accu64 = dsplib_approx_divide(threshold, global_peak);
-            attn32 = (int32)accu64;         // Extract the normalized inverse
-            iq32   = (int32)(accu64 >> 32); // Extract the normalization shift factor
+         // Compute the absolute magnitude of the input
+         absL32 = (int32)u32_abs_s32_sat(inpL32);
+
+         // Compute the local maxima in the input audio
+         local_max_peak = s32_max_s32_s32(local_max_peak, absL32);
 
-            // Shift the result to get the quotient in desired Q27 format
-            target_gain_q27 = s32_shl_s32_sat(attn32, (int16)iq32 + 27);
+         /************************************************************************
+         Compute the global maxima - start
+          *************************************************************************/
+         gp_change_flag = 0;
+         if (global_peak < local_max_peak)
+         {
+            global_peak    = local_max_peak;
+            gp_change_flag = 1;
          }
-         else
+
+         peak_subbuf_idx++;
+
+         // If the 'max_wait_smps_m1' samples' local maxima is computed, store the
+         // value into the peak history buffer, and re-compute the global peak
+         if (peak_subbuf_idx > max_wait_smps_m1)
          {
-            target_gain_q27 = c_gain_unity;
+            per_ch_ptr->history_peak_buf[prev_peak_idx] = local_max_peak;
+            prev_peak_idx                               = s32_modwrap_s32_u32(prev_peak_idx + 1, c_local_peak_bufsize);
+            local_max_peak                              = 0;
+            peak_subbuf_idx                             = 0;
+
+            new_global_peak = search_global_peak(per_ch_ptr->history_peak_buf, c_local_peak_bufsize);
+            if (global_peak != new_global_peak)
+            {
+               global_peak    = new_global_peak;
+               gp_change_flag = 1;
+            }
          }
-      }
 
-      /************************************************************************
-         Implementation of Limiter gain computation
-       *************************************************************************/
-      if (gain_q27 != target_gain_q27)
-      { // do gain smoothing
-         if (gain_q27 < target_gain_q27)
+         // When the user wrongly set history window length < delay, this case will happen
+         // Set global peak = abs(current sample) to avoid overshoot
+         if ((int32)u32_abs_s32_sat(per_ch_ptr->delay_buf[cur_idx]) > global_peak)
          {
-            time_coef  = per_ch_ptr->tuning_params.release_coef;
-            time_const = per_ch_ptr->tuning_params.gain_release;
+            global_peak    = (int32)u32_abs_s32_sat(per_ch_ptr->delay_buf[cur_idx]);
+            gp_change_flag = 1;
          }
-         else
+
+         if (gp_change_flag == 1)
          {
-            time_coef  = per_ch_ptr->tuning_params.attack_coef;
-            time_const = per_ch_ptr->tuning_params.gain_attack;
+            if (global_peak > threshold)
+            {
+               // Use Q6 DSP's linear approximation division routine to lower down the MIPS
+               // The inverse is computed with a normalized shift factor
+               accu64 = dsplib_approx_divide(threshold, global_peak);
+               attn32 = (int32)accu64;         // Extract the normalized inverse
+               iq32   = (int32)(accu64 >> 32); // Extract the normalization shift factor
+
+               // Shift the result to get the quotient in desired Q27 format
+               target_gain_q27 = s32_shl_s32_sat(attn32, (int16)iq32 + 27);
+            }
+            else
+            {
+               target_gain_q27 = c_gain_unity;
+            }
          }
 
-         // accu64 = (1-coef)*abs(x) + coef
-         accu64 = s64_mult_s32_s32_shift(s32_sub_s32_s32_sat(c_unity_q15, (int32)time_coef),
-                                         absL32,
-                                         32 - (int16)q_factor);                // Q15
-         accu64 = s64_add_s32_s32(s32_saturate_s64(accu64), (int32)time_coef); // Q15
+         /************************************************************************
+            Implementation of Limiter gain computation
+          *************************************************************************/
+         if (gain_q27 != target_gain_q27)
+         { // do gain smoothing
+            if (gain_q27 < target_gain_q27)
+            {
+               time_coef  = per_ch_ptr->tuning_params.release_coef;
+               time_const = per_ch_ptr->tuning_params.gain_release;
+            }
+            else
+            {
+               time_coef  = per_ch_ptr->tuning_params.attack_coef;
+               time_const = per_ch_ptr->tuning_params.gain_attack;
+            }
 
-         // time_const = accu64 * gain_release, Q31
-         time_const = (uint32)s64_mult_s32_u32_shift(s32_saturate_s64(accu64), time_const, 17);
+            // accu64 = (1-coef)*abs(x) + coef
+            accu64 = s64_mult_s32_s32_shift(s32_sub_s32_s32_sat(c_unity_q15, (int32)time_coef),
+                                            absL32,
+                                            32 - (int16)q_factor);                // Q15
+            accu64 = s64_add_s32_s32(s32_saturate_s64(accu64), (int32)time_coef); // Q15
 
-         // limit the time_const uppper bound to be 1
-         time_const = time_const > c_unity_q31 ? c_unity_q31 : time_const;
+            // time_const = accu64 * gain_release, Q31
+            time_const = (uint32)s64_mult_s32_u32_shift(s32_saturate_s64(accu64), time_const, 17);
 
-         // gain_q27	= gain_q27*(1-time_const) + target_gain_q27*time_const
-         //			= gain_q27 + (target_gain_q27 - gain_q27)*time_const
-         gain_diff_q27 = s32_sub_s32_s32_sat(target_gain_q27, gain_q27);
-         gain_q27 =
-            s32_add_s32_s32_sat(gain_q27, s32_saturate_s64(s64_mult_s32_u32_shift(gain_diff_q27, time_const, 1)));
-      }
+            // limit the time_const uppper bound to be 1
+            time_const = time_const > c_unity_q31 ? c_unity_q31 : time_const;
 
-      /************************************************************************
-         Implementation of Limiter gain on the input data
-       *************************************************************************/
-      // Gain application - Multiply and shift and round and sat (one cycle in Q6)
-      if (dly_smps_m1 >= 0)
-      { // if process with limiter delay
-         scratch32[j] = s32_saturate_s64(
-            s64_shl_s64(s64_add_s64_s64(s64_mult_s32_s32(per_ch_ptr->delay_buf[cur_idx], gain_q27), 0x4000000), -27));
-         // Store the new input sample in the input buffer
-         per_ch_ptr->delay_buf[cur_idx] = inpL32;
-
-         cur_idx = s32_modwrap_s32_u32(cur_idx + 1, dly_smps_m1 + 1);
-      }
-      else
-      { //  if process delayless
-         scratch32[j] =
-            s32_saturate_s64(s64_shl_s64(s64_add_s64_s64(s64_mult_s32_s32(inpL32, gain_q27), 0x4000000), -27));
-      }
+            // gain_q27	= gain_q27*(1-time_const) + target_gain_q27*time_const
+            //			= gain_q27 + (target_gain_q27 - gain_q27)*time_const
+            gain_diff_q27 = s32_sub_s32_s32_sat(target_gain_q27, gain_q27);
+            gain_q27 =
+               s32_add_s32_s32_sat(gain_q27, s32_saturate_s64(s64_mult_s32_u32_shift(gain_diff_q27, time_const, 1)));
+         }
 
-      /************************************************************************
-         Apply hard-limiting if output exceeds hard threshold
-       *************************************************************************/
-      if (scratch32[j] > hard_thresh || scratch32[j] < -hard_thresh)
-      {
-         scratch32[j] = scratch32[j] > 0 ? hard_thresh : -hard_thresh;
-         gain_q27     = target_gain_q27;
-      }
+         /************************************************************************
+            Implementation of Limiter gain on the input data
+          *************************************************************************/
+         // Gain application - Multiply and shift and round and sat (one cycle in Q6)
+         if (dly_smps_m1 >= 0)
+         { // if process with limiter delay
+            scratch32[j] = s32_saturate_s64(
+               s64_shl_s64(s64_add_s64_s64(s64_mult_s32_s32(per_ch_ptr->delay_buf[cur_idx], gain_q27), 0x4000000), -27));
+            // Store the new input sample in the input buffer
+            per_ch_ptr->delay_buf[cur_idx] = inpL32;
 
-   } /* for loop */
+            cur_idx = s32_modwrap_s32_u32(cur_idx + 1, dly_smps_m1 + 1);
+         }
+         else
+         { //  if process delayless
+            scratch32[j] =
+               s32_saturate_s64(s64_shl_s64(s64_add_s64_s64(s64_mult_s32_s32(inpL32, gain_q27), 0x4000000), -27));
+         }
+
+         /************************************************************************
+            Apply hard-limiting if output exceeds hard threshold
+          *************************************************************************/
+         if (scratch32[j] > hard_thresh || scratch32[j] < -hard_thresh)
+         {
+            scratch32[j] = scratch32[j] > 0 ? hard_thresh : -hard_thresh;
+            gain_q27     = target_gain_q27;
+         }
+
+      }
+   } /* while loop */
 
    per_ch_ptr->cur_idx          = cur_idx;
    per_ch_ptr->prev_peak_idx    = prev_peak_idx;
@@ -538,7 +628,7 @@ time interval between gain updates exceeds the specified wait time.
 ----------------------------------------------------------------------------*/
 static void process_delayless_zc(limiter_per_ch_t *per_ch_ptr, int32 *scratch32, int32 samples)
 {
-   int                  j;
+   int                  j, blk_end;
    int64                accu64, prod64;
    int32                accu32, attn32, inpL32, absL32;
    int16                gc;
@@ -558,69 +648,97 @@ static void process_delayless_zc(limiter_per_ch_t *per_ch_ptr, int32 *scratch32,
    gain_var_q27    = per_ch_ptr->gain_var_q27;
    gain_q27        = per_ch_ptr->gain_q27;
 
-   for (j = 0; j < samples; ++j)
+   j = 0;
+   while (j < samples)
    {
-      // Extract and store the current input data
-      inpL32 = scratch32[j];
+      blk_end = j + s32_min_s32_s32(samples - j, c_steady_blk_size);
 
-      // Compute the absolute magnitude of the input
-      absL32 = (int32)u32_abs_s32_sat(inpL32);
+      /****************************************************************************
+      Steady state: with no gain reduction pending, a block whose peak stays under
+      the threshold leaves the gain at unity, so the output equals the input and
+      only the wait-time counter needs to be tracked.
+       *****************************************************************************/
+      if ((0 == gain_var_q27) && (block_peak(&scratch32[j], blk_end - j) <= threshold))
+      {
+         for (; j < blk_end; ++j)
+         {
+            inpL32 = scratch32[j];
+            prod64 = s64_mult_s32_s32(inpL32, prev_sample_l32);
+            if ((prod64 < 0) || (inpL32 == 0) || (cur_idx > max_wait_smps_m1))
+            {
+               cur_idx = 0;
+            }
+            prev_sample_l32 = inpL32;
+            cur_idx++;
+         }
+         gain_q27 = c_gain_unity;
+         continue;
+      }
 
-      // Detect zero-crossing in the data
-      prod64 = s64_mult_s32_s32(inpL32, prev_sample_l32);
+      for (; j < blk_end; ++j)
+      {
+         // Extract and store the current input data
+         inpL32 = scratch32[j];
 
-      // Compute maximum of gain vs. previous instantaneous gain - March 2011 Changes
-      // tmp16 = max(gain, 1-GRC*gainVar)
-      new_gain_var_q27 = s32_mult_s32_s16_rnd_sat(gain_var_q27, gc);
-      tmp32            = s32_sub_s32_s32_sat(c_gain_unity, new_gain_var_q27);
+         // Compute the absolute magnitude of the input
+         absL32 = (int32)u32_abs_s32_sat(inpL32);
 
-      // absolute input x gain - Multiply 32x16 round, shift and sat in one cycle
-      accu32 = s32_saturate_s64(s64_mult_s32_s32_shift(absL32, tmp32, 5));
+         // Detect zero-crossing in the data
+         prod64 = s64_mult_s32_s32(inpL32, prev_sample_l32);
 
-      // If the peak in the data is above the threshold, attack the gain immediately.
-      if (accu32 > threshold)
-      {
+         // Compute maximum of gain vs. previous instantaneous gain - March 2011 Changes
+         // tmp16 = max(gain, 1-GRC*gainVar)
+         new_gain_var_q27 = s32_mult_s32_s16_rnd_sat(gain_var_q27, gc);
+         tmp32            = s32_sub_s32_s32_sat(c_gain_unity, new_gain_var_q27);
+
+         // absolute input x gain - Multiply 32x16 round, shift and sat in one cycle
+         accu32 = s32_saturate_s64(s64_mult_s32_s32_shift(absL32, tmp32, 5));
 
-         // Use Q6 DSP's linear approximation division routine to lower down the MIPS
-         // The inverse is computed with a normalized shift factor
-         accu64 = dsplib_approx_divide(threshold, absL32);
-         attn32 = (int32)accu64;         // Extract the normalized inverse
-         iq32   = (int32)(accu64 >> 32); // Extract the normalization shift factor
+         // If the peak in the data is above the threshold, attack the gain immediately.
+         if (accu32 > threshold)
+         {
+
+            // Use Q6 DSP's linear approximation division routine to lower down the MIPS
+            // The inverse is computed with a normalized shift factor
+            accu64 = dsplib_approx_divide(threshold, absL32);
+            attn32 = (int32)accu64;         // Extract the normalized inverse
+            iq32   = (int32)(accu64 >> 32); // Extract the normalization shift factor
 
-         // Shift the result to get the quotient in desired Q15 format
-         attnQ27 = s32_shl_s32_sat(attn32, (int16)iq32 + 27);
+            // Shift the result to get the quotient in desired Q15 format
+            attnQ27 = s32_shl_s32_sat(attn32, (int16)iq32 + 27);
 
-         // Attack gain immediately if the peak overshoots the threshold
-         gain_var_q27 = s32_sub_s32_s32_sat(c_gain_unity, attnQ27);
+            // Attack gain immediately if the peak overshoots the threshold
+            gain_var_q27 = s32_sub_s32_s32_sat(c_gain_unity, attnQ27);
 
-         // Re-set the wait time index counter
-         cur_idx = 0;
-      }
-      else if ((prod64 < 0) || (absL32 == 0) || (cur_idx > max_wait_smps_m1))
-      {
-         // Gain release at zero-crossings or if the wait time is exceeded.
-         // Release slowly using gain recovery coefficient (Q15 multiplication)
-         gain_var_q27 = new_gain_var_q27;
+            // Re-set the wait time index counter
+            cur_idx = 0;
+         }
+         else if ((prod64 < 0) || (absL32 == 0) || (cur_idx > max_wait_smps_m1))
+         {
+            // Gain release at zero-crossings or if the wait time is exceeded.
+            // Release slowly using gain recovery coefficient (Q15 multiplication)
+            gain_var_q27 = new_gain_var_q27;
 
-         // Re-set the wait time index counter
-         cur_idx = 0;
-      }
+            // Re-set the wait time index counter
+            cur_idx = 0;
+         }
 
-      // Update the gain at the zero-crossings (no saturation)
-      gain_q27 = s32_sub_s32_s32(c_gain_unity, gain_var_q27);
+         // Update the gain at the zero-crossings (no saturation)
+         gain_q27 = s32_sub_s32_s32(c_gain_unity, gain_var_q27);
 
-      // Store previous sample in the memory
-      prev_sample_l32 = inpL32;
+         // Store previous sample in the memory
+         prev_sample_l32 = inpL32;
 
-      // Increment the wait-time counter index in a circular buffer fashion
-      cur_idx++;
+         // Increment the wait-time counter index in a circular buffer fashion
+         cur_idx++;
 
-      /****************************************************************************
-      Implementation of Limiter gain on the input data
-       *****************************************************************************/
-      // Gain application - Multiply and shift and round and sat (one cycle in Q6)
-      scratch32[j] = s32_saturate_s64(s64_shl_s64(s64_add_s64_s64(s64_mult_s32_s32(inpL32, gain_q27), 0x4000000), -27));
-   } // for loop for j
+         /****************************************************************************
+         Implementation of Limiter gain on the input data
+          *****************************************************************************/
+         // Gain application - Multiply and shift and round and sat (one cycle in Q6)
+         scratch32[j] = s32_saturate_s64(s64_shl_s64(s64_add_s64_s64(s64_mult_s32_s32(inpL32, gain_q27), 0x4000000), -27));
+      } // for loop for j
+   } // while loop
 
    per_ch_ptr->prev_sample_l32 = prev_sample_l32;
    per_ch_ptr->cur_idx         = cur_idx;
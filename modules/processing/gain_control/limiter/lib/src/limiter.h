@@ -32,6 +32,7 @@ static const int32  c_unity_q15              = 32768;      // limiter unity numb
 static const uint32 c_unity_q31              = 0x80000000; // limiter unity number (1, Q31)
 static const int16  c_fade_grc               = 24576;      // release const (0.75, Q15)
 static const int16  c_local_peak_bufsize     = 4;          // history peak buffer size
+static const int32  c_steady_blk_size        = 32;         // block size for steady state peak detection
 
 /*----------------------------------------------------------------------------
  * Type Declarations
@@ -0,0 +1,514 @@
+/**
+ * \file polyphase_rs_bench.c
+ * \brief
+ *    Host tool that measures the quality and the speed of the portable polyphase resampler.
+ *
+ *    For every conversion the resampler is fed 32 bit Q27 tones in 10 ms frames, like the PCM converter does.
+ *    The output is least squares fitted with a sine at the tone frequency. What the fit does not explain is noise,
+ *    distortion, images and aliases.
+ *
+ *    Reported per conversion:
+ *       thd+n     residual to fundamental power of a 1 kHz tone at -1 dBFS, in dB
+ *       thd+n hf  same for a tone at 80% of the lower Nyquist frequency
+ *       ripple    max - min gain of 16 tones up to the pass band edge, in dB
+ *       alias     output power of a tone between the output and the input Nyquist frequency, down sampling only
+ *       kernels   max difference of each SIMD kernel to the scalar one, in Q27 LSBs
+ *       speed     ns per output sample and channel and times real time, per kernel
+ *
+ *    The drift conversion changes the input rate by up to +-0.1% every frame, as the drift correction of a
+ *    dynamic mode resampler would. The tone is generated at the changing rate, so the output has to stay a clean
+ *    tone. Larger jumps per frame are not band limited at the high tone and measure the stimulus, not the resampler.
+ *
+ *    Exits with 1 if a quality limit is not met.
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+/* =======================================================================
+INCLUDE FILES FOR MODULE
+========================================================================== */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "polyphase_rs.h"
+
+/* =======================================================================
+**                          Macro definitions
+** ======================================================================= */
+#define POLYPHASE_RS_BENCH_Q_FACTOR 27
+#define POLYPHASE_RS_BENCH_FRAME_MS 10
+#define POLYPHASE_RS_BENCH_TONE_MS 500
+#define POLYPHASE_RS_BENCH_NUM_RIPPLE_TONES 16
+#define POLYPHASE_RS_BENCH_DEFAULT_SPEED_MS 2000
+#define POLYPHASE_RS_BENCH_DEFAULT_CHANNELS 2
+#define POLYPHASE_RS_BENCH_MAX_CHANNELS 32
+#define POLYPHASE_RS_BENCH_DRIFT (0.001)
+
+/* Tone level, -1 dBFS */
+#define POLYPHASE_RS_BENCH_AMPLITUDE (0.891)
+
+/* Quality limits, for the high quality filter; the low delay filter is checked with the relaxed ones */
+#define POLYPHASE_RS_BENCH_MAX_THDN_DB (-90.0)
+#define POLYPHASE_RS_BENCH_MAX_RIPPLE_DB (0.01)
+#define POLYPHASE_RS_BENCH_MAX_ALIAS_DB (-80.0)
+#define POLYPHASE_RS_BENCH_LOW_DELAY_MARGIN_DB (25.0)
+
+#define POLYPHASE_RS_BENCH_PI (3.14159265358979323846)
+
+/* =======================================================================
+**                          Type definitions
+** ======================================================================= */
+typedef struct polyphase_rs_bench_case_t
+{
+   const char *name;
+   uint32_t    in_rate;
+   uint32_t    out_rate;
+   bool_t      is_dynamic;
+} polyphase_rs_bench_case_t;
+
+typedef struct polyphase_rs_bench_t
+{
+   uint32_t num_taps;
+   uint32_t num_channels;
+   uint32_t speed_ms;
+   uint32_t num_failures;
+} polyphase_rs_bench_t;
+
+/* =======================================================================
+**                          Global variables
+** ======================================================================= */
+static const polyphase_rs_bench_case_t polyphase_rs_bench_cases[] = {
+   { "44.1k->48k", 44100, 48000, FALSE }, { "48k->44.1k", 48000, 44100, FALSE }, { "16k->48k", 16000, 48000, FALSE },
+   { "48k->16k", 48000, 16000, FALSE },   { "8k->48k", 8000, 48000, FALSE },     { "48k->8k", 48000, 8000, FALSE },
+   { "48k drift", 48000, 48000, TRUE },
+};
+
+/* =======================================================================
+**                          Function definitions
+** ======================================================================= */
+static inline uint64_t polyphase_rs_bench_now_ns(void)
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static polyphase_rs_t *polyphase_rs_bench_create(polyphase_rs_bench_t            *me_ptr,
+                                                 const polyphase_rs_bench_case_t *case_ptr,
+                                                 uint32_t                         num_channels,
+                                                 polyphase_rs_kernel_t            kernel)
+{
+   polyphase_rs_config_t cfg;
+   memset(&cfg, 0, sizeof(cfg));
+   cfg.in_sample_rate  = case_ptr->in_rate;
+   cfg.out_sample_rate = case_ptr->out_rate;
+   cfg.num_channels    = num_channels;
+   cfg.bits_per_sample = 32;
+   cfg.q_factor        = POLYPHASE_RS_BENCH_Q_FACTOR;
+   cfg.num_taps        = me_ptr->num_taps;
+   cfg.is_dynamic      = case_ptr->is_dynamic;
+
+   uint32_t        mem_size = 0;
+   polyphase_rs_t *rs_ptr   = NULL;
+   if (AR_EOK != polyphase_rs_get_mem_req(&cfg, &mem_size))
+   {
+      return NULL;
+   }
+
+   void *mem_ptr = malloc(mem_size);
+   if ((NULL == mem_ptr) || (AR_EOK != polyphase_rs_init(&rs_ptr, &cfg, mem_ptr, mem_size)) ||
+       (AR_EOK != polyphase_rs_set_kernel(rs_ptr, kernel)))
+   {
+      free(mem_ptr);
+      return NULL;
+   }
+   return rs_ptr;
+}
+
+/** Input rate of frame frame_idx. Constant unless the case is dynamic. */
+static uint32_t polyphase_rs_bench_in_rate(const polyphase_rs_bench_case_t *case_ptr, uint32_t frame_idx)
+{
+   if (!case_ptr->is_dynamic)
+   {
+      return case_ptr->in_rate;
+   }
+   double drift = POLYPHASE_RS_BENCH_DRIFT * sin(2.0 * POLYPHASE_RS_BENCH_PI * frame_idx / 37.0);
+   return (uint32_t)lround(case_ptr->in_rate * (1.0 + drift));
+}
+
+/** Resamples a mono tone of freq_hz at the case's input rate, returns the number of outputs in out_ptr (Q27
+ *  converted to double). */
+static uint32_t polyphase_rs_bench_run_tone(polyphase_rs_bench_t            *me_ptr,
+                                            const polyphase_rs_bench_case_t *case_ptr,
+                                            polyphase_rs_kernel_t            kernel,
+                                            double                           freq_hz,
+                                            double                          *out_ptr,
+                                            uint32_t                         max_out)
+{
+   polyphase_rs_t *rs_ptr = polyphase_rs_bench_create(me_ptr, case_ptr, 1, kernel);
+   if (NULL == rs_ptr)
+   {
+      return 0;
+   }
+
+   uint32_t max_frame = (case_ptr->in_rate * 2 * POLYPHASE_RS_BENCH_FRAME_MS) / 1000;
+   int32_t *in_buf    = (int32_t *)malloc(max_frame * sizeof(int32_t));
+   int32_t *out_buf   = (int32_t *)malloc(max_out * sizeof(int32_t));
+   uint32_t num_out   = 0;
+   double   phase     = 0.0;
+   double   scale     = (double)(1 << POLYPHASE_RS_BENCH_Q_FACTOR);
+
+   for (uint32_t frame = 0; (NULL != in_buf) && (NULL != out_buf) && (num_out < max_out); frame++)
+   {
+      uint32_t in_rate = polyphase_rs_bench_in_rate(case_ptr, frame);
+      uint32_t in_len  = (in_rate * POLYPHASE_RS_BENCH_FRAME_MS) / 1000;
+      polyphase_rs_set_in_rate(rs_ptr, in_rate);
+
+      for (uint32_t i = 0; i < in_len; i++)
+      {
+         in_buf[i] = (int32_t)lrint(POLYPHASE_RS_BENCH_AMPLITUDE * scale * sin(phase));
+         phase += 2.0 * POLYPHASE_RS_BENCH_PI * freq_hz / in_rate;
+      }
+      phase = fmod(phase, 2.0 * POLYPHASE_RS_BENCH_PI);
+
+      void    *in_pptr[1]  = { in_buf };
+      void    *out_pptr[1] = { out_buf + num_out };
+      uint32_t out_len     = max_out - num_out;
+      polyphase_rs_process(rs_ptr, in_pptr, &in_len, out_pptr, &out_len);
+      num_out += out_len;
+   }
+
+   for (uint32_t i = 0; (NULL != out_buf) && (i < num_out); i++)
+   {
+      out_ptr[i] = out_buf[i] / scale;
+   }
+
+   free(out_buf);
+   free(in_buf);
+   free(rs_ptr);
+   return num_out;
+}
+
+/** Least squares fit of a*sin + b*cos + c at freq_hz. Returns the amplitude, and the residual power in
+ *  residual_ptr. */
+static double polyphase_rs_bench_fit(const double *y_ptr,
+                                     uint32_t      num,
+                                     double        freq_hz,
+                                     uint32_t      rate,
+                                     double       *residual_ptr)
+{
+   double w = 2.0 * POLYPHASE_RS_BENCH_PI * freq_hz / rate;
+   double m[3][4];
+   memset(m, 0, sizeof(m));
+
+   for (uint32_t n = 0; n < num; n++)
+   {
+      double basis[3] = { sin(w * n), cos(w * n), 1.0 };
+      for (uint32_t r = 0; r < 3; r++)
+      {
+         for (uint32_t c = 0; c < 3; c++)
+         {
+            m[r][c] += basis[r] * basis[c];
+         }
+         m[r][3] += basis[r] * y_ptr[n];
+      }
+   }
+
+   // Gauss-Jordan on the 3x3 normal equations
+   for (uint32_t p = 0; p < 3; p++)
+   {
+      for (uint32_t r = 0; r < 3; r++)
+      {
+         if (r != p)
+         {
+            double f = m[r][p] / m[p][p];
+            for (uint32_t c = p; c < 4; c++)
+            {
+               m[r][c] -= f * m[p][c];
+            }
+         }
+      }
+   }
+   double a = m[0][3] / m[0][0];
+   double b = m[1][3] / m[1][1];
+   double c = m[2][3] / m[2][2];
+
+   double residual = 0.0;
+   for (uint32_t n = 0; n < num; n++)
+   {
+      double e = y_ptr[n] - (a * sin(w * n) + b * cos(w * n) + c);
+      residual += e * e;
+   }
+   *residual_ptr = residual / num;
+   return sqrt(a * a + b * b);
+}
+
+/** Samples to skip at the start of the output, until the filter is filled */
+static uint32_t polyphase_rs_bench_settle(const polyphase_rs_bench_case_t *case_ptr)
+{
+   return case_ptr->out_rate / 50;
+}
+
+static double polyphase_rs_bench_thdn_db(polyphase_rs_bench_t            *me_ptr,
+                                         const polyphase_rs_bench_case_t *case_ptr,
+                                         double                           freq_hz,
+                                         double                          *y_ptr,
+                                         uint32_t                         max_out)
+{
+   uint32_t num  = polyphase_rs_bench_run_tone(me_ptr, case_ptr, POLYPHASE_RS_KERNEL_AUTO, freq_hz, y_ptr, max_out);
+   uint32_t skip = polyphase_rs_bench_settle(case_ptr);
+   if (num <= 2 * skip)
+   {
+      return 0.0;
+   }
+
+   double residual = 0.0;
+   double amp      = polyphase_rs_bench_fit(y_ptr + skip, num - skip, freq_hz, case_ptr->out_rate, &residual);
+   return 10.0 * log10(residual / (amp * amp / 2.0) + 1e-30);
+}
+
+static void polyphase_rs_bench_quality(polyphase_rs_bench_t *me_ptr, const polyphase_rs_bench_case_t *case_ptr)
+{
+   uint32_t max_out  = (case_ptr->out_rate * POLYPHASE_RS_BENCH_TONE_MS) / 1000;
+   double  *y_ptr    = (double *)malloc(max_out * sizeof(double));
+   double  *ref_ptr  = (double *)malloc(max_out * sizeof(double));
+   uint32_t min_rate = (case_ptr->in_rate < case_ptr->out_rate) ? case_ptr->in_rate : case_ptr->out_rate;
+   double   margin   = (me_ptr->num_taps < POLYPHASE_RS_TAPS_HIGH_QUALITY) ? POLYPHASE_RS_BENCH_LOW_DELAY_MARGIN_DB : 0;
+   bool_t   is_ok    = TRUE;
+
+   if ((NULL == y_ptr) || (NULL == ref_ptr))
+   {
+      printf("%-12s failed to allocate the buffers\n", case_ptr->name);
+      me_ptr->num_failures++;
+      free(ref_ptr);
+      free(y_ptr);
+      return;
+   }
+
+   double thdn    = polyphase_rs_bench_thdn_db(me_ptr, case_ptr, 1000.0, y_ptr, max_out);
+   double thdn_hf = polyphase_rs_bench_thdn_db(me_ptr, case_ptr, 0.8 * min_rate / 2.0, y_ptr, max_out);
+
+   // pass band ripple, the drift case is measured at its nominal rate
+   polyphase_rs_bench_case_t fixed_case = *case_ptr;
+   fixed_case.is_dynamic                = FALSE;
+   double   min_gain = 1e9, max_gain = -1e9;
+   uint32_t skip     = polyphase_rs_bench_settle(case_ptr);
+   for (uint32_t t = 0; t < POLYPHASE_RS_BENCH_NUM_RIPPLE_TONES; t++)
+   {
+      double   freq = 50.0 + (0.85 * min_rate / 2.0 - 50.0) * t / (POLYPHASE_RS_BENCH_NUM_RIPPLE_TONES - 1);
+      uint32_t num  = polyphase_rs_bench_run_tone(me_ptr, &fixed_case, POLYPHASE_RS_KERNEL_AUTO, freq, y_ptr, max_out);
+      double   residual = 0.0;
+      double   gain_db  = -200.0;
+      if (num > 2 * skip)
+      {
+         double amp = polyphase_rs_bench_fit(y_ptr + skip, num - skip, freq, case_ptr->out_rate, &residual);
+         gain_db    = 20.0 * log10(amp / POLYPHASE_RS_BENCH_AMPLITUDE + 1e-30);
+      }
+      min_gain = (gain_db < min_gain) ? gain_db : min_gain;
+      max_gain = (gain_db > max_gain) ? gain_db : max_gain;
+   }
+   double ripple = max_gain - min_gain;
+
+   // alias of a tone above the output Nyquist frequency
+   double alias = -999.0;
+   if (case_ptr->in_rate > case_ptr->out_rate)
+   {
+      double   freq = case_ptr->out_rate / 2.0 + 0.25 * (case_ptr->in_rate - case_ptr->out_rate) / 2.0;
+      uint32_t num  = polyphase_rs_bench_run_tone(me_ptr, &fixed_case, POLYPHASE_RS_KERNEL_AUTO, freq, y_ptr, max_out);
+      double   power = 0.0;
+      for (uint32_t n = skip; n < num; n++)
+      {
+         power += y_ptr[n] * y_ptr[n];
+      }
+      power /= (num > skip) ? (num - skip) : 1;
+      alias = 10.0 * log10(power / (POLYPHASE_RS_BENCH_AMPLITUDE * POLYPHASE_RS_BENCH_AMPLITUDE / 2.0) + 1e-30);
+   }
+
+   is_ok = (thdn <= POLYPHASE_RS_BENCH_MAX_THDN_DB + margin) && (thdn_hf <= POLYPHASE_RS_BENCH_MAX_THDN_DB + margin) &&
+           (ripple <= POLYPHASE_RS_BENCH_MAX_RIPPLE_DB) && (alias <= POLYPHASE_RS_BENCH_MAX_ALIAS_DB + margin);
+
+   printf("%-12s thd+n %7.1f dB  thd+n hf %7.1f dB  ripple %.5f dB  alias ", case_ptr->name, thdn, thdn_hf, ripple);
+   if (case_ptr->in_rate > case_ptr->out_rate)
+   {
+      printf("%7.1f dB", alias);
+   }
+   else
+   {
+      printf("%7s   ", "-");
+   }
+   printf("  %s\n", is_ok ? "ok" : "FAIL");
+   me_ptr->num_failures += is_ok ? 0 : 1;
+
+   // SIMD kernels against the scalar reference
+   uint32_t ref_num =
+      polyphase_rs_bench_run_tone(me_ptr, case_ptr, POLYPHASE_RS_KERNEL_SCALAR, 1000.0, ref_ptr, max_out);
+   for (uint32_t k = POLYPHASE_RS_KERNEL_SSE2; k < POLYPHASE_RS_NUM_KERNELS; k++)
+   {
+      uint32_t num = polyphase_rs_bench_run_tone(me_ptr, case_ptr, (polyphase_rs_kernel_t)k, 1000.0, y_ptr, max_out);
+      if (0 == num)
+      {
+         continue;
+      }
+      double max_diff = 0.0;
+      for (uint32_t n = 0; (n < num) && (n < ref_num); n++)
+      {
+         double diff = fabs(y_ptr[n] - ref_ptr[n]) * (1 << POLYPHASE_RS_BENCH_Q_FACTOR);
+         max_diff    = (diff > max_diff) ? diff : max_diff;
+      }
+      printf("%-12s %s max diff to scalar %.0f LSB, %u of %u samples\n",
+             case_ptr->name,
+             polyphase_rs_kernel_name((polyphase_rs_kernel_t)k),
+             max_diff,
+             num,
+             ref_num);
+   }
+
+   free(ref_ptr);
+   free(y_ptr);
+}
+
+static void polyphase_rs_bench_speed(polyphase_rs_bench_t *me_ptr, const polyphase_rs_bench_case_t *case_ptr)
+{
+   uint32_t ch        = me_ptr->num_channels;
+   uint32_t max_frame = (case_ptr->in_rate * 2 * POLYPHASE_RS_BENCH_FRAME_MS) / 1000;
+   uint32_t max_out   = (case_ptr->out_rate * 2 * POLYPHASE_RS_BENCH_FRAME_MS) / 1000 + 2;
+   int32_t *in_buf    = (int32_t *)calloc(max_frame * ch, sizeof(int32_t));
+   int32_t *out_buf   = (int32_t *)calloc(max_out * ch, sizeof(int32_t));
+   void    *in_pptr[POLYPHASE_RS_BENCH_MAX_CHANNELS];
+   void    *out_pptr[POLYPHASE_RS_BENCH_MAX_CHANNELS];
+
+   if ((NULL == in_buf) || (NULL == out_buf))
+   {
+      free(out_buf);
+      free(in_buf);
+      return;
+   }
+
+   for (uint32_t c = 0; c < ch; c++)
+   {
+      in_pptr[c]  = in_buf + c * max_frame;
+      out_pptr[c] = out_buf + c * max_out;
+      for (uint32_t i = 0; i < max_frame; i++)
+      {
+         in_buf[c * max_frame + i] = (int32_t)((i * 2654435761u) >> 6) - (1 << 25);
+      }
+   }
+
+   for (uint32_t k = POLYPHASE_RS_KERNEL_SCALAR; k < POLYPHASE_RS_NUM_KERNELS; k++)
+   {
+      polyphase_rs_t *rs_ptr = polyphase_rs_bench_create(me_ptr, case_ptr, ch, (polyphase_rs_kernel_t)k);
+      if (NULL == rs_ptr)
+      {
+         continue;
+      }
+
+      uint32_t num_frames = me_ptr->speed_ms / POLYPHASE_RS_BENCH_FRAME_MS;
+      uint64_t total_out  = 0;
+      uint64_t start_ns   = polyphase_rs_bench_now_ns();
+      for (uint32_t frame = 0; frame < num_frames; frame++)
+      {
+         uint32_t in_rate = polyphase_rs_bench_in_rate(case_ptr, frame);
+         uint32_t in_len  = (in_rate * POLYPHASE_RS_BENCH_FRAME_MS) / 1000;
+         uint32_t out_len = max_out;
+         polyphase_rs_set_in_rate(rs_ptr, in_rate);
+         polyphase_rs_process(rs_ptr, in_pptr, &in_len, out_pptr, &out_len);
+         total_out += out_len;
+      }
+      uint64_t elapsed_ns = polyphase_rs_bench_now_ns() - start_ns;
+
+      printf("%-12s %-6s %8.2f ns/sample %9.1fx real time  (%u taps, %llu Mmac/s needed)\n",
+             case_ptr->name,
+             polyphase_rs_kernel_name((polyphase_rs_kernel_t)k),
+             (double)elapsed_ns / (double)(total_out * ch),
+             ((double)me_ptr->speed_ms * 1e6) / (double)elapsed_ns,
+             me_ptr->num_taps,
+             (unsigned long long)(polyphase_rs_get_macs_per_sec(rs_ptr) / 1000000));
+      free(rs_ptr);
+   }
+
+   free(out_buf);
+   free(in_buf);
+}
+
+static void polyphase_rs_bench_usage(const char *prog_name)
+{
+   printf("Usage: %s [-t taps] [-c num_channels] [-d speed_test_ms]\n", prog_name);
+   printf("   taps: %u (low delay) or %u (high quality, default)\n",
+          POLYPHASE_RS_TAPS_LOW_DELAY,
+          POLYPHASE_RS_TAPS_HIGH_QUALITY);
+}
+
+int main(int argc, char *argv[])
+{
+   polyphase_rs_bench_t bench;
+   memset(&bench, 0, sizeof(bench));
+   bench.num_taps     = POLYPHASE_RS_TAPS_HIGH_QUALITY;
+   bench.num_channels = POLYPHASE_RS_BENCH_DEFAULT_CHANNELS;
+   bench.speed_ms     = POLYPHASE_RS_BENCH_DEFAULT_SPEED_MS;
+
+   int opt;
+   while (-1 != (opt = getopt(argc, argv, "t:c:d:h")))
+   {
+      switch (opt)
+      {
+         case 't':
+            bench.num_taps = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+         case 'c':
+            bench.num_channels = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+         case 'd':
+            bench.speed_ms = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+         default:
+            polyphase_rs_bench_usage(argv[0]);
+            return (('h' == opt) ? 0 : 1);
+      }
+   }
+
+   if ((0 == bench.num_taps) || (0 == bench.num_channels) || (POLYPHASE_RS_BENCH_MAX_CHANNELS < bench.num_channels))
+   {
+      polyphase_rs_bench_usage(argv[0]);
+      return 1;
+   }
+
+   uint32_t num_cases = sizeof(polyphase_rs_bench_cases) / sizeof(polyphase_rs_bench_cases[0]);
+
+   polyphase_rs_t *rs_ptr =
+      polyphase_rs_bench_create(&bench, &polyphase_rs_bench_cases[0], 1, POLYPHASE_RS_KERNEL_AUTO);
+   if (NULL == rs_ptr)
+   {
+      printf("Failed to create the resampler\n");
+      return 1;
+   }
+   printf("%u taps, Q%u, %u ms frames, best kernel %s\n\n",
+          bench.num_taps,
+          POLYPHASE_RS_BENCH_Q_FACTOR,
+          POLYPHASE_RS_BENCH_FRAME_MS,
+          polyphase_rs_kernel_name(polyphase_rs_get_kernel(rs_ptr)));
+   free(rs_ptr);
+
+   for (uint32_t i = 0; i < num_cases; i++)
+   {
+      polyphase_rs_bench_quality(&bench, &polyphase_rs_bench_cases[i]);
+   }
+
+   printf("\n%u channels, %u ms of audio\n", bench.num_channels, bench.speed_ms);
+   for (uint32_t i = 0; i < num_cases; i++)
+   {
+      polyphase_rs_bench_speed(&bench, &polyphase_rs_bench_cases[i]);
+   }
+
+   if (0 != bench.num_failures)
+   {
+      printf("\n%u conversions out of limits\n", bench.num_failures);
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,136 @@
+/**
+ * \file polyphase_rs.h
+ * \brief
+ *    Portable polyphase FIR sample rate converter. Used as the backend of the hwsw_rs_lib and iir_rs_lib interfaces
+ *    on targets for which the prebuilt resampler libraries are not available.
+ *
+ *    The filter is a Kaiser windowed sinc which is designed at init for the given rates. Ratios with a small enough
+ *    reduced fraction L/M are stepped exactly with L phases. Other ratios, and all ratios in dynamic mode, step a
+ *    Q32 input position and interpolate linearly between two of a fixed number of phases, which lets the input rate
+ *    be changed at run time (drift correction) without a reset.
+ *
+ *    Samples are deinterleaved, 16 bit Q15 or 32 bit in the configured Q format, and filtered in float. The dot
+ *    product kernel is picked at init: AVX2/FMA or SSE2 on x86, NEON on ARM, scalar otherwise.
+ *
+ *    The library does not allocate memory. The caller queries the size with polyphase_rs_get_mem_req() and passes
+ *    the memory to polyphase_rs_init().
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef POLYPHASE_RS_H
+#define POLYPHASE_RS_H
+
+/*------------------------------------------------------------------------
+ * Include files
+ * -----------------------------------------------------------------------*/
+#include "ar_error_codes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /*__cplusplus*/
+
+/*------------------------------------------------------------------------
+ * Macros, Defines, Type declarations
+ * -----------------------------------------------------------------------*/
+/** Max supported sampling rate */
+#define POLYPHASE_RS_MAX_SAMPLE_RATE (384000)
+
+/** Max supported number of channels */
+#define POLYPHASE_RS_MAX_CHANNELS (128)
+
+/** Max supported down sampling ratio */
+#define POLYPHASE_RS_MAX_DOWN_RATIO (48)
+
+/** Taps per output at the lower of the two rates, i.e. before scaling for down sampling */
+#define POLYPHASE_RS_TAPS_HIGH_QUALITY (96)
+#define POLYPHASE_RS_TAPS_LOW_DELAY (64)
+
+/** Max input rate change in dynamic mode, in percent of the rate the filter was designed for. A bigger change
+ *  needs a new instance. */
+#define POLYPHASE_RS_DYNAMIC_MAX_DRIFT_PERCENT (5)
+
+typedef enum polyphase_rs_kernel_t
+{
+   POLYPHASE_RS_KERNEL_AUTO = 0, /**< Best kernel available on this cpu */
+   POLYPHASE_RS_KERNEL_SCALAR,   /**< Reference C implementation */
+   POLYPHASE_RS_KERNEL_SSE2,
+   POLYPHASE_RS_KERNEL_AVX2,
+   POLYPHASE_RS_KERNEL_NEON,
+   POLYPHASE_RS_NUM_KERNELS
+} polyphase_rs_kernel_t;
+
+typedef struct polyphase_rs_config_t
+{
+   uint32_t in_sample_rate;
+   uint32_t out_sample_rate;
+   uint32_t num_channels;
+   uint32_t bits_per_sample; /**< 16 (Q15) or 32 */
+   uint32_t q_factor;        /**< Q format of 32 bit samples, ignored for 16 bit */
+   uint32_t num_taps;        /**< Taps per output at the lower rate, POLYPHASE_RS_TAPS_xxx */
+   bool_t   is_dynamic;      /**< Input rate can be changed with polyphase_rs_set_in_rate() */
+} polyphase_rs_config_t;
+
+typedef struct polyphase_rs_t polyphase_rs_t;
+
+/*------------------------------------------------------------------------
+ * Function declarations
+ * -----------------------------------------------------------------------*/
+/** Memory needed by an instance for the given config. Returns AR_EUNSUPPORTED for unsupported configs. */
+ar_result_t polyphase_rs_get_mem_req(const polyphase_rs_config_t *cfg_ptr, uint32_t *mem_size_ptr);
+
+/** Designs the filter and initializes the instance in mem_ptr, with cleared history. The instance pointer returned
+ *  in rs_pptr is mem_ptr. */
+ar_result_t polyphase_rs_init(polyphase_rs_t             **rs_pptr,
+                              const polyphase_rs_config_t *cfg_ptr,
+                              void                        *mem_ptr,
+                              uint32_t                     mem_size);
+
+/** Config of the instance. The input rate is the current one in dynamic mode. */
+const polyphase_rs_config_t *polyphase_rs_get_config(polyphase_rs_t *rs_ptr);
+
+/** Clears the history and the phase */
+void polyphase_rs_reset(polyphase_rs_t *rs_ptr);
+
+/** Changes the input rate of a dynamic mode instance, keeping the history and the phase. Returns AR_EUNSUPPORTED if
+ *  the instance is not dynamic or the rate is too far from the one the filter was designed for. */
+ar_result_t polyphase_rs_set_in_rate(polyphase_rs_t *rs_ptr, uint32_t in_sample_rate);
+
+/** Forces the dot product kernel. Returns AR_EUNSUPPORTED if the kernel is not available on this cpu. */
+ar_result_t polyphase_rs_set_kernel(polyphase_rs_t *rs_ptr, polyphase_rs_kernel_t kernel);
+
+polyphase_rs_kernel_t polyphase_rs_get_kernel(polyphase_rs_t *rs_ptr);
+
+const char *polyphase_rs_kernel_name(polyphase_rs_kernel_t kernel);
+
+/** Resamples up to *in_samples_ptr input samples per channel into at most *out_samples_ptr output samples per
+ *  channel. Processing stops when the input runs out or the output is full. On return *in_samples_ptr holds the
+ *  consumed and *out_samples_ptr the generated samples per channel. Input and output may not overlap. */
+void polyphase_rs_process(polyphase_rs_t *rs_ptr,
+                          void          **in_pptr,
+                          uint32_t       *in_samples_ptr,
+                          void          **out_pptr,
+                          uint32_t       *out_samples_ptr);
+
+/** Input samples per channel which are needed to generate out_samples from the current state */
+uint32_t polyphase_rs_calc_fixed_out(polyphase_rs_t *rs_ptr, uint32_t out_samples);
+
+/** Output samples per channel which are generated from in_samples from the current state */
+uint32_t polyphase_rs_calc_fixed_in(polyphase_rs_t *rs_ptr, uint32_t in_samples);
+
+/** Group delay in micro seconds */
+uint32_t polyphase_rs_get_delay_us(polyphase_rs_t *rs_ptr);
+
+/** Multiply accumulates per second for all channels at the current rates */
+uint64_t polyphase_rs_get_macs_per_sec(polyphase_rs_t *rs_ptr);
+
+/** Bytes of filter coefficients, which are read for every output sample */
+uint32_t polyphase_rs_get_coef_size(polyphase_rs_t *rs_ptr);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif // POLYPHASE_RS_H
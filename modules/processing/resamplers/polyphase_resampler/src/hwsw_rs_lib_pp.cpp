@@ -0,0 +1,344 @@
+/**
+ * \file hwsw_rs_lib_pp.cpp
+ * \brief
+ *    hwsw_rs_lib interface on top of the portable polyphase resampler, for targets without the prebuilt dynamic
+ *    resampler library.
+ *
+ *    Only the SW path exists. The polyphase instance is kept in sw_rs_mem_ptr[STAGE_ZERO]->drs_mem_ptr.pStructMem,
+ *    which is where the PCM converter looks for it to detect the SW path and to call resamp_calc_fixedout(). Every
+ *    conversion is done in one stage.
+ *
+ *    C++ like the PCM converter, since hwsw_rs_lib_hw.h sizes arrays with static const variables.
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "hwsw_rs_lib.h"
+#include "capi_fwk_extns_dm.h"
+#include "polyphase_rs.h"
+
+/* =======================================================================
+Static Function Definitions
+========================================================================== */
+
+static polyphase_rs_t *hwsw_rs_pp_get_inst(hwsw_resampler_lib_t *hwsw_rs_ptr)
+{
+   hwsw_rs_sw_memory_t *sw_mem_ptr = hwsw_rs_ptr->sw_rs_mem_ptr[STAGE_ZERO];
+   return (NULL != sw_mem_ptr) ? (polyphase_rs_t *)sw_mem_ptr->drs_mem_ptr.pStructMem : NULL;
+}
+
+static void hwsw_rs_pp_free_inst(hwsw_resampler_lib_t *hwsw_rs_ptr)
+{
+   hwsw_rs_sw_memory_t *sw_mem_ptr = hwsw_rs_ptr->sw_rs_mem_ptr[STAGE_ZERO];
+   if (NULL != sw_mem_ptr)
+   {
+      if (NULL != sw_mem_ptr->drs_mem_ptr.pStructMem)
+      {
+         posal_memory_free(sw_mem_ptr->drs_mem_ptr.pStructMem);
+      }
+      posal_memory_free(sw_mem_ptr);
+      hwsw_rs_ptr->sw_rs_mem_ptr[STAGE_ZERO] = NULL;
+   }
+   hwsw_rs_ptr->this_resampler_instance_using = NO_RESAMPLER;
+}
+
+static void hwsw_rs_pp_get_config(hwsw_resampler_lib_t *hwsw_rs_ptr, polyphase_rs_config_t *cfg_ptr)
+{
+   hwsw_rs_media_fmt_t *mf_ptr = &hwsw_rs_ptr->media_fmt;
+
+   cfg_ptr->in_sample_rate  = mf_ptr->inp_sample_rate;
+   cfg_ptr->out_sample_rate = mf_ptr->output_sample_rate;
+   cfg_ptr->num_channels    = mf_ptr->num_channels;
+   cfg_ptr->bits_per_sample = (16 == mf_ptr->bits_per_sample) ? 16 : 32;
+   cfg_ptr->q_factor        = (16 == mf_ptr->bits_per_sample) ? 15 : mf_ptr->q_factor;
+   cfg_ptr->num_taps        = (1 == hwsw_rs_ptr->sw_rs_config_param.delay_type) ? POLYPHASE_RS_TAPS_LOW_DELAY
+                                                                                 : POLYPHASE_RS_TAPS_HIGH_QUALITY;
+   cfg_ptr->is_dynamic = (0 != hwsw_rs_ptr->sw_rs_config_param.dynamic_mode) ? TRUE : FALSE;
+}
+
+/** TRUE if the configs differ at most in the input rate */
+static bool_t hwsw_rs_pp_is_same_but_in_rate(const polyphase_rs_config_t *cur_ptr, const polyphase_rs_config_t *cfg_ptr)
+{
+   return ((cur_ptr->out_sample_rate == cfg_ptr->out_sample_rate) && (cur_ptr->num_channels == cfg_ptr->num_channels) &&
+           (cur_ptr->bits_per_sample == cfg_ptr->bits_per_sample) && (cur_ptr->q_factor == cfg_ptr->q_factor) &&
+           (cur_ptr->num_taps == cfg_ptr->num_taps) && (cur_ptr->is_dynamic == cfg_ptr->is_dynamic))
+             ? TRUE
+             : FALSE;
+}
+
+/* =======================================================================
+Function Definitions
+========================================================================== */
+
+void hwsw_rs_lib_init(hwsw_resampler_lib_t *hwsw_rs_lib)
+{
+   hwsw_rs_lib->this_resampler_instance_using = NO_RESAMPLER;
+   hwsw_rs_lib->dm_mode                       = FWK_EXTN_DM_FIXED_INPUT_MODE;
+   hwsw_rs_lib->is_multi_stage_process        = FALSE;
+}
+
+ar_result_t hwsw_rs_lib_deinit(hwsw_resampler_lib_t *hwsw_rs_ptr)
+{
+   hwsw_rs_pp_free_inst(hwsw_rs_ptr);
+   return AR_EOK;
+}
+
+void hwsw_rs_set_lib_mf(hwsw_resampler_lib_t *hwsw_rs_ptr, hwsw_rs_media_fmt_t *inp_mf)
+{
+   hwsw_rs_ptr->media_fmt = *inp_mf;
+}
+
+void hwsw_rs_lib_set_config(uint32_t              use_hwrs,
+                            uint16_t              dyn_mode,
+                            uint16_t              delay,
+                            hwsw_resampler_lib_t *hwsw_rs_ptr,
+                            bool_t *              update_rs)
+{
+   *update_rs = FALSE;
+
+   // there is no HW resampler, the flag is only kept so that a change still re-creates like the prebuilt lib does
+   if (((0 != use_hwrs) != (0 != hwsw_rs_ptr->hw_resampler.use_hw_rs)) ||
+       (dyn_mode != hwsw_rs_ptr->sw_rs_config_param.dynamic_mode) ||
+       (delay != hwsw_rs_ptr->sw_rs_config_param.delay_type))
+   {
+      hwsw_rs_ptr->hw_resampler.use_hw_rs          = (0 != use_hwrs) ? TRUE : FALSE;
+      hwsw_rs_ptr->sw_rs_config_param.dynamic_mode = dyn_mode;
+      hwsw_rs_ptr->sw_rs_config_param.delay_type   = delay;
+      *update_rs                                   = TRUE;
+   }
+}
+
+ar_result_t hwsw_rs_lib_check_create_resampler_instance(hwsw_resampler_lib_t *hwsw_rs_ptr, uint32_t heap_id)
+{
+   polyphase_rs_config_t cfg;
+   hwsw_rs_pp_get_config(hwsw_rs_ptr, &cfg);
+
+   polyphase_rs_t *rs_ptr = hwsw_rs_pp_get_inst(hwsw_rs_ptr);
+   if (NULL != rs_ptr)
+   {
+      const polyphase_rs_config_t *cur_ptr = polyphase_rs_get_config(rs_ptr);
+
+      // dynamic mode keeps the history across input rate changes, as long as the drift is in range
+      if (hwsw_rs_pp_is_same_but_in_rate(cur_ptr, &cfg) &&
+          ((cur_ptr->in_sample_rate == cfg.in_sample_rate) ||
+           (cfg.is_dynamic && (AR_EOK == polyphase_rs_set_in_rate(rs_ptr, cfg.in_sample_rate)))))
+      {
+         return AR_EOK;
+      }
+      hwsw_rs_pp_free_inst(hwsw_rs_ptr);
+   }
+
+   uint32_t    mem_size = 0;
+   ar_result_t result   = polyphase_rs_get_mem_req(&cfg, &mem_size);
+   if ((AR_EOK == result) && (CAPI_MAX_CHANNELS_V2 < cfg.num_channels))
+   {
+      result = AR_EUNSUPPORTED;
+   }
+   if (AR_EOK != result)
+   {
+      AR_MSG(DBG_ERROR_PRIO,
+             "hwsw_rs_lib: unsupported config, in %lu Hz, out %lu Hz, ch %lu, bits %lu",
+             cfg.in_sample_rate,
+             cfg.out_sample_rate,
+             cfg.num_channels,
+             cfg.bits_per_sample);
+      return result;
+   }
+
+   hwsw_rs_sw_memory_t *sw_mem_ptr =
+      (hwsw_rs_sw_memory_t *)posal_memory_malloc(sizeof(hwsw_rs_sw_memory_t), (POSAL_HEAP_ID)heap_id);
+   if (NULL == sw_mem_ptr)
+   {
+      return AR_ENOMEMORY;
+   }
+   memset(sw_mem_ptr, 0, sizeof(hwsw_rs_sw_memory_t));
+   hwsw_rs_ptr->sw_rs_mem_ptr[STAGE_ZERO] = sw_mem_ptr;
+
+   void *mem_ptr = posal_memory_malloc(mem_size, (POSAL_HEAP_ID)heap_id);
+   if (NULL == mem_ptr)
+   {
+      hwsw_rs_pp_free_inst(hwsw_rs_ptr);
+      return AR_ENOMEMORY;
+   }
+
+   result = polyphase_rs_init(&rs_ptr, &cfg, mem_ptr, mem_size);
+   if (AR_EOK != result)
+   {
+      posal_memory_free(mem_ptr);
+      hwsw_rs_pp_free_inst(hwsw_rs_ptr);
+      return result;
+   }
+
+   sw_mem_ptr->drs_mem_req.drsStructSize = mem_size;
+   sw_mem_ptr->drs_mem_req.drsMemSize    = mem_size;
+   sw_mem_ptr->drs_mem_ptr.pStructMem    = rs_ptr;
+
+   hwsw_rs_ptr->this_resampler_instance_using = SW_RESAMPLER;
+   hwsw_rs_ptr->is_multi_stage_process        = FALSE;
+
+   AR_MSG(DBG_HIGH_PRIO,
+          "hwsw_rs_lib: polyphase resampler %lu -> %lu Hz, ch %lu, taps %lu, dynamic %lu, kernel %s, size %lu",
+          cfg.in_sample_rate,
+          cfg.out_sample_rate,
+          cfg.num_channels,
+          cfg.num_taps,
+          (uint32_t)cfg.is_dynamic,
+          polyphase_rs_kernel_name(polyphase_rs_get_kernel(rs_ptr)),
+          mem_size);
+   return AR_EOK;
+}
+
+ar_result_t hwsw_rs_lib_process(hwsw_resampler_lib_t *hwsw_rs_ptr,
+                                capi_buf_t *          input_buf_ptr,
+                                capi_buf_t *          output_buf_ptr,
+                                uint32_t              input_num_bufs,
+                                uint32_t              output_num_bufs,
+                                uint32_t              heap_id)
+{
+   polyphase_rs_t *rs_ptr = hwsw_rs_pp_get_inst(hwsw_rs_ptr);
+   if (NULL == rs_ptr)
+   {
+      return AR_EFAILED;
+   }
+
+   const polyphase_rs_config_t *cfg_ptr      = polyphase_rs_get_config(rs_ptr);
+   uint32_t                     num_channels = cfg_ptr->num_channels;
+   uint32_t                     sample_bytes = cfg_ptr->bits_per_sample >> 3;
+   if ((input_num_bufs < num_channels) || (output_num_bufs < num_channels))
+   {
+      return AR_EBADPARAM;
+   }
+
+   void *in_pptr[CAPI_MAX_CHANNELS_V2];
+   void *out_pptr[CAPI_MAX_CHANNELS_V2];
+   for (uint32_t ch = 0; ch < num_channels; ch++)
+   {
+      in_pptr[ch]  = input_buf_ptr[ch].data_ptr;
+      out_pptr[ch] = output_buf_ptr[ch].data_ptr;
+   }
+
+   uint32_t in_samples  = input_buf_ptr[0].actual_data_len / sample_bytes;
+   uint32_t out_samples = output_buf_ptr[0].max_data_len / sample_bytes;
+   if ((FWK_EXTN_DM_FIXED_OUTPUT_MODE == hwsw_rs_ptr->dm_mode) && (hwsw_rs_ptr->output_fixed_samples < out_samples))
+   {
+      out_samples = hwsw_rs_ptr->output_fixed_samples;
+   }
+
+   polyphase_rs_process(rs_ptr, in_pptr, &in_samples, out_pptr, &out_samples);
+
+   for (uint32_t ch = 0; ch < input_num_bufs; ch++)
+   {
+      input_buf_ptr[ch].actual_data_len = in_samples * sample_bytes;
+   }
+   for (uint32_t ch = 0; ch < output_num_bufs; ch++)
+   {
+      output_buf_ptr[ch].actual_data_len = out_samples * sample_bytes;
+   }
+
+#ifdef HWSW_RESAMPLER_PRINT_FRAME_STATS
+   AR_MSG(DBG_HIGH_PRIO, "hwsw_rs_lib: consumed %lu, generated %lu samples per ch", in_samples, out_samples);
+#endif
+   return AR_EOK;
+}
+
+void hwsw_rs_lib_process_get_hw_process_info(hwsw_resampler_lib_t *hwsw_rs_ptr,
+                                             uint32_t              input_actual_samples,
+                                             uint32_t              output_max_samples,
+                                             uint32_t *            input_samples_to_consume_ptr,
+                                             uint32_t *            output_samples_to_generate_ptr)
+{
+   // no HW resampler, answer for the SW one so that callers which ask anyway get consistent numbers
+   polyphase_rs_t *rs_ptr = hwsw_rs_pp_get_inst(hwsw_rs_ptr);
+   if (NULL == rs_ptr)
+   {
+      *input_samples_to_consume_ptr   = 0;
+      *output_samples_to_generate_ptr = 0;
+      return;
+   }
+
+   uint32_t out_samples = polyphase_rs_calc_fixed_in(rs_ptr, input_actual_samples);
+   out_samples          = (out_samples > output_max_samples) ? output_max_samples : out_samples;
+   uint32_t in_samples  = polyphase_rs_calc_fixed_out(rs_ptr, out_samples);
+
+   *input_samples_to_consume_ptr   = (in_samples > input_actual_samples) ? input_actual_samples : in_samples;
+   *output_samples_to_generate_ptr = out_samples;
+}
+
+void hwsw_rs_lib_set_dm_config(hwsw_resampler_lib_t *hwsw_rs_ptr, uint32_t dm_mode, uint32_t fixed_out_samples)
+{
+   hwsw_rs_ptr->dm_mode              = dm_mode;
+   hwsw_rs_ptr->output_fixed_samples = fixed_out_samples;
+}
+
+ar_result_t hwsw_rs_lib_set_hwrs_suspend_resume(bool_t                is_suspend,
+                                                hwsw_resampler_lib_t *hwsw_rs_ptr,
+                                                uint32_t *            create_rs)
+{
+   // nothing is held in HW, resume never needs a new instance
+   *create_rs = FALSE;
+   return AR_EOK;
+}
+
+uint32_t hwsw_rs_lib_get_kpps(hwsw_resampler_lib_t *hwsw_rs_ptr)
+{
+   polyphase_rs_t *rs_ptr = hwsw_rs_pp_get_inst(hwsw_rs_ptr);
+   if (NULL == rs_ptr)
+   {
+      return 0;
+   }
+
+   // one packet per multiply accumulate, the SIMD kernels leave the margin for the conversions
+   return (uint32_t)(polyphase_rs_get_macs_per_sec(rs_ptr) / 1000);
+}
+
+uint32_t hwsw_rs_lib_get_bw(hwsw_resampler_lib_t *hwsw_rs_ptr)
+{
+   polyphase_rs_t *rs_ptr = hwsw_rs_pp_get_inst(hwsw_rs_ptr);
+   if (NULL == rs_ptr)
+   {
+      return 0;
+   }
+
+   // input and output samples, the coefficients stay in cache
+   const polyphase_rs_config_t *cfg_ptr = polyphase_rs_get_config(rs_ptr);
+   uint32_t                     bytes   = cfg_ptr->bits_per_sample >> 3;
+   return (cfg_ptr->in_sample_rate + cfg_ptr->out_sample_rate) * cfg_ptr->num_channels * bytes;
+}
+
+uint32_t hwsw_rs_lib_get_alg_delay(hwsw_resampler_lib_t *hwsw_rs_ptr)
+{
+   polyphase_rs_t *rs_ptr = hwsw_rs_pp_get_inst(hwsw_rs_ptr);
+   return (NULL != rs_ptr) ? polyphase_rs_get_delay_us(rs_ptr) : 0;
+}
+
+void hwsw_rs_lib_get_process_check(hwsw_resampler_lib_t *hwsw_rs_ptr, uint32_t *process_check)
+{
+   *process_check = (NULL != hwsw_rs_pp_get_inst(hwsw_rs_ptr)) ? TRUE : FALSE;
+}
+
+ar_result_t hwsw_rs_lib_algo_reset(hwsw_resampler_lib_t *hwsw_rs_ptr)
+{
+   polyphase_rs_t *rs_ptr = hwsw_rs_pp_get_inst(hwsw_rs_ptr);
+   if (NULL != rs_ptr)
+   {
+      polyphase_rs_reset(rs_ptr);
+   }
+   return AR_EOK;
+}
+
+bool_t hwsw_rs_lib_is_multi_stage_supported(hwsw_resampler_lib_t *hwsw_rs_ptr)
+{
+   return FALSE;
+}
+
+int32 resamp_calc_fixedin(void *rs_ptr, int32 in_samples)
+{
+   return (int32)polyphase_rs_calc_fixed_in((polyphase_rs_t *)rs_ptr, (uint32_t)in_samples);
+}
+
+int32 resamp_calc_fixedout(void *rs_ptr, int32 out_samples)
+{
+   return (int32)polyphase_rs_calc_fixed_out((polyphase_rs_t *)rs_ptr, (uint32_t)out_samples);
+}
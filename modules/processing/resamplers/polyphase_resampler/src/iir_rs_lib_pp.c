@@ -0,0 +1,180 @@
+/**
+ * \file iir_rs_lib_pp.c
+ * \brief
+ *    iir_rs_lib interface on top of the portable polyphase resampler, for targets without the prebuilt IIR resampler
+ *    library.
+ *
+ *    The IIR resampler is the low delay choice of the PCM converter, so the low delay filter length is used. Frames
+ *    are 16 bit with a whole number of samples at both rates, which an exact ratio instance converts without
+ *    carrying a phase from one frame to the next.
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "iir_rs_lib.h"
+#include "polyphase_rs.h"
+
+/* =======================================================================
+Static Function Definitions
+========================================================================== */
+
+static polyphase_rs_t *iir_rs_pp_get_inst(iir_rs_lib_t *iir_rs_ptr)
+{
+   return (NULL != iir_rs_ptr) ? (polyphase_rs_t *)iir_rs_ptr->lib_instance_per_port_ptr[0].lib_mem_ptr : NULL;
+}
+
+/* =======================================================================
+Function Definitions
+========================================================================== */
+
+void iir_rs_lib_deinit(iir_rs_lib_t *iir_rs_ptr)
+{
+   iir_rs_lib_instance_t *inst_ptr = &iir_rs_ptr->lib_instance_per_port_ptr[0];
+   if (NULL != inst_ptr->lib_mem_ptr)
+   {
+      posal_memory_free(inst_ptr->lib_mem_ptr);
+   }
+   memset(inst_ptr, 0, sizeof(iir_rs_lib_instance_t));
+   iir_rs_ptr->num_ports = 0;
+}
+
+ar_result_t iir_rs_lib_allocate_memory(iir_rs_lib_t *iir_rs_ptr,
+                                       uint32_t      inp_sampling_rate,
+                                       uint32_t      out_sampling_rate,
+                                       uint32_t      num_channels,
+                                       uint32_t      bits_per_sample,
+                                       uint32_t      frame_length_ms,
+                                       uint32_t      heap_id)
+{
+   iir_rs_lib_deinit(iir_rs_ptr);
+
+   // the process call only passes 16 bit frames
+   if ((16 != bits_per_sample) || (IIR_RESAMPLER_MAX_NUM_CHAN < num_channels))
+   {
+      AR_MSG(DBG_ERROR_PRIO, "iir_rs_lib: unsupported bits %lu or ch %lu", bits_per_sample, num_channels);
+      return AR_EUNSUPPORTED;
+   }
+
+   polyphase_rs_config_t cfg;
+   memset(&cfg, 0, sizeof(cfg));
+   cfg.in_sample_rate  = inp_sampling_rate;
+   cfg.out_sample_rate = out_sampling_rate;
+   cfg.num_channels    = num_channels;
+   cfg.bits_per_sample = 16;
+   cfg.q_factor        = 15;
+   cfg.num_taps        = POLYPHASE_RS_TAPS_LOW_DELAY;
+   cfg.is_dynamic      = FALSE;
+
+   uint32_t    mem_size = 0;
+   ar_result_t result   = polyphase_rs_get_mem_req(&cfg, &mem_size);
+   if (AR_EOK != result)
+   {
+      AR_MSG(DBG_ERROR_PRIO,
+             "iir_rs_lib: unsupported rates, in %lu Hz, out %lu Hz",
+             inp_sampling_rate,
+             out_sampling_rate);
+      return result;
+   }
+
+   void *mem_ptr = posal_memory_malloc(mem_size, (POSAL_HEAP_ID)heap_id);
+   if (NULL == mem_ptr)
+   {
+      return AR_ENOMEMORY;
+   }
+
+   polyphase_rs_t *rs_ptr = NULL;
+   result                 = polyphase_rs_init(&rs_ptr, &cfg, mem_ptr, mem_size);
+   if (AR_EOK != result)
+   {
+      posal_memory_free(mem_ptr);
+      return result;
+   }
+
+   iir_rs_lib_instance_t *inst_ptr          = &iir_rs_ptr->lib_instance_per_port_ptr[0];
+   inst_ptr->lib_io_config.in_channels      = num_channels;
+   inst_ptr->lib_io_config.out_channels     = num_channels;
+   inst_ptr->lib_io_config.in_sample_rate   = inp_sampling_rate;
+   inst_ptr->lib_io_config.out_sample_rate  = out_sampling_rate;
+   inst_ptr->lib_io_config.frame_length_ms  = frame_length_ms;
+   inst_ptr->lib_io_config.bytes_per_sample = bits_per_sample >> 3;
+
+   inst_ptr->lib_mem_config.lib_instance_mem_size = mem_size;
+   inst_ptr->lib_mem_config.lib_stack_mem_size    = 0;
+   inst_ptr->lib_mem_config.num_in_samples        = (inp_sampling_rate / 1000) * frame_length_ms;
+   inst_ptr->lib_mem_config.num_out_samples       = (out_sampling_rate / 1000) * frame_length_ms;
+
+   inst_ptr->lib_mem_ptr = (iir_resampler_t *)rs_ptr;
+   iir_rs_ptr->num_ports = 1;
+   return AR_EOK;
+}
+
+ar_result_t iir_rs_lib_clear_algo_memory(iir_rs_lib_t *iir_rs_ptr)
+{
+   polyphase_rs_t *rs_ptr = iir_rs_pp_get_inst(iir_rs_ptr);
+   if (NULL == rs_ptr)
+   {
+      return AR_EBADPARAM;
+   }
+
+   polyphase_rs_reset(rs_ptr);
+   return AR_EOK;
+}
+
+ar_result_t iir_rs_process(iir_rs_lib_t *iir_rs_ptr,
+                           int8        **input_data_ptr,
+                           int8        **output_data_ptr,
+                           uint32        num_in_samples,
+                           uint32        num_out_samples)
+{
+   polyphase_rs_t *rs_ptr = iir_rs_pp_get_inst(iir_rs_ptr);
+   if (NULL == rs_ptr)
+   {
+      return AR_EBADPARAM;
+   }
+
+   uint32_t in_samples  = num_in_samples;
+   uint32_t out_samples = num_out_samples;
+   polyphase_rs_process(rs_ptr, (void **)input_data_ptr, &in_samples, (void **)output_data_ptr, &out_samples);
+
+   // frames are a whole number of samples at both rates, a short frame only happens with a mismatched caller
+   if ((in_samples != num_in_samples) || (out_samples != num_out_samples))
+   {
+      AR_MSG(DBG_ERROR_PRIO,
+             "iir_rs_lib: frame mismatch, consumed %lu of %lu, generated %lu of %lu",
+             in_samples,
+             num_in_samples,
+             out_samples,
+             num_out_samples);
+      for (uint32_t ch = 0; ch < iir_rs_ptr->lib_instance_per_port_ptr[0].lib_io_config.out_channels; ch++)
+      {
+         memset(output_data_ptr[ch] + (out_samples << 1), 0, (num_out_samples - out_samples) << 1);
+      }
+   }
+   return AR_EOK;
+}
+
+uint32_t iir_rs_lib_get_kpps(iir_rs_lib_t *iir_rs_ptr, uint32_t input_samp_rate, uint32_t output_samp_rate)
+{
+   polyphase_rs_t *rs_ptr = iir_rs_pp_get_inst(iir_rs_ptr);
+   return (NULL != rs_ptr) ? (uint32_t)(polyphase_rs_get_macs_per_sec(rs_ptr) / 1000) : 0;
+}
+
+uint32_t iir_rs_lib_get_delay(iir_rs_lib_t *iir_rs_ptr, uint32_t input_samp_rate, uint32_t output_samp_rate)
+{
+   polyphase_rs_t *rs_ptr = iir_rs_pp_get_inst(iir_rs_ptr);
+   return (NULL != rs_ptr) ? polyphase_rs_get_delay_us(rs_ptr) : 0;
+}
+
+uint32_t iir_rs_lib_get_bw(iir_rs_lib_t *iir_rs_ptr, uint32_t input_samp_rate)
+{
+   polyphase_rs_t *rs_ptr = iir_rs_pp_get_inst(iir_rs_ptr);
+   if (NULL == rs_ptr)
+   {
+      return 0;
+   }
+
+   const polyphase_rs_config_t *cfg_ptr = polyphase_rs_get_config(rs_ptr);
+   return (cfg_ptr->in_sample_rate + cfg_ptr->out_sample_rate) * cfg_ptr->num_channels * sizeof(int16_t);
+}
@@ -0,0 +1,648 @@
+/**
+ * \file polyphase_rs.c
+ * \brief
+ *    Filter design and processing of the portable polyphase resampler.
+ *
+ *    Output n is taken at input position t = t0 + n * in_rate / out_rate, counted in input samples from the first
+ *    unconsumed input. It is the dot product of the num_taps input samples ending at floor(t) with the filter phase
+ *    of frac(t). Positions are kept in integer units: 1/L of an input sample for exact ratios, 2^-32 otherwise.
+ *
+ *    Every channel has a float buffer which holds the last num_taps input samples followed by up to
+ *    POLYPHASE_RS_CHUNK_SAMPLES new ones. The next output position is >= -1, i.e. an output never needs more than the
+ *    history and the new input.
+ *
+ *    A dynamic mode rate change applies to the input which follows it. The filter center lags the output position by
+ *    num_taps / 2 input samples, so the new step is used only once the center reaches that input. Switching at the
+ *    newest sample instead would time the outputs of the old rate input with the new rate, which shows up as phase
+ *    modulation when the rate drifts.
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "polyphase_rs_i.h"
+
+/* =======================================================================
+Macros
+========================================================================== */
+
+/** New input samples per channel converted and filtered per pass */
+#define POLYPHASE_RS_CHUNK_SAMPLES (512)
+
+/** Max coefficients in the table. Exact ratios which need more use interpolated phases. */
+#define POLYPHASE_RS_MAX_COEFS (64 * 1024)
+
+/** Phases of the interpolated mode, power of 2. Fewer phases are used for long (down sampling) filters. */
+#define POLYPHASE_RS_MAX_INTERP_PHASES (256)
+#define POLYPHASE_RS_MIN_INTERP_PHASES (32)
+
+/** Pass band and stop band edge, as fraction of the Nyquist frequency of the lower rate */
+#define POLYPHASE_RS_PASS_BAND (0.85)
+#define POLYPHASE_RS_STOP_BAND (1.0)
+
+#define POLYPHASE_RS_Q32_ONE ((uint64_t)1 << 32)
+
+#define POLYPHASE_RS_ALIGN_UP(x, a) ((((x) + (a)-1) / (a)) * (a))
+
+#define POLYPHASE_RS_PI (3.14159265358979323846)
+
+/* =======================================================================
+Structure Definitions
+========================================================================== */
+
+/** Sizes which follow from the config, computed the same way for the memory query and the init */
+typedef struct polyphase_rs_layout_t
+{
+   uint32_t num_taps;
+   uint32_t num_rows;   /**< Rows of the coefficient table */
+   uint32_t num_phases; /**< L in exact mode, interpolated phases otherwise */
+   bool_t   is_exact;
+   uint32_t up_factor;   /**< L */
+   uint32_t down_factor; /**< M */
+   uint32_t struct_size;
+   uint32_t coef_size;
+   uint32_t buf_len; /**< Floats per channel buffer */
+} polyphase_rs_layout_t;
+
+struct polyphase_rs_t
+{
+   polyphase_rs_config_t cfg;
+   polyphase_rs_layout_t layout;
+
+   uint32_t phase_shift;    /**< Interpolated mode: 32 - log2(num_phases) */
+   uint32_t design_in_rate; /**< Input rate the filter was designed for */
+
+   uint64_t pos_one;    /**< Position units per input sample */
+   uint64_t step;       /**< Position units per output */
+   uint64_t step_whole; /**< Whole input samples per output */
+   uint64_t step_rem;   /**< Remaining position units per output */
+   int64_t  pos;        /**< Position of the next output, >= -pos_one */
+
+   bool_t   is_step_pending; /**< Dynamic mode: the step of a new input rate is used from switch_pos on */
+   uint64_t pending_step;
+   int64_t  switch_pos;
+
+   float *coef_ptr;
+   float *buf_ptr;
+
+   polyphase_rs_kernel_t            kernel;
+   const polyphase_rs_kernel_fns_t *fns_ptr;
+};
+
+/* =======================================================================
+Static Function Definitions
+========================================================================== */
+
+static uint32_t polyphase_rs_gcd(uint32_t a, uint32_t b)
+{
+   while (0 != b)
+   {
+      uint32_t t = a % b;
+      a          = b;
+      b          = t;
+   }
+   return a;
+}
+
+static ar_result_t polyphase_rs_get_layout(const polyphase_rs_config_t *cfg_ptr, polyphase_rs_layout_t *layout_ptr)
+{
+   if ((0 == cfg_ptr->in_sample_rate) || (0 == cfg_ptr->out_sample_rate) ||
+       (POLYPHASE_RS_MAX_SAMPLE_RATE < cfg_ptr->in_sample_rate) ||
+       (POLYPHASE_RS_MAX_SAMPLE_RATE < cfg_ptr->out_sample_rate) ||
+       (cfg_ptr->in_sample_rate > POLYPHASE_RS_MAX_DOWN_RATIO * cfg_ptr->out_sample_rate) ||
+       (0 == cfg_ptr->num_channels) || (POLYPHASE_RS_MAX_CHANNELS < cfg_ptr->num_channels) ||
+       ((16 != cfg_ptr->bits_per_sample) && (32 != cfg_ptr->bits_per_sample)) || (31 < cfg_ptr->q_factor))
+   {
+      return AR_EUNSUPPORTED;
+   }
+
+   uint32_t base_taps = (0 != cfg_ptr->num_taps) ? cfg_ptr->num_taps : POLYPHASE_RS_TAPS_HIGH_QUALITY;
+   uint32_t num_taps  = base_taps;
+
+   // down sampling: the transition band is narrower at the input rate, in input samples the filter is longer
+   if (cfg_ptr->in_sample_rate > cfg_ptr->out_sample_rate)
+   {
+      num_taps = (uint32_t)(((uint64_t)base_taps * cfg_ptr->in_sample_rate + cfg_ptr->out_sample_rate - 1) /
+                            cfg_ptr->out_sample_rate);
+   }
+   num_taps = POLYPHASE_RS_ALIGN_UP(num_taps, POLYPHASE_RS_TAP_ALIGN);
+
+   uint32_t gcd            = polyphase_rs_gcd(cfg_ptr->in_sample_rate, cfg_ptr->out_sample_rate);
+   layout_ptr->num_taps    = num_taps;
+   layout_ptr->up_factor   = cfg_ptr->out_sample_rate / gcd;
+   layout_ptr->down_factor = cfg_ptr->in_sample_rate / gcd;
+   layout_ptr->is_exact =
+      (!cfg_ptr->is_dynamic && ((uint64_t)layout_ptr->up_factor * num_taps <= POLYPHASE_RS_MAX_COEFS)) ? TRUE : FALSE;
+
+   if (layout_ptr->is_exact)
+   {
+      layout_ptr->num_phases = layout_ptr->up_factor;
+      layout_ptr->num_rows   = layout_ptr->up_factor;
+   }
+   else
+   {
+      uint32_t num_phases = POLYPHASE_RS_MAX_INTERP_PHASES;
+      while ((num_phases > POLYPHASE_RS_MIN_INTERP_PHASES) && ((num_phases + 1) * num_taps > POLYPHASE_RS_MAX_COEFS))
+      {
+         num_phases >>= 1;
+      }
+      layout_ptr->num_phases = num_phases;
+      // one more row, so that phase p + 1 exists for every p
+      layout_ptr->num_rows = num_phases + 1;
+   }
+
+   layout_ptr->buf_len     = num_taps + POLYPHASE_RS_CHUNK_SAMPLES;
+   layout_ptr->struct_size = POLYPHASE_RS_ALIGN_UP(sizeof(polyphase_rs_t), 32);
+   layout_ptr->coef_size   = layout_ptr->num_rows * num_taps * sizeof(float);
+   return AR_EOK;
+}
+
+/** Zeroth order modified Bessel function of the first kind, for the Kaiser window */
+static double polyphase_rs_bessel_i0(double x)
+{
+   double sum  = 1.0;
+   double term = 1.0;
+   double half = x / 2.0;
+   for (uint32_t k = 1; k < 64; k++)
+   {
+      term *= (half / k) * (half / k);
+      sum += term;
+      if (term < sum * 1e-12)
+      {
+         break;
+      }
+   }
+   return sum;
+}
+
+/** Fills the coefficient table with the phases of a Kaiser windowed sinc. Row p is the filter for fractional position
+ *  p / num_phases. Taps are in input order, the last tap is applied to the newest sample. */
+static void polyphase_rs_design(polyphase_rs_t *me_ptr)
+{
+   const polyphase_rs_config_t *cfg_ptr  = &me_ptr->cfg;
+   uint32_t                     num_taps = me_ptr->layout.num_taps;
+   double                       ratio    = (double)cfg_ptr->out_sample_rate / cfg_ptr->in_sample_rate;
+   double                       scale    = (ratio < 1.0) ? ratio : 1.0;
+
+   // cutoff in the middle of the transition band, normalized to the input Nyquist frequency
+   double cutoff = scale * (POLYPHASE_RS_PASS_BAND + POLYPHASE_RS_STOP_BAND) / 2.0;
+
+   // Kaiser estimate of the stop band attenuation for the taps at the lower rate, and the matching beta
+   double base_taps = num_taps * scale;
+   double atten_db  = 8.0 + 2.285 * POLYPHASE_RS_PI * (POLYPHASE_RS_STOP_BAND - POLYPHASE_RS_PASS_BAND) * base_taps;
+   double beta      = (atten_db > 50.0) ? 0.1102 * (atten_db - 8.7)
+                                        : 0.5842 * pow(atten_db - 21.0, 0.4) + 0.07886 * (atten_db - 21.0);
+   double i0_beta   = polyphase_rs_bessel_i0(beta);
+   double half_len  = num_taps / 2.0;
+
+   for (uint32_t row = 0; row < me_ptr->layout.num_rows; row++)
+   {
+      float *h_ptr = me_ptr->coef_ptr + row * num_taps;
+      double frac  = (double)row / me_ptr->layout.num_phases;
+      double sum   = 0.0;
+
+      for (uint32_t k = 0; k < num_taps; k++)
+      {
+         // distance of this tap from the filter center, which lags the output position by half the length
+         double tau = frac + (double)(num_taps - 1 - k) - half_len;
+         double x   = tau / half_len;
+         double win = (x * x < 1.0) ? polyphase_rs_bessel_i0(beta * sqrt(1.0 - x * x)) / i0_beta : 0.0;
+         double arg = POLYPHASE_RS_PI * cutoff * tau;
+         double snc = (0.0 == arg) ? 1.0 : sin(arg) / arg;
+         double h   = cutoff * snc * win;
+
+         h_ptr[k] = (float)h;
+         sum += h;
+      }
+
+      // unity DC gain on every phase
+      if (0.0 != sum)
+      {
+         for (uint32_t k = 0; k < num_taps; k++)
+         {
+            h_ptr[k] = (float)(h_ptr[k] / sum);
+         }
+      }
+   }
+}
+
+/** Position units per output for the configured rates */
+static uint64_t polyphase_rs_calc_step(polyphase_rs_t *me_ptr)
+{
+   if (me_ptr->layout.is_exact)
+   {
+      return me_ptr->layout.down_factor;
+   }
+   return (((uint64_t)me_ptr->cfg.in_sample_rate << 32) + (me_ptr->cfg.out_sample_rate >> 1)) /
+          me_ptr->cfg.out_sample_rate;
+}
+
+static void polyphase_rs_apply_step(polyphase_rs_t *me_ptr, uint64_t step)
+{
+   me_ptr->step       = step;
+   me_ptr->step_whole = step / me_ptr->pos_one;
+   me_ptr->step_rem   = step % me_ptr->pos_one;
+}
+
+/** Number of outputs before limit, from position pos */
+static uint32_t polyphase_rs_count_before(int64_t pos, uint64_t step, int64_t limit)
+{
+   if (pos >= limit)
+   {
+      return 0;
+   }
+   return (uint32_t)(((uint64_t)(limit - pos) + step - 1) / step);
+}
+
+/** Position pos, which is past the switch position in steps of the old rate, in steps of the new rate. The part of
+ *  the step before the switch stays at the old rate. */
+static int64_t polyphase_rs_rescale_pos(polyphase_rs_t *me_ptr, int64_t pos)
+{
+   double past = (double)(pos - me_ptr->switch_pos) * (double)me_ptr->pending_step / (double)me_ptr->step;
+   return me_ptr->switch_pos + (int64_t)llround(past);
+}
+
+/** Position of output out_idx from now, taking a pending rate change into account */
+static int64_t polyphase_rs_output_pos(polyphase_rs_t *me_ptr, uint32_t out_idx)
+{
+   if (me_ptr->is_step_pending)
+   {
+      uint32_t num_before = polyphase_rs_count_before(me_ptr->pos, me_ptr->step, me_ptr->switch_pos);
+      if (out_idx >= num_before)
+      {
+         int64_t first_after = polyphase_rs_rescale_pos(me_ptr, me_ptr->pos + (int64_t)(num_before * me_ptr->step));
+         return first_after + (int64_t)((uint64_t)(out_idx - num_before) * me_ptr->pending_step);
+      }
+   }
+   return me_ptr->pos + (int64_t)((uint64_t)out_idx * me_ptr->step);
+}
+
+static void polyphase_rs_convert_in(polyphase_rs_t *me_ptr, const void *in_ptr, float *dst_ptr, uint32_t num_samples)
+{
+   if (16 == me_ptr->cfg.bits_per_sample)
+   {
+      const int16_t *src_ptr = (const int16_t *)in_ptr;
+      const float    scale   = 1.0f / 32768.0f;
+      for (uint32_t i = 0; i < num_samples; i++)
+      {
+         dst_ptr[i] = src_ptr[i] * scale;
+      }
+   }
+   else
+   {
+      const int32_t *src_ptr = (const int32_t *)in_ptr;
+      const float    scale   = 1.0f / (float)((uint64_t)1 << me_ptr->cfg.q_factor);
+      for (uint32_t i = 0; i < num_samples; i++)
+      {
+         dst_ptr[i] = (float)src_ptr[i] * scale;
+      }
+   }
+}
+
+static inline void polyphase_rs_store_out(polyphase_rs_t *me_ptr, void *out_ptr, uint32_t idx, float y)
+{
+   if (16 == me_ptr->cfg.bits_per_sample)
+   {
+      float v = y * 32768.0f;
+      v       = (v > 32767.0f) ? 32767.0f : ((v < -32768.0f) ? -32768.0f : v);
+
+      ((int16_t *)out_ptr)[idx] = (int16_t)lrintf(v);
+   }
+   else
+   {
+      // 2^31 is the first float above INT32_MAX
+      float   v = y * (float)((uint64_t)1 << me_ptr->cfg.q_factor);
+      int32_t s = (v >= 2147483648.0f) ? INT32_MAX : ((v <= -2147483648.0f) ? INT32_MIN : (int32_t)lrintf(v));
+
+      ((int32_t *)out_ptr)[idx] = s;
+   }
+}
+
+/** Generates num_out outputs of one channel, starting at the current position. buf_ptr points to the history. */
+static void polyphase_rs_filter_channel(polyphase_rs_t *me_ptr,
+                                        const float    *buf_ptr,
+                                        void           *out_ptr,
+                                        uint32_t        out_offset,
+                                        uint32_t        num_out)
+{
+   const uint32_t num_taps = me_ptr->layout.num_taps;
+   const uint64_t pos_one  = me_ptr->pos_one;
+   const float   *coef_ptr = me_ptr->coef_ptr;
+   const uint64_t biased   = (uint64_t)(me_ptr->pos + (int64_t)pos_one);
+   uint64_t       idx      = biased / pos_one; // window start, floor(t) + 1
+   uint64_t       ph       = biased % pos_one;
+
+   if (me_ptr->layout.is_exact)
+   {
+      polyphase_rs_dot_fn_t dot_fn = me_ptr->fns_ptr->dot;
+      for (uint32_t n = 0; n < num_out; n++)
+      {
+         float y = dot_fn(buf_ptr + idx, coef_ptr + ph * num_taps, num_taps);
+         polyphase_rs_store_out(me_ptr, out_ptr, out_offset + n, y);
+
+         idx += me_ptr->step_whole;
+         ph += me_ptr->step_rem;
+         if (ph >= pos_one)
+         {
+            ph -= pos_one;
+            idx++;
+         }
+      }
+   }
+   else
+   {
+      polyphase_rs_dot2_fn_t dot2_fn    = me_ptr->fns_ptr->dot2;
+      const uint32_t         shift      = me_ptr->phase_shift;
+      const uint64_t         alpha_mask = ((uint64_t)1 << shift) - 1;
+      const float            alpha_unit = 1.0f / (float)((uint64_t)1 << shift);
+      for (uint32_t n = 0; n < num_out; n++)
+      {
+         const float *h0_ptr = coef_ptr + (ph >> shift) * num_taps;
+         float        alpha  = (float)(ph & alpha_mask) * alpha_unit;
+         float        y0, y1;
+         dot2_fn(buf_ptr + idx, h0_ptr, h0_ptr + num_taps, num_taps, &y0, &y1);
+         polyphase_rs_store_out(me_ptr, out_ptr, out_offset + n, y0 + alpha * (y1 - y0));
+
+         idx += me_ptr->step_whole;
+         ph += me_ptr->step_rem;
+         if (ph >= pos_one)
+         {
+            ph -= pos_one;
+            idx++;
+         }
+      }
+   }
+}
+
+/* =======================================================================
+Function Definitions
+========================================================================== */
+
+ar_result_t polyphase_rs_get_mem_req(const polyphase_rs_config_t *cfg_ptr, uint32_t *mem_size_ptr)
+{
+   polyphase_rs_layout_t layout;
+   ar_result_t           result = polyphase_rs_get_layout(cfg_ptr, &layout);
+   if (AR_EOK != result)
+   {
+      return result;
+   }
+
+   *mem_size_ptr = layout.struct_size + layout.coef_size + cfg_ptr->num_channels * layout.buf_len * sizeof(float);
+   return AR_EOK;
+}
+
+ar_result_t polyphase_rs_init(polyphase_rs_t             **rs_pptr,
+                              const polyphase_rs_config_t *cfg_ptr,
+                              void                        *mem_ptr,
+                              uint32_t                     mem_size)
+{
+   uint32_t    req_size = 0;
+   ar_result_t result   = polyphase_rs_get_mem_req(cfg_ptr, &req_size);
+   if (AR_EOK != result)
+   {
+      return result;
+   }
+   if ((NULL == mem_ptr) || (mem_size < req_size))
+   {
+      return AR_EBADPARAM;
+   }
+
+   polyphase_rs_t *me_ptr = (polyphase_rs_t *)mem_ptr;
+   memset(me_ptr, 0, sizeof(*me_ptr));
+   me_ptr->cfg = *cfg_ptr;
+   polyphase_rs_get_layout(cfg_ptr, &me_ptr->layout);
+
+   me_ptr->coef_ptr       = (float *)((int8_t *)mem_ptr + me_ptr->layout.struct_size);
+   me_ptr->buf_ptr        = (float *)((int8_t *)me_ptr->coef_ptr + me_ptr->layout.coef_size);
+   me_ptr->design_in_rate = cfg_ptr->in_sample_rate;
+
+   if (!me_ptr->layout.is_exact)
+   {
+      uint32_t log2_phases = 0;
+      while (((uint32_t)1 << log2_phases) < me_ptr->layout.num_phases)
+      {
+         log2_phases++;
+      }
+      me_ptr->phase_shift = 32 - log2_phases;
+   }
+
+   me_ptr->pos_one = me_ptr->layout.is_exact ? me_ptr->layout.up_factor : POLYPHASE_RS_Q32_ONE;
+
+   polyphase_rs_design(me_ptr);
+   polyphase_rs_apply_step(me_ptr, polyphase_rs_calc_step(me_ptr));
+   polyphase_rs_set_kernel(me_ptr, POLYPHASE_RS_KERNEL_AUTO);
+   polyphase_rs_reset(me_ptr);
+
+   *rs_pptr = me_ptr;
+   return AR_EOK;
+}
+
+const polyphase_rs_config_t *polyphase_rs_get_config(polyphase_rs_t *rs_ptr)
+{
+   return &rs_ptr->cfg;
+}
+
+void polyphase_rs_reset(polyphase_rs_t *rs_ptr)
+{
+   memset(rs_ptr->buf_ptr, 0, rs_ptr->cfg.num_channels * rs_ptr->layout.buf_len * sizeof(float));
+   rs_ptr->pos = 0;
+
+   if (rs_ptr->is_step_pending)
+   {
+      polyphase_rs_apply_step(rs_ptr, rs_ptr->pending_step);
+      rs_ptr->is_step_pending = FALSE;
+   }
+}
+
+ar_result_t polyphase_rs_set_in_rate(polyphase_rs_t *rs_ptr, uint32_t in_sample_rate)
+{
+   if (in_sample_rate == rs_ptr->cfg.in_sample_rate)
+   {
+      return AR_EOK;
+   }
+
+   uint32_t design_rate = rs_ptr->design_in_rate;
+   uint32_t diff = (in_sample_rate > design_rate) ? (in_sample_rate - design_rate) : (design_rate - in_sample_rate);
+   if (!rs_ptr->cfg.is_dynamic ||
+       ((uint64_t)diff * 100 > (uint64_t)design_rate * POLYPHASE_RS_DYNAMIC_MAX_DRIFT_PERCENT))
+   {
+      return AR_EUNSUPPORTED;
+   }
+
+   // a change which did not take effect yet is overtaken, its input was shorter than the filter delay
+   if (rs_ptr->is_step_pending)
+   {
+      polyphase_rs_apply_step(rs_ptr, rs_ptr->pending_step);
+   }
+
+   // position and history stay, the new step is used once the filter center reaches the next input
+   rs_ptr->cfg.in_sample_rate = in_sample_rate;
+   rs_ptr->pending_step       = polyphase_rs_calc_step(rs_ptr);
+   rs_ptr->switch_pos         = (int64_t)(rs_ptr->layout.num_taps / 2) * (int64_t)rs_ptr->pos_one;
+   rs_ptr->is_step_pending    = TRUE;
+   return AR_EOK;
+}
+
+ar_result_t polyphase_rs_set_kernel(polyphase_rs_t *rs_ptr, polyphase_rs_kernel_t kernel)
+{
+   if (POLYPHASE_RS_KERNEL_AUTO == kernel)
+   {
+      kernel = polyphase_rs_get_best_kernel();
+   }
+
+   const polyphase_rs_kernel_fns_t *fns_ptr = polyphase_rs_get_kernel_fns(kernel);
+   if (NULL == fns_ptr)
+   {
+      return AR_EUNSUPPORTED;
+   }
+
+   rs_ptr->kernel  = kernel;
+   rs_ptr->fns_ptr = fns_ptr;
+   return AR_EOK;
+}
+
+polyphase_rs_kernel_t polyphase_rs_get_kernel(polyphase_rs_t *rs_ptr)
+{
+   return rs_ptr->kernel;
+}
+
+const char *polyphase_rs_kernel_name(polyphase_rs_kernel_t kernel)
+{
+   switch (kernel)
+   {
+      case POLYPHASE_RS_KERNEL_AUTO:
+         return "auto";
+      case POLYPHASE_RS_KERNEL_SCALAR:
+         return "scalar";
+      case POLYPHASE_RS_KERNEL_SSE2:
+         return "sse2";
+      case POLYPHASE_RS_KERNEL_AVX2:
+         return "avx2";
+      case POLYPHASE_RS_KERNEL_NEON:
+         return "neon";
+      default:
+         return "unknown";
+   }
+}
+
+void polyphase_rs_process(polyphase_rs_t *rs_ptr,
+                          void          **in_pptr,
+                          uint32_t       *in_samples_ptr,
+                          void          **out_pptr,
+                          uint32_t       *out_samples_ptr)
+{
+   const uint32_t num_taps = rs_ptr->layout.num_taps;
+   const uint32_t buf_len  = rs_ptr->layout.buf_len;
+   const uint32_t in_bytes = rs_ptr->cfg.bits_per_sample >> 3;
+   uint32_t       in_avail = *in_samples_ptr;
+   uint32_t       out_max  = *out_samples_ptr;
+   uint32_t       in_done  = 0;
+   uint32_t       out_done = 0;
+
+   while (out_done < out_max)
+   {
+      uint32_t chunk = in_avail - in_done;
+      chunk          = (chunk > POLYPHASE_RS_CHUNK_SAMPLES) ? POLYPHASE_RS_CHUNK_SAMPLES : chunk;
+      int64_t  limit = (int64_t)chunk * (int64_t)rs_ptr->pos_one;
+
+      for (uint32_t ch = 0; ch < rs_ptr->cfg.num_channels; ch++)
+      {
+         float *buf_ptr = rs_ptr->buf_ptr + ch * buf_len;
+         polyphase_rs_convert_in(rs_ptr, (int8_t *)in_pptr[ch] + in_done * in_bytes, buf_ptr + num_taps, chunk);
+      }
+
+      // outputs in runs of one step, a pending rate change splits the chunk
+      while (out_done < out_max)
+      {
+         bool_t   at_switch = (rs_ptr->is_step_pending && (rs_ptr->switch_pos < limit)) ? TRUE : FALSE;
+         int64_t  run_limit = at_switch ? rs_ptr->switch_pos : limit;
+         uint32_t num_out   = polyphase_rs_count_before(rs_ptr->pos, rs_ptr->step, run_limit);
+         num_out            = (num_out > out_max - out_done) ? (out_max - out_done) : num_out;
+
+         for (uint32_t ch = 0; ch < rs_ptr->cfg.num_channels; ch++)
+         {
+            polyphase_rs_filter_channel(rs_ptr, rs_ptr->buf_ptr + ch * buf_len, out_pptr[ch], out_done, num_out);
+         }
+         rs_ptr->pos += (int64_t)((uint64_t)num_out * rs_ptr->step);
+         out_done += num_out;
+
+         if (!at_switch || (rs_ptr->pos < run_limit))
+         {
+            break;
+         }
+         rs_ptr->pos = polyphase_rs_rescale_pos(rs_ptr, rs_ptr->pos);
+         polyphase_rs_apply_step(rs_ptr, rs_ptr->pending_step);
+         rs_ptr->is_step_pending = FALSE;
+      }
+
+      // consume up to the sample before the next output position, so that it stays >= -1
+      uint64_t next     = (uint64_t)(rs_ptr->pos + (int64_t)rs_ptr->pos_one) / rs_ptr->pos_one;
+      uint32_t consumed = (next < chunk) ? (uint32_t)next : chunk;
+
+      if (0 != consumed)
+      {
+         for (uint32_t ch = 0; ch < rs_ptr->cfg.num_channels; ch++)
+         {
+            float *buf_ptr = rs_ptr->buf_ptr + ch * buf_len;
+            memmove(buf_ptr, buf_ptr + consumed, num_taps * sizeof(float));
+         }
+         rs_ptr->pos -= (int64_t)consumed * (int64_t)rs_ptr->pos_one;
+         rs_ptr->switch_pos -= (int64_t)consumed * (int64_t)rs_ptr->pos_one;
+      }
+
+      in_done += consumed;
+
+      if ((consumed < chunk) || (0 == chunk))
+      {
+         break;
+      }
+   }
+
+   *in_samples_ptr  = in_done;
+   *out_samples_ptr = out_done;
+}
+
+uint32_t polyphase_rs_calc_fixed_out(polyphase_rs_t *rs_ptr, uint32_t out_samples)
+{
+   if (0 == out_samples)
+   {
+      return 0;
+   }
+
+   // position of the last output, the input up to its floor is needed
+   int64_t last = polyphase_rs_output_pos(rs_ptr, out_samples - 1);
+   return (uint32_t)((uint64_t)(last + (int64_t)rs_ptr->pos_one) / rs_ptr->pos_one);
+}
+
+uint32_t polyphase_rs_calc_fixed_in(polyphase_rs_t *rs_ptr, uint32_t in_samples)
+{
+   int64_t limit = (int64_t)in_samples * (int64_t)rs_ptr->pos_one;
+   if (!rs_ptr->is_step_pending || (limit <= rs_ptr->switch_pos))
+   {
+      return polyphase_rs_count_before(rs_ptr->pos, rs_ptr->step, limit);
+   }
+
+   uint32_t num_before = polyphase_rs_count_before(rs_ptr->pos, rs_ptr->step, rs_ptr->switch_pos);
+   int64_t  first_after = polyphase_rs_rescale_pos(rs_ptr, rs_ptr->pos + (int64_t)(num_before * rs_ptr->step));
+   return num_before + polyphase_rs_count_before(first_after, rs_ptr->pending_step, limit);
+}
+
+uint32_t polyphase_rs_get_delay_us(polyphase_rs_t *rs_ptr)
+{
+   return (uint32_t)(((uint64_t)rs_ptr->layout.num_taps * 500000) / rs_ptr->cfg.in_sample_rate);
+}
+
+uint64_t polyphase_rs_get_macs_per_sec(polyphase_rs_t *rs_ptr)
+{
+   uint64_t macs_per_out = rs_ptr->layout.is_exact ? rs_ptr->layout.num_taps : 2 * rs_ptr->layout.num_taps;
+   return macs_per_out * rs_ptr->cfg.out_sample_rate * rs_ptr->cfg.num_channels;
+}
+
+uint32_t polyphase_rs_get_coef_size(polyphase_rs_t *rs_ptr)
+{
+   return rs_ptr->layout.coef_size;
+}
@@ -0,0 +1,51 @@
+/**
+ * \file polyphase_rs_i.h
+ * \brief
+ *    Internal declarations of the polyphase resampler, shared between the engine and the dot product kernels.
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef POLYPHASE_RS_I_H
+#define POLYPHASE_RS_I_H
+
+#include "polyphase_rs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /*__cplusplus*/
+
+/** Number of taps is a multiple of this, so that kernels need no tail loop */
+#define POLYPHASE_RS_TAP_ALIGN (8)
+
+/** y = sum(x[k] * h[k]) */
+typedef float (*polyphase_rs_dot_fn_t)(const float *x_ptr, const float *h_ptr, uint32_t num_taps);
+
+/** *y0_ptr = sum(x[k] * h0[k]), *y1_ptr = sum(x[k] * h1[k]), for interpolating between two adjacent phases */
+typedef void (*polyphase_rs_dot2_fn_t)(const float *x_ptr,
+                                       const float *h0_ptr,
+                                       const float *h1_ptr,
+                                       uint32_t     num_taps,
+                                       float       *y0_ptr,
+                                       float       *y1_ptr);
+
+typedef struct polyphase_rs_kernel_fns_t
+{
+   polyphase_rs_dot_fn_t  dot;
+   polyphase_rs_dot2_fn_t dot2;
+} polyphase_rs_kernel_fns_t;
+
+/** Kernel functions, NULL if the kernel is not built in or not supported by this cpu. Not for
+ *  POLYPHASE_RS_KERNEL_AUTO. */
+const polyphase_rs_kernel_fns_t *polyphase_rs_get_kernel_fns(polyphase_rs_kernel_t kernel);
+
+/** Fastest kernel supported by this cpu */
+polyphase_rs_kernel_t polyphase_rs_get_best_kernel(void);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif // POLYPHASE_RS_I_H
@@ -0,0 +1,271 @@
+/**
+ * \file polyphase_rs_kernels.c
+ * \brief
+ *    Dot product kernels of the polyphase resampler. The scalar kernel is the reference, the SIMD kernels only change
+ *    the order of the additions.
+ *
+ *    SSE2 is part of the x86-64 baseline. The AVX2/FMA kernel is compiled with a function level target, so the rest
+ *    of the build needs no -mavx2, and is only used if the cpu reports both features. NEON is used when the compiler
+ *    targets it.
+ *
+ * \copyright
+ *  Copyright (c) Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *  SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "polyphase_rs_i.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define POLYPHASE_RS_HAS_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__)
+#define POLYPHASE_RS_HAS_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define POLYPHASE_RS_HAS_NEON
+#include <arm_neon.h>
+#endif
+
+/* =======================================================================
+Scalar
+========================================================================== */
+
+static float polyphase_rs_dot_scalar(const float *x_ptr, const float *h_ptr, uint32_t num_taps)
+{
+   float acc = 0.0f;
+   for (uint32_t k = 0; k < num_taps; k++)
+   {
+      acc += x_ptr[k] * h_ptr[k];
+   }
+   return acc;
+}
+
+static void polyphase_rs_dot2_scalar(const float *x_ptr,
+                                     const float *h0_ptr,
+                                     const float *h1_ptr,
+                                     uint32_t     num_taps,
+                                     float       *y0_ptr,
+                                     float       *y1_ptr)
+{
+   float acc0 = 0.0f;
+   float acc1 = 0.0f;
+   for (uint32_t k = 0; k < num_taps; k++)
+   {
+      acc0 += x_ptr[k] * h0_ptr[k];
+      acc1 += x_ptr[k] * h1_ptr[k];
+   }
+   *y0_ptr = acc0;
+   *y1_ptr = acc1;
+}
+
+static const polyphase_rs_kernel_fns_t polyphase_rs_kernel_scalar = { polyphase_rs_dot_scalar,
+                                                                      polyphase_rs_dot2_scalar };
+
+/* =======================================================================
+SSE2
+========================================================================== */
+#ifdef POLYPHASE_RS_HAS_SSE2
+
+static inline float polyphase_rs_hsum_sse2(__m128 v)
+{
+   __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+   __m128 sums = _mm_add_ps(v, shuf);
+   shuf        = _mm_movehl_ps(shuf, sums);
+   sums        = _mm_add_ss(sums, shuf);
+   return _mm_cvtss_f32(sums);
+}
+
+static float polyphase_rs_dot_sse2(const float *x_ptr, const float *h_ptr, uint32_t num_taps)
+{
+   __m128 acc0 = _mm_setzero_ps();
+   __m128 acc1 = _mm_setzero_ps();
+   for (uint32_t k = 0; k < num_taps; k += 8)
+   {
+      acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(x_ptr + k), _mm_loadu_ps(h_ptr + k)));
+      acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(x_ptr + k + 4), _mm_loadu_ps(h_ptr + k + 4)));
+   }
+   return polyphase_rs_hsum_sse2(_mm_add_ps(acc0, acc1));
+}
+
+static void polyphase_rs_dot2_sse2(const float *x_ptr,
+                                   const float *h0_ptr,
+                                   const float *h1_ptr,
+                                   uint32_t     num_taps,
+                                   float       *y0_ptr,
+                                   float       *y1_ptr)
+{
+   __m128 acc0 = _mm_setzero_ps();
+   __m128 acc1 = _mm_setzero_ps();
+   for (uint32_t k = 0; k < num_taps; k += 4)
+   {
+      __m128 x = _mm_loadu_ps(x_ptr + k);
+      acc0     = _mm_add_ps(acc0, _mm_mul_ps(x, _mm_loadu_ps(h0_ptr + k)));
+      acc1     = _mm_add_ps(acc1, _mm_mul_ps(x, _mm_loadu_ps(h1_ptr + k)));
+   }
+   *y0_ptr = polyphase_rs_hsum_sse2(acc0);
+   *y1_ptr = polyphase_rs_hsum_sse2(acc1);
+}
+
+static const polyphase_rs_kernel_fns_t polyphase_rs_kernel_sse2 = { polyphase_rs_dot_sse2, polyphase_rs_dot2_sse2 };
+
+#endif // POLYPHASE_RS_HAS_SSE2
+
+/* =======================================================================
+AVX2 + FMA
+========================================================================== */
+#ifdef POLYPHASE_RS_HAS_AVX2
+
+__attribute__((target("avx2,fma"))) static inline float polyphase_rs_hsum_avx2(__m256 v)
+{
+   __m128 lo = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+   __m128 sh = _mm_movehdup_ps(lo);
+   __m128 s  = _mm_add_ps(lo, sh);
+   sh        = _mm_movehl_ps(sh, s);
+   s         = _mm_add_ss(s, sh);
+   return _mm_cvtss_f32(s);
+}
+
+__attribute__((target("avx2,fma"))) static float polyphase_rs_dot_avx2(const float *x_ptr,
+                                                                        const float *h_ptr,
+                                                                        uint32_t     num_taps)
+{
+   __m256   acc0 = _mm256_setzero_ps();
+   __m256   acc1 = _mm256_setzero_ps();
+   uint32_t k    = 0;
+   for (; k + 16 <= num_taps; k += 16)
+   {
+      acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(x_ptr + k), _mm256_loadu_ps(h_ptr + k), acc0);
+      acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(x_ptr + k + 8), _mm256_loadu_ps(h_ptr + k + 8), acc1);
+   }
+   if (k < num_taps)
+   {
+      acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(x_ptr + k), _mm256_loadu_ps(h_ptr + k), acc0);
+   }
+   return polyphase_rs_hsum_avx2(_mm256_add_ps(acc0, acc1));
+}
+
+__attribute__((target("avx2,fma"))) static void polyphase_rs_dot2_avx2(const float *x_ptr,
+                                                                        const float *h0_ptr,
+                                                                        const float *h1_ptr,
+                                                                        uint32_t     num_taps,
+                                                                        float       *y0_ptr,
+                                                                        float       *y1_ptr)
+{
+   __m256 acc0 = _mm256_setzero_ps();
+   __m256 acc1 = _mm256_setzero_ps();
+   for (uint32_t k = 0; k < num_taps; k += 8)
+   {
+      __m256 x = _mm256_loadu_ps(x_ptr + k);
+      acc0     = _mm256_fmadd_ps(x, _mm256_loadu_ps(h0_ptr + k), acc0);
+      acc1     = _mm256_fmadd_ps(x, _mm256_loadu_ps(h1_ptr + k), acc1);
+   }
+   *y0_ptr = polyphase_rs_hsum_avx2(acc0);
+   *y1_ptr = polyphase_rs_hsum_avx2(acc1);
+}
+
+static const polyphase_rs_kernel_fns_t polyphase_rs_kernel_avx2 = { polyphase_rs_dot_avx2, polyphase_rs_dot2_avx2 };
+
+static bool_t polyphase_rs_cpu_has_avx2(void)
+{
+   __builtin_cpu_init();
+   return (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) ? TRUE : FALSE;
+}
+
+#endif // POLYPHASE_RS_HAS_AVX2
+
+/* =======================================================================
+NEON
+========================================================================== */
+#ifdef POLYPHASE_RS_HAS_NEON
+
+static inline float polyphase_rs_hsum_neon(float32x4_t v)
+{
+#if defined(__aarch64__)
+   return vaddvq_f32(v);
+#else
+   float32x2_t s = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+   return vget_lane_f32(vpadd_f32(s, s), 0);
+#endif
+}
+
+static float polyphase_rs_dot_neon(const float *x_ptr, const float *h_ptr, uint32_t num_taps)
+{
+   float32x4_t acc0 = vdupq_n_f32(0.0f);
+   float32x4_t acc1 = vdupq_n_f32(0.0f);
+   for (uint32_t k = 0; k < num_taps; k += 8)
+   {
+      acc0 = vmlaq_f32(acc0, vld1q_f32(x_ptr + k), vld1q_f32(h_ptr + k));
+      acc1 = vmlaq_f32(acc1, vld1q_f32(x_ptr + k + 4), vld1q_f32(h_ptr + k + 4));
+   }
+   return polyphase_rs_hsum_neon(vaddq_f32(acc0, acc1));
+}
+
+static void polyphase_rs_dot2_neon(const float *x_ptr,
+                                   const float *h0_ptr,
+                                   const float *h1_ptr,
+                                   uint32_t     num_taps,
+                                   float       *y0_ptr,
+                                   float       *y1_ptr)
+{
+   float32x4_t acc0 = vdupq_n_f32(0.0f);
+   float32x4_t acc1 = vdupq_n_f32(0.0f);
+   for (uint32_t k = 0; k < num_taps; k += 4)
+   {
+      float32x4_t x = vld1q_f32(x_ptr + k);
+      acc0          = vmlaq_f32(acc0, x, vld1q_f32(h0_ptr + k));
+      acc1          = vmlaq_f32(acc1, x, vld1q_f32(h1_ptr + k));
+   }
+   *y0_ptr = polyphase_rs_hsum_neon(acc0);
+   *y1_ptr = polyphase_rs_hsum_neon(acc1);
+}
+
+static const polyphase_rs_kernel_fns_t polyphase_rs_kernel_neon = { polyphase_rs_dot_neon, polyphase_rs_dot2_neon };
+
+#endif // POLYPHASE_RS_HAS_NEON
+
+/* =======================================================================
+Selection
+========================================================================== */
+
+const polyphase_rs_kernel_fns_t *polyphase_rs_get_kernel_fns(polyphase_rs_kernel_t kernel)
+{
+   switch (kernel)
+   {
+      case POLYPHASE_RS_KERNEL_SCALAR:
+         return &polyphase_rs_kernel_scalar;
+#ifdef POLYPHASE_RS_HAS_SSE2
+      case POLYPHASE_RS_KERNEL_SSE2:
+         return &polyphase_rs_kernel_sse2;
+#endif
+#ifdef POLYPHASE_RS_HAS_AVX2
+      case POLYPHASE_RS_KERNEL_AVX2:
+         return polyphase_rs_cpu_has_avx2() ? &polyphase_rs_kernel_avx2 : NULL;
+#endif
+#ifdef POLYPHASE_RS_HAS_NEON
+      case POLYPHASE_RS_KERNEL_NEON:
+         return &polyphase_rs_kernel_neon;
+#endif
+      default:
+         return NULL;
+   }
+}
+
+polyphase_rs_kernel_t polyphase_rs_get_best_kernel(void)
+{
+#ifdef POLYPHASE_RS_HAS_AVX2
+   if (polyphase_rs_cpu_has_avx2())
+   {
+      return POLYPHASE_RS_KERNEL_AVX2;
+   }
+#endif
+#ifdef POLYPHASE_RS_HAS_SSE2
+   return POLYPHASE_RS_KERNEL_SSE2;
+#elif defined(POLYPHASE_RS_HAS_NEON)
+   return POLYPHASE_RS_KERNEL_NEON;
+#else
+   return POLYPHASE_RS_KERNEL_SCALAR;
+#endif
+}
@@ -275,6 +275,7 @@ class CSoftVolumeControlsLib
    void ApplySteadyGain(void *pOutPtr, void *pInPtr, const uint32 gainQ28, uint32 samples);
    void ApplySteadyGain16(void *pOutPtr, void *pInPtr, const uint32 gainQ28, uint32 samples);
    void ApplySteadyGain32(void *pOutPtr, void *pInPtr, const uint32 gainQ28, uint32 samples);
+   boolean ApplyUnityOrZeroGain(void *pOutPtr, void *pInPtr, const uint32 gainQ28, uint32 samples);
    void IncrementPointer(void **pPtr, uint32 samples);
 
    // Threshold functions
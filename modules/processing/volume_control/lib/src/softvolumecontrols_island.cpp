@@ -2006,11 +2006,38 @@ uint32 CSoftVolumeControlsLib::GetTargetGain(void *pChannelStruct)
    return pChannelData->panner.targetgainL32Q28;
 }
 
+// Unity and zero gain produce the same output as the 16 and 32 bit multiply paths (the rounding
+// term never carries into the result), so skip the arithmetic. For in-place processing unity
+// gain needs no memory access at all. Returns true if the gain was applied.
+boolean CSoftVolumeControlsLib::ApplyUnityOrZeroGain(void *pOutPtr, void *pInPtr, const uint32 gainQ28, uint32 samples)
+{
+   if (UNITY_L32_Q28 == gainQ28)
+   {
+      if (pOutPtr != pInPtr)
+      {
+         memscpy(pOutPtr, samples * m_bytesPerSample, pInPtr, samples * m_bytesPerSample);
+      }
+      return true;
+   }
+
+   if (0 == gainQ28)
+   {
+      memset(pOutPtr, 0, samples * m_bytesPerSample);
+      return true;
+   }
+
+   return false;
+}
+
 void CSoftVolumeControlsLib::ApplySteadyGain(void *pOutPtr, void *pInPtr, const uint32 gainQ28, uint32 samples)
 {
    switch (m_bytesPerSample)
    {
       case 2:
+         if (ApplyUnityOrZeroGain(pOutPtr, pInPtr, gainQ28, samples))
+         {
+            break;
+         }
 #if ((defined __hexagon__) || (defined __qdsp6__))
          if (gainQ28 < UNITY_L32_Q28)
          {
@@ -2022,6 +2049,10 @@ void CSoftVolumeControlsLib::ApplySteadyGain(void *pOutPtr, void *pInPtr, const
          break;
 
       case 4:
+         if (ApplyUnityOrZeroGain(pOutPtr, pInPtr, gainQ28, samples))
+         {
+            break;
+         }
          ApplySteadyGain32(pOutPtr, pInPtr, gainQ28, samples);
          break;
    }